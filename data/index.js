@@ -7,8 +7,21 @@ async function updateSensors() {
         const res = await fetch('/api/status');
         const data = await res.json();
         // BME280
-        if (data.bme280 && data.bme280.last_reading) {
-            const r = data.bme280.last_reading;
+        const bmeBtn = document.getElementById('bme280-read-btn');
+        // Each sensor is listed once; bme280_primary picks the main one
+        const bmeSensors = data.bme280_sensors || (data.bme280 ? [data.bme280] : []);
+        const bme = data.bme280_sensors ? data.bme280_sensors[data.bme280_primary] : data.bme280;
+        if (bmeBtn && bme) {
+            if (bmeSensors.some(b => b.state === 'updating' || b.state === 'reading')) {
+                bmeBtn.disabled = true;
+                bmeBtn.textContent = 'Reading...';
+            } else {
+                bmeBtn.disabled = false;
+                bmeBtn.textContent = 'Take BME280 Reading';
+            }
+        }
+        if (bme && bme.last_reading) {
+            const r = bme.last_reading;
             let bmeHtml = '';
             bmeHtml += `<b>Temperature:</b> ${r.temperature?.toFixed(2)} °C<br>`;
             bmeHtml += `<b>Humidity:</b> ${r.humidity?.toFixed(2)} %<br>`;
@@ -16,6 +29,17 @@ async function updateSensors() {
             bmeHtml += `<b>Heat Index:</b> ${r.heat_index?.toFixed(2)} °C<br>`;
             bmeHtml += `<b>Dew Point:</b> ${r.dew_point?.toFixed(2)} °C<br>`;
             bmeHtml += `<b>Timestamp:</b> ${r.timestamp || '--'}<br>`;
+            // With more than one sensor, each one's values and the median irrigation uses
+            if (bmeSensors.length > 1) {
+                bmeSensors.forEach(b => {
+                    const br = b.last_reading || {};
+                    bmeHtml += `<b>${b.address}:</b> ${br.avg_temperature?.toFixed(2)} °C, ${br.avg_humidity?.toFixed(2)} %, ${br.avg_pressure?.toFixed(2)} hPa<br>`;
+                });
+                const m = data.bme280_median;
+                if (m && m.valid) {
+                    bmeHtml += `<b>Median (${m.sensors}):</b> ${m.avg_temperature?.toFixed(2)} °C, ${m.avg_humidity?.toFixed(2)} %, ${m.avg_pressure?.toFixed(2)} hPa<br>`;
+                }
+            }
             document.getElementById('bme280-data').innerHTML = bmeHtml;
         } else {
             document.getElementById('bme280-data').textContent = '--';
@@ -110,27 +134,12 @@ window.addEventListener('DOMContentLoaded', () => {
             bmeBtn.disabled = true;
             bmeBtn.textContent = 'Reading...';
             try {
-                const res = await fetch('/api/bme280/trigger', { method: 'POST', headers: { 'Content-Type': 'application/json' }, body: '{}' });
-                const data = await res.json();
-                if (data.result === 'ok') {
-                    let bmeHtml = '';
-                    bmeHtml += `<b>Temperature:</b> ${data.temperature?.toFixed(2)} °C<br>`;
-                    bmeHtml += `<b>Humidity:</b> ${data.humidity?.toFixed(2)} %<br>`;
-                    bmeHtml += `<b>Pressure:</b> ${data.pressure?.toFixed(2)} hPa<br>`;
-                    bmeHtml += `<b>Heat Index:</b> ${data.heat_index?.toFixed(2)} °C<br>`;
-                    bmeHtml += `<b>Dew Point:</b> ${data.dew_point?.toFixed(2)} °C<br>`;
-                    document.getElementById('bme280-data').innerHTML = bmeHtml;
-                    bmeBtn.textContent = 'Take BME280 Reading';
-                } else {
-                    bmeBtn.textContent = 'Error';
-                }
+                await fetch('/api/bme280/trigger', { method: 'POST', headers: { 'Content-Type': 'application/json' }, body: '{}' });
+                // No need to handle response, updateSensors will poll and update state
             } catch (e) {
                 bmeBtn.textContent = 'Error';
-            }
-            setTimeout(() => {
-                bmeBtn.textContent = 'Take BME280 Reading';
                 bmeBtn.disabled = false;
-            }, 2000);
+            }
         });
     }
 
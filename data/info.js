@@ -227,6 +227,11 @@ function updateI2CInfo(data) {
     if (!el) return;
     let i2cHtml = '';
     // Removed SDA/SCL pin display
+    if (i2c.frequency) {
+        let speed = `${i2c.frequency / 1000} kHz`;
+        if (i2c.speed_fallback_device) speed += ` (requested ${i2c.requested_frequency / 1000} kHz, held back by ${i2c.speed_fallback_device})`;
+        i2cHtml += `<div><strong>Bus speed:</strong> <span class="value">${speed}</span></div>`;
+    }
     if (Array.isArray(i2c.devices) && i2c.devices.length > 0) {
         i2c.devices.forEach(dev => {
             i2cHtml += `<div><strong>Device:</strong> <span class="value">${dev.name || 'Unknown'} (${dev.address || 'N/A'})</span></div>`;
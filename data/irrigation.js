@@ -49,8 +49,8 @@ function updateIrrigationState() {
 
             // BME280
             let bmeHtml = '';
-            if (data.bme280 && data.bme280.last_reading) {
-                const b = data.bme280;
+            const b = data.bme280_sensors ? data.bme280_sensors[data.bme280_primary] : data.bme280;
+            if (b && b.last_reading) {
                 const r = b.last_reading;
                 bmeHtml += `<b>Temperature:</b> ${r.temperature?.toFixed(2)} °C` + '<br>';
                 bmeHtml += `<b>Humidity:</b> ${r.humidity?.toFixed(2)} %` + '<br>';
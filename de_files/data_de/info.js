@@ -227,6 +227,11 @@ function updateI2CInfo(data) {
     if (!el) return;
     let i2cHtml = '';
     // Removed SDA/SCL pin display
+    if (i2c.frequency) {
+        let speed = `${i2c.frequency / 1000} kHz`;
+        if (i2c.speed_fallback_device) speed += ` (angefordert ${i2c.requested_frequency / 1000} kHz, begrenzt durch ${i2c.speed_fallback_device})`;
+        i2cHtml += `<div><strong>Bustakt:</strong> <span class="value">${speed}</span></div>`;
+    }
     if (Array.isArray(i2c.devices) && i2c.devices.length > 0) {
         i2c.devices.forEach(dev => {
             i2cHtml += `<div><strong>Gerät:</strong> <span class="value">${dev.name || 'Unbekannt'} (${dev.address || 'N/A'})</span></div>`;
@@ -0,0 +1,52 @@
+#ifndef BME280_COMPENSATION_H
+#define BME280_COMPENSATION_H
+
+#include <stdint.h>
+
+// Trimming parameters of one BME280 and the integer compensation formulas
+// from section 4.2.3 of the Bosch datasheet (BST-BME280-DS002): 32-bit for
+// temperature and humidity, 64-bit for pressure. BME280Device reads the
+// trimming NVM once and then turns each 8-byte burst of the data registers
+// into a sample itself, so temperature is compensated once per sample
+// rather than once per quantity as the Adafruit driver does.
+class BME280Compensation {
+public:
+    static const uint8_t CALIB_TP_REG = 0x88; // dig_T1..dig_P9, dig_H1
+    static const uint8_t CALIB_TP_LEN = 26;
+    static const uint8_t CALIB_H_REG = 0xE1;  // dig_H2..dig_H6
+    static const uint8_t CALIB_H_LEN = 7;
+    static const uint8_t DATA_REG = 0xF7;     // press_msb..hum_lsb
+    static const uint8_t DATA_LEN = 8;
+
+    // Uncompensated codes from one burst of the data registers
+    struct Raw {
+        int32_t adcT; // 20 bits; SKIPPED_TP when temperature is off
+        int32_t adcP; // 20 bits; SKIPPED_TP when pressure is off
+        int32_t adcH; // 16 bits; SKIPPED_H when humidity is off
+    };
+    static const int32_t SKIPPED_TP = 0x80000; // Reset value, left by a skipped measurement
+    static const int32_t SKIPPED_H = 0x8000;
+
+    // Parses the 0x88..0xA1 and 0xE1..0xE7 register blocks
+    void parse(const uint8_t* tp, const uint8_t* h);
+    bool isLoaded() const { return loaded; }
+    static Raw parseData(const uint8_t* data); // DATA_LEN bytes from DATA_REG
+
+    // t_fine is produced by compensateT and consumed by the other two
+    int32_t compensateT(int32_t adcT, int32_t& tFine) const;   // 0.01 degC
+    uint32_t compensateP(int32_t adcP, int32_t tFine) const;   // Q24.8 Pa, 0 if the trimming is bad
+    uint32_t compensateH(int32_t adcH, int32_t tFine) const;   // Q22.10 %RH
+
+    // One sample in the units BME280Reading uses (degC, %RH, hPa); NAN for
+    // a skipped measurement
+    void compensate(const Raw& raw, float& temperature, float& humidity, float& pressure) const;
+
+private:
+    uint16_t T1 = 0; int16_t T2 = 0; int16_t T3 = 0;
+    uint16_t P1 = 0; int16_t P2 = 0; int16_t P3 = 0; int16_t P4 = 0; int16_t P5 = 0;
+    int16_t P6 = 0; int16_t P7 = 0; int16_t P8 = 0; int16_t P9 = 0;
+    uint8_t H1 = 0; int16_t H2 = 0; uint8_t H3 = 0; int16_t H4 = 0; int16_t H5 = 0; int8_t H6 = 0;
+    bool loaded = false;
+};
+
+#endif // BME280_COMPENSATION_H
@@ -3,8 +3,11 @@
 #define BME280_DEVICE_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <Adafruit_BME280.h>
 #include <RTClib.h> // Include RTClib for DateTime
+#include "devices/BME280Compensation.h"
+#include "system/I2CTracer.h"
 // Forward declaration to avoid circular include
 class I2CManager;
 #include "diagnostics/DiagnosticManager.h"
@@ -26,6 +29,29 @@ struct BME280Reading {
 };
 
 class TimeManager; // Forward declaration
+
+// A reading is ten forced conversions, filtered and averaged. It runs as a
+// state machine: startReading() (or requestReading() from another task)
+// begins it, update() on the loop task takes the next step once its wait is
+// over, and the bus is only held for the register traffic of each step.
+// Each conversion waits the datasheet's typical measurement time for the
+// oversampling in use, then polls the status register's measuring bit
+// until the maximum time; at x16 on all three the result lands in
+// getLastReading() about 1 s later. readData() runs the same steps to
+// completion, for boot.
+//
+// The Adafruit driver only sets the chip up; each sample is one burst of
+// the eight data registers behind a repeated START, compensated here with
+// the trimming read at begin(). Two transactions a sample instead of ten.
+//
+// In normal mode the chip measures continuously, standing by between
+// measurements, and its IIR filter smooths temperature and pressure. A
+// sample is then one burst of the latest filtered values, with no
+// conversion waits; only the first after begin() waits for a measurement.
+// A reading averages normalSamples of them, one measurement period apart,
+// so humidity (which the chip does not filter) is as quiet as in forced
+// mode. With one sample a reading is a single burst, at about 2.5x the
+// humidity noise.
 class BME280Device {
 public:
     void forceIdle();
@@ -40,27 +66,86 @@ public:
             default: return "unknown";
         }
     }
+    enum Mode { MODE_FORCED, MODE_NORMAL };
+    static const char* modeToString(Mode m) { return m == MODE_NORMAL ? "normal" : "forced"; }
     BME280Device(uint8_t address, I2CManager* i2c, DiagnosticManager* diag);
+    // Before begin(). standbyMs (normal mode) and iirCoefficient (0 = off)
+    // are rounded to the nearest setting the chip has; normalSamples is
+    // clamped to 1..SAMPLES.
+    void setMode(Mode mode, float standbyMs = 125.0f, uint8_t iirCoefficient = 16, uint8_t normalSamples = SAMPLES);
+    Mode getMode() const { return mode; }
+    uint8_t getNormalSamples() const { return normalSamples; }
+    // Before begin(); applies to T, P and H and is rounded to 1, 2, 4, 8 or 16
+    void setOversampling(uint8_t samples);
+    uint8_t getOversampling() const { return oversampling; }
     void setTimeManager(TimeManager* timeMgr);
-    bool begin();
-    BME280Reading readData();
+    // With firstReading false the caller takes the first reading, e.g.
+    // BME280Group::readData() for all sensors at once
+    bool begin(bool firstReading = true);
+    void logInitialReading();
+    BME280Reading readData(); // Blocks until the reading is done
+    bool startReading();       // Loop task; false if the sensor is not there
+    void requestReading();     // Any task; started by the next update()
+    bool update();             // Loop task; true when a reading just completed
+    bool isReading() const { return step != STEP_IDLE; }
+    // millis() at which update() takes the next step, while isReading()
+    unsigned long getNextStepMs() const { return stepStart + stepWaitMs; }
+    bool isInitialized() const { return initialized; }
+    uint32_t getReadingCount() const { return readingCount; } // Completed readings
+    // Reads and compensates the data registers of the last conversion into
+    // temperature, humidity and pressure; false on a bus error
+    bool readMeasurement(BME280Reading& sample);
     const BME280Reading& getLastReading() const { return lastReading; }
     uint8_t getAddress() const { return address; }
     State getState() const { return state; }
     const String& getLastError() const { return lastError; }
+    // Pure helpers, static so the host benchmarks can call them directly
+    static float computeHeatIndex(float t, float h);
+    static float computeDewPoint(float t, float h);
+    static void filterAndAverage(const BME280Reading* readings, int count, BME280Reading& avgResult);
+    // Datasheet 9.1 measurement time for oversampling counts (0 = skipped)
+    static uint32_t maxMeasurementUs(uint8_t osrsT, uint8_t osrsP, uint8_t osrsH);
+    static uint32_t typicalMeasurementUs(uint8_t osrsT, uint8_t osrsP, uint8_t osrsH);
+    static const int SAMPLES = 10; // Per forced reading, and the most per normal-mode one
 private:
+    enum Step { STEP_IDLE, STEP_CONVERTING, STEP_LATEST };
+
     uint8_t address;
     I2CManager* i2cManager;
     DiagnosticManager* diagnosticManager;
     TimeManager* timeManager = nullptr;
     Adafruit_BME280 bme;
+    BME280Compensation compensation;
+    Mode mode = MODE_FORCED;
+    Adafruit_BME280::standby_duration standby = Adafruit_BME280::STANDBY_MS_125;
+    float standbyMs = 125.0f;
+    uint8_t normalSamples = SAMPLES;
+    Adafruit_BME280::sensor_filter filter = Adafruit_BME280::FILTER_X16;
+    uint8_t oversampling = 16;
+    Adafruit_BME280::sensor_sampling sampling = Adafruit_BME280::SAMPLING_X16;
+    unsigned long firstResultMs = 0; // millis() of the first normal-mode measurement
     bool initialized = false;
     BME280Reading lastReading; // Store the last reading
     State state = UNINITIALIZED;
     String lastError;
-    float computeHeatIndex(float t, float h);
-    float computeDewPoint(float t, float h);
-    void filterAndAverage(const BME280Reading* readings, int count, BME280Reading& avgResult);
+    Step step = STEP_IDLE;
+    unsigned long stepStart = 0;
+    unsigned long stepWaitMs = 0;
+    unsigned long conversionMaxMs = 0; // Give up on the measuring bit after this
+    int sampleCount = 0;
+    BME280Reading samples[SAMPLES];
+    std::atomic<bool> readRequested{false};
+    uint32_t readingCount = 0;
+
+    bool readRegisters(I2CTracer::Access& access, uint8_t reg, uint8_t* buffer, uint8_t len);
+    bool loadCompensation();
+    void applySampling(Adafruit_BME280::sensor_mode chipMode);
+    void beginStep(Step next, unsigned long waitMs);
+    unsigned long measurementMs(bool typical) const; // Rounded up, plus a millis() tick
+    bool conversionDone(); // Measuring bit clear; false on a bus error
+    void triggerConversion();
+    void collectSample();
+    void finishReading();
 };
 
 #endif // BME280_DEVICE_H
@@ -0,0 +1,40 @@
+#ifndef BME280_GROUP_H
+#define BME280_GROUP_H
+
+#include "devices/BME280Device.h"
+
+// Every BME280 found on the bus, acquired together. startReading() starts
+// each sensor's state machine at once; update() on the loop task steps
+// them independently, so their conversion waits overlap and two
+// sensors take about as long as one. getMedianReading() is the value the
+// irrigation decision uses: with three sensors one bad part cannot move it,
+// with two it is their mean. The devices are owned by I2CManager.
+class BME280Group {
+public:
+    static const int MAX_SENSORS = 3; // I2CManager probes 0x70, 0x76 and 0x77
+
+    bool add(BME280Device* device); // false when full
+    void clear() { count = 0; }
+    int size() const { return count; }
+    BME280Device* get(int index) const { return index >= 0 && index < count ? devices[index] : nullptr; }
+
+    int startReading();      // Loop task; returns how many sensors started
+    void requestReading();   // Any task; each sensor starts on its next update()
+    bool isReading() const;  // Any sensor still reading
+    void forceIdle();
+    BME280Reading readData(); // Blocks until every sensor is done, for boot
+
+    // Per-quantity median of the sensors whose last reading is valid;
+    // valid is false when there are none
+    BME280Reading getMedianReading() const;
+    int validCount() const;
+
+    // Median of the non-NaN values, NAN if there are none; reorders values
+    static float median(float* values, int n);
+
+private:
+    BME280Device* devices[MAX_SENSORS];
+    int count = 0;
+};
+
+#endif // BME280_GROUP_H
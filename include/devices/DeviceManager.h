@@ -6,6 +6,7 @@
 #include "devices/Device.h"
 #include "config/ConfigManager.h"
 #include "devices/SoilMoistureSensor.h"
+#include "devices/BME280Group.h"
 
 class Device;
 class BME280Device;
@@ -17,11 +18,13 @@ public:
     void addDevice(Device* device);
     
     // Getter methods for specific device types
-    BME280Device* getBME280Device();
+    BME280Device* getBME280Device(); // The first BME280 found
+    BME280Group& getBME280Group() { return bme280Group; } // Every BME280 found
     SoilMoistureSensor* getSoilMoistureSensor();
     
     // Setter methods for sensor devices (these are managed separately)
     void setBME280Device(BME280Device* device);
+    void addBME280Device(BME280Device* device); // The first added is also the primary
 private:
     static const int MAX_DEVICES = 8;
     Device* devices[MAX_DEVICES];
@@ -30,6 +33,7 @@ private:
     
     // Direct references to sensor devices
     BME280Device* bme280Device = nullptr;
+    BME280Group bme280Group;
 };
 
 #endif // DEVICE_MANAGER_H
@@ -5,7 +5,7 @@
 #include "devices/SoilMoistureSensor.h"
 #include "devices/RelayController.h"
 #include "devices/Relay.h"
-#include "devices/BME280Device.h"
+#include "devices/BME280Group.h"
 #include "system/TimeManager.h"
 #include "config/ConfigManager.h" // Corrected include path
 #include <cJSON.h>
@@ -14,7 +14,8 @@ class IrrigationManager {
 public:
 
     IrrigationManager();
-    void begin(BME280Device* bme, SoilMoistureSensor* soil, TimeManager* timeMgr);
+    // Every BME280 is read; the watering decision uses their median
+    void begin(BME280Group* bme, SoilMoistureSensor* soil, TimeManager* timeMgr);
     void trigger(); // Start the irrigation reading sequence
     void update();  // Call this in loop to process state
     void checkAndRunScheduled(); // Check if it's time to run scheduled irrigation
@@ -27,7 +28,7 @@ public:
 private:
     enum State { IDLE, START, BME_READING, SOIL_READING, MQ135_READING, WATER_NOW, COMPLETE };
     State state = IDLE;
-    BME280Device* bme280 = nullptr;
+    BME280Group* bme280 = nullptr;
     SoilMoistureSensor* soilSensor = nullptr;
     TimeManager* timeManager = nullptr;
     ConfigManager* configManager = nullptr; // Add ConfigManager pointer
@@ -65,6 +66,8 @@ public:
     float getLastAvgSoilCorrected() const { return lastAvgSoilCorrected; }
     time_t getLastReadingTimestamp() const { return lastReadingTimestamp; }
     time_t getLastRunTimestamp() const { return lastRunTimestamp; }
+    bool isWateringActive() const { return wateringActive; }
+    unsigned long getWateringEnd() const { return wateringStart + (unsigned long)wateringDuration * 1000UL; } // millis() when watering stops
     void setConfigManager(ConfigManager* cfg) { configManager = cfg; } // Setter for ConfigManager
     void setRelayController(RelayController* rc) { relayController = rc; }
     void setDashboardManager(class DashboardManager* dm) { dashboardManager = dm; } // Setter for DashboardManager
@@ -5,6 +5,7 @@
 #include <Arduino.h>
 #include <ctime>
 #include "system/ADS1115Manager.h"
+#include "system/ADS1115Sampler.h"
 #include "config/ConfigManager.h"
 #include "devices/RelayController.h"
 #include "system/TimeManager.h"
@@ -19,7 +20,10 @@ public:
     MQ135Sensor();
     void begin(ADS1115Manager* adsMgr, ConfigManager* configMgr, RelayController* relayCtrl, DiagnosticManager* diagMgr = nullptr);
     void startReading(); // Activates relay, starts warmup
-    bool readyForReading() const; // True if warmup time has elapsed
+    // True once warmup time has elapsed and, with a sampler, the sampler
+    // task has collected the window takeReading() will use
+    bool readyForReading();
+    void setSampler(ADS1115Sampler* adsSampler); // Registers the input; call after begin()
     void takeReading(); // Takes the reading, deactivates relay
     struct Reading {
         int16_t raw = 0;
@@ -64,20 +68,32 @@ public:
         if (strcmp(label, "Very Poor") == 0) return 5;
         return 0; // unknown/error
     }
+    // Drops the min and max raw sample and averages the rest
+    static void filterAndAverage(float* rawVals, float* voltVals, int count, float& avgRaw, float& avgVolt);
 private:
     ADS1115Manager* ads = nullptr;
     ConfigManager* config = nullptr;
     RelayController* relay = nullptr;
+    ADS1115Sampler* sampler = nullptr;
+    int samplerId = -1;
+    bool acquiring = false; // Window requested from the sampler, not yet taken
+    unsigned long acquireStart = 0;
     TimeManager* timeManager = nullptr;
     DiagnosticManager* diagnosticManager = nullptr;
-    static constexpr uint8_t channel = 1; // A1
-    static constexpr ADS1115Manager::Gain gain = ADS1115Manager::GAIN_TWOTHIRDS; // For 6V (±6.144V)
+    // mq135.ads_channel and .gain; GAIN_TWOTHIRDS for 6V (±6.144V). With
+    // mq135.auto_gain the ADS1115 reads at the tightest range that fits
+    // (a few hundred mV need +/-0.512V or +/-1.024V) and raw is rescaled to gain.
+    uint8_t channel = 1;
+    ADS1115Manager::Gain gain = ADS1115Manager::GAIN_TWOTHIRDS;
+    bool autoGain = true;
+    static constexpr size_t BURST_SAMPLES = 32; // Per takeReading(), min and max dropped
+    static constexpr ADS1115Manager::DataRate BURST_RATE = ADS1115Manager::SPS_860;
+    static constexpr unsigned long ACQUIRE_TIMEOUT_MS = 500; // Then take whatever the sampler has
     Reading lastReading{};
     unsigned long warmupStart = 0;
     int warmupTimeSec = 60;
     bool warmingUp = false;
     State state = IDLE;
-    void filterAndAverage(float* rawVals, float* voltVals, int count, float& avgRaw, float& avgVolt);
 };
 
 #endif // MQ135_SENSOR_H
@@ -5,6 +5,7 @@
 #include <Arduino.h>
 #include <ctime>
 #include "system/ADS1115Manager.h"
+#include "system/ADS1115Sampler.h"
 #include "config/ConfigManager.h"
 #include "system/TimeManager.h"
 #include "diagnostics/DiagnosticManager.h"
@@ -34,15 +35,35 @@ public:
         float avgVoltage = 0;
         float avgPercent = 0;
     };
+    // One ADC conversion and the values derived from it
+    struct Sample {
+        int16_t raw;
+        float voltage;
+        float percent;
+    };
     SoilMoistureSensor();
     void begin(ADS1115Manager* adsMgr, ConfigManager* configMgr = nullptr, TimeManager* timeMgr = nullptr, DiagnosticManager* diagMgr = nullptr);
+    Sample readSample(); // Single conversion
     int16_t readRaw();
     float readVoltage();
     void readBoth(int16_t& raw, float& voltage);
     float readPercent();
+    // Wet/dry calibration mapping used by readSample(), clamped to 0..100
+    static float rawToPercent(int16_t raw, int wet, int dry);
+    // Drops the min and max raw sample and averages the rest
+    static void filterAndAverage(float* rawVals, float* voltVals, float* percentVals, int count, float& avgRaw, float& avgVolt, float& avgPercent);
     void takeReading();
     void beginStabilisation(); // Start stabilisation timer
-    bool readyForReading() const; // True if stabilisation time has elapsed
+    // True once stabilisation time has elapsed and, with a sampler, the
+    // sampler task has collected the window takeReading() will use
+    bool readyForReading();
+    void setSampler(ADS1115Sampler* adsSampler); // Registers the input; call after begin()
+    // With soil_moisture.dry_watch, a reading wetter than watering_threshold
+    // leaves the probe powered and the ADS1115 comparator watching for the
+    // dryness crossing. Returns true once when the chip has flagged it
+    // (a flag check, no bus traffic until then); call from loop().
+    bool checkDryWatch();
+    bool isDryWatchArmed() const { return dryWatchArmed; }
     const Reading& getLastReading() const;
     void printReading() const; // Print the last reading to Serial
     unsigned long getStabilisationStart() const { return stabilisationStart; }
@@ -63,16 +84,38 @@ public:
 private:
     ADS1115Manager* ads = nullptr;
     ConfigManager* config = nullptr;
+    ADS1115Sampler* sampler = nullptr;
+    int samplerId = -1;
+    bool acquiring = false; // Window requested from the sampler, not yet taken
+    unsigned long acquireStart = 0;
     TimeManager* timeManager = nullptr;
     DiagnosticManager* diagnosticManager = nullptr;
-    static constexpr uint8_t channel = 0; // A0
-    static constexpr ADS1115Manager::Gain gain = ADS1115Manager::GAIN_TWOTHIRDS; // For 3.3V
+    // soil_moisture.ads_channel and .gain; GAIN_TWOTHIRDS keeps 3.3V in range.
+    // With soil_moisture.auto_gain the ADS1115 reads at the tightest range
+    // that fits and raw is rescaled to gain, so wet/dry still apply.
+    uint8_t channel = 0;
+    ADS1115Manager::Gain gain = ADS1115Manager::GAIN_TWOTHIRDS;
+    bool autoGain = true;
+    bool dryWatch = false;      // soil_moisture.dry_watch; needs ads1115_alert_gpio
+    bool dryWatchArmed = false;
+    static constexpr size_t BURST_SAMPLES = 32; // Per takeReading(), min and max dropped
+    static constexpr ADS1115Manager::DataRate BURST_RATE = ADS1115Manager::SPS_860;
+    static constexpr unsigned long ACQUIRE_TIMEOUT_MS = 500; // Then take whatever the sampler has
+    void loadCalibration(); // Re-reads soil_moisture wet/dry from config
+    void armDryWatch();     // After a reading: arms the comparator if the soil is wet
+    void disarmDryWatch();
+    int16_t readCode(ADS1115Manager::Gain& codeGain); // One conversion, at the gain it was read at
+    Sample toSample(int16_t code, ADS1115Manager::Gain codeGain) const;
     Reading lastReading{};
+    // Cached by begin() and each beginStabilisation(), so a calibration
+    // saved from the web UI applies from the next reading
+    bool calibrated = false; // No config or soil_moisture section: percent reads 0
+    int calibrationWet = 0;
+    int calibrationDry = 11300;
     unsigned long stabilisationStart = 0;
     int stabilisationTimeSec = 10;
     int soilPowerGpio = -1;
     State state = IDLE;
-    void filterAndAverage(float* rawVals, float* voltVals, float* percentVals, int count, float& avgRaw, float& avgVolt, float& avgPercent);
 };
 
 #endif // SOIL_MOISTURE_SENSOR_H
@@ -0,0 +1,88 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <Arduino.h>
+#include <cJSON.h>
+
+// Per-operation heap accounting. cJSON's allocator hooks and the global
+// operator new/delete report every allocation to the innermost active
+// Scope on the calling task; each operation (web handler, MQTT publish)
+// accumulates calls, allocations, bytes requested and the peak net bytes
+// held while it ran. Arduino String and plain malloc() are not seen.
+// Nested scopes also count towards their parent.
+//
+// Outside any scope the hooks still keep process-wide totals of live
+// blocks and bytes, so slow leaks show up as a rising baseline, and
+// bytes an operation leaves allocated when it returns are summed per
+// operation (net_bytes).
+//
+// The hooks are only built with -D ALLOC_TRACKING, which the native env
+// sets. Without it the firmware keeps the default allocators (cJSON can
+// then grow print buffers with realloc), scopes only count calls, and
+// /api/metrics/alloc reports "tracking": false.
+class AllocationTracker {
+public:
+    static const int MAX_OPERATIONS = 48;
+    static const int NAME_LENGTH = 40;
+
+    struct Operation {
+        char name[NAME_LENGTH];
+        uint32_t calls;
+        uint64_t allocs;
+        uint64_t bytes;
+        uint32_t maxAllocs;    // Worst single call
+        uint32_t maxBytes;
+        uint32_t maxPeakBytes; // Highest net bytes held at once during a call
+        int64_t netBytes;      // Still allocated when the calls returned, summed
+    };
+
+    struct Totals {
+        uint32_t liveBlocks;
+        int32_t liveBytes;     // Usable size, as the heap accounts for it
+        int32_t peakLiveBytes;
+        uint64_t allocs;
+    };
+
+    class Scope {
+    public:
+        explicit Scope(const char* operation);
+        ~Scope();
+    private:
+        int index;
+        uint32_t allocs = 0;
+        uint32_t bytes = 0;
+        int32_t liveBytes = 0;
+        int32_t peakBytes = 0;
+        Scope* parent;
+        friend class AllocationTracker;
+    };
+
+    static void begin(); // Installs the cJSON hooks when ALLOC_TRACKING is set
+#ifdef ALLOC_TRACKING
+    static bool isEnabled() { return true; }
+#else
+    static bool isEnabled() { return false; }
+#endif
+    static void reset();
+    static int getOperationCount();
+    static const Operation* getOperation(int index);
+    static const Operation* findOperation(const char* name);
+    static cJSON* getStatsJson(); // Returns all operations as a cJSON object
+    static Totals getTotals();
+
+    // Optional observer of every allocation and free the hooks see, e.g. a
+    // heap model on the host. Set before the firmware starts allocating.
+    typedef void (*AllocateListener)(void* ptr, size_t size);
+    typedef void (*FreeListener)(void* ptr);
+    static void setListener(AllocateListener onAllocate, FreeListener onFree);
+
+    // Allocator hooks
+    static void noteAllocation(void* ptr, size_t size);
+    static void noteFree(void* ptr);
+
+private:
+    static int findOrAdd(const char* name);
+    static void finish(Scope& scope);
+};
+
+#endif // ALLOCATION_TRACKER_H
@@ -2,7 +2,43 @@
 #define ADS1115_MANAGER_H
 
 #include <Arduino.h>
+#include "system/I2CTracer.h"
 
+// Single-shot and burst reads from an ADS1115. By default a single-shot
+// read polls the OS bit of the config register until the conversion is
+// done, holding the I2C bus throughout. With an ALERT/RDY GPIO the chip is
+// put in conversion-ready mode and the read sleeps on the interrupt
+// instead, leaving the bus and CPU free while it converts. If the interrupt
+// stops arriving (line not wired, no pull-up) reads are finished by
+// polling, and after a few misses in a row the manager falls back to
+// polling for good.
+//
+// readBurst() runs the chip in continuous mode at up to 860 SPS and reads
+// each conversion as it lands, on the ALERT/RDY pulse or paced by time, so
+// dozens of samples take tens of milliseconds rather than a single-shot
+// read each. The bus is released between samples.
+//
+// The *Auto() reads pick the PGA gain themselves: the tightest range whose
+// full scale keeps the signal under AUTO_RANGE_HEADROOM_PERCENT. The gain
+// is cached per input and re-aimed from the peak of each read, so a
+// range-finding conversion at +/-6.144V is only needed the first time and
+// after a read clips.
+//
+// startWatch() leaves one input converting continuously with the on-chip
+// comparator armed: the chip compares every result with Lo_thresh and
+// Hi_thresh itself and latches ALERT/RDY low once the input has been out
+// of bounds for a few conversions. Until then nothing touches the bus; the
+// interrupt only sets a flag that watchTripped() reads. Other reads on the
+// chip still work: they pause the watch (waiting out the conversion in
+// flight) and re-arm it when done, and use polling while it is armed
+// because the thresholds are taken.
+//
+// The manager keeps a shadow of the chip's pointer, config and threshold
+// registers. A pointer write is only sent when the pointer has to move, and
+// is joined to the following read by a repeated START, so polling the OS
+// bit is a bare 2-byte read. Writes that would not change a register are
+// skipped; a single-shot config write always goes out, as it starts the
+// conversion. Any bus error forgets the shadow.
 class ADS1115Manager {
 public:
     enum Gain {
@@ -14,18 +50,159 @@ public:
         GAIN_SIXTEEN = 5    // +/-0.256V
     };
 
+    enum ComparatorMode {
+        COMPARATOR_TRADITIONAL = 0, // Above Hi_thresh; released below Lo_thresh
+        COMPARATOR_WINDOW = 1       // Above Hi_thresh or below Lo_thresh
+    };
+
+    enum DataRate {
+        SPS_8 = 0,
+        SPS_16 = 1,
+        SPS_32 = 2,
+        SPS_64 = 3,
+        SPS_128 = 4, // Single-shot reads
+        SPS_250 = 5,
+        SPS_475 = 6,
+        SPS_860 = 7
+    };
+
+    // How reads waited for their conversion since begin()
+    struct ReadStats {
+        uint32_t alertReads;   // Woken by ALERT/RDY
+        uint32_t polledReads;  // Polled the OS bit (no ALERT/RDY configured, or after fallback)
+        uint32_t missedAlerts; // ALERT/RDY did not arrive in time, finished by polling
+        uint32_t timeouts;     // Conversion never reported ready
+        uint32_t bursts;
+        uint32_t burstSamples;
+        uint32_t rangeFinds;   // Range-finding conversions for auto gain
+        uint32_t gainChanges;  // Auto gain moved to another range
+        uint32_t watchTrips;   // Comparator alerts while watching
+        uint32_t elidedWrites; // Register writes skipped, value already there
+    };
+
     ADS1115Manager();
-    void begin(SemaphoreHandle_t i2cMutex = nullptr, uint8_t i2cAddress = 0x48);
+    // alertGpio: GPIO wired to ALERT/RDY, or -1 to poll
+    void begin(SemaphoreHandle_t i2cMutex = nullptr, uint8_t i2cAddress = 0x48, I2CTracer* tracer = nullptr, int alertGpio = -1);
     float readVoltage(uint8_t channel, Gain gain = GAIN_TWOTHIRDS, uint16_t timeoutMs = 100);
     bool isConnected() const;
     uint8_t getAddress() const;
     uint16_t readRaw(uint8_t channel, Gain gain, uint16_t timeoutMs);
+    // Fills samples with count consecutive conversions of one channel in
+    // continuous mode, then returns the chip to power-down. Returns the
+    // number of samples read; fewer than count only on a bus error.
+    size_t readBurst(uint8_t channel, Gain gain, DataRate rate, int16_t* samples, size_t count, uint16_t timeoutMs = 100);
+
+    // One readBurst() on one chip, as part of readBurstGroup()
+    struct BurstJob {
+        ADS1115Manager* ads;
+        uint8_t channel;
+        Gain gain;
+        DataRate rate;
+        int16_t* samples;
+        size_t count;
+        size_t taken; // Set on return
+    };
+    static const size_t MAX_GROUP_JOBS = 4; // One per ADS1115 address
+    // Runs one burst on each of several chips at once: every chip is put in
+    // continuous mode before any sample is read, then samples are collected
+    // round-robin, so the group takes about as long as its longest burst.
+    // Each job must name a different chip.
+    static void readBurstGroup(BurstJob* jobs, size_t jobCount, uint16_t timeoutMs = 100);
+    // Auto-ranged versions: gain is set to the range the codes were read at
+    uint16_t readRawAuto(uint8_t channel, Gain& gain, uint16_t timeoutMs = 100);
+    size_t readBurstAuto(uint8_t channel, DataRate rate, int16_t* samples, size_t count, Gain& gain, uint16_t timeoutMs = 100);
+    // Cached auto gain for an input; runs one range-finding conversion if
+    // there is none yet
+    Gain getAutoGain(uint8_t channel, uint16_t timeoutMs = 100);
+    // Re-aims the cached gain from codes read at gain. Returns false if they
+    // clipped, i.e. should be read again at getAutoGain().
+    bool updateAutoGain(uint8_t channel, Gain gain, const int16_t* codes, size_t count);
+    static float codeToVolts(int16_t code, Gain gain);
+    static float fullScaleVolts(Gain gain);
+    // The same voltage as a code at another gain, e.g. to keep raw values
+    // and calibrations in one scale while the gain changes
+    static float rescaleCode(float code, Gain from, Gain to);
+    static uint32_t conversionPeriodUs(DataRate rate); // Nominal 1/DR
+    // Needs the ALERT/RDY GPIO. Latching, and asserts after four
+    // conversions out of bounds, so a single noisy result does not trip it.
+    // The rate bounds how long another read waits for the chip (one period).
+    bool startWatch(uint8_t channel, Gain gain, int16_t loThresh, int16_t hiThresh,
+                    ComparatorMode mode = COMPARATOR_WINDOW, DataRate rate = SPS_64);
+    // Powers the chip down and frees the thresholds; lastCode gets the
+    // final conversion if not null
+    void stopWatch(int16_t* lastCode = nullptr);
+    bool isWatching() const { return watch.armed; }
+    bool watchTripped() const { return watch.tripped; } // No bus access
+    // Off: every access sets the pointer and writes its register, with a
+    // STOP before each read, as the driver used to. For comparisons.
+    void setRegisterCache(bool enabled);
+    bool isAlertMode() const { return alertMode; }
+    const ReadStats& getReadStats() const { return readStats; }
 
 private:
+    static const uint8_t MAX_MISSED_ALERTS = 3; // In a row, before falling back to polling
+    // The internal oscillator may run up to 10% slow; time-paced burst
+    // samples wait that much longer so no conversion is read twice
+    static const uint32_t PACE_MARGIN_PERCENT = 110;
+    // Auto gain aims for the signal to stay under this share of full scale,
+    // and only moves to a wider range once it passes LOOSEN, so a signal
+    // near a boundary does not flip between two ranges
+    static const uint32_t AUTO_RANGE_HEADROOM_PERCENT = 80;
+    static const uint32_t AUTO_RANGE_LOOSEN_PERCENT = 95;
+    static const int16_t CLIP_CODE = 32767;
+
     uint8_t address = 0x48;
     bool connected = false;
     SemaphoreHandle_t i2cMutex = nullptr;
+    I2CTracer* i2cTracer = nullptr;
+    int alertGpio = -1;
+    volatile bool alertMode = false;
+    bool alertAttached = false; // Interrupt attached, for reads or the watch
+    SemaphoreHandle_t alertReady = nullptr;      // Given by the ALERT/RDY interrupt
+    SemaphoreHandle_t conversionMutex = nullptr; // One conversion at a time on this chip
+    uint8_t consecutiveMisses = 0;
+    ReadStats readStats = {};
+    bool registerCache = true;
+    int8_t pointerShadow = -1;      // Register the pointer is on, -1 unknown
+    int32_t registerShadow[4] = { -1, -1, -1, -1 }; // Last value written; config without OS
+    int8_t autoGain[4] = { -1, -1, -1, -1 }; // Per input, -1 until range-found
+    struct BurstState {
+        uint16_t config;
+        uint32_t paceUs;
+        unsigned long due; // micros() of the next time-paced sample
+        bool onAlert;
+        size_t taken;
+    } burst = {};
+    struct WatchState {
+        uint16_t config;         // Continuous mode, comparator on
+        uint16_t idleTimeoutMs;  // Longest wait for the conversion in flight
+        int16_t lo;
+        int16_t hi;
+        volatile bool armed;
+        volatile bool paused;    // A read has the chip
+        volatile bool tripped;   // Set by the interrupt
+    } watch = {};
+
     bool checkConnection();
+    bool enableAlert();
+    void disableAlert();
+    void attachAlert();
+    bool writeThresholds(int16_t lo, int16_t hi);
+    void pauseWatch();  // Caller holds conversionMutex
+    void resumeWatch(); // Caller holds conversionMutex
+    uint16_t readPolled(uint16_t config, uint16_t timeoutMs);
+    uint16_t readOnAlert(uint16_t config, uint16_t timeoutMs);
+    bool writeRegister(I2CTracer::Access& access, uint8_t reg, uint16_t value);
+    bool selectRegister(I2CTracer::Access& access, uint8_t reg); // Pointer write, repeated START follows
+    bool readRegister(I2CTracer::Access& access, uint8_t reg, uint16_t& value);
+    void forgetRegisters();
+    bool waitForConversion(I2CTracer::Access& access, uint16_t timeoutMs);
+    uint16_t readConversion(I2CTracer::Access& access);
+    // Burst steps; burstBegin() holds conversionMutex until burstEnd()
+    bool burstBegin(uint8_t channel, Gain gain, DataRate rate);
+    bool burstNext(int16_t& code, uint16_t timeoutMs);
+    void burstEnd(size_t taken);
+    static void IRAM_ATTR onAlert(void* arg);
 };
 
 #endif // ADS1115_MANAGER_H
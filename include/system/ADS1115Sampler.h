@@ -0,0 +1,163 @@
+#ifndef ADS1115_SAMPLER_H
+#define ADS1115_SAMPLER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <cJSON.h>
+#include "system/ADS1115Manager.h"
+#include "system/SampleRing.h"
+
+// Background acquisition for ADS1115 inputs. Each sensor registers its
+// channel once and gets a single-producer/single-consumer ring. When the
+// sensor is ready it calls request(); a dedicated FreeRTOS task then fills
+// the ring with fresh conversions in short readBurst() chunks while loop()
+// carries on, and the sensor pops the window once available() reaches the
+// count it asked for. The task sleeps while no request is outstanding, so
+// an unpowered sensor is never sampled.
+//
+// Only the loop task may call request(), available() and readWindow() for
+// a channel; only the sampler task pushes.
+//
+// Inputs that are always powered can instead be scanned: the ads1115_scan
+// config array lists them, each with its own gain, data rate, burst length,
+// filter and interval. update() (loop task) marks scans that are due, the
+// task reads them after any outstanding request, and getScanValue() returns
+// the latest filtered value of each. An extra soil probe on A2 or A3 is one
+// more array entry with its wet/dry calibration.
+//
+// Up to four chips (0x48-0x4B, device 0-3) can be attached; inputs are
+// addressed as (device, channel). Each pass runs one due scan per chip
+// through ADS1115Manager::readBurstGroup(), so the chips convert in
+// parallel and a pass takes about as long as one scan.
+class ADS1115Sampler {
+public:
+    static const int MAX_DEVICES = 4;
+    static const int MAX_CHANNELS = 4;
+    static const size_t RING_SAMPLES = 64; // Largest window a request can ask for
+    static const size_t CHUNK_SAMPLES = 8; // Per readBurst(), so channels take turns
+    static const int MAX_SCANS = 4;
+    static const size_t MAX_SCAN_SAMPLES = 32;
+
+    enum Filter {
+        FILTER_MEAN,
+        FILTER_TRIMMED_MEAN, // Drops the min and max sample, as the sensors do
+        FILTER_MEDIAN
+    };
+
+    struct ScanConfig {
+        char name[24];
+        uint8_t device;      // ADS1115 at 0x48 + device
+        uint8_t channel;
+        ADS1115Manager::Gain gain; // Scale of code, wet and dry; the read gain unless autoGain
+        bool autoGain;       // Read at the tightest range that fits
+        ADS1115Manager::DataRate rate;
+        uint8_t samples;     // Per scan, 1..MAX_SCAN_SAMPLES
+        Filter filter;
+        uint32_t intervalMs;
+        bool calibrated;     // wet/dry given: report a moisture percent
+        int wet;
+        int dry;
+    };
+
+    struct ScanValue {
+        bool valid;          // At least one scan completed
+        float code;          // Filtered raw code, in ScanConfig::gain's scale
+        ADS1115Manager::Gain readGain; // Range the last scan was read at
+        float volts;
+        float percent;       // 0 unless calibrated
+        unsigned long updatedMs;
+        uint32_t scans;
+        uint32_t failures;   // Scans whose burst came back short
+    };
+
+    struct Stats {
+        uint32_t requests;
+        uint32_t samples;  // Pushed into a ring
+        uint32_t bursts;
+        uint32_t failures; // Bursts that came back short; the request is dropped
+    };
+
+    // Starts the task with adsMgr as device 0. Returns false (sensors read
+    // the ADS1115 directly) if no attached chip is connected or the task
+    // cannot be created.
+    bool begin(ADS1115Manager* adsMgr, ADS1115Manager::DataRate dataRate = ADS1115Manager::SPS_860);
+    void addDevice(int device, ADS1115Manager* adsMgr); // Devices 1-3, before begin()
+    bool hasDevice(int device) const;                   // Attached and connected
+    bool isRunning() const { return task != nullptr; }
+    // Returns a channel id for the other calls, or -1 when the table is full
+    // or the device is missing. With autoGain each window is read at the
+    // chip's cached auto gain instead of gain.
+    int addChannel(uint8_t channel, ADS1115Manager::Gain gain, int device = 0, bool autoGain = false);
+    // Empties the ring and asks for count fresh samples (at most RING_SAMPLES).
+    // Replaces a request still in progress; a chunk already being read for
+    // it is discarded rather than pushed into the new window.
+    bool request(int id, size_t count);
+    size_t available(int id); // Drops samples left from a replaced request first
+    // Pops up to max samples, oldest first
+    size_t readWindow(int id, int16_t* out, size_t max);
+    ADS1115Manager::Gain getWindowGain(int id) const; // Gain the current window is read at
+    Stats getStats() const;
+
+    // Reads the ads1115_scan array; call once after begin(). Returns the
+    // number of scans added; bad entries are skipped with a message.
+    int configureScans(cJSON* list);
+    int addScan(const ScanConfig& scan); // Returns a scan id, or -1 when the table is full
+    void update();                       // Loop task: queues scans that are due
+    int getScanCount() const { return scanCount.load(); }
+    const ScanConfig& getScanConfig(int id) const { return scans[id].config; }
+    bool getScanValue(int id, ScanValue& value) const;
+    cJSON* getScanJson() const;          // Returns the latest scan values as a cJSON array
+    static float filterCodes(const int16_t* codes, size_t count, Filter filter);
+
+private:
+    // Each sample carries the generation of the request it was read for, so
+    // the consumer can drop what the task pushed for a replaced request
+    struct Sample {
+        int16_t code;
+        uint16_t generation;
+    };
+    typedef SampleRing<Sample, RING_SAMPLES> Ring;
+
+    struct Channel {
+        uint8_t device;
+        uint8_t channel;
+        ADS1115Manager::Gain gain;
+        bool autoGain;
+        Ring ring;
+        std::atomic<int> windowGain{0};
+        // Generation in the high 16 bits, samples still wanted in the low
+        // 16. Set by request() and counted down by the task in one word, so
+        // a count for a replaced request can never be applied to a new one.
+        std::atomic<uint32_t> work{0};
+        uint16_t servedGeneration = 0; // Task only: the request windowGain was picked for
+    };
+
+    struct Scan {
+        ScanConfig config;
+        ScanValue value;
+        unsigned long lastQueuedMs;
+        std::atomic<bool> pending{false}; // Set by update(), cleared by the task
+    };
+
+    ADS1115Manager* devices[MAX_DEVICES] = {};
+    ADS1115Manager::DataRate rate = ADS1115Manager::SPS_860;
+    Channel channels[MAX_CHANNELS];
+    std::atomic<int> channelCount{0};
+    Scan scans[MAX_SCANS];
+    std::atomic<int> scanCount{0};
+    SemaphoreHandle_t valueMutex = nullptr; // Guards Scan::value
+    TaskHandle_t task = nullptr;
+    SemaphoreHandle_t workReady = nullptr; // Given by request(), taken by the idle task
+    std::atomic<uint32_t> requests{0};
+    std::atomic<uint32_t> samples{0};
+    std::atomic<uint32_t> bursts{0};
+    std::atomic<uint32_t> failures{0};
+
+    static void taskEntry(void* arg);
+    void run();
+    bool service(Channel& c); // One chunk for one channel; false if nothing was wanted
+    void dropStale(Channel& c); // Loop task: pops samples of an older generation
+    bool serviceScans(); // One pending scan per chip, in parallel; false if none
+};
+
+#endif // ADS1115_SAMPLER_H
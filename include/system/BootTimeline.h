@@ -0,0 +1,65 @@
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <Arduino.h>
+#include <cJSON.h>
+
+// Cold-boot timeline from setup() to a usable web UI. Phases are timed with
+// micros() into a fixed table: Scopes around blocking steps in
+// SystemManager::begin() and the managers it calls (nested scopes are kept
+// under their parent), the INIT_* sensor states of loop() as top-level
+// spans, and zero-length milestones such as WiFi getting an IP. finish()
+// closes the timeline, prints it on serial and stops recording, so the same
+// code paths run later (config reload, BME280 re-register) are not counted.
+// Only the loop task records; a report built from the web server task
+// before finish() may be missing the phase still open.
+class BootTimeline {
+public:
+    static const int MAX_PHASES = 40;
+
+    struct Phase {
+        const char* name;     // String literal
+        uint32_t startUs;     // micros() since reset
+        uint32_t durationUs;  // 0 for milestones and phases still open
+        uint8_t depth;
+        bool milestone;
+        bool open;
+    };
+
+    // Times the enclosing block as one phase of the active timeline. No-op
+    // before start() and after finish(). name must be a string literal.
+    class Scope {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+    private:
+        BootTimeline* timeline;
+        int index;
+    };
+
+    void start();                      // Called first thing in SystemManager::begin()
+    void enterState(const char* name); // Ends the current state span, opens the next (nullptr: none)
+    static void mark(const char* name); // Milestone on the active timeline
+    void finish();                     // Web UI is up: close, print and stop recording
+    bool isComplete() const { return complete; }
+    int getPhaseCount() const { return phaseCount; }
+    const Phase& getPhase(int index) const { return phases[index]; }
+    uint32_t getTotalUs() const;       // Reset to finish(), or to now while booting
+    cJSON* getJson() const;            // Returns the timeline as a cJSON object
+    void printReport() const;          // One line per phase on Serial
+
+private:
+    Phase phases[MAX_PHASES] = {};
+    int phaseCount = 0;
+    int depth = 0;
+    int stateIndex = -1;
+    uint32_t setupStartUs = 0;
+    uint32_t finishUs = 0;
+    bool complete = false;
+    uint32_t droppedPhases = 0;
+
+    int open(const char* name, bool milestone);
+    void close(int index);
+};
+
+#endif // BOOT_TIMELINE_H
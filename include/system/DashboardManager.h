@@ -9,6 +9,7 @@
 #include "devices/RelayController.h"
 #include "devices/TouchSensorDevice.h"
 #include "devices/BME280Device.h"
+#include "devices/BME280Group.h"
 #include "devices/SoilMoistureSensor.h"
 #include "devices/MQ135Sensor.h"
 #include "devices/IrrigationManager.h"
@@ -40,6 +41,7 @@ public:
     void setRelayController(RelayController* relayCtrl);
     void setTouchSensorDevice(TouchSensorDevice* touchDev);
     void setBME280Device(BME280Device* bme280Dev);
+    void setBME280Group(BME280Group* group); // Adds every sensor and their median
     void setSoilMoistureSensor(SoilMoistureSensor* soilSensor);
     void setMQ135Sensor(MQ135Sensor* sensor);
     void setIrrigationManager(IrrigationManager* irrigationMgr);
@@ -54,6 +56,7 @@ private:
     RelayController* relayController = nullptr;
     TouchSensorDevice* touchSensorDevice = nullptr;
     BME280Device* bme280Device = nullptr;
+    BME280Group* bme280Group = nullptr;
     SoilMoistureSensor* soilMoistureSensor = nullptr;
     MQ135Sensor* mq135Sensor = nullptr;
     IrrigationManager* irrigationManager = nullptr;
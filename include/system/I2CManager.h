@@ -8,13 +8,22 @@
 #include "devices/BME280Device.h"
 #include "config/ConfigManager.h"
 #include "diagnostics/DiagnosticManager.h"
+#include "system/I2CTracer.h"
 
 class TimeManager; // Forward declaration
 class DeviceManager; // Forward declaration
 
 
+// The bus is scanned at 100 kHz, then brought up to i2c_frequency once
+// every detected device passes a self-test at that speed: a read of a
+// register with a known or stable value (BME280 chip id, DS3231 control,
+// ADS1115 Hi_thresh), other parts just have to ACK. If one fails the bus
+// drops to the next slower speed and tries again, down to 100 kHz.
 class I2CManager {
 public:
+    static const uint32_t STANDARD_FREQUENCY = 100000;
+    static const uint32_t MAX_FREQUENCY = 1000000; // Fast-mode Plus, the ESP32's limit
+
     void begin(ConfigManager* config, DiagnosticManager* diag);
     void scanBus();
     void autoDetectDevices();
@@ -23,11 +32,18 @@ public:
     void writeByte(uint8_t address, uint8_t reg, uint8_t value);
     uint8_t readByte(uint8_t address, uint8_t reg);
     void autoRegisterBME280s(TimeManager* timeMgr, class DeviceManager* deviceMgr = nullptr);
+    // Runs the self-test at requestedHz and each slower speed until every
+    // detected device passes; leaves the bus at the speed returned
+    uint32_t negotiateFrequency(uint32_t requestedHz);
+    bool selfTestDevice(uint8_t address); // At the current bus speed
+    uint32_t getFrequency() const { return busFrequency; }
+    uint8_t getSpeedFallbackDevice() const { return speedFailAddress; } // 0 if the requested speed held
     int getSdaPin() const { return sdaPin; }
     int getSclPin() const { return sclPin; }
     const std::vector<uint8_t>& getDetectedDevices() const { return detectedDevices; }
     const std::vector<std::unique_ptr<BME280Device>>& getBME280Devices() const { return bme280Devices; }
     cJSON* getI2CInfoJson() const; // Returns I2C info as a cJSON object
+    static const char* getDeviceName(uint8_t address); // Known part at this address, or "Unknown"
 
     // Wire-like API for compatibility with device drivers
     void beginTransmission(uint8_t address);
@@ -39,6 +55,9 @@ public:
     // Mutex for I2C bus protection
     SemaphoreHandle_t getI2CMutex() const { return i2cMutex; }
 
+    // Per-address transaction counters and recent access trace
+    I2CTracer& getTracer() { return tracer; }
+
 private:
     int sdaPin = 21;
     int sclPin = 22;
@@ -47,6 +66,13 @@ private:
     std::vector<uint8_t> detectedDevices;
     std::vector<std::unique_ptr<BME280Device>> bme280Devices;
     SemaphoreHandle_t i2cMutex = nullptr;
+    I2CTracer tracer;
+    uint32_t busFrequency = STANDARD_FREQUENCY;
+    uint32_t requestedFrequency = STANDARD_FREQUENCY;
+    uint8_t speedFailAddress = 0; // Failed at the speed above the final one, 0 if none
+
+    bool readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, uint8_t len);
+    bool writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t len);
 };
 
 #endif // I2C_MANAGER_H
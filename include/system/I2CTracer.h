@@ -0,0 +1,99 @@
+#ifndef I2C_TRACER_H
+#define I2C_TRACER_H
+
+#include <Arduino.h>
+#include <cJSON.h>
+
+class I2CManager; // Forward declaration
+
+// Per-address I2C accounting and a short trace of recent bus accesses.
+// Driver libraries (RTClib, Adafruit_BME280) talk to Wire directly, so
+// traffic is recorded at the call site: each Access covers one driver call
+// or raw Wire sequence, and the caller adds the transactions and bytes it
+// put on the wire. Bus time is estimated from the byte counts and the
+// configured clock; held time is how long the caller kept the bus.
+class I2CTracer {
+public:
+    static const int MAX_DEVICES = 12;
+    static const int TRACE_SIZE = 64;
+    static const uint8_t SCAN_ADDRESS = 0x00; // Whole-bus probes (scan, auto-detect)
+
+    // Wire traffic of one driver call: transactions (START..STOP or repeated
+    // START) and payload bytes written/read, excluding the address byte.
+    struct Cost {
+        uint16_t transactions;
+        uint16_t txBytes;
+        uint16_t rxBytes;
+    };
+
+    struct DeviceStats {
+        uint8_t address;
+        uint32_t calls;
+        uint32_t transactions;
+        uint32_t txBytes;
+        uint32_t rxBytes;
+        uint32_t errors;
+        uint64_t heldUs;      // Time between acquiring and releasing the bus
+        uint64_t mutexWaitUs; // Time spent waiting for the bus mutex
+        uint32_t maxHeldUs;
+        uint32_t maxMutexWaitUs;
+    };
+
+    struct TraceEntry {
+        uint32_t timeMs;
+        const char* label;
+        uint8_t address;
+        bool error;
+        uint16_t transactions;
+        uint16_t txBytes;
+        uint16_t rxBytes;
+        uint32_t heldUs;
+        uint32_t mutexWaitUs;
+    };
+
+    // Scoped bus access. Takes the bus mutex (when lockBus is set and a mutex
+    // exists), measures the wait, and records everything added to it when it
+    // goes out of scope. label must be a string literal.
+    class Access {
+    public:
+        Access(I2CManager* i2c, uint8_t address, const char* label, bool lockBus = true);
+        Access(I2CTracer* tracer, SemaphoreHandle_t mutex, uint8_t address, const char* label);
+        ~Access();
+        void add(const Cost& cost, uint16_t times = 1);
+        void addTransaction(uint16_t txBytes, uint16_t rxBytes);
+        void fail() { error = true; }
+    private:
+        void acquire();
+        I2CTracer* tracer;
+        SemaphoreHandle_t mutex;
+        uint8_t address;
+        const char* label;
+        bool error = false;
+        Cost cost = {0, 0, 0};
+        unsigned long startUs = 0;
+        uint32_t waitUs = 0;
+        Access(const Access&) = delete;
+        Access& operator=(const Access&) = delete;
+    };
+
+    void begin(uint32_t clockHz);
+    void setClockHz(uint32_t hz) { clockHz = hz; }
+    void record(uint8_t address, const char* label, const Cost& cost, bool error, uint32_t heldUs, uint32_t mutexWaitUs);
+    void reset();
+    const DeviceStats* findDevice(uint8_t address) const;
+    uint32_t estimateBusMicros(uint32_t transactions, uint32_t bytes) const;
+    cJSON* getUtilisationJson() const; // Per-address table as a cJSON object
+    cJSON* getTraceJson() const;       // Ring contents, oldest first
+
+private:
+    DeviceStats* slotFor(uint8_t address);
+    DeviceStats devices[MAX_DEVICES + 1] = {}; // Last slot collects overflow
+    int deviceCount = 0;
+    TraceEntry trace[TRACE_SIZE] = {};
+    uint32_t traceHead = 0; // Total entries written
+    uint32_t clockHz = 100000;
+    unsigned long windowStart = 0;
+    SemaphoreHandle_t tracerMutex = nullptr;
+};
+
+#endif // I2C_TRACER_H
@@ -0,0 +1,140 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+#include <cJSON.h>
+
+// Per-subsystem timing for SystemManager::update() and the blocks of loop().
+// Each section keeps min/max/total and a log-linear histogram (exact below
+// 16 us, then four buckets per power of two up to ~16 s) in fixed memory,
+// so p50/p99 are available without storing samples. Recording is lock-free
+// and only done from the loop task; a report built from the web server task
+// may mix two consecutive iterations.
+//
+// Iterations slower than the stall threshold are kept in a top-N list,
+// attributed to the blocking call (Site) and the section that took longest,
+// and summed per attributed site so repeat offenders show up as well.
+class LoopProfiler {
+public:
+    enum Section {
+        POWER = 0,
+        HEALTH,
+        NETWORK,
+        TIME,
+        DEVICES,
+        READINGS,
+        MQTT,
+        IRRIGATION,
+        SENSORS,
+        ALARMS,
+        RELAYS,
+        TOUCH,
+        LOOP_TOTAL,
+        SECTION_COUNT
+    };
+
+    // Times the enclosing block into one section
+    class Scope {
+    public:
+        Scope(LoopProfiler& profiler, Section section) : profiler(profiler), section(section), start(micros()) {}
+        ~Scope() { profiler.record(section, micros() - start); }
+    private:
+        LoopProfiler& profiler;
+        Section section;
+        unsigned long start;
+    };
+
+    // Names a blocking call so a stalled iteration can be attributed to it.
+    // Ignored outside the loop task; nested sites charge their time to the
+    // innermost one. name must be a string literal.
+    class Site {
+    public:
+        explicit Site(const char* name);
+        ~Site();
+    private:
+        LoopProfiler* profiler;
+        const char* name;
+        unsigned long start;
+        uint32_t childUs = 0;
+        Site* parent;
+    };
+
+    static const int TOP_STALLS = 10;
+    static const int MAX_OFFENDERS = 12;
+    static const uint32_t DEFAULT_STALL_THRESHOLD_US = 100000;
+
+    struct Stall {
+        uint32_t timeMs;       // millis() when the iteration ended
+        uint32_t durationUs;   // Whole loop() iteration
+        const char* site;      // Blocking call with the most time, or nullptr
+        uint32_t siteUs;
+        Section section;       // Slowest section in the iteration
+        uint32_t sectionUs;
+    };
+
+    // Stalls per attributed site (or section name when no site was open)
+    struct Offender {
+        const char* name;
+        uint32_t stalls;
+        uint32_t maxUs;
+        uint64_t totalUs;
+    };
+
+    void record(Section section, unsigned long durationUs); // LOOP_TOTAL ends an iteration
+    void setStallThresholdUs(uint32_t us) { stallThresholdUs = us; }
+    int getStallCount() const { return topStallCount; } // Entries in the top-N list
+    const Stall& getStall(int index) const { return topStalls[index]; } // Slowest first
+    uint32_t getStallTotal() const { return stallTotal; } // All iterations over the threshold
+    int getOffenderCount() const { return offenderCount; }
+    const Offender& getOffender(int index) const { return offenders[index]; } // In order of first stall
+    void requestReset() { resetPending = true; } // Applied by the loop task on its next record()
+    cJSON* getMetricsJson() const; // Returns all sections as a cJSON object
+    cJSON* getStallsJson() const;  // Loop histogram and top-N stalls as a cJSON object
+    static const char* getSectionName(Section section);
+
+private:
+    static const int LINEAR_BUCKETS = 16;
+    static const int SUB_BUCKETS = 4;  // Per power of two
+    static const int MAX_OCTAVE = 24;  // 2^24 us ~ 16.8 s, longer samples go in the last bucket
+    static const int BUCKET_COUNT = LINEAR_BUCKETS + (MAX_OCTAVE - 4) * SUB_BUCKETS;
+
+    struct Stats {
+        uint32_t count;
+        uint32_t minUs;
+        uint32_t maxUs;
+        uint64_t totalUs;
+        uint32_t buckets[BUCKET_COUNT];
+    };
+
+    static const int MAX_SITES = 8; // Distinct sites per iteration
+
+    struct SiteTime {
+        const char* name;
+        uint32_t us;
+    };
+
+    Stats stats[SECTION_COUNT] = {};
+    unsigned long windowStart = 0;
+    volatile bool resetPending = false;
+
+    // Current iteration, cleared when LOOP_TOTAL is recorded
+    uint32_t iterationSectionUs[SECTION_COUNT] = {};
+    SiteTime iterationSites[MAX_SITES] = {};
+    int iterationSiteCount = 0;
+
+    Stall topStalls[TOP_STALLS] = {};
+    int topStallCount = 0;
+    Offender offenders[MAX_OFFENDERS] = {};
+    int offenderCount = 0;
+    uint32_t stallTotal = 0;
+    uint32_t stallThresholdUs = DEFAULT_STALL_THRESHOLD_US;
+
+    void reset();
+    void recordSite(const char* name, uint32_t us);
+    void finishIteration(uint32_t durationUs);
+    static int bucketIndex(uint32_t us);
+    static uint32_t bucketUpper(int index);
+    static uint32_t percentile(const Stats& s, float fraction);
+};
+
+#endif // LOOP_PROFILER_H
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include "config/ConfigManager.h"
+class BME280Device;
 class MqttManager {
 public:
     MqttManager();
@@ -13,20 +14,26 @@ public:
     void loop();
     void setInitialized(bool initialized);
     bool isInitialized() const;
-    void publishDiscoveryForBME280Temperature();
-    void publishBME280Temperature(float temperature);
+    void publishDiscoveryForBME280Temperature(const char* key = "bme280", const char* label = "BME280");
+    void publishBME280Temperature(float temperature, const char* key = "bme280");
     // Add declarations for new BME280 sensor functions
-    void publishDiscoveryForBME280Humidity();
-    void publishDiscoveryForBME280Pressure();
-    void publishDiscoveryForBME280HeatIndex();
-    void publishDiscoveryForBME280DewPoint();
+    void publishDiscoveryForBME280Humidity(const char* key = "bme280", const char* label = "BME280");
+    void publishDiscoveryForBME280Pressure(const char* key = "bme280", const char* label = "BME280");
+    void publishDiscoveryForBME280HeatIndex(const char* key = "bme280", const char* label = "BME280");
+    void publishDiscoveryForBME280DewPoint(const char* key = "bme280", const char* label = "BME280");
     void publishDiscoveryForSoilMoisture();
     void publishDiscoveryForSoilMoistureAvg();
     void publishSoilMoisture(float percent);
-    void publishBME280Humidity(float humidity);
-    void publishBME280Pressure(float pressure);
-    void publishBME280HeatIndex(float heatIndex);
-    void publishBME280DewPoint(float dewPoint);
+    void publishBME280Humidity(float humidity, const char* key = "bme280");
+    void publishBME280Pressure(float pressure, const char* key = "bme280");
+    void publishBME280HeatIndex(float heatIndex, const char* key = "bme280");
+    void publishBME280DewPoint(float dewPoint, const char* key = "bme280");
+    // All five entities of one sensor. The primary BME280 keeps the bme280_*
+    // ids; any other is keyed by its address, e.g. bme280_77. The primary is
+    // the first found at boot, so if it drops off the bus the next sensor
+    // silently takes over the bme280_* ids
+    void publishDiscoveryForBME280(const BME280Device* bme);
+    void publishBME280Reading(const BME280Device* bme);
     // MQ135 Air Quality Rating
     void publishDiscoveryForMQ135AirQuality();
     void publishMQ135AirQuality();
@@ -35,6 +42,7 @@ private:
     std::vector<std::string> relayNames;
     bool initialized;
     void publishDiscoveryForRelay(int relayIndex);
+    static void bme280EntityKey(const BME280Device* bme, char* key, size_t keyLen, char* label, size_t labelLen);
     void publish(const std::string& topic, cJSON* payload);
     void publish(const std::string& topic, const char* payload);
 };
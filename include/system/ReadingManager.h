@@ -1,17 +1,18 @@
 
 #include <RTClib.h>
 
-class BME280Device;
+class BME280Group;
 
 class SoilMoistureSensor;
 
 class ReadingManager {
 public:
-    ReadingManager(BME280Device* bme, SoilMoistureSensor* soil);
+    ReadingManager(BME280Group* bme, SoilMoistureSensor* soil);
     void begin();
     void loop(const DateTime& now);
 private:
-    BME280Device* bme280;
+    BME280Group* bme280;
     SoilMoistureSensor* soilSensor;
     int lastHour = -1;
+    bool bmePending = false; // Hourly BME280 readings started, not logged yet
 };
@@ -0,0 +1,53 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <atomic>
+#include <stddef.h>
+
+// Fixed-size single-producer/single-consumer ring. One task may push and
+// one other task may pop/clear without a lock: the producer only writes
+// head, the consumer only writes tail. Capacity must be a power of two.
+// push() drops the sample when full rather than overwrite one the consumer
+// may be reading.
+template <typename T, size_t Capacity>
+class SampleRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= Capacity) return false;
+        slots[h & (Capacity - 1)] = value;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    size_t freeSpace() const { return Capacity - size(); }
+
+    // Consumer side
+    bool peek(T& value) const {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        value = slots[t & (Capacity - 1)];
+        return true;
+    }
+    bool pop(T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        value = slots[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    void clear() { tail.store(head.load(std::memory_order_acquire), std::memory_order_release); }
+
+    // Either side; a snapshot that may be stale by the time it is used
+    size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    T slots[Capacity] = {};
+    std::atomic<size_t> head{0}; // Next slot to write, only advanced by the producer
+    std::atomic<size_t> tail{0}; // Next slot to read, only advanced by the consumer
+};
+
+#endif // SAMPLE_RING_H
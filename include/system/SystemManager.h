@@ -13,6 +13,9 @@
 #include "system/I2CManager.h"
 #include "system/TimeManager.h"
 #include "system/ADS1115Manager.h"
+#include "system/ADS1115Sampler.h"
+#include "system/LoopProfiler.h"
+#include "system/BootTimeline.h"
 
 
 
@@ -31,7 +34,10 @@ public:
     NetworkManager& getNetworkManager();
     I2CManager& getI2CManager();
     TimeManager& getTimeManager();
-    ADS1115Manager& getADS1115Manager();
+    ADS1115Manager& getADS1115Manager(int device = 0); // ADS1115 at 0x48 + device
+    ADS1115Sampler& getADS1115Sampler();
+    LoopProfiler& getLoopProfiler();
+    BootTimeline& getBootTimeline();
     cJSON* getSystemInfoJson(); // Returns system info as a cJSON object
     cJSON* getFileSystemInfoJson(); // Returns file system info as a cJSON object
     cJSON* getHealthJson(); // Returns health info as a cJSON object
@@ -55,7 +61,10 @@ private:
     NetworkManager networkManager;
     I2CManager i2cManager;
     TimeManager timeManager;
-    ADS1115Manager ads1115Manager;
+    ADS1115Manager ads1115Managers[ADS1115Sampler::MAX_DEVICES];
+    ADS1115Sampler ads1115Sampler;
+    LoopProfiler loopProfiler;
+    BootTimeline bootTimeline;
 
     // Restart scheduling
     bool restartPending = false;
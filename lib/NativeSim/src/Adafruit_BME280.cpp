@@ -0,0 +1,100 @@
+#include <Adafruit_BME280.h>
+
+void Adafruit_BME280::write8(uint8_t reg, uint8_t value) {
+    wire->beginTransmission(address);
+    wire->write(reg);
+    wire->write(value);
+    wire->endTransmission();
+}
+
+void Adafruit_BME280::readBlock(uint8_t reg, uint8_t* buf, uint8_t len) {
+    wire->beginTransmission(address);
+    wire->write(reg);
+    wire->endTransmission();
+    wire->requestFrom(address, len);
+    for (uint8_t i = 0; i < len; ++i) buf[i] = (uint8_t)wire->read();
+}
+
+uint8_t Adafruit_BME280::read8(uint8_t reg) {
+    uint8_t v = 0;
+    readBlock(reg, &v, 1);
+    return v;
+}
+
+uint16_t Adafruit_BME280::read16(uint8_t reg) {
+    uint8_t b[2] = {0, 0};
+    readBlock(reg, b, 2);
+    return (uint16_t)((b[0] << 8) | b[1]);
+}
+
+uint32_t Adafruit_BME280::read24(uint8_t reg) {
+    uint8_t b[3] = {0, 0, 0};
+    readBlock(reg, b, 3);
+    return ((uint32_t)b[0] << 16) | ((uint32_t)b[1] << 8) | b[2];
+}
+
+bool Adafruit_BME280::isReadingCalibration() {
+    return (read8(0xF3) & 0x01) != 0;
+}
+
+bool Adafruit_BME280::begin(uint8_t addr, TwoWire* theWire) {
+    address = addr;
+    wire = theWire;
+    sensorId = read8(0xD0);
+    if (sensorId != 0x60) return false;
+    write8(0xE0, 0xB6);
+    delay(10);
+    while (isReadingCalibration()) delay(10);
+    uint8_t tp[26];
+    uint8_t h[7];
+    readBlock(0x88, tp, 26);
+    readBlock(0xE1, h, 7);
+    calib.parse(tp, h);
+    setSampling();
+    delay(100);
+    return true;
+}
+
+void Adafruit_BME280::setSampling(sensor_mode mode, sensor_sampling tempSampling,
+                                  sensor_sampling pressSampling, sensor_sampling humSampling,
+                                  sensor_filter filter, standby_duration duration) {
+    ctrlMeas = (uint8_t)((tempSampling << 5) | (pressSampling << 2) | mode);
+    // Registers only take effect in sleep mode (datasheet 5.4.5/5.4.6)
+    write8(0xF4, MODE_SLEEP);
+    write8(0xF2, humSampling);
+    write8(0xF5, (uint8_t)((duration << 5) | (filter << 2)));
+    write8(0xF4, ctrlMeas);
+}
+
+bool Adafruit_BME280::takeForcedMeasurement() {
+    if ((ctrlMeas & 0x03) != MODE_FORCED) return true;
+    write8(0xF4, ctrlMeas);
+    unsigned long start = millis();
+    while (read8(0xF3) & 0x08) {
+        if (millis() - start > 2000) return false;
+        delay(1);
+    }
+    return true;
+}
+
+float Adafruit_BME280::readTemperature() {
+    int32_t adc = (int32_t)read24(0xFA);
+    if (adc == 0x800000) return NAN;
+    adc >>= 4;
+    return calib.compensateT(adc, tFine) / 100.0f;
+}
+
+float Adafruit_BME280::readPressure() {
+    readTemperature();
+    int32_t adc = (int32_t)read24(0xF7);
+    if (adc == 0x800000) return NAN;
+    adc >>= 4;
+    return calib.compensateP64(adc, tFine) / 256.0f;
+}
+
+float Adafruit_BME280::readHumidity() {
+    readTemperature();
+    int32_t adc = read16(0xFD);
+    if (adc == 0x8000) return NAN;
+    return calib.compensateH(adc, tFine) / 1024.0f;
+}
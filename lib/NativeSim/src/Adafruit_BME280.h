@@ -0,0 +1,75 @@
+#ifndef ADAFRUIT_BME280_H
+#define ADAFRUIT_BME280_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "sim/Bme280Math.h"
+
+#define BME280_ADDRESS (0x77)
+#define BME280_ADDRESS_ALTERNATE (0x76)
+
+// Host stand-in for the Adafruit BME280 driver. Register access pattern
+// and compensation match the upstream library so bus traffic is realistic.
+class Adafruit_BME280 {
+public:
+    enum sensor_sampling {
+        SAMPLING_NONE = 0b000,
+        SAMPLING_X1 = 0b001,
+        SAMPLING_X2 = 0b010,
+        SAMPLING_X4 = 0b011,
+        SAMPLING_X8 = 0b100,
+        SAMPLING_X16 = 0b101
+    };
+    enum sensor_mode {
+        MODE_SLEEP = 0b00,
+        MODE_FORCED = 0b01,
+        MODE_NORMAL = 0b11
+    };
+    enum sensor_filter {
+        FILTER_OFF = 0b000,
+        FILTER_X2 = 0b001,
+        FILTER_X4 = 0b010,
+        FILTER_X8 = 0b011,
+        FILTER_X16 = 0b100
+    };
+    enum standby_duration {
+        STANDBY_MS_0_5 = 0b000,
+        STANDBY_MS_10 = 0b110,
+        STANDBY_MS_20 = 0b111,
+        STANDBY_MS_62_5 = 0b001,
+        STANDBY_MS_125 = 0b010,
+        STANDBY_MS_250 = 0b011,
+        STANDBY_MS_500 = 0b100,
+        STANDBY_MS_1000 = 0b101
+    };
+
+    bool begin(uint8_t addr = BME280_ADDRESS, TwoWire* theWire = &Wire);
+    void setSampling(sensor_mode mode = MODE_NORMAL,
+                     sensor_sampling tempSampling = SAMPLING_X16,
+                     sensor_sampling pressSampling = SAMPLING_X16,
+                     sensor_sampling humSampling = SAMPLING_X16,
+                     sensor_filter filter = FILTER_OFF,
+                     standby_duration duration = STANDBY_MS_0_5);
+    bool takeForcedMeasurement();
+    float readTemperature();
+    float readPressure();
+    float readHumidity();
+    uint32_t sensorID() const { return sensorId; }
+
+private:
+    TwoWire* wire = nullptr;
+    uint8_t address = BME280_ADDRESS;
+    uint8_t sensorId = 0;
+    int32_t tFine = 0;
+    Bme280Calibration calib;
+    uint8_t ctrlMeas = 0;
+
+    void write8(uint8_t reg, uint8_t value);
+    uint8_t read8(uint8_t reg);
+    uint32_t read24(uint8_t reg);
+    uint16_t read16(uint8_t reg);
+    void readBlock(uint8_t reg, uint8_t* buf, uint8_t len);
+    bool isReadingCalibration();
+};
+
+#endif // ADAFRUIT_BME280_H
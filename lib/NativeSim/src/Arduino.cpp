@@ -0,0 +1,149 @@
+#include <Arduino.h>
+#include <random>
+#include "sim/SimClock.h"
+#include "sim/SimGpio.h"
+#include "sim/SimHeap.h"
+#include "esp_system.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static uint32_t cpuFrequencyMhz = 240;
+static std::mt19937 rng(42);
+
+unsigned long millis() {
+    return (unsigned long)(SimClock::nowMicros() / 1000ULL);
+}
+
+unsigned long micros() {
+    return (unsigned long)SimClock::nowMicros();
+}
+
+void delay(uint32_t ms) {
+    SimClock::sleepMicros((uint64_t)ms * 1000ULL);
+}
+
+void delayMicroseconds(uint32_t us) {
+    SimClock::sleepMicros(us);
+}
+
+void yield() {
+    SimClock::sleepMicros(0);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    SimGpio::setMode(pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    SimGpio::writeOutput(pin, val);
+}
+
+int digitalRead(uint8_t pin) {
+    return SimGpio::readLevel(pin);
+}
+
+uint16_t analogRead(uint8_t pin) {
+    // 12-bit ADC, 11 dB attenuation, ~3.3 V full scale
+    uint32_t mv = SimGpio::getAnalogMillivolts(pin);
+    uint32_t raw = mv * 4095UL / 3300UL;
+    return (uint16_t)(raw > 4095 ? 4095 : raw);
+}
+
+uint16_t touchRead(uint8_t pin) {
+    return SimGpio::getTouchValue(pin);
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+    SimGpio::attachInterrupt(pin, handler, mode);
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode) {
+    SimGpio::attachInterruptArg(pin, handler, arg, mode);
+}
+
+void detachInterrupt(uint8_t pin) {
+    SimGpio::detachInterrupt(pin);
+}
+
+long random(long max) {
+    return max > 0 ? random(0, max) : 0;
+}
+
+long random(long min, long max) {
+    if (max <= min) return min;
+    std::uniform_int_distribution<long> dist(min, max - 1);
+    return dist(rng);
+}
+
+void randomSeed(unsigned long seed) {
+    rng.seed(seed);
+}
+
+bool setCpuFrequencyMhz(uint32_t cpuFreqMhz) {
+    cpuFrequencyMhz = cpuFreqMhz;
+    return true;
+}
+
+uint32_t getCpuFrequencyMhz() {
+    return cpuFrequencyMhz;
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, (size_t)len);
+    char* big = (char*)malloc((size_t)len + 1);
+    if (!big) return 0;
+    va_start(args, format);
+    vsnprintf(big, (size_t)len + 1, format, args);
+    va_end(args);
+    size_t n = write((const uint8_t*)big, (size_t)len);
+    free(big);
+    return n;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    bytesWritten += size;
+    return echo ? fwrite(buffer, 1, size, stdout) : size;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+void EspClass::restart() {
+    Serial.println("[Sim] ESP.restart() requested, exiting");
+    fflush(stdout);
+    exit(0);
+}
+
+// The ESP32 has ~320 KB of DRAM available to the heap; the host has no
+// equivalent, so report a fixed figure unless the SimHeap model is attached.
+uint32_t EspClass::getFreeHeap() {
+    return SimHeap::isAttached() ? SimHeap::getStats().freeBytes : 240 * 1024;
+}
+uint32_t EspClass::getHeapSize() { return 320 * 1024; }
+uint32_t EspClass::getMinFreeHeap() {
+    return SimHeap::isAttached() ? SimHeap::ARENA_BYTES - SimHeap::getStats().highWaterBytes : 240 * 1024;
+}
+uint32_t EspClass::getMaxAllocHeap() {
+    return SimHeap::isAttached() ? SimHeap::getStats().largestFreeBlock : 110 * 1024;
+}
+
+uint32_t esp_get_free_heap_size(void) { return ESP.getFreeHeap(); }
+uint32_t esp_get_minimum_free_heap_size(void) { return ESP.getMinFreeHeap(); }
@@ -0,0 +1,129 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the ESP32 Arduino core used by the native build.
+// Only the subset of the core the firmware actually touches is provided.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define PULLDOWN 0x08
+#define INPUT_PULLDOWN 0x09
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define IRAM_ATTR
+
+using std::min;
+using std::max;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint16_t touchRead(uint8_t pin);
+#define digitalPinToInterrupt(p) (p)
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+bool setCpuFrequencyMhz(uint32_t cpuFreqMhz);
+uint32_t getCpuFrequencyMhz();
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned int n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(double n, int digits = 2) { return print(String(n, (unsigned int)digits)); }
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    int available() { return 0; }
+    int read() { return -1; }
+    void flush();
+    operator bool() const { return true; }
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+
+    // Simulation controls: long runs mute the console but still count
+    // output, which SimScheduler uses as a sign the firmware is busy.
+    void simSetEcho(bool enabled) { echo = enabled; }
+    uint64_t simBytesWritten() const { return bytesWritten; }
+
+private:
+    bool echo = true;
+    uint64_t bytesWritten = 0;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint8_t getChipRevision() { return 3; }
+    uint32_t getCpuFreqMHz() { return getCpuFrequencyMhz(); }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    const char* getSdkVersion() { return "native-sim"; }
+    uint32_t getSketchSize() { return 1024 * 1024; }
+    uint32_t getFreeSketchSpace() { return 1920 * 1024; }
+    uint64_t getEfuseMac() { return 0x0000A4CF12345678ULL; }
+};
+
+extern EspClass ESP;
+
+#endif // ARDUINO_H
@@ -0,0 +1,193 @@
+#include <ESPAsyncWebServer.h>
+#include <arpa/inet.h>
+#include <mutex>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+static std::vector<AsyncWebServer*> startedServers;
+// Serialises requests from the TCP thread against simRequest() callers;
+// handlers run concurrently with loop() exactly as they do on the device.
+static std::mutex dispatchLock;
+
+void AsyncWebServerRequest::send(int code, const char* contentType, const char* content) {
+    if (responded()) return; // the real server ignores a second response
+    response.code = code;
+    response.contentType = contentType ? contentType : "";
+    response.body = content ? content : "";
+}
+
+void AsyncWebServerRequest::send(FS& fs, const String& path, const String& contentType, bool download) {
+    (void)download;
+    if (responded()) return;
+    if (!fs.exists(path)) {
+        send(404);
+        return;
+    }
+    send(200, contentType, "");
+    responseFs = &fs;
+    responsePath = path;
+}
+
+void AsyncWebServerRequest::loadFileBody() {
+    if (!responseFs) return;
+    File file = responseFs->open(responsePath, FILE_READ);
+    if (!file || file.isDirectory()) {
+        response.code = 404;
+        response.body = "";
+    } else {
+        response.body = file.readString();
+    }
+    file.close();
+    responseFs = nullptr;
+}
+
+AsyncWebServer::~AsyncWebServer() {
+    end();
+}
+
+void AsyncWebServer::begin() {
+    if (started) return;
+    started = true;
+    startedServers.push_back(this);
+
+    const char* portEnv = getenv("NATIVE_SIM_HTTP_PORT");
+    if (!portEnv || !*portEnv) return;
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons((uint16_t)atoi(portEnv));
+    if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 4) != 0) {
+        Serial.printf("[Sim] HTTP listener on port %s failed\n", portEnv);
+        close(listenFd);
+        listenFd = -1;
+        return;
+    }
+    Serial.printf("[Sim] Serving HTTP on http://127.0.0.1:%s/\n", portEnv);
+    std::thread([this] { serveTcp(); }).detach();
+}
+
+void AsyncWebServer::end() {
+    for (auto it = startedServers.begin(); it != startedServers.end(); ++it) {
+        if (*it == this) {
+            startedServers.erase(it);
+            break;
+        }
+    }
+    if (listenFd >= 0) {
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        listenFd = -1;
+    }
+    started = false;
+}
+
+void AsyncWebServer::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) {
+    routes.push_back({uri, method, onRequest, nullptr});
+}
+
+void AsyncWebServer::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                        ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody) {
+    (void)onUpload;
+    routes.push_back({uri, method, onRequest, onBody});
+}
+
+// Same rule as AsyncCallbackWebHandler::canHandle: a route also takes every
+// URL below it, so "/api/metrics" answers "/api/metrics/x" unless a more
+// specific route was registered first.
+static bool routeMatches(const String& uri, const String& url) {
+    return uri == url || (uri.length() && url.startsWith(uri + "/"));
+}
+
+bool AsyncWebServer::handle(AsyncWebServerRequest& request, const char* body, size_t len, size_t chunkSize) {
+    for (auto& route : routes) {
+        if (!(route.method & request.method()) || !routeMatches(route.uri, request.url())) continue;
+        request.bodyLength = len;
+        if (route.onBody && len > 0) {
+            if (chunkSize == 0) chunkSize = len;
+            for (size_t index = 0; index < len; index += chunkSize) {
+                size_t n = std::min(chunkSize, len - index);
+                // Handlers treat the chunk as a C string; keep a terminator
+                // after it so that does not read past the buffer.
+                std::vector<uint8_t> chunk(body + index, body + index + n);
+                chunk.push_back(0);
+                route.onBody(&request, chunk.data(), n, index, len);
+            }
+        }
+        if (route.onRequest) route.onRequest(&request);
+        return true;
+    }
+    return false;
+}
+
+SimHttpResponse AsyncWebServer::simRequest(WebRequestMethod method, const char* url, const char* body, size_t chunkSize) {
+    std::lock_guard<std::mutex> guard(dispatchLock);
+    AsyncWebServerRequest request(method, url);
+    size_t len = body ? strlen(body) : 0;
+    for (AsyncWebServer* server : startedServers) {
+        if (server->handle(request, body, len, chunkSize)) break;
+    }
+    if (!request.responded() && !startedServers.empty() && startedServers.front()->notFoundHandler) {
+        // Only reached when no route matched; a matched route that never
+        // responds is reported as an error below.
+        bool matched = false;
+        for (AsyncWebServer* server : startedServers) {
+            for (auto& route : server->routes) {
+                if ((route.method & method) && routeMatches(route.uri, request.url())) matched = true;
+            }
+        }
+        if (!matched) startedServers.front()->notFoundHandler(&request);
+    }
+    if (!request.responded()) request.send(500, "text/plain", "Handler sent no response");
+    request.loadFileBody();
+    return request.getResponse();
+}
+
+void AsyncWebServer::serveTcp() {
+    while (listenFd >= 0) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) break;
+        std::string raw;
+        char buf[2048];
+        size_t headerEnd = std::string::npos;
+        size_t contentLength = 0;
+        while (true) {
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) break;
+            raw.append(buf, (size_t)n);
+            if (headerEnd == std::string::npos) {
+                headerEnd = raw.find("\r\n\r\n");
+                if (headerEnd == std::string::npos) continue;
+                String headers(raw.substr(0, headerEnd).c_str());
+                headers.toLowerCase();
+                int cl = headers.indexOf("content-length:");
+                if (cl >= 0) contentLength = (size_t)atol(headers.c_str() + cl + 15);
+            }
+            if (raw.size() >= headerEnd + 4 + contentLength) break;
+        }
+        if (headerEnd != std::string::npos) {
+            size_t sp1 = raw.find(' ');
+            size_t sp2 = raw.find(' ', sp1 + 1);
+            std::string verb = raw.substr(0, sp1);
+            std::string path = raw.substr(sp1 + 1, sp2 - sp1 - 1);
+            size_t q = path.find('?');
+            if (q != std::string::npos) path.resize(q);
+            std::string body = raw.substr(headerEnd + 4, contentLength);
+            WebRequestMethod method = verb == "POST" ? HTTP_POST : verb == "PUT" ? HTTP_PUT
+                                    : verb == "DELETE" ? HTTP_DELETE : HTTP_GET;
+            SimHttpResponse resp = simRequest(method, path.c_str(), body.c_str());
+            char head[256];
+            int headLen = snprintf(head, sizeof(head),
+                                   "HTTP/1.0 %d\r\nContent-Type: %s\r\nContent-Length: %u\r\nConnection: close\r\n\r\n",
+                                   resp.code, resp.contentType.c_str(), (unsigned)resp.body.length());
+            send(fd, head, (size_t)headLen, MSG_NOSIGNAL);
+            send(fd, resp.body.c_str(), resp.body.length(), MSG_NOSIGNAL);
+        }
+        close(fd);
+    }
+}
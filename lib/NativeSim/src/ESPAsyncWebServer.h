@@ -0,0 +1,119 @@
+#ifndef ESPASYNCWEBSERVER_H
+#define ESPASYNCWEBSERVER_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <functional>
+#include <vector>
+#include "IPAddress.h"
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111
+} WebRequestMethod;
+
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServerRequest;
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, const String& filename, size_t index,
+                           uint8_t* data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index,
+                           size_t total)> ArBodyHandlerFunction;
+
+class AsyncClient {
+public:
+    IPAddress remoteIP() const { return ip; }
+    IPAddress ip = IPAddress(192, 168, 1, 100);
+};
+
+// Response captured from a dispatched request.
+struct SimHttpResponse {
+    int code = 0;
+    String contentType;
+    String body;
+};
+
+class AsyncWebServerRequest {
+public:
+    AsyncWebServerRequest(WebRequestMethod method, const String& url) : reqMethod(method), reqUrl(url) {}
+
+    WebRequestMethod method() const { return reqMethod; }
+    const String& url() const { return reqUrl; }
+    AsyncClient* client() { return &clientInfo; }
+    size_t contentLength() const { return bodyLength; }
+
+    void send(int code, const char* contentType = "", const char* content = "");
+    void send(int code, const String& contentType, const String& content = String()) {
+        send(code, contentType.c_str(), content.c_str());
+    }
+    void send(int code, const char* contentType, const String& content) {
+        send(code, contentType, content.c_str());
+    }
+    void send(FS& fs, const String& path, const String& contentType = String(), bool download = false);
+
+    bool responded() const { return response.code != 0; }
+    const SimHttpResponse& getResponse() const { return response; }
+
+private:
+    friend class AsyncWebServer;
+    WebRequestMethod reqMethod;
+    String reqUrl;
+    size_t bodyLength = 0;
+    AsyncClient clientInfo;
+    SimHttpResponse response;
+    // Like AsyncFileResponse on the device, file content is read after the
+    // handler returns, so it is not charged to the handler.
+    FS* responseFs = nullptr;
+    String responsePath;
+    void loadFileBody();
+};
+
+// Host stand-in for ESPAsyncWebServer. Routes are kept in a table and
+// requests are dispatched synchronously with simRequest(); when the
+// NATIVE_SIM_HTTP_PORT environment variable is set, begin() also serves
+// plain HTTP/1.0 on that port so the web UI can be used from a browser.
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port) : port(port) {}
+    ~AsyncWebServer();
+
+    void begin();
+    void end();
+    void on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+    void on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+            ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody = nullptr);
+    void onNotFound(ArRequestHandlerFunction fn) { notFoundHandler = fn; }
+
+    // Dispatch a request to whichever started server owns the route.
+    // The body is delivered in chunks of at most chunkSize bytes, as the
+    // async TCP stack would.
+    static SimHttpResponse simRequest(WebRequestMethod method, const char* url, const char* body = nullptr,
+                                      size_t chunkSize = 1436);
+
+private:
+    struct Route {
+        String uri;
+        WebRequestMethodComposite method;
+        ArRequestHandlerFunction onRequest;
+        ArBodyHandlerFunction onBody;
+    };
+
+    bool handle(AsyncWebServerRequest& request, const char* body, size_t len, size_t chunkSize);
+    void serveTcp();
+
+    uint16_t port;
+    bool started = false;
+    std::vector<Route> routes;
+    ArRequestHandlerFunction notFoundHandler;
+    int listenFd = -1;
+};
+
+#endif // ESPASYNCWEBSERVER_H
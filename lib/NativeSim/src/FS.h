@@ -0,0 +1,77 @@
+#ifndef FS_H
+#define FS_H
+
+#include <Arduino.h>
+#include <memory>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+struct FileImpl;
+
+// Host stand-in for the Arduino-ESP32 fs::File. Reads load the whole file
+// up front; writes are buffered and flushed to the backing directory on
+// close() or when the last copy of the handle goes away.
+class File : public Print {
+public:
+    File() {}
+    explicit File(std::shared_ptr<FileImpl> impl) : impl(impl) {}
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int available();
+    int read();
+    int peek();
+    size_t read(uint8_t* buffer, size_t size);
+    String readString();
+    bool seek(uint32_t pos);
+    size_t position() const;
+    size_t size() const;
+    void flush();
+    void close();
+    const char* name() const;
+    const char* path() const;
+    bool isDirectory() const;
+    File openNextFile(const char* mode = FILE_READ);
+    void rewindDirectory();
+    operator bool() const;
+
+private:
+    std::shared_ptr<FileImpl> impl;
+};
+
+class FS {
+public:
+    explicit FS(const char* hostRoot) : hostRoot(hostRoot) {}
+    File open(const char* path, const char* mode = FILE_READ, const bool create = false);
+    File open(const String& path, const char* mode = FILE_READ, const bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* pathFrom, const char* pathTo);
+    bool mkdir(const char* path);
+    bool rmdir(const char* path);
+
+    // Directory on the host that backs this filesystem.
+    const char* getHostRoot() const { return hostRoot.c_str(); }
+    void setHostRoot(const char* root) { hostRoot = root; }
+
+protected:
+    std::string hostPath(const char* path) const;
+    std::string hostRoot;
+    bool mounted = false;
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+
+#endif // FS_H
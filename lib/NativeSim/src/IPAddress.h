@@ -0,0 +1,23 @@
+#ifndef IPADDRESS_H
+#define IPADDRESS_H
+
+#include <Arduino.h>
+
+class IPAddress {
+public:
+    IPAddress() : addr{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr{a, b, c, d} {}
+    uint8_t operator[](int index) const { return addr[index & 3]; }
+    bool operator==(const IPAddress& other) const { return memcmp(addr, other.addr, 4) == 0; }
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", addr[0], addr[1], addr[2], addr[3]);
+        return String(buf);
+    }
+
+private:
+    uint8_t addr[4];
+};
+
+#endif // IPADDRESS_H
@@ -0,0 +1,268 @@
+#include <LittleFS.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+static const size_t PARTITION_BYTES = 0x160000;
+static const size_t BLOCK_BYTES = 4096;
+
+namespace fs {
+
+struct FileImpl {
+    std::string hostPath;
+    std::string path;
+    std::string name;
+    bool directory = false;
+    bool writable = false;
+    bool dirty = false;
+    bool open = true;
+    std::string data;
+    size_t pos = 0;
+    std::vector<std::string> entries; // directory listing (host paths)
+    size_t nextEntry = 0;
+    const FS* owner = nullptr;
+
+    ~FileImpl() { flush(); }
+
+    void flush() {
+        if (!open || !writable || !dirty) return;
+        std::ofstream out(hostPath, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), (std::streamsize)data.size());
+        dirty = false;
+    }
+};
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!impl || !impl->open || !impl->writable) return 0;
+    if (impl->pos > impl->data.size()) impl->pos = impl->data.size();
+    impl->data.replace(impl->pos, std::min(size, impl->data.size() - impl->pos), (const char*)buffer, size);
+    impl->pos += size;
+    impl->dirty = true;
+    return size;
+}
+
+int File::available() {
+    if (!impl || !impl->open || impl->directory) return 0;
+    return impl->pos < impl->data.size() ? (int)(impl->data.size() - impl->pos) : 0;
+}
+
+int File::read() {
+    if (available() <= 0) return -1;
+    return (uint8_t)impl->data[impl->pos++];
+}
+
+int File::peek() {
+    if (available() <= 0) return -1;
+    return (uint8_t)impl->data[impl->pos];
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    size_t n = std::min(size, (size_t)std::max(available(), 0));
+    if (n) memcpy(buffer, impl->data.data() + impl->pos, n);
+    if (impl) impl->pos += n;
+    return n;
+}
+
+String File::readString() {
+    if (available() <= 0) return String();
+    String s(impl->data.substr(impl->pos).c_str());
+    impl->pos = impl->data.size();
+    return s;
+}
+
+bool File::seek(uint32_t pos) {
+    if (!impl || !impl->open || pos > impl->data.size()) return false;
+    impl->pos = pos;
+    return true;
+}
+
+size_t File::position() const {
+    return impl ? impl->pos : 0;
+}
+
+size_t File::size() const {
+    return impl && !impl->directory ? impl->data.size() : 0;
+}
+
+void File::flush() {
+    if (impl) impl->flush();
+}
+
+void File::close() {
+    if (!impl) return;
+    impl->flush();
+    impl->open = false;
+    impl.reset();
+}
+
+const char* File::name() const {
+    return impl ? impl->name.c_str() : nullptr;
+}
+
+const char* File::path() const {
+    return impl ? impl->path.c_str() : nullptr;
+}
+
+bool File::isDirectory() const {
+    return impl && impl->directory;
+}
+
+File::operator bool() const {
+    return impl && impl->open;
+}
+
+void File::rewindDirectory() {
+    if (impl) impl->nextEntry = 0;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!impl || !impl->directory || impl->nextEntry >= impl->entries.size()) return File();
+    std::string child = impl->path;
+    if (child.empty() || child.back() != '/') child += '/';
+    child += stdfs::path(impl->entries[impl->nextEntry++]).filename().string();
+    return const_cast<FS*>(impl->owner)->open(child.c_str(), mode);
+}
+
+std::string FS::hostPath(const char* path) const {
+    std::string p = path ? path : "/";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return hostRoot + p;
+}
+
+File FS::open(const char* path, const char* mode, const bool create) {
+    if (!mounted || !path || !mode) return File();
+    std::string host = hostPath(path);
+    std::error_code ec;
+    auto impl = std::make_shared<FileImpl>();
+    impl->hostPath = host;
+    impl->path = path[0] == '/' ? path : std::string("/") + path;
+    impl->name = stdfs::path(impl->path).filename().string();
+    impl->owner = this;
+
+    if (stdfs::is_directory(host, ec)) {
+        impl->directory = true;
+        for (const auto& entry : stdfs::directory_iterator(host, ec)) {
+            impl->entries.push_back(entry.path().string());
+        }
+        std::sort(impl->entries.begin(), impl->entries.end());
+        return File(impl);
+    }
+
+    if (mode[0] == 'r') {
+        std::ifstream in(host, std::ios::binary);
+        if (!in) return File();
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        impl->data = ss.str();
+        impl->writable = strchr(mode, '+') != nullptr;
+        return File(impl);
+    }
+
+    if (create) stdfs::create_directories(stdfs::path(host).parent_path(), ec);
+    if (!stdfs::is_directory(stdfs::path(host).parent_path(), ec)) return File();
+    impl->writable = true;
+    if (mode[0] == 'a') {
+        std::ifstream in(host, std::ios::binary);
+        if (in) {
+            std::ostringstream ss;
+            ss << in.rdbuf();
+            impl->data = ss.str();
+            impl->pos = impl->data.size();
+        }
+    }
+    // Opening for write truncates immediately, matching LittleFS.
+    impl->dirty = true;
+    impl->flush();
+    return File(impl);
+}
+
+bool FS::exists(const char* path) {
+    std::error_code ec;
+    return mounted && stdfs::exists(hostPath(path), ec);
+}
+
+bool FS::remove(const char* path) {
+    std::error_code ec;
+    return mounted && stdfs::is_regular_file(hostPath(path), ec) && stdfs::remove(hostPath(path), ec);
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+    std::error_code ec;
+    if (!mounted) return false;
+    stdfs::rename(hostPath(pathFrom), hostPath(pathTo), ec);
+    return !ec;
+}
+
+bool FS::mkdir(const char* path) {
+    std::error_code ec;
+    if (!mounted) return false;
+    stdfs::create_directories(hostPath(path), ec);
+    return !ec;
+}
+
+bool FS::rmdir(const char* path) {
+    std::error_code ec;
+    return mounted && stdfs::remove(hostPath(path), ec);
+}
+
+static std::string defaultHostRoot() {
+    const char* env = getenv("NATIVE_SIM_FS");
+    return env && *env ? env : ".sim/littlefs";
+}
+
+LittleFSFS::LittleFSFS() : FS("") {
+    hostRoot = defaultHostRoot();
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* partitionLabel) {
+    (void)basePath; (void)maxOpenFiles; (void)partitionLabel;
+    std::error_code ec;
+    if (mounted) return true;
+    if (!stdfs::is_directory(hostRoot, ec)) {
+        if (!formatOnFail || !format()) return false;
+    }
+    mounted = true;
+    return true;
+}
+
+bool LittleFSFS::format() {
+    std::error_code ec;
+    stdfs::remove_all(hostRoot, ec);
+    stdfs::create_directories(hostRoot, ec);
+    return !ec;
+}
+
+size_t LittleFSFS::totalBytes() {
+    return PARTITION_BYTES;
+}
+
+size_t LittleFSFS::usedBytes() {
+    // LittleFS allocates whole blocks, so round each file up.
+    std::error_code ec;
+    size_t used = 2 * BLOCK_BYTES; // superblock pair
+    for (const auto& entry : stdfs::recursive_directory_iterator(hostRoot, ec)) {
+        if (entry.is_regular_file(ec)) {
+            size_t sz = (size_t)entry.file_size(ec);
+            used += (sz + BLOCK_BYTES - 1) / BLOCK_BYTES * BLOCK_BYTES;
+        } else {
+            used += BLOCK_BYTES;
+        }
+    }
+    return std::min(used, PARTITION_BYTES);
+}
+
+void LittleFSFS::end() {
+    mounted = false;
+}
+
+} // namespace fs
+
+fs::LittleFSFS LittleFS;
@@ -0,0 +1,28 @@
+#ifndef LITTLEFS_H
+#define LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+
+// LittleFS backed by a host directory. The directory defaults to
+// .sim/littlefs under the working directory and can be overridden with the
+// NATIVE_SIM_FS environment variable. Capacity is reported as the size of
+// the spiffs partition in partitions.csv so usage figures look like the
+// device.
+class LittleFSFS : public FS {
+public:
+    LittleFSFS();
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    bool format();
+    size_t totalBytes();
+    size_t usedBytes();
+    void end();
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif // LITTLEFS_H
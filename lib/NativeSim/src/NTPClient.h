@@ -0,0 +1,25 @@
+#ifndef NTPCLIENT_H
+#define NTPCLIENT_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include "sim/SimClock.h"
+
+// Minimal NTPClient stand-in; the firmware does its own NTP exchange over
+// WiFiUDP and only includes this header.
+class NTPClient {
+public:
+    explicit NTPClient(WiFiUDP& udp, const char* poolServerName = "pool.ntp.org", long timeOffset = 0,
+                       unsigned long updateInterval = 60000)
+        : timeOffset(timeOffset) { (void)udp; (void)poolServerName; (void)updateInterval; }
+    void begin() {}
+    bool update() { return true; }
+    bool forceUpdate() { return true; }
+    void setTimeOffset(int offset) { timeOffset = offset; }
+    unsigned long getEpochTime() const { return SimClock::unixTimeUtc() + timeOffset; }
+
+private:
+    long timeOffset;
+};
+
+#endif // NTPCLIENT_H
@@ -0,0 +1,137 @@
+#include <PubSubClient.h>
+#include <deque>
+
+// MQTT fixed header + 2-byte topic length, as counted by PubSubClient when
+// checking against the buffer size.
+static const size_t MQTT_OVERHEAD = 5;
+
+static bool brokerAvailable = true;
+static bool recording = true;
+static unsigned long publishTotal = 0;
+static unsigned long oversizeTotal = 0;
+static unsigned long oversizeBytesTotal = 0;
+static std::vector<SimMqttBroker::Message> publishLog;
+static std::deque<SimMqttBroker::Message> inbound;
+
+void SimMqttBroker::setAvailable(bool available) { brokerAvailable = available; }
+bool SimMqttBroker::isAvailable() { return brokerAvailable; }
+
+void SimMqttBroker::inject(const char* topic, const char* payload) {
+    inbound.push_back({topic, payload ? payload : "", false, millis()});
+}
+
+const std::vector<SimMqttBroker::Message>& SimMqttBroker::published() { return publishLog; }
+void SimMqttBroker::clearPublished() { publishLog.clear(); }
+void SimMqttBroker::setRecording(bool enabled) { recording = enabled; }
+unsigned long SimMqttBroker::publishCount() { return publishTotal; }
+unsigned long SimMqttBroker::oversizeCount() { return oversizeTotal; }
+unsigned long SimMqttBroker::oversizeBytes() { return oversizeBytesTotal; }
+
+static bool topicMatches(const std::string& filter, const std::string& topic) {
+    size_t f = 0, t = 0;
+    while (f < filter.size()) {
+        if (filter[f] == '#') return true;
+        if (filter[f] == '+') {
+            while (t < topic.size() && topic[t] != '/') ++t;
+            ++f;
+            continue;
+        }
+        if (t >= topic.size() || filter[f] != topic[t]) return false;
+        ++f;
+        ++t;
+    }
+    return t == topic.size();
+}
+
+PubSubClient& PubSubClient::setServer(const char* domain, uint16_t port) {
+    (void)domain; (void)port;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE) {
+    this->callback = callback;
+    return *this;
+}
+
+bool PubSubClient::connect(const char* id) {
+    return connect(id, nullptr, nullptr);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+    (void)id; (void)user; (void)pass;
+    if (!WiFi.isConnected() || !brokerAvailable) {
+        connState = MQTT_CONNECT_FAILED;
+        return false;
+    }
+    connState = MQTT_CONNECTED;
+    return true;
+}
+
+void PubSubClient::disconnect() {
+    connState = MQTT_DISCONNECTED;
+    subscriptions.clear();
+}
+
+bool PubSubClient::connected() {
+    if (connState == MQTT_CONNECTED && (!WiFi.isConnected() || !brokerAvailable)) {
+        connState = MQTT_CONNECTION_LOST;
+        subscriptions.clear();
+    }
+    return connState == MQTT_CONNECTED;
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload) {
+    return publish(topic, payload, false);
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+    return publish(topic, (const uint8_t*)payload, payload ? (unsigned int)strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int plength, bool retained) {
+    if (!connected() || !topic) return false;
+    // The real client silently refuses packets larger than its buffer.
+    if (MQTT_OVERHEAD + strlen(topic) + plength > bufferSize) {
+        ++oversizeTotal;
+        oversizeBytesTotal += plength;
+        return false;
+    }
+    ++publishTotal;
+    if (recording) publishLog.push_back({topic, std::string((const char*)payload, plength), retained, millis()});
+    return true;
+}
+
+bool PubSubClient::subscribe(const char* topic, uint8_t qos) {
+    (void)qos;
+    if (!connected() || !topic) return false;
+    subscriptions.push_back(topic);
+    return true;
+}
+
+bool PubSubClient::unsubscribe(const char* topic) {
+    for (auto it = subscriptions.begin(); it != subscriptions.end(); ++it) {
+        if (*it == topic) {
+            subscriptions.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PubSubClient::loop() {
+    if (!connected()) return false;
+    while (!inbound.empty()) {
+        SimMqttBroker::Message msg = inbound.front();
+        inbound.pop_front();
+        for (const auto& filter : subscriptions) {
+            if (!topicMatches(filter, msg.topic)) continue;
+            if (callback) {
+                std::vector<char> topicBuf(msg.topic.begin(), msg.topic.end());
+                topicBuf.push_back('\0');
+                callback(topicBuf.data(), (uint8_t*)msg.payload.data(), (unsigned int)msg.payload.size());
+            }
+            break;
+        }
+    }
+    return true;
+}
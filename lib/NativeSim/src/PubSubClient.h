@@ -0,0 +1,76 @@
+#ifndef PUBSUBCLIENT_H
+#define PUBSUBCLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define MQTT_CONNECTION_TIMEOUT -4
+#define MQTT_CONNECTION_LOST -3
+#define MQTT_CONNECT_FAILED -2
+#define MQTT_DISCONNECTED -1
+#define MQTT_CONNECTED 0
+
+#define MQTT_MAX_PACKET_SIZE 256
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+// In-process stand-in for the broker the firmware talks to. Every publish
+// is recorded; inject() queues an inbound message that is delivered from
+// PubSubClient::loop() when a subscription matches.
+class SimMqttBroker {
+public:
+    struct Message {
+        std::string topic;
+        std::string payload;
+        bool retained;
+        unsigned long atMs;
+    };
+
+    static void setAvailable(bool available);
+    static bool isAvailable();
+    static void inject(const char* topic, const char* payload);
+    static const std::vector<Message>& published();
+    static void clearPublished();
+    // Stop recording publishes (long runs that only need counts).
+    static void setRecording(bool enabled);
+    static unsigned long publishCount();
+    // Publishes the client refused for exceeding its buffer, and their
+    // payload bytes; these never reach the broker.
+    static unsigned long oversizeCount();
+    static unsigned long oversizeBytes();
+};
+
+class PubSubClient {
+public:
+    PubSubClient() {}
+    explicit PubSubClient(WiFiClient& client) { (void)client; }
+
+    PubSubClient& setServer(const char* domain, uint16_t port);
+    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+    PubSubClient& setClient(WiFiClient& client) { (void)client; return *this; }
+    bool setBufferSize(uint16_t size) { bufferSize = size; return true; }
+    uint16_t getBufferSize() const { return bufferSize; }
+
+    bool connect(const char* id);
+    bool connect(const char* id, const char* user, const char* pass);
+    void disconnect();
+    bool publish(const char* topic, const char* payload);
+    bool publish(const char* topic, const char* payload, bool retained);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int plength, bool retained = false);
+    bool subscribe(const char* topic, uint8_t qos = 0);
+    bool unsubscribe(const char* topic);
+    bool loop();
+    bool connected();
+    int state() const { return connState; }
+
+private:
+    std::function<void(char*, uint8_t*, unsigned int)> callback;
+    std::vector<std::string> subscriptions;
+    int connState = MQTT_DISCONNECTED;
+    uint16_t bufferSize = MQTT_MAX_PACKET_SIZE;
+};
+
+#endif // PUBSUBCLIENT_H
@@ -0,0 +1,238 @@
+#include <RTClib.h>
+
+#define DS3231_ADDRESS 0x68
+#define DS3231_TIME 0x00
+#define DS3231_ALARM1 0x07
+#define DS3231_ALARM2 0x0B
+#define DS3231_CONTROL 0x0E
+#define DS3231_STATUSREG 0x0F
+#define DS3231_TEMPERATUREREG 0x11
+
+static const uint8_t daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30};
+
+static uint16_t date2days(uint16_t y, uint8_t m, uint8_t d) {
+    if (y >= 2000U) y -= 2000U;
+    uint16_t days = d;
+    for (uint8_t i = 1; i < m; ++i) days += daysInMonth[i - 1];
+    if (m > 2 && y % 4 == 0) ++days;
+    return (uint16_t)(days + 365 * y + (y + 3) / 4 - 1);
+}
+
+static uint32_t time2ulong(uint16_t days, uint8_t h, uint8_t m, uint8_t s) {
+    return ((days * 24UL + h) * 60 + m) * 60 + s;
+}
+
+static uint8_t bin2bcd(uint8_t val) { return (uint8_t)(val + 6 * (val / 10)); }
+static uint8_t bcd2bin(uint8_t val) { return (uint8_t)(val - 6 * (val >> 4)); }
+
+DateTime::DateTime(uint32_t t) {
+    t -= SECONDS_FROM_1970_TO_2000;
+    ss = t % 60;
+    t /= 60;
+    mm = t % 60;
+    t /= 60;
+    hh = t % 24;
+    uint16_t days = (uint16_t)(t / 24);
+    uint8_t leap;
+    for (yOff = 0;; ++yOff) {
+        leap = yOff % 4 == 0;
+        if (days < 365U + leap) break;
+        days -= 365 + leap;
+    }
+    for (m = 1; m < 12; ++m) {
+        uint8_t daysPerMonth = daysInMonth[m - 1];
+        if (leap && m == 2) ++daysPerMonth;
+        if (days < daysPerMonth) break;
+        days -= daysPerMonth;
+    }
+    d = (uint8_t)(days + 1);
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec) {
+    if (year >= 2000U) year -= 2000U;
+    yOff = (uint8_t)year;
+    m = month;
+    d = day;
+    hh = hour;
+    mm = min;
+    ss = sec;
+}
+
+bool DateTime::isValid() const {
+    if (yOff >= 100) return false;
+    DateTime other(unixtime());
+    return yOff == other.yOff && m == other.m && d == other.d && hh == other.hh &&
+           mm == other.mm && ss == other.ss;
+}
+
+uint8_t DateTime::dayOfTheWeek() const {
+    uint16_t day = date2days(yOff, m, d);
+    return (uint8_t)((day + 6) % 7); // Jan 1, 2000 is a Saturday, i.e. returns 6
+}
+
+uint32_t DateTime::secondstime() const {
+    return time2ulong(date2days(yOff, m, d), hh, mm, ss);
+}
+
+uint32_t DateTime::unixtime() const {
+    return secondstime() + SECONDS_FROM_1970_TO_2000;
+}
+
+DateTime DateTime::operator+(const TimeSpan& span) const {
+    return DateTime(unixtime() + span.totalseconds());
+}
+
+DateTime DateTime::operator-(const TimeSpan& span) const {
+    return DateTime(unixtime() - span.totalseconds());
+}
+
+TimeSpan DateTime::operator-(const DateTime& right) const {
+    return TimeSpan((int32_t)(unixtime() - right.unixtime()));
+}
+
+bool DateTime::operator<(const DateTime& right) const {
+    return unixtime() < right.unixtime();
+}
+
+bool DateTime::operator==(const DateTime& right) const {
+    return unixtime() == right.unixtime();
+}
+
+uint8_t RTC_DS3231::read_register(uint8_t reg) {
+    wire->beginTransmission(DS3231_ADDRESS);
+    wire->write(reg);
+    wire->endTransmission();
+    wire->requestFrom(DS3231_ADDRESS, 1);
+    return (uint8_t)wire->read();
+}
+
+void RTC_DS3231::write_register(uint8_t reg, uint8_t val) {
+    wire->beginTransmission(DS3231_ADDRESS);
+    wire->write(reg);
+    wire->write(val);
+    wire->endTransmission();
+}
+
+bool RTC_DS3231::begin(TwoWire* wireInstance) {
+    wire = wireInstance;
+    wire->beginTransmission(DS3231_ADDRESS);
+    return wire->endTransmission() == 0;
+}
+
+bool RTC_DS3231::lostPower() {
+    return read_register(DS3231_STATUSREG) >> 7;
+}
+
+void RTC_DS3231::adjust(const DateTime& dt) {
+    uint8_t buffer[8] = {DS3231_TIME, bin2bcd(dt.second()), bin2bcd(dt.minute()), bin2bcd(dt.hour()),
+                         (uint8_t)(dt.dayOfTheWeek() + 1), bin2bcd(dt.day()), bin2bcd(dt.month()),
+                         bin2bcd((uint8_t)(dt.year() - 2000U))};
+    wire->beginTransmission(DS3231_ADDRESS);
+    wire->write(buffer, 8);
+    wire->endTransmission();
+    uint8_t statreg = read_register(DS3231_STATUSREG);
+    statreg &= (uint8_t)~0x80; // clear OSF
+    write_register(DS3231_STATUSREG, statreg);
+}
+
+DateTime RTC_DS3231::now() {
+    uint8_t buffer[7];
+    wire->beginTransmission(DS3231_ADDRESS);
+    wire->write((uint8_t)0);
+    wire->endTransmission();
+    wire->requestFrom(DS3231_ADDRESS, 7);
+    for (uint8_t i = 0; i < 7; ++i) buffer[i] = (uint8_t)wire->read();
+    return DateTime((uint16_t)(bcd2bin(buffer[6]) + 2000U), bcd2bin(buffer[5] & 0x7F),
+                    bcd2bin(buffer[4]), bcd2bin(buffer[2]), bcd2bin(buffer[1]),
+                    bcd2bin(buffer[0] & 0x7F));
+}
+
+Ds3231SqwPinMode RTC_DS3231::readSqwPinMode() {
+    int mode = read_register(DS3231_CONTROL) & 0x1C;
+    if (mode & 0x04) mode = DS3231_OFF;
+    return static_cast<Ds3231SqwPinMode>(mode);
+}
+
+void RTC_DS3231::writeSqwPinMode(Ds3231SqwPinMode mode) {
+    uint8_t ctrl = read_register(DS3231_CONTROL);
+    ctrl &= (uint8_t)~0x04; // turn off INTCON
+    ctrl &= (uint8_t)~0x18; // set freq bits to 0
+    write_register(DS3231_CONTROL, (uint8_t)(ctrl | mode));
+}
+
+bool RTC_DS3231::setAlarm1(const DateTime& dt, Ds3231Alarm1Mode alarm_mode) {
+    uint8_t ctrl = read_register(DS3231_CONTROL);
+    if (!(ctrl & 0x04)) return false;
+    uint8_t A1M1 = (alarm_mode & 0x01) << 7;
+    uint8_t A1M2 = (alarm_mode & 0x02) << 6;
+    uint8_t A1M3 = (alarm_mode & 0x04) << 5;
+    uint8_t A1M4 = (alarm_mode & 0x08) << 4;
+    uint8_t DY_DT = (alarm_mode & 0x10) << 2;
+    uint8_t day = (DY_DT) ? (uint8_t)(dt.dayOfTheWeek() == 0 ? 7 : dt.dayOfTheWeek()) : dt.day();
+    uint8_t buffer[5] = {DS3231_ALARM1, (uint8_t)(bin2bcd(dt.second()) | A1M1),
+                         (uint8_t)(bin2bcd(dt.minute()) | A1M2), (uint8_t)(bin2bcd(dt.hour()) | A1M3),
+                         (uint8_t)(bin2bcd(day) | A1M4 | DY_DT)};
+    wire->beginTransmission(DS3231_ADDRESS);
+    wire->write(buffer, 5);
+    wire->endTransmission();
+    write_register(DS3231_CONTROL, (uint8_t)(ctrl | 0x01)); // AI1E
+    return true;
+}
+
+bool RTC_DS3231::setAlarm2(const DateTime& dt, Ds3231Alarm2Mode alarm_mode) {
+    uint8_t ctrl = read_register(DS3231_CONTROL);
+    if (!(ctrl & 0x04)) return false;
+    uint8_t A2M2 = (alarm_mode & 0x01) << 7;
+    uint8_t A2M3 = (alarm_mode & 0x02) << 6;
+    uint8_t A2M4 = (alarm_mode & 0x04) << 5;
+    uint8_t DY_DT = (alarm_mode & 0x08) << 3;
+    uint8_t day = (DY_DT) ? (uint8_t)(dt.dayOfTheWeek() == 0 ? 7 : dt.dayOfTheWeek()) : dt.day();
+    uint8_t buffer[4] = {DS3231_ALARM2, (uint8_t)(bin2bcd(dt.minute()) | A2M2),
+                         (uint8_t)(bin2bcd(dt.hour()) | A2M3), (uint8_t)(bin2bcd(day) | A2M4 | DY_DT)};
+    wire->beginTransmission(DS3231_ADDRESS);
+    wire->write(buffer, 4);
+    wire->endTransmission();
+    write_register(DS3231_CONTROL, (uint8_t)(ctrl | 0x02)); // AI2E
+    return true;
+}
+
+void RTC_DS3231::disableAlarm(uint8_t alarm_num) {
+    uint8_t ctrl = read_register(DS3231_CONTROL);
+    ctrl &= (uint8_t)~(1 << (alarm_num - 1));
+    write_register(DS3231_CONTROL, ctrl);
+}
+
+void RTC_DS3231::clearAlarm(uint8_t alarm_num) {
+    uint8_t status = read_register(DS3231_STATUSREG);
+    status &= (uint8_t)~(0x1 << (alarm_num - 1));
+    write_register(DS3231_STATUSREG, status);
+}
+
+bool RTC_DS3231::alarmFired(uint8_t alarm_num) {
+    return (read_register(DS3231_STATUSREG) >> (alarm_num - 1)) & 0x1;
+}
+
+void RTC_DS3231::enable32K() {
+    uint8_t status = read_register(DS3231_STATUSREG);
+    write_register(DS3231_STATUSREG, (uint8_t)(status | (0x1 << 0x03)));
+}
+
+void RTC_DS3231::disable32K() {
+    uint8_t status = read_register(DS3231_STATUSREG);
+    write_register(DS3231_STATUSREG, (uint8_t)(status & ~(0x1 << 0x03)));
+}
+
+bool RTC_DS3231::isEnabled32K() {
+    return (read_register(DS3231_STATUSREG) >> 0x03) & 0x01;
+}
+
+float RTC_DS3231::getTemperature() {
+    uint8_t buffer[2];
+    wire->beginTransmission(DS3231_ADDRESS);
+    wire->write((uint8_t)DS3231_TEMPERATUREREG);
+    wire->endTransmission();
+    wire->requestFrom(DS3231_ADDRESS, 2);
+    buffer[0] = (uint8_t)wire->read();
+    buffer[1] = (uint8_t)wire->read();
+    return (float)buffer[0] + (buffer[1] >> 6) * 0.25f;
+}
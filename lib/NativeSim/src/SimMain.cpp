@@ -0,0 +1,176 @@
+// Entry point for the native build: runs the unmodified sketch against the
+// simulated board.
+//
+//   .pio/build/native/program [--run-seconds N] [--data DIR]
+//   .pio/build/native/program --season DAYS [--start YYYY-MM-DD] [--max-step SEC] [--stall-budget-ms MS] [--verbose]
+//   .pio/build/native/program --alloc-bench [--iterations N] [--budget FILE|none] [--write-budget FILE]
+//   .pio/build/native/program --json-bench [--iterations N]
+//   .pio/build/native/program --sensor-bench [--iterations N]
+//   .pio/build/native/program --soak [DAYS] [--max-growth BYTES] [--verbose]
+//   .pio/build/native/program --ads-check [--iterations N]
+//   .pio/build/native/program --sampler-check [--iterations N]
+//   .pio/build/native/program --i2c-speed-check [--iterations N]
+//   .pio/build/native/program --bme-check [--iterations N]
+//
+// The LittleFS image lives in $NATIVE_SIM_FS (default .sim/littlefs) and is
+// seeded from DIR (default data/) on first start. Set NATIVE_SIM_HTTP_PORT
+// to reach the web UI from a browser.
+//
+// --season switches to virtual time (see SimSeason.h) and prints the relay
+// timeline, per-day CPU report and slowest loop() iterations instead of the
+// serial log; with --stall-budget-ms it exits 1 when an iteration is slower.
+// --alloc-bench reports heap allocations per web route and MQTT publish, and
+// exits non-zero when the budget (default lib/NativeSim/alloc_budget.json)
+// is exceeded; it keeps its own image in .sim/alloc-fs (see SimAllocBench.h). --json-bench
+// times the status and discovery JSON builders (see SimJsonBench.h).
+// --sensor-bench times the sensor filters and derived-value maths over
+// synthetic noisy windows (see SimSensorBench.h). --soak keeps web and
+// MQTT traffic going for DAYS (default 30) of virtual time and reports
+// live allocations and a model of the board's heap (see SimSoak.h).
+// --ads-check runs ADS1115Manager against the simulated ADS1115 with and
+// without ALERT/RDY and exits 1 when a check fails (see SimAdsCheck.h).
+// --sampler-check measures how long loop()-side sensor calls block with and
+// without the background ADS1115 sampler (see SimSamplerCheck.h).
+// --i2c-speed-check times RTC, BME280 and ADS1115 operations at each bus
+// speed and checks the I2C speed fallback (see SimI2CSpeedCheck.h).
+// --bme-check checks the BME280 integer compensation against the datasheet
+// and compares the burst sample read with the driver's (see SimBmeCheck.h).
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "harness/SimAdsCheck.h"
+#include "harness/SimAllocBench.h"
+#include "harness/SimBmeCheck.h"
+#include "harness/SimI2CSpeedCheck.h"
+#include "harness/SimJsonBench.h"
+#include "harness/SimSamplerCheck.h"
+#include "harness/SimSeason.h"
+#include "harness/SimSensorBench.h"
+#include "harness/SimSoak.h"
+#include "sim/SimClock.h"
+#include "sim/SimWorld.h"
+
+void setup();
+void loop();
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--run-seconds N] [--data DIR]\n"
+            "       %s --season DAYS [--start YYYY-MM-DD] [--max-step SEC] [--stall-budget-ms MS] [--verbose] [--data DIR]\n"
+            "       %s --alloc-bench [--iterations N] [--budget FILE|none] [--write-budget FILE] [--verbose] [--data DIR]\n"
+            "       %s --json-bench [--iterations N] [--verbose] [--data DIR]\n"
+            "       %s --sensor-bench [--iterations N]\n"
+            "       %s --soak [DAYS] [--max-growth BYTES] [--verbose] [--data DIR]\n"
+            "       %s --ads-check [--iterations N]\n"
+            "       %s --sampler-check [--iterations N]\n"
+            "       %s --i2c-speed-check [--iterations N]\n"
+            "       %s --bme-check [--iterations N]\n",
+            argv0, argv0, argv0, argv0, argv0, argv0, argv0, argv0, argv0, argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* dataDir = "data";
+    uint64_t runSeconds = 0;
+    bool season = false;
+    SimSeasonOptions seasonOptions;
+    bool allocBench = false;
+    SimAllocBenchOptions allocOptions;
+    bool jsonBench = false;
+    SimJsonBenchOptions jsonOptions;
+    bool sensorBench = false;
+    SimSensorBenchOptions sensorOptions;
+    bool soak = false;
+    SimSoakOptions soakOptions;
+    bool adsCheck = false;
+    SimAdsCheckOptions adsOptions;
+    bool samplerCheck = false;
+    SimSamplerCheckOptions samplerOptions;
+    bool i2cSpeedCheck = false;
+    SimI2CSpeedCheckOptions i2cSpeedOptions;
+    bool bmeCheck = false;
+    SimBmeCheckOptions bmeOptions;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--run-seconds") && i + 1 < argc) {
+            runSeconds = strtoull(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--data") && i + 1 < argc) {
+            dataDir = argv[++i];
+        } else if (!strcmp(argv[i], "--season") && i + 1 < argc) {
+            season = true;
+            seasonOptions.days = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--start") && i + 1 < argc) {
+            struct tm start = {};
+            if (!strptime(argv[++i], "%Y-%m-%d", &start)) {
+                usage(argv[0]);
+                return 2;
+            }
+            seasonOptions.startLocal = (uint32_t)timegm(&start);
+        } else if (!strcmp(argv[i], "--max-step") && i + 1 < argc) {
+            seasonOptions.maxStepSec = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--stall-budget-ms") && i + 1 < argc) {
+            seasonOptions.stallBudgetMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--alloc-bench")) {
+            allocBench = true;
+        } else if (!strcmp(argv[i], "--json-bench")) {
+            jsonBench = true;
+        } else if (!strcmp(argv[i], "--sensor-bench")) {
+            sensorBench = true;
+        } else if (!strcmp(argv[i], "--soak")) {
+            soak = true;
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+                soakOptions.days = (uint32_t)strtoul(argv[++i], nullptr, 10);
+            }
+        } else if (!strcmp(argv[i], "--ads-check")) {
+            adsCheck = true;
+        } else if (!strcmp(argv[i], "--sampler-check")) {
+            samplerCheck = true;
+        } else if (!strcmp(argv[i], "--i2c-speed-check")) {
+            i2cSpeedCheck = true;
+        } else if (!strcmp(argv[i], "--bme-check")) {
+            bmeCheck = true;
+        } else if (!strcmp(argv[i], "--max-growth") && i + 1 < argc) {
+            soakOptions.maxGrowthBytes = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+            allocOptions.iterations = (uint32_t)strtoul(argv[++i], nullptr, 10);
+            jsonOptions.iterations = allocOptions.iterations;
+            sensorOptions.iterations = allocOptions.iterations;
+            adsOptions.iterations = allocOptions.iterations;
+            samplerOptions.iterations = allocOptions.iterations;
+            i2cSpeedOptions.iterations = allocOptions.iterations;
+            bmeOptions.iterations = allocOptions.iterations;
+        } else if (!strcmp(argv[i], "--budget") && i + 1 < argc) {
+            ++i;
+            allocOptions.budgetFile = strcmp(argv[i], "none") ? argv[i] : nullptr;
+        } else if (!strcmp(argv[i], "--write-budget") && i + 1 < argc) {
+            allocOptions.writeBudgetFile = argv[++i];
+        } else if (!strcmp(argv[i], "--verbose")) {
+            seasonOptions.verbose = true;
+            allocOptions.verbose = true;
+            jsonOptions.verbose = true;
+            soakOptions.verbose = true;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    // Pure maths, no firmware or filesystem needed
+    if (sensorBench) return SimSensorBench::run(sensorOptions);
+
+    if (allocBench) LittleFS.setHostRoot(SimAllocBenchOptions::FS_ROOT);
+    SimWorld::begin(dataDir);
+    if (season) return SimSeason::run(seasonOptions);
+    if (allocBench) return SimAllocBench::run(allocOptions);
+    if (jsonBench) return SimJsonBench::run(jsonOptions);
+    if (soak) return SimSoak::run(soakOptions);
+    if (adsCheck) return SimAdsCheck::run(adsOptions);
+    if (samplerCheck) return SimSamplerCheck::run(samplerOptions);
+    if (i2cSpeedCheck) return SimI2CSpeedCheck::run(i2cSpeedOptions);
+    if (bmeCheck) return SimBmeCheck::run(bmeOptions);
+
+    setup();
+    while (runSeconds == 0 || SimClock::nowMicros() < runSeconds * 1000000ULL) {
+        SimWorld::tick();
+        loop();
+    }
+    Serial.printf("[Sim] Stopped after %llu s\n", (unsigned long long)runSeconds);
+    return 0;
+}
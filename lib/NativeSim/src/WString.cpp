@@ -0,0 +1,85 @@
+#include "WString.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <algorithm>
+
+static std::string formatUnsigned(unsigned long value, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+    char buf[8 * sizeof(unsigned long) + 1];
+    char* p = buf + sizeof(buf) - 1;
+    *p = '\0';
+    do {
+        unsigned long digit = value % base;
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value);
+    return std::string(p);
+}
+
+String::String(int value, unsigned char base) : String((long)value, base) {}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) {
+    if (base == DEC && value < 0) {
+        s = "-" + formatUnsigned((unsigned long)(-(value + 1)) + 1, base);
+    } else {
+        s = formatUnsigned((unsigned long)value, base);
+    }
+}
+
+String::String(unsigned long value, unsigned char base) : s(formatUnsigned(value, base)) {}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    s = buf;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t pos = s.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str, unsigned int from) const {
+    size_t pos = s.find(str.s, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const {
+    return substring(beginIndex, length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+    if (beginIndex >= s.length()) return String();
+    if (endIndex > s.length()) endIndex = (unsigned int)s.length();
+    return String(s.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::trim() {
+    size_t start = 0;
+    while (start < s.length() && isspace((unsigned char)s[start])) start++;
+    size_t end = s.length();
+    while (end > start && isspace((unsigned char)s[end - 1])) end--;
+    s = s.substr(start, end - start);
+}
+
+void String::toLowerCase() {
+    for (char& c : s) c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (char& c : s) c = (char)toupper((unsigned char)c);
+}
+
+long String::toInt() const {
+    return atol(s.c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(s.c_str());
+}
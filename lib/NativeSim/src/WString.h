@@ -0,0 +1,72 @@
+#ifndef WSTRING_H
+#define WSTRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// Host stand-in for the Arduino String class, backed by std::string.
+class String {
+public:
+    String() {}
+    String(const char* cstr) : s(cstr ? cstr : "") {}
+    String(const char* cstr, size_t len) : s(cstr ? std::string(cstr, len) : std::string()) {}
+    String(const std::string& str) : s(str) {}
+    String(char c) : s(1, c) {}
+    String(int value, unsigned char base = DEC);
+    String(unsigned int value, unsigned char base = DEC);
+    String(long value, unsigned char base = DEC);
+    String(unsigned long value, unsigned char base = DEC);
+    String(float value, unsigned int decimalPlaces = 2);
+    String(double value, unsigned int decimalPlaces = 2);
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.length(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+    char charAt(unsigned int index) const { return index < s.length() ? s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    String& operator=(const char* cstr) { s = cstr ? cstr : ""; return *this; }
+    String& operator+=(const String& rhs) { s += rhs.s; return *this; }
+    String& operator+=(const char* cstr) { if (cstr) s += cstr; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    bool concat(const String& rhs) { s += rhs.s; return true; }
+    bool concat(const char* cstr) { if (cstr) s += cstr; return true; }
+    bool concat(const char* cstr, unsigned int len) { if (cstr) s.append(cstr, len); return true; }
+
+    bool equals(const String& rhs) const { return s == rhs.s; }
+    bool equals(const char* cstr) const { return s == (cstr ? cstr : ""); }
+    bool operator==(const String& rhs) const { return s == rhs.s; }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& rhs) const { return s != rhs.s; }
+    bool operator!=(const char* cstr) const { return !equals(cstr); }
+    bool operator<(const String& rhs) const { return s < rhs.s; }
+
+    bool startsWith(const String& prefix) const { return s.compare(0, prefix.s.length(), prefix.s) == 0; }
+    bool endsWith(const String& suffix) const {
+        return s.length() >= suffix.s.length() && s.compare(s.length() - suffix.s.length(), suffix.s.length(), suffix.s) == 0;
+    }
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String& str, unsigned int from = 0) const;
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const;
+    float toFloat() const;
+
+    friend String operator+(const String& lhs, const String& rhs) { return String(lhs.s + rhs.s); }
+    friend String operator+(const String& lhs, const char* rhs) { return String(lhs.s + (rhs ? rhs : "")); }
+    friend String operator+(const char* lhs, const String& rhs) { return String(std::string(lhs ? lhs : "") + rhs.s); }
+
+private:
+    std::string s;
+};
+
+#endif // WSTRING_H
@@ -0,0 +1,185 @@
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <vector>
+#include "sim/SimClock.h"
+
+WiFiClass WiFi;
+
+static std::vector<std::function<void(arduino_event_t*)>> eventHandlers;
+
+void WiFiClass::dispatch(arduino_event_id_t id) {
+    arduino_event_t event;
+    memset(&event, 0, sizeof(event));
+    event.event_id = id;
+    if (id == ARDUINO_EVENT_WIFI_AP_STACONNECTED) {
+        static const uint8_t mac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+        memcpy(event.event_info.wifi_ap_staconnected.mac, mac, 6);
+        event.event_info.wifi_ap_staconnected.aid = apClients;
+    }
+    // Copy so a handler may register further handlers.
+    std::vector<std::function<void(arduino_event_t*)>> handlers = eventHandlers;
+    for (auto& handler : handlers) handler(&event);
+}
+
+void WiFiClass::onEvent(WiFiEventSysCb cb) {
+    eventHandlers.push_back(cb);
+}
+
+void WiFiClass::onEvent(WiFiEventFuncCb cb) {
+    eventHandlers.push_back([cb](arduino_event_t* event) { cb(event->event_id, event->event_info); });
+}
+
+bool WiFiClass::mode(wifi_mode_t m) {
+    currentMode = m;
+    if (!(m & WIFI_AP)) apUp = false;
+    if (!(m & WIFI_STA)) {
+        connecting = false;
+        staStatus = WL_IDLE_STATUS;
+    }
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase) {
+    (void)ssid; (void)passphrase;
+    if (!(currentMode & WIFI_STA)) mode((wifi_mode_t)(currentMode | WIFI_STA));
+    staStatus = WL_DISCONNECTED;
+    connecting = true;
+    connectStartMs = millis();
+    return staStatus;
+}
+
+void WiFiClass::poll() {
+    if (!connecting || millis() - connectStartMs < connectDelayMs) return;
+    connecting = false;
+    if (!stationAvailable) {
+        staStatus = WL_NO_SSID_AVAIL;
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+        return;
+    }
+    staStatus = WL_CONNECTED;
+    dispatch(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+}
+
+wl_status_t WiFiClass::status() {
+    poll();
+    return staStatus;
+}
+
+bool WiFiClass::disconnect(bool wifioff) {
+    bool wasConnected = staStatus == WL_CONNECTED;
+    connecting = false;
+    staStatus = WL_DISCONNECTED;
+    if (wifioff) mode(WIFI_OFF);
+    if (wasConnected) dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    return true;
+}
+
+IPAddress WiFiClass::localIP() {
+    return staStatus == WL_CONNECTED ? IPAddress(192, 168, 1, 50) : IPAddress();
+}
+
+String WiFiClass::macAddress() {
+    uint64_t mac = ESP.getEfuseMac();
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
+             (unsigned)(mac & 0xFF), (unsigned)((mac >> 8) & 0xFF), (unsigned)((mac >> 16) & 0xFF),
+             (unsigned)((mac >> 24) & 0xFF), (unsigned)((mac >> 32) & 0xFF), (unsigned)((mac >> 40) & 0xFF));
+    return String(buf);
+}
+
+bool WiFiClass::softAP(const char* ssid, const char* passphrase) {
+    (void)ssid; (void)passphrase;
+    if (!(currentMode & WIFI_AP)) currentMode = (wifi_mode_t)(currentMode | WIFI_AP);
+    apUp = true;
+    return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifioff) {
+    apUp = false;
+    apClients = 0;
+    if (wifioff) mode((wifi_mode_t)(currentMode & ~WIFI_AP));
+    return true;
+}
+
+uint8_t WiFiClass::softAPgetStationNum() {
+    return apUp ? apClients : 0;
+}
+
+int WiFiClass::hostByName(const char* hostname, IPAddress& result) {
+    if (!hostname || !*hostname || staStatus != WL_CONNECTED) return 0;
+    int a, b, c, d;
+    if (sscanf(hostname, "%d.%d.%d.%d", &a, &b, &c, &d) == 4) {
+        result = IPAddress((uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d);
+    } else {
+        result = IPAddress(192, 168, 1, 1);
+    }
+    return 1;
+}
+
+void WiFiClass::simSetStationAvailable(bool available) {
+    stationAvailable = available;
+    if (!available && staStatus == WL_CONNECTED) {
+        staStatus = WL_CONNECTION_LOST;
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+}
+
+void WiFiClass::simSetApClients(uint8_t count) {
+    bool joined = count > apClients;
+    apClients = count;
+    if (joined && apUp) dispatch(ARDUINO_EVENT_WIFI_AP_STACONNECTED);
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+    (void)ip;
+    remotePort = port;
+    txLen = 0;
+    return 1;
+}
+
+int WiFiUDP::beginPacket(const char* host, uint16_t port) {
+    (void)host;
+    return beginPacket(IPAddress(), port);
+}
+
+size_t WiFiUDP::write(const uint8_t* buffer, size_t size) {
+    size_t n = std::min(size, sizeof(tx) - txLen);
+    memcpy(tx + txLen, buffer, n);
+    txLen += n;
+    return n;
+}
+
+int WiFiUDP::endPacket() {
+    if (remotePort != 123 || txLen < 48 || !WiFi.isConnected()) return 1;
+    // Server reply: mode 4, stratum 1, transmit timestamp in bytes 40..43.
+    memset(rx, 0, sizeof(rx));
+    rx[0] = 0x24;
+    rx[1] = 1;
+    uint32_t secsSince1900 = SimClock::unixTimeUtc() + 2208988800UL;
+    rx[40] = (uint8_t)(secsSince1900 >> 24);
+    rx[41] = (uint8_t)(secsSince1900 >> 16);
+    rx[42] = (uint8_t)(secsSince1900 >> 8);
+    rx[43] = (uint8_t)secsSince1900;
+    pending = true;
+    return 1;
+}
+
+int WiFiUDP::parsePacket() {
+    if (!pending) return 0;
+    pending = false;
+    rxLen = sizeof(rx);
+    rxPos = 0;
+    return (int)rxLen;
+}
+
+int WiFiUDP::read() {
+    return rxPos < rxLen ? rx[rxPos++] : -1;
+}
+
+int WiFiUDP::read(uint8_t* buffer, size_t len) {
+    size_t n = std::min(len, rxLen - rxPos);
+    memcpy(buffer, rx + rxPos, n);
+    rxPos += n;
+    return (int)n;
+}
@@ -0,0 +1,101 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+#include <Arduino.h>
+#include <functional>
+#include "IPAddress.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_STOP = 3,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_AP_START = 10,
+    ARDUINO_EVENT_WIFI_AP_STOP = 11,
+    ARDUINO_EVENT_WIFI_AP_STACONNECTED = 12,
+    ARDUINO_EVENT_WIFI_AP_STADISCONNECTED = 13
+} arduino_event_id_t;
+
+typedef struct {
+    uint8_t mac[6];
+    uint8_t aid;
+    bool is_mesh_child;
+} wifi_event_ap_staconnected_t;
+
+typedef union {
+    wifi_event_ap_staconnected_t wifi_ap_staconnected;
+    wifi_event_ap_staconnected_t wifi_sta_connected;
+} arduino_event_info_t;
+
+typedef struct {
+    arduino_event_id_t event_id;
+    arduino_event_info_t event_info;
+} arduino_event_t;
+
+typedef void (*WiFiEventSysCb)(arduino_event_t* event);
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+
+// Host stand-in for the ESP32 WiFi stack. Nothing touches a real network:
+// a station "associates" a short while after begin() when the simulated
+// access point is available, and events are delivered from poll(), which
+// the sim main loop and status() call.
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t m);
+    wifi_mode_t getMode() const { return currentMode; }
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    wl_status_t status();
+    bool isConnected() { return status() == WL_CONNECTED; }
+    bool disconnect(bool wifioff = false);
+    IPAddress localIP();
+    String macAddress();
+    bool softAP(const char* ssid, const char* passphrase = nullptr);
+    bool softAPdisconnect(bool wifioff = false);
+    uint8_t softAPgetStationNum();
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    int hostByName(const char* hostname, IPAddress& result);
+    void onEvent(WiFiEventSysCb cb);
+    void onEvent(WiFiEventFuncCb cb);
+
+    // Simulation controls.
+    void poll();
+    void simSetStationAvailable(bool available);
+    void simSetConnectDelayMs(uint32_t ms) { connectDelayMs = ms; }
+    void simSetApClients(uint8_t count);
+
+private:
+    void dispatch(arduino_event_id_t id);
+
+    wifi_mode_t currentMode = WIFI_OFF;
+    wl_status_t staStatus = WL_IDLE_STATUS;
+    bool stationAvailable = true;
+    bool connecting = false;
+    unsigned long connectStartMs = 0;
+    uint32_t connectDelayMs = 1500;
+    bool apUp = false;
+    uint8_t apClients = 0;
+};
+
+class WiFiClient {
+public:
+    int connect(const char* host, uint16_t port) { (void)host; (void)port; return 1; }
+    void stop() {}
+    uint8_t connected() { return 1; }
+};
+
+extern WiFiClass WiFi;
+
+#endif // WIFI_H
@@ -0,0 +1,34 @@
+#ifndef WIFIUDP_H
+#define WIFIUDP_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+
+// UDP stand-in. Only NTP is modelled: a 48-byte request sent to port 123
+// is answered immediately with the simulated UTC time (SimClock).
+class WiFiUDP {
+public:
+    uint8_t begin(uint16_t port) { localPort = port; return 1; }
+    void stop() {}
+    int beginPacket(IPAddress ip, uint16_t port);
+    int beginPacket(const char* host, uint16_t port);
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size);
+    int endPacket();
+    int parsePacket();
+    int available() { return (int)(rxLen - rxPos); }
+    int read();
+    int read(uint8_t* buffer, size_t len);
+
+private:
+    uint16_t localPort = 0;
+    uint16_t remotePort = 0;
+    uint8_t tx[48];
+    size_t txLen = 0;
+    uint8_t rx[48];
+    size_t rxLen = 0;
+    size_t rxPos = 0;
+    bool pending = false;
+};
+
+#endif // WIFIUDP_H
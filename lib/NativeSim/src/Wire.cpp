@@ -0,0 +1,94 @@
+#include <Wire.h>
+#include <string.h>
+#include "sim/SimClock.h"
+#include "sim/SimI2CBus.h"
+
+TwoWire Wire;
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    (void)sda; (void)scl;
+    if (frequency) clockHz = frequency;
+    return true;
+}
+
+bool TwoWire::end() {
+    return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+    clockHz = frequency;
+    return true;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    txAddress = address;
+    txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (txLength >= sizeof(txBuffer)) return 0;
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+    size_t n = 0;
+    while (n < quantity && write(data[n])) n++;
+    return n;
+}
+
+// Time on the wire for one transfer: START, address byte and payload at
+// nine clocks per byte (eight data bits plus ACK), then STOP unless the
+// next transfer follows with a repeated START. Charged to the virtual clock
+// so polling loops make progress in virtual-time runs.
+void TwoWire::chargeBusTime(size_t bytes, bool sendStop) {
+    uint64_t bits = (sendStop ? 2 : 1) + (uint64_t)(1 + bytes) * 9;
+    SimClock::elapseMicros((bits * 1000000ULL + clockHz - 1) / clockHz);
+}
+
+// Return codes follow the Arduino convention: 0 success, 2 address NACK,
+// 3 data NACK.
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    SimI2CDevice* device = SimI2CBus::find(txAddress);
+    size_t len = txLength;
+    txLength = 0;
+    if (!device || !SimI2CBus::supportsClock(txAddress, clockHz)) {
+        bool floats = device && SimI2CBus::floatsAbove(txAddress);
+        chargeBusTime(floats ? len : 0, sendStop);
+        return floats ? 0 : 2;
+    }
+    chargeBusTime(len, sendStop);
+    return device->onWrite(txBuffer, len) ? 0 : 3;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+    rxIndex = 0;
+    rxLength = 0;
+    SimI2CDevice* device = SimI2CBus::find(address);
+    if (quantity > sizeof(rxBuffer)) quantity = sizeof(rxBuffer);
+    if (!device || !SimI2CBus::supportsClock(address, clockHz)) {
+        if (!device || !SimI2CBus::floatsAbove(address)) {
+            chargeBusTime(0, sendStop);
+            return 0;
+        }
+        memset(rxBuffer, 0xFF, quantity);
+        rxLength = quantity;
+        chargeBusTime(rxLength, sendStop);
+        return (uint8_t)rxLength;
+    }
+    rxLength = device->onRead(rxBuffer, quantity);
+    chargeBusTime(rxLength, sendStop);
+    return (uint8_t)rxLength;
+}
+
+int TwoWire::available() {
+    return (int)(rxLength - rxIndex);
+}
+
+int TwoWire::read() {
+    return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1;
+}
+
+int TwoWire::peek() {
+    return rxIndex < rxLength ? rxBuffer[rxIndex] : -1;
+}
@@ -0,0 +1,44 @@
+#ifndef TWOWIRE_H
+#define TWOWIRE_H
+
+#include <Arduino.h>
+
+#define I2C_BUFFER_LENGTH 128
+
+// Host stand-in for the ESP32 TwoWire driver. Transfers are routed to the
+// simulated peripherals registered with SimI2CBus.
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool end();
+    bool setClock(uint32_t frequency);
+    uint32_t getClock() const { return clockHz; }
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+    uint8_t endTransmission(bool sendStop = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t quantity);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+    uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity, true); }
+    uint8_t requestFrom(int address, int quantity, int sendStop) { return requestFrom((uint8_t)address, (uint8_t)quantity, sendStop != 0); }
+    int available();
+    int read();
+    int peek();
+    void flush() {}
+
+private:
+    void chargeBusTime(size_t bytes, bool sendStop);
+
+    uint32_t clockHz = 100000;
+    uint8_t txAddress = 0;
+    uint8_t txBuffer[I2C_BUFFER_LENGTH];
+    size_t txLength = 0;
+    uint8_t rxBuffer[I2C_BUFFER_LENGTH];
+    size_t rxLength = 0;
+    size_t rxIndex = 0;
+};
+
+extern TwoWire Wire;
+
+#endif // TWOWIRE_H
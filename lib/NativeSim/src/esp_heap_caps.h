@@ -0,0 +1,12 @@
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <malloc.h>
+
+// Usable size of a heap block, as ESP-IDF reports it for its own heap.
+inline size_t heap_caps_get_allocated_size(void* ptr) {
+    return ptr ? malloc_usable_size(ptr) : 0;
+}
+
+#endif // ESP_HEAP_CAPS_H
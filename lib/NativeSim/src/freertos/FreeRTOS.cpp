@@ -0,0 +1,120 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "sim/SimClock.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Semaphores are modelled as counting semaphores with a ceiling of one:
+// mutexes start available, binary semaphores start empty. Priority
+// inheritance is not modelled.
+struct SimSemaphore {
+    std::mutex lock;
+    std::condition_variable cv;
+    int count;
+    bool binary;
+    SimSemaphore(int initial, bool isBinary) : count(initial), binary(isBinary) {}
+};
+
+// Step between wait-hook calls while blocked on a binary semaphore
+static const uint64_t WAIT_STEP_US = 50;
+
+struct SimTask {
+    std::thread thread;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return new SimSemaphore(1, false);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return new SimSemaphore(0, true);
+}
+
+static bool tryTake(SimSemaphore* sem) {
+    std::lock_guard<std::mutex> guard(sem->lock);
+    if (sem->count <= 0) return false;
+    sem->count--;
+    return true;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t xBlockTime) {
+    if (!sem) return pdFALSE;
+    SimClock::WaitHook hook = SimClock::getWaitHook();
+    if (sem->binary && hook && xBlockTime != 0 && xBlockTime != portMAX_DELAY) {
+        // Given from an ISR that only fires when a peripheral model runs,
+        // so keep time moving and the models ticking until then
+        uint64_t deadline = SimClock::nowMicros() + (uint64_t)xBlockTime * portTICK_PERIOD_MS * 1000ULL;
+        while (!tryTake(sem)) {
+            uint64_t now = SimClock::nowMicros();
+            if (now >= deadline) return pdFALSE;
+            SimClock::sleepMicros(std::min(WAIT_STEP_US, deadline - now));
+            hook();
+        }
+        return pdTRUE;
+    }
+    std::unique_lock<std::mutex> guard(sem->lock);
+    if (xBlockTime == portMAX_DELAY) {
+        sem->cv.wait(guard, [sem] { return sem->count > 0; });
+    } else if (!sem->cv.wait_for(guard, std::chrono::milliseconds(xBlockTime), [sem] { return sem->count > 0; })) {
+        return pdFALSE;
+    }
+    sem->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    if (!sem) return pdFALSE;
+    {
+        std::lock_guard<std::mutex> guard(sem->lock);
+        if (sem->count >= 1) return pdFALSE;
+        sem->count++;
+    }
+    sem->cv.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+    return xSemaphoreGive(sem);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+    delete sem;
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+    SimClock::sleepMicros((uint64_t)xTicksToDelay * portTICK_PERIOD_MS * 1000ULL);
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(SimClock::nowMicros() / (1000ULL * portTICK_PERIOD_MS));
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char* const pcName,
+                                   const uint32_t usStackDepth, void* const pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t* const pvCreatedTask,
+                                   const BaseType_t xCoreID) {
+    (void)pcName; (void)usStackDepth; (void)uxPriority; (void)xCoreID;
+    SimTask* task = new SimTask();
+    task->thread = std::thread(pvTaskCode, pvParameters);
+    task->thread.detach();
+    if (pvCreatedTask) *pvCreatedTask = task;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char* const pcName,
+                       const uint32_t usStackDepth, void* const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t* const pvCreatedTask) {
+    return xTaskCreatePinnedToCore(pvTaskCode, pcName, usStackDepth, pvParameters,
+                                   uxPriority, pvCreatedTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    // Host threads cannot be killed from outside; tasks are expected to
+    // return from their entry function. Only the bookkeeping is released.
+    delete xTaskToDelete;
+}
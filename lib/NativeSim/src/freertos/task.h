@@ -0,0 +1,20 @@
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void*);
+typedef struct SimTask* TaskHandle_t;
+
+void vTaskDelay(const TickType_t xTicksToDelay);
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char* const pcName,
+                                   const uint32_t usStackDepth, void* const pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t* const pvCreatedTask,
+                                   const BaseType_t xCoreID);
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char* const pcName,
+                       const uint32_t usStackDepth, void* const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t* const pvCreatedTask);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+
+#endif // FREERTOS_TASK_H
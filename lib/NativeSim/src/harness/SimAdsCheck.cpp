@@ -0,0 +1,360 @@
+#include "harness/SimAdsCheck.h"
+#include "harness/SimCheck.h"
+#include "sim/SimClock.h"
+#include "sim/SimI2CBus.h"
+#include "sim/SimWorld.h"
+#include "system/ADS1115Manager.h"
+#include "system/I2CTracer.h"
+#include <Arduino.h>
+#include <Wire.h>
+#include <math.h>
+#include <stdint.h>
+
+static const uint8_t ADS_ADDRESS = 0x48;
+// Nothing drives this pin, so ALERT/RDY never arrives there
+static const int UNWIRED_GPIO = 5;
+// Five sigma of the simulated front-end noise
+static const float TOLERANCE_VOLTS = 0.010f;
+
+struct AdsSetup {
+    const char* name;
+    int alertGpio;
+    bool registerCache;
+};
+
+static const AdsSetup SETUPS[] = {
+    { "polled", -1, true },
+    { "alert", SimWorld::ADS_ALERT_GPIO, true },
+    { "alert_unwired", UNWIRED_GPIO, true },
+    // The same reads with every pointer and register write sent, for comparison
+    { "polled_uncached", -1, false },
+    { "alert_uncached", SimWorld::ADS_ALERT_GPIO, false },
+};
+
+struct AdsResult {
+    uint32_t reads;
+    uint32_t badReads;
+    float maxErrorVolts;
+    double usPerRead;
+    double transactionsPerRead;
+    double txBytesPerRead;
+    double rxBytesPerRead;
+    double heldUsPerRead;
+    double busFreePct;
+    uint32_t conversions;
+    ADS1115Manager::ReadStats stats;
+    bool alertModeAtEnd;
+    uint32_t burstSamples;
+    uint32_t burstBad;
+    double burstMs;
+    uint32_t burstStale;
+    bool burstPoweredDown;
+};
+
+static AdsResult runSetup(const AdsSetup& setup, uint32_t reads) {
+    static I2CTracer tracer;
+    static SemaphoreHandle_t busMutex = xSemaphoreCreateMutex();
+    tracer.begin(Wire.getClock());
+    ADS1115Manager ads;
+    ads.begin(busMutex, ADS_ADDRESS, &tracer, setup.alertGpio);
+    ads.setRegisterCache(setup.registerCache);
+    tracer.reset();
+
+    SimADS1115& chip = SimWorld::ads();
+    // The previous set-up's burst may have left a conversion finishing
+    delay(2);
+    chip.tick();
+    uint32_t conversionsBefore = chip.getConversionCount();
+    AdsResult r = {};
+    uint64_t start = SimClock::nowMicros();
+    for (uint32_t i = 0; i < reads; ++i) {
+        // Soil and MQ135 inputs at the gains the sensors use
+        uint8_t channel = i % 2;
+        ADS1115Manager::Gain gain = channel == 0 ? ADS1115Manager::GAIN_ONE : ADS1115Manager::GAIN_TWOTHIRDS;
+        float error = fabsf(ads.readVoltage(channel, gain) - chip.getInputVoltage(channel));
+        if (error > r.maxErrorVolts) r.maxErrorVolts = error;
+        if (error > TOLERANCE_VOLTS) r.badReads++;
+    }
+    uint64_t elapsed = SimClock::nowMicros() - start;
+
+    const I2CTracer::DeviceStats* bus = tracer.findDevice(ADS_ADDRESS);
+    r.usPerRead = (double)elapsed / reads;
+    r.transactionsPerRead = bus ? (double)bus->transactions / reads : 0;
+    r.txBytesPerRead = bus ? (double)bus->txBytes / reads : 0;
+    r.rxBytesPerRead = bus ? (double)bus->rxBytes / reads : 0;
+    r.heldUsPerRead = bus ? (double)bus->heldUs / reads : 0;
+    r.busFreePct = bus && elapsed ? 100.0 * (1.0 - (double)bus->heldUs / elapsed) : 100.0;
+    r.conversions = chip.getConversionCount() - conversionsBefore;
+    r.reads = reads;
+    r.stats = ads.getReadStats();
+    r.alertModeAtEnd = ads.isAlertMode();
+
+    int16_t codes[SimAdsCheckOptions::BURST_SAMPLES];
+    uint32_t staleBefore = chip.getStaleReads();
+    uint64_t burstStart = SimClock::nowMicros();
+    r.burstSamples = (uint32_t)ads.readBurst(0, ADS1115Manager::GAIN_ONE, ADS1115Manager::SPS_860, codes,
+                                             SimAdsCheckOptions::BURST_SAMPLES);
+    r.burstMs = (SimClock::nowMicros() - burstStart) / 1000.0;
+    r.burstStale = chip.getStaleReads() - staleBefore;
+    r.burstPoweredDown = chip.getConfig() & 0x0100;
+    for (uint32_t i = 0; i < r.burstSamples; ++i) {
+        float error = fabsf(ADS1115Manager::codeToVolts(codes[i], ADS1115Manager::GAIN_ONE) - chip.getInputVoltage(0));
+        if (error > TOLERANCE_VOLTS) r.burstBad++;
+    }
+    if (setup.alertGpio >= 0) detachInterrupt(setup.alertGpio);
+    return r;
+}
+
+struct GroupResult {
+    double serialMs;
+    double groupMs;
+    uint32_t samples;
+    uint32_t bad;
+    uint32_t stale;
+};
+
+// Polled chips, as devices 1-3 are wired; device 0 is the world's chip
+static GroupResult runGroup() {
+    static SemaphoreHandle_t busMutex = xSemaphoreCreateMutex();
+    const int chips = SimAdsCheckOptions::GROUP_CHIPS;
+    const uint32_t samples = SimAdsCheckOptions::BURST_SAMPLES;
+    SimADS1115 extra[chips - 1];
+    SimADS1115* sim[chips] = { &SimWorld::ads() };
+    for (int i = 1; i < chips; ++i) {
+        sim[i] = &extra[i - 1];
+        sim[i]->setInputVoltage(0, 0.5f * i);
+        SimI2CBus::attach(ADS_ADDRESS + i, sim[i]);
+    }
+    ADS1115Manager ads[chips];
+    for (int i = 0; i < chips; ++i) ads[i].begin(busMutex, ADS_ADDRESS + i);
+    delay(2);
+    SimI2CBus::tickAll();
+
+    GroupResult r = {};
+    static int16_t codes[chips][SimAdsCheckOptions::BURST_SAMPLES];
+    uint64_t start = SimClock::nowMicros();
+    for (int i = 0; i < chips; ++i) {
+        ads[i].readBurst(0, ADS1115Manager::GAIN_ONE, ADS1115Manager::SPS_860, codes[i], samples);
+    }
+    r.serialMs = (SimClock::nowMicros() - start) / 1000.0;
+    delay(2);
+    SimI2CBus::tickAll();
+
+    uint32_t staleBefore[chips];
+    ADS1115Manager::BurstJob jobs[chips];
+    for (int i = 0; i < chips; ++i) {
+        staleBefore[i] = sim[i]->getStaleReads();
+        jobs[i] = { &ads[i], 0, ADS1115Manager::GAIN_ONE, ADS1115Manager::SPS_860, codes[i], samples, 0 };
+    }
+    start = SimClock::nowMicros();
+    ADS1115Manager::readBurstGroup(jobs, chips);
+    r.groupMs = (SimClock::nowMicros() - start) / 1000.0;
+    for (int i = 0; i < chips; ++i) {
+        r.samples += (uint32_t)jobs[i].taken;
+        r.stale += sim[i]->getStaleReads() - staleBefore[i];
+        for (size_t s = 0; s < jobs[i].taken; ++s) {
+            float error = fabsf(ADS1115Manager::codeToVolts(codes[i][s], ADS1115Manager::GAIN_ONE) - sim[i]->getInputVoltage(0));
+            if (error > TOLERANCE_VOLTS) r.bad++;
+        }
+    }
+    delay(2);
+    for (int i = 1; i < chips; ++i) SimI2CBus::detach(ADS_ADDRESS + i);
+    return r;
+}
+
+struct AutoGainResult {
+    float fixedErrorUv;
+    int gain;
+    float autoErrorUv;
+    uint32_t rangeFinds;
+    int stepGain;
+    bool stepClipped;
+    float stepErrorMv;
+    uint32_t rangeFindsAfterStep;
+};
+
+static float burstMeanVolts(const int16_t* codes, size_t count, ADS1115Manager::Gain gain) {
+    double sum = 0;
+    for (size_t i = 0; i < count; ++i) sum += codes[i];
+    return count ? ADS1115Manager::codeToVolts(1, gain) * (float)(sum / count) : 0.0f;
+}
+
+// MQ135-like level on a noise-free chip, so only quantisation is left
+static AutoGainResult runAutoGain() {
+    static SemaphoreHandle_t busMutex = xSemaphoreCreateMutex();
+    const uint8_t address = ADS_ADDRESS + 1;
+    const uint8_t channel = 1;
+    const float inputVolts = 0.40009f;
+    const float stepVolts = 2.0f;
+    SimADS1115 chip;
+    chip.setInputVoltage(channel, inputVolts);
+    SimI2CBus::attach(address, &chip);
+    ADS1115Manager ads;
+    ads.begin(busMutex, address);
+
+    AutoGainResult r = {};
+    int16_t codes[SimAdsCheckOptions::BURST_SAMPLES];
+    const size_t n = SimAdsCheckOptions::BURST_SAMPLES;
+    size_t got = ads.readBurst(channel, ADS1115Manager::GAIN_TWOTHIRDS, ADS1115Manager::SPS_860, codes, n);
+    r.fixedErrorUv = fabsf(burstMeanVolts(codes, got, ADS1115Manager::GAIN_TWOTHIRDS) - inputVolts) * 1e6f;
+    ADS1115Manager::Gain gain = ADS1115Manager::GAIN_TWOTHIRDS;
+    for (int i = 0; i < SimAdsCheckOptions::AUTO_GAIN_BURSTS; ++i) {
+        got = ads.readBurstAuto(channel, ADS1115Manager::SPS_860, codes, n, gain);
+    }
+    r.gain = gain;
+    r.autoErrorUv = fabsf(burstMeanVolts(codes, got, gain) - inputVolts) * 1e6f;
+    r.rangeFinds = ads.getReadStats().rangeFinds;
+
+    chip.setInputVoltage(channel, stepVolts);
+    got = ads.readBurstAuto(channel, ADS1115Manager::SPS_860, codes, n, gain);
+    for (size_t i = 0; i < got; ++i) r.stepClipped |= codes[i] == 32767;
+    r.stepGain = gain;
+    r.stepErrorMv = fabsf(burstMeanVolts(codes, got, gain) - stepVolts) * 1e3f;
+    r.rangeFindsAfterStep = ads.getReadStats().rangeFinds;
+    delay(2);
+    SimI2CBus::detach(address);
+    return r;
+}
+
+struct WatchResult {
+    bool started;
+    uint32_t idleTransactions;
+    bool falseTrip;
+    float readErrorMv;
+    double tripMs;
+    int16_t tripCode;
+    bool alertReadsAfter;
+};
+
+// Advances virtual time the way loop() does, ticking the peripherals
+static bool stepUntilTripped(ADS1115Manager& ads, uint32_t ms) {
+    for (uint32_t t = 0; t < ms && !ads.watchTripped(); t += 10) {
+        delay(10);
+        SimI2CBus::tickAll();
+    }
+    return ads.watchTripped();
+}
+
+// Soil-like window: wet 4400, dry 10700, 50% threshold at code 7550
+static WatchResult runWatch() {
+    static I2CTracer tracer;
+    static SemaphoreHandle_t busMutex = xSemaphoreCreateMutex();
+    const int16_t thresholdCode = 7550;
+    const float wetVolts = 1.2f;
+    const float dryVolts = 1.6f;
+    tracer.begin(Wire.getClock());
+    SimADS1115& chip = SimWorld::ads();
+    float original = chip.getInputVoltage(0);
+    chip.setInputVoltage(0, wetVolts);
+    ADS1115Manager ads;
+    ads.begin(busMutex, ADS_ADDRESS, &tracer, SimWorld::ADS_ALERT_GPIO);
+
+    WatchResult r = {};
+    r.started = ads.startWatch(0, ADS1115Manager::GAIN_TWOTHIRDS, INT16_MIN, thresholdCode);
+    tracer.reset();
+    stepUntilTripped(ads, SimAdsCheckOptions::WATCH_IDLE_MS / 2);
+    const I2CTracer::DeviceStats* bus = tracer.findDevice(ADS_ADDRESS);
+    r.idleTransactions = bus ? bus->transactions : 0;
+    // Another input read mid-watch
+    r.readErrorMv = fabsf(ads.readVoltage(1, ADS1115Manager::GAIN_TWOTHIRDS) - chip.getInputVoltage(1)) * 1000.0f;
+    r.falseTrip = stepUntilTripped(ads, SimAdsCheckOptions::WATCH_IDLE_MS / 2);
+
+    chip.setInputVoltage(0, dryVolts);
+    uint64_t start = SimClock::nowMicros();
+    stepUntilTripped(ads, SimAdsCheckOptions::WATCH_TRIP_BUDGET_MS * 2);
+    r.tripMs = ads.watchTripped() ? (SimClock::nowMicros() - start) / 1000.0 : -1.0;
+    ads.stopWatch(&r.tripCode);
+    uint32_t alertReads = ads.getReadStats().alertReads;
+    ads.readVoltage(0, ADS1115Manager::GAIN_TWOTHIRDS);
+    r.alertReadsAfter = ads.getReadStats().alertReads == alertReads + 1;
+
+    detachInterrupt(SimWorld::ADS_ALERT_GPIO);
+    chip.setInputVoltage(0, original);
+    return r;
+}
+
+static const SimCheck check("ads-check");
+
+int SimAdsCheck::run(const SimAdsCheckOptions& options) {
+    uint32_t reads = options.iterations ? options.iterations : 1;
+    SimClock::setVirtual(true);
+
+    const int count = sizeof(SETUPS) / sizeof(SETUPS[0]);
+    AdsResult results[count];
+    printf("setup,reads,bad_reads,max_error_mv,us_per_read,transactions_per_read,tx_bytes_per_read,"
+           "rx_bytes_per_read,bus_held_us_per_read,bus_free_pct,conversions,alert_reads,polled_reads,missed_alerts,"
+           "timeouts,alert_mode_at_end,elided_writes,burst_samples,burst_bad,burst_ms,burst_stale_reads\n");
+    for (int i = 0; i < count; ++i) {
+        const AdsResult& r = results[i] = runSetup(SETUPS[i], reads);
+        printf("%s,%u,%u,%.2f,%.1f,%.2f,%.2f,%.2f,%.1f,%.1f,%u,%u,%u,%u,%u,%d,%u,%u,%u,%.2f,%u\n", SETUPS[i].name,
+               r.reads, r.badReads, r.maxErrorVolts * 1000.0f, r.usPerRead, r.transactionsPerRead, r.txBytesPerRead,
+               r.rxBytesPerRead, r.heldUsPerRead, r.busFreePct, r.conversions, r.stats.alertReads,
+               r.stats.polledReads, r.stats.missedAlerts, r.stats.timeouts, r.alertModeAtEnd ? 1 : 0,
+               r.stats.elidedWrites, r.burstSamples, r.burstBad, r.burstMs, r.burstStale);
+    }
+
+    bool ok = true;
+    for (int i = 0; i < count; ++i) {
+        ok &= check(results[i].badReads == 0, SETUPS[i].name, "readings do not match the simulated inputs");
+        ok &= check(results[i].conversions == reads, SETUPS[i].name, "not one conversion per read");
+        ok &= check(results[i].stats.timeouts == 0, SETUPS[i].name, "conversions timed out");
+        ok &= check(results[i].burstSamples == SimAdsCheckOptions::BURST_SAMPLES && results[i].burstBad == 0,
+                    SETUPS[i].name, "burst short or off");
+        ok &= check(results[i].burstStale == 0, SETUPS[i].name, "burst read a conversion twice");
+        ok &= check(results[i].burstMs <= SimAdsCheckOptions::BURST_BUDGET_MS, SETUPS[i].name, "burst over budget");
+        ok &= check(results[i].burstPoweredDown, SETUPS[i].name, "chip left in continuous mode after burst");
+    }
+    const AdsResult& polled = results[0];
+    const AdsResult& alert = results[1];
+    const AdsResult& unwired = results[2];
+    const AdsResult& polledUncached = results[3];
+    const AdsResult& alertUncached = results[4];
+    ok &= check(alert.stats.alertReads == reads && alert.stats.polledReads == 0 && alert.alertModeAtEnd,
+                "alert", "reads did not all complete on ALERT/RDY");
+    ok &= check(alert.transactionsPerRead < polled.transactionsPerRead, "alert", "no less bus traffic than polling");
+    ok &= check(!unwired.alertModeAtEnd && unwired.stats.alertReads == 0 && unwired.stats.missedAlerts > 0 &&
+                unwired.stats.polledReads + unwired.stats.missedAlerts == reads,
+                "alert_unwired", "did not fall back to polling");
+    // Polling holds the bus for the whole conversion either way; the cache
+    // shows as fewer pointer writes and more of the time spent reading
+    ok &= check(polled.transactionsPerRead < polledUncached.transactionsPerRead &&
+                polled.txBytesPerRead < polledUncached.txBytesPerRead,
+                "polled", "register cache saved no bus traffic");
+    ok &= check(alert.transactionsPerRead <= alertUncached.transactionsPerRead &&
+                alert.txBytesPerRead <= alertUncached.txBytesPerRead,
+                "alert", "register cache added bus traffic");
+
+    const GroupResult group = runGroup();
+    printf("chips,serial_ms,group_ms,group_samples,group_bad,group_stale_reads\n");
+    printf("%d,%.2f,%.2f,%u,%u,%u\n", SimAdsCheckOptions::GROUP_CHIPS, group.serialMs, group.groupMs, group.samples,
+           group.bad, group.stale);
+    ok &= check(group.samples == SimAdsCheckOptions::GROUP_CHIPS * SimAdsCheckOptions::BURST_SAMPLES && group.bad == 0,
+                "group", "group burst short or off");
+    ok &= check(group.stale == 0, "group", "group burst read a conversion twice");
+    ok &= check(group.groupMs <= SimAdsCheckOptions::BURST_BUDGET_MS, "group", "chips did not convert in parallel");
+
+    const AutoGainResult autoGain = runAutoGain();
+    printf("fixed_error_uv,auto_gain,auto_error_uv,range_finds,step_gain,step_clipped,step_error_mv,range_finds_after_step\n");
+    printf("%.1f,%d,%.1f,%u,%d,%d,%.2f,%u\n", autoGain.fixedErrorUv, autoGain.gain, autoGain.autoErrorUv,
+           autoGain.rangeFinds, autoGain.stepGain, autoGain.stepClipped ? 1 : 0, autoGain.stepErrorMv,
+           autoGain.rangeFindsAfterStep);
+    ok &= check(autoGain.gain == ADS1115Manager::GAIN_EIGHT, "auto_gain", "0.4 V not read at +/-0.512V");
+    ok &= check(autoGain.rangeFinds == 1, "auto_gain", "cached gain not reused");
+    ok &= check(autoGain.autoErrorUv < autoGain.fixedErrorUv, "auto_gain", "no finer than +/-6.144V");
+    ok &= check(!autoGain.stepClipped && autoGain.stepErrorMv * 1e-3f < TOLERANCE_VOLTS &&
+                autoGain.stepGain == ADS1115Manager::GAIN_ONE, "auto_gain", "did not re-range after the step");
+
+    const WatchResult watch = runWatch();
+    printf("watch_started,watch_idle_transactions,watch_false_trip,watch_read_error_mv,watch_trip_ms,watch_trip_code,"
+           "alert_reads_after_watch\n");
+    printf("%d,%u,%d,%.2f,%.1f,%d,%d\n", watch.started ? 1 : 0, watch.idleTransactions, watch.falseTrip ? 1 : 0,
+           watch.readErrorMv, watch.tripMs, watch.tripCode, watch.alertReadsAfter ? 1 : 0);
+    ok &= check(watch.started, "watch", "comparator not armed");
+    ok &= check(watch.idleTransactions == 0, "watch", "bus traffic while watching");
+    ok &= check(!watch.falseTrip, "watch", "tripped while the input was in bounds");
+    ok &= check(watch.readErrorMv < TOLERANCE_VOLTS * 1000.0f, "watch", "read during the watch is off");
+    ok &= check(watch.tripMs >= 0 && watch.tripMs <= SimAdsCheckOptions::WATCH_TRIP_BUDGET_MS, "watch",
+                "dry step not caught in time");
+    ok &= check(watch.alertReadsAfter, "watch", "conversion-ready reads not restored after the watch");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+#ifndef SIM_ADS_CHECK_H
+#define SIM_ADS_CHECK_H
+
+#include <stdint.h>
+
+// Checks ADS1115Manager against the simulated ADS1115 in virtual time, in
+// five set-ups: polling the OS bit, ALERT/RDY on the GPIO the simulated
+// chip drives, and ALERT/RDY configured on a GPIO nothing drives (which
+// must fall back to polling), then polling and ALERT/RDY again with the
+// register cache off for comparison. Alternates channels and gains, compares each
+// reading with the simulated input, and prints per set-up the time per
+// read, I2C transactions, bytes and bus-held time per read and how reads waited,
+// as CSV. Each set-up then takes one readBurst() the size the sensors use.
+// Exits 1 when a reading is off, the interrupt path still polls, puts as
+// much traffic on the bus as polling, the fallback does not happen, the
+// register cache does not cut polled traffic, or a
+// burst reads a conversion twice, comes back short or takes longer than
+// BURST_BUDGET_MS. Finally three more chips are attached at 0x49-0x4B and
+// one burst per chip is taken back to back and then as one
+// readBurstGroup(); the group must stay within BURST_BUDGET_MS, i.e. the
+// chips must convert in parallel. Last, a noise-free chip is read with
+// readBurstAuto() at an MQ135-like 0.4 V and then after a step to 2 V: it
+// must range-find once, settle on +/-0.512V with a smaller quantisation
+// error than +/-6.144V, and after the step return no clipped codes and
+// widen the range. Then A0 is watched with the window comparator at a
+// soil dryness threshold: while the input stays wet there must be no bus
+// traffic and no alert (a read of A1 in between must not trip it either),
+// and a step past the threshold must trip it within WATCH_TRIP_BUDGET_MS.
+// No firmware boot.
+struct SimAdsCheckOptions {
+    static const uint32_t BURST_SAMPLES = 32;
+    static const uint32_t BURST_BUDGET_MS = 60;
+    static const int GROUP_CHIPS = 4;
+    static const int AUTO_GAIN_BURSTS = 10;
+    static const uint32_t WATCH_IDLE_MS = 2000;
+    static const uint32_t WATCH_TRIP_BUDGET_MS = 1000; // Four conversions at 8 SPS plus margin
+    uint32_t iterations = 200;
+};
+
+class SimAdsCheck {
+public:
+    // Returns the process exit code: 0 all checks passed, 1 a check failed
+    static int run(const SimAdsCheckOptions& options);
+};
+
+#endif // SIM_ADS_CHECK_H
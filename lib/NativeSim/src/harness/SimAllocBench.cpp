@@ -0,0 +1,160 @@
+#include "harness/SimAllocBench.h"
+#include "harness/SimBoot.h"
+#include "system/MqttManager.h"
+#include "diagnostics/AllocationTracker.h"
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <string>
+
+// Defined in src/main.cpp.
+extern MqttManager mqttManager;
+
+struct BenchRequest {
+    WebRequestMethod method;
+    const char* url;
+    const char* body;
+};
+
+// Everything registered in WebServerManager::begin() except routes that
+// restart the board or rewrite/delete the config.
+static const BenchRequest REQUESTS[] = {
+    { HTTP_GET, "/api/status", nullptr },
+    { HTTP_GET, "/api/metrics", nullptr },
+    { HTTP_GET, "/", nullptr },
+    { HTTP_GET, "/index.html", nullptr },
+    { HTTP_GET, "/index.js", nullptr },
+    { HTTP_GET, "/style.css", nullptr },
+    { HTTP_GET, "/relay.html", nullptr },
+    { HTTP_GET, "/relay.js", nullptr },
+    { HTTP_GET, "/irrigation.html", nullptr },
+    { HTTP_GET, "/irrigation.js", nullptr },
+    { HTTP_GET, "/config.html", nullptr },
+    { HTTP_GET, "/config.js", nullptr },
+    { HTTP_GET, "/info.html", nullptr },
+    { HTTP_GET, "/info.js", nullptr },
+    { HTTP_GET, "/missing", nullptr },
+    { HTTP_POST, "/api/led", "{\"command\":\"toggle\"}" },
+    { HTTP_POST, "/api/relay", "{\"relay\":2,\"command\":\"toggle\"}" },
+    { HTTP_POST, "/api/bme280/trigger", "{}" },
+    { HTTP_POST, "/api/soilmoisture/trigger", "{}" },
+    { HTTP_POST, "/api/mq135/trigger", "{}" },
+    { HTTP_POST, "/api/irrigation/stop", "{}" },
+};
+
+static void publishAll() {
+    mqttManager.publishDiscovery();
+    mqttManager.publishRelayState(2, true);
+    mqttManager.publishBME280Temperature(21.5f);
+    mqttManager.publishBME280Humidity(48.2f);
+    mqttManager.publishBME280Pressure(1013.2f);
+    mqttManager.publishBME280HeatIndex(21.4f);
+    mqttManager.publishBME280DewPoint(10.1f);
+    mqttManager.publishSoilMoisture(37.5f);
+    mqttManager.publishMQ135AirQuality();
+}
+
+static cJSON* loadBudget(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return nullptr;
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    fclose(f);
+    return cJSON_Parse(text.c_str());
+}
+
+static bool overBudget(const char* name, const char* field, uint32_t actual, cJSON* budget) {
+    cJSON* limit = cJSON_GetObjectItemCaseSensitive(budget, field);
+    if (!cJSON_IsNumber(limit) || actual <= (uint32_t)limit->valuedouble) return false;
+    printf("FAIL,%s,%s,%u,%u\n", name, field, actual, (uint32_t)limit->valuedouble);
+    return true;
+}
+
+// 10% over the measured worst case plus a small constant, so float
+// formatting and timestamp lengths do not trip the gate.
+static uint32_t withHeadroom(uint32_t value, uint32_t slack) {
+    return value + value / 10 + slack;
+}
+
+static bool writeBudget(const char* path) {
+    cJSON* root = cJSON_CreateObject();
+    for (int i = 0; i < AllocationTracker::getOperationCount(); ++i) {
+        const AllocationTracker::Operation* op = AllocationTracker::getOperation(i);
+        if (!op->calls) continue;
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "max_allocs", withHeadroom(op->maxAllocs, 2));
+        cJSON_AddNumberToObject(item, "max_bytes", withHeadroom(op->maxBytes, 64));
+        cJSON_AddNumberToObject(item, "peak_bytes", withHeadroom(op->maxPeakBytes, 64));
+        cJSON_AddItemToObject(root, op->name, item);
+    }
+    char* text = cJSON_Print(root);
+    FILE* f = fopen(path, "wb");
+    bool ok = f && fputs(text, f) >= 0 && fputc('\n', f) != EOF;
+    if (f) fclose(f);
+    cJSON_free(text);
+    cJSON_Delete(root);
+    return ok;
+}
+
+int SimAllocBench::run(const SimAllocBenchOptions& options) {
+    if (!AllocationTracker::isEnabled()) {
+        fprintf(stderr, "alloc-bench: built without ALLOC_TRACKING, nothing to measure\n");
+        return 2;
+    }
+    if (!SimBoot::startFirmware(options.verbose)) {
+        fprintf(stderr, "alloc-bench: web server did not start\n");
+        return 2;
+    }
+    SimBoot::connectMqtt("alloc_bench");
+    publishAll(); // Connect outside the measured window
+
+    AllocationTracker::reset();
+    for (uint32_t i = 0; i < options.iterations; ++i) {
+        for (const BenchRequest& r : REQUESTS) {
+            AsyncWebServer::simRequest(r.method, r.url, r.body);
+        }
+        publishAll();
+        SimBoot::runLoops(20);
+    }
+
+    printf("operation,calls,avg_allocs,max_allocs,avg_bytes,max_bytes,peak_bytes\n");
+    for (int i = 0; i < AllocationTracker::getOperationCount(); ++i) {
+        const AllocationTracker::Operation* op = AllocationTracker::getOperation(i);
+        if (!op->calls) continue;
+        printf("%s,%u,%.1f,%u,%.1f,%u,%u\n", op->name, op->calls, (double)op->allocs / op->calls, op->maxAllocs,
+               (double)op->bytes / op->calls, op->maxBytes, op->maxPeakBytes);
+    }
+
+    if (options.writeBudgetFile) {
+        if (!writeBudget(options.writeBudgetFile)) {
+            fprintf(stderr, "alloc-bench: cannot write %s\n", options.writeBudgetFile);
+            return 2;
+        }
+        printf("# budget written to %s\n", options.writeBudgetFile);
+        return 0; // A new baseline is not checked against the old one
+    }
+    if (!options.budgetFile) return 0;
+
+    cJSON* budget = loadBudget(options.budgetFile);
+    if (!budget) {
+        fprintf(stderr, "alloc-bench: cannot read budget %s\n", options.budgetFile);
+        return 2;
+    }
+    bool failed = false;
+    cJSON* entry = nullptr;
+    cJSON_ArrayForEach(entry, budget) {
+        const AllocationTracker::Operation* op = AllocationTracker::findOperation(entry->string);
+        if (!op || !op->calls) {
+            printf("FAIL,%s,not exercised,0,0\n", entry->string);
+            failed = true;
+            continue;
+        }
+        failed |= overBudget(op->name, "max_allocs", op->maxAllocs, entry);
+        failed |= overBudget(op->name, "max_bytes", op->maxBytes, entry);
+        failed |= overBudget(op->name, "peak_bytes", op->maxPeakBytes, entry);
+    }
+    cJSON_Delete(budget);
+    printf("# alloc budget %s\n", failed ? "EXCEEDED" : "ok");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+#ifndef SIM_ALLOC_BENCH_H
+#define SIM_ALLOC_BENCH_H
+
+#include <stdint.h>
+
+// Boots the firmware in virtual time, then drives every safe web route
+// through AsyncWebServer::simRequest() and every MqttManager publish path
+// against SimMqttBroker, reporting AllocationTracker's per-operation
+// numbers as CSV. It is a regression gate against the committed budget:
+// the run fails if any operation's worst call exceeds its budgeted
+// allocations, bytes or peak bytes. Needs -D ALLOC_TRACKING (native env).
+struct SimAllocBenchOptions {
+    // Relative to the project root, where the native program is run from
+    static constexpr const char* DEFAULT_BUDGET = "lib/NativeSim/alloc_budget.json";
+    // The simulated LittleFS allocates the host path of every file it
+    // opens, so static routes cost more bytes under a longer root. The
+    // bench uses this root, as long as the default one, whatever
+    // NATIVE_SIM_FS says, so the budget holds on any host.
+    static constexpr const char* FS_ROOT = ".sim/alloc-fs";
+    uint32_t iterations = 20;
+    const char* budgetFile = DEFAULT_BUDGET; // Compare against this budget; nullptr: report only
+    const char* writeBudgetFile = nullptr;   // Write current numbers plus headroom instead
+    bool verbose = false;
+};
+
+class SimAllocBench {
+public:
+    // Returns the process exit code: 0 pass, 1 over budget, 2 setup failure
+    static int run(const SimAllocBenchOptions& options);
+};
+
+#endif // SIM_ALLOC_BENCH_H
@@ -0,0 +1,496 @@
+#include "harness/SimBmeCheck.h"
+#include "harness/SimCheck.h"
+#include "devices/BME280Compensation.h"
+#include "devices/BME280Device.h"
+#include "devices/BME280Group.h"
+#include "sim/Bme280Math.h"
+#include "sim/SimClock.h"
+#include "sim/SimI2CBus.h"
+#include "sim/SimWorld.h"
+#include <Adafruit_BME280.h>
+#include <Arduino.h>
+#include <Wire.h>
+#include <chrono>
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+static const uint8_t BME_ADDRESS = 0x76;
+static const uint32_t BUS_HZ = 400000;
+static const uint32_t CPU_REPEAT = 2000;
+static const uint32_t CPU_ROUNDS = 5;
+static const uint32_t READING_INTERVAL_MS = 60000;
+// SimBME280's noise at oversampling x1; the modes are also compared at ten
+// times that, where the filtering rather than the quantisation shows
+static const float NOISE_T_C = 0.02f;
+static const float NOISE_H_PCT = 0.07f;
+static const float NOISE_P_PA = 3.3f;
+static const float NOISE_SCALES[] = { 1.0f, 10.0f };
+static const uint32_t OVERSAMPLING = 16;
+static const int IIR_COEFF = 16;
+// Where quantisation rather than noise sets the error: half a 0.01 degC
+// count, and what forced mode measures for pressure at the part's noise
+static const double FLOOR_T_C = 0.005;
+static const double FLOOR_P_PA = 0.5;
+static const uint8_t OVERSAMPLING_SWEEP[] = { 1, 2, 4, 8, 16 };
+// BME280Device's forced reading: ten conversions, the first started at once
+static const int READING_SAMPLES = 10;
+
+// The group check: the other two addresses I2CManager probes, and what
+// each sensor sees. The third reads 9 degC hot, as a part in the sun would;
+// the median of three must ignore it
+static const uint8_t GROUP_ADDRESSES[] = { 0x76, 0x77, 0x70 };
+static const float GROUP_TEMPERATURES_C[] = { 21.0f, 21.6f, 30.0f };
+
+// Tolerances against the double precision formulas, a little over the
+// integer versions' resolution
+static const double MAX_T_ERROR_C = 0.01;
+static const double MAX_P_ERROR_PA = 1.0;
+static const double MAX_H_ERROR_PCT = 0.01;
+
+// Sits at the BME280's address and counts what crosses the bus, as the
+// device sees it: every onWrite/onRead is one transfer
+class CountingDevice : public SimI2CDevice {
+public:
+    explicit CountingDevice(SimI2CDevice* inner) : inner(inner) {}
+    bool onWrite(const uint8_t* data, size_t len) override {
+        transfers++;
+        txBytes += len;
+        return inner->onWrite(data, len);
+    }
+    size_t onRead(uint8_t* data, size_t len) override {
+        transfers++;
+        size_t n = inner->onRead(data, len);
+        rxBytes += n;
+        return n;
+    }
+    void tick() override { inner->tick(); }
+    void reset() { transfers = txBytes = rxBytes = 0; }
+
+    SimI2CDevice* inner;
+    uint32_t transfers = 0;
+    uint32_t txBytes = 0;
+    uint32_t rxBytes = 0;
+};
+
+struct ModeResult {
+    float noiseScale;
+    bool bootValid; // The reading begin() takes has numbers in it
+    uint32_t readings;
+    double msPerReading;
+    double transfersPerReading;
+    double rmsT; // Against the simulated environment
+    double rmsH;
+    double rmsP;
+};
+
+struct TimingResult {
+    uint8_t oversampling;
+    double typicalMs;
+    double maxMs;
+    double msPerReading;
+    double transfersPerReading;
+    bool valid; // Every reading had numbers in it
+};
+
+struct PathResult {
+    double transfersPerSample;
+    double txBytesPerSample;
+    double rxBytesPerSample;
+    double busUsPerSample;
+    double cpuNsPerSample;
+};
+
+static const SimCheck check("bme-check");
+
+static BME280Compensation toCompensation(const Bme280Calibration& calib) {
+    uint8_t tp[BME280Compensation::CALIB_TP_LEN];
+    uint8_t h[BME280Compensation::CALIB_H_LEN];
+    calib.serialise(tp, h);
+    BME280Compensation comp;
+    comp.parse(tp, h);
+    return comp;
+}
+
+// BMP280 datasheet, section 8.1 (rev. 1.14 and later)
+static bool checkReferenceVector() {
+    Bme280Calibration calib = {};
+    calib.T1 = 27504; calib.T2 = 26435; calib.T3 = -1000;
+    calib.P1 = 36477; calib.P2 = -10685; calib.P3 = 3024; calib.P4 = 2855; calib.P5 = 140;
+    calib.P6 = -7; calib.P7 = 15500; calib.P8 = -14600; calib.P9 = 6000;
+    BME280Compensation comp = toCompensation(calib);
+    const int32_t adcT = 519888;
+    const int32_t adcP = 415148;
+    int32_t tFine = 0;
+    int32_t t = comp.compensateT(adcT, tFine);
+    double pa = comp.compensateP(adcP, tFine) / 256.0;
+    printf("vector,adc_t,adc_p,t_fine,t_centi_c,p_pa\n");
+    printf("bmp280_8.1,%d,%d,%d,%d,%.3f\n", adcT, adcP, tFine, t, pa);
+    bool ok = true;
+    ok &= check(tFine == 128422, "vector", "t_fine is not 128422");
+    ok &= check(t == 2508, "vector", "temperature is not 25.08 degC");
+    ok &= check(fabs(pa - 100653.27) < 0.1, "vector", "pressure is not 100653.27 Pa");
+    return ok;
+}
+
+// Sweeps T, P and H codes through the simulated part's trimming, over the
+// sensor's operating range
+static bool checkSweep(const Bme280Calibration& calib) {
+    BME280Compensation comp = toCompensation(calib);
+    uint32_t points = 0, mismatches = 0;
+    double maxT = 0, maxP = 0, maxH = 0;
+    for (int32_t adcT = 300000; adcT <= 700000; adcT += 4000) {
+        int32_t tFine = 0, simTFine = 0;
+        int32_t t = comp.compensateT(adcT, tFine);
+        if (t < -4000 || t > 8500) continue;
+        double dTFine = 0;
+        double tDouble = calib.compensateTDouble(adcT, dTFine);
+        if (t != calib.compensateT(adcT, simTFine) || tFine != simTFine) mismatches++;
+        maxT = fmax(maxT, fabs(t / 100.0 - tDouble));
+        for (int32_t adcP = 150000; adcP <= 650000; adcP += 10000) {
+            uint32_t p = comp.compensateP(adcP, tFine);
+            if (p < 30000u * 256 || p > 110000u * 256) continue;
+            points++;
+            if (p != calib.compensateP64(adcP, tFine)) mismatches++;
+            maxP = fmax(maxP, fabs(p / 256.0 - calib.compensatePDouble(adcP, dTFine)));
+        }
+        for (int32_t adcH = 10000; adcH <= 60000; adcH += 1000) {
+            uint32_t h = comp.compensateH(adcH, tFine);
+            points++;
+            if (h != calib.compensateH(adcH, tFine)) mismatches++;
+            double hDouble = calib.compensateHDouble(adcH, dTFine);
+            // The integer version clamps at 100 %RH before its rounding
+            if (hDouble > 0.0 && hDouble < 100.0) maxH = fmax(maxH, fabs(h / 1024.0 - hDouble));
+        }
+    }
+    printf("sweep_points,mismatches,max_t_error_c,max_p_error_pa,max_h_error_pct\n");
+    printf("%u,%u,%.4f,%.3f,%.4f\n", points, mismatches, maxT, maxP, maxH);
+    bool ok = true;
+    ok &= check(points > 0, "sweep", "no codes in range");
+    ok &= check(mismatches == 0, "sweep", "differs from the sim's integer formulas");
+    ok &= check(maxT <= MAX_T_ERROR_C, "sweep", "temperature off the double formula");
+    ok &= check(maxP <= MAX_P_ERROR_PA, "sweep", "pressure off the double formula");
+    ok &= check(maxH <= MAX_H_ERROR_PCT, "sweep", "humidity off the double formula");
+
+    // A skipped measurement leaves the reset value in its registers
+    const uint8_t skipped[BME280Compensation::DATA_LEN] = { 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00 };
+    float t, h, p;
+    comp.compensate(BME280Compensation::parseData(skipped), t, h, p);
+    ok &= check(isnan(t) && isnan(h) && isnan(p), "sweep", "skipped measurement not reported as NAN");
+    return ok;
+}
+
+// Compensation maths of one sample as the Adafruit driver does it:
+// temperature again before humidity and before pressure
+static float adafruitMaths(const BME280Compensation& comp, const BME280Compensation::Raw& raw) {
+    int32_t tFine = 0;
+    float t = comp.compensateT(raw.adcT, tFine) / 100.0f;
+    comp.compensateT(raw.adcT, tFine);
+    float h = comp.compensateH(raw.adcH, tFine) / 1024.0f;
+    comp.compensateT(raw.adcT, tFine);
+    float p = comp.compensateP(raw.adcP, tFine) / 256.0f / 100.0f;
+    return t + h + p;
+}
+
+static float burstMaths(const BME280Compensation& comp, const BME280Compensation::Raw& raw) {
+    float t, h, p;
+    comp.compensate(raw, t, h, p);
+    return t + h + p;
+}
+
+template <typename Maths>
+static double cpuNsPerSample(const BME280Compensation& comp, const std::vector<BME280Compensation::Raw>& raws, Maths maths) {
+    volatile float sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < CPU_REPEAT; ++r) {
+        for (const BME280Compensation::Raw& raw : raws) sink = sink + maths(comp, raw);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return (double)elapsed.count() / ((double)CPU_REPEAT * raws.size());
+}
+
+// Readings a minute apart in one mode, as the firmware would take them
+static ModeResult runMode(BME280Device::Mode mode, uint8_t normalSamples, float noiseScale, uint32_t readings,
+                          CountingDevice& counter) {
+    const double envT = 21.0, envH = 50.0, envP = 101325.0;
+    SimWorld::bme().setEnvironment((float)envT, (float)envH, (float)envP);
+    SimWorld::bme().setNoise(NOISE_T_C * noiseScale, NOISE_H_PCT * noiseScale, NOISE_P_PA * noiseScale);
+    BME280Device device(BME_ADDRESS, nullptr, nullptr);
+    device.setMode(mode, 125.0f, IIR_COEFF, normalSamples);
+    device.begin();
+    ModeResult r = {};
+    r.noiseScale = noiseScale;
+    const BME280Reading& boot = device.getLastReading();
+    r.bootValid = !isnan(boot.avgTemperature) && !isnan(boot.avgHumidity) && !isnan(boot.avgPressure);
+    double sumT = 0, sumH = 0, sumP = 0;
+    uint64_t busyUs = 0;
+    counter.reset();
+    for (uint32_t i = 0; i < readings; ++i) {
+        delay(READING_INTERVAL_MS);
+        uint64_t start = SimClock::nowMicros();
+        BME280Reading reading = device.readData();
+        busyUs += SimClock::nowMicros() - start;
+        sumT += (reading.avgTemperature - envT) * (reading.avgTemperature - envT);
+        sumH += (reading.avgHumidity - envH) * (reading.avgHumidity - envH);
+        sumP += (reading.avgPressure * 100.0 - envP) * (reading.avgPressure * 100.0 - envP);
+        r.readings++;
+    }
+    r.msPerReading = busyUs / 1000.0 / readings;
+    r.transfersPerReading = (double)counter.transfers / readings;
+    r.rmsT = sqrt(sumT / readings);
+    r.rmsH = sqrt(sumH / readings);
+    r.rmsP = sqrt(sumP / readings);
+    return r;
+}
+
+// Forced readings at one oversampling, timed in virtual time
+static TimingResult runTiming(uint8_t oversampling, uint32_t readings, CountingDevice& counter) {
+    BME280Device device(BME_ADDRESS, nullptr, nullptr);
+    device.setOversampling(oversampling);
+    device.begin();
+    TimingResult r = {};
+    r.oversampling = device.getOversampling();
+    r.typicalMs = BME280Device::typicalMeasurementUs(r.oversampling, r.oversampling, r.oversampling) / 1000.0;
+    r.maxMs = BME280Device::maxMeasurementUs(r.oversampling, r.oversampling, r.oversampling) / 1000.0;
+    r.valid = true;
+    uint64_t busyUs = 0;
+    counter.reset();
+    for (uint32_t i = 0; i < readings; ++i) {
+        uint64_t start = SimClock::nowMicros();
+        BME280Reading reading = device.readData();
+        busyUs += SimClock::nowMicros() - start;
+        r.valid &= !isnan(reading.avgTemperature) && !isnan(reading.avgHumidity) && !isnan(reading.avgPressure);
+    }
+    r.msPerReading = busyUs / 1000.0 / readings;
+    r.transfersPerReading = (double)counter.transfers / readings;
+    return r;
+}
+
+struct GroupResult {
+    int sensors;
+    double msPerPass;    // BME280Group::readData(), all sensors together
+    double serialMsPerPass; // One BME280Device::readData() after another
+    double medianT;
+    bool valid;
+};
+
+// Forced readings of the first n group sensors, pipelined and one by one
+static GroupResult runGroup(int n, uint32_t readings) {
+    std::vector<BME280Device*> devices;
+    BME280Group group;
+    for (int i = 0; i < n; ++i) {
+        SimWorld::bme(i).setEnvironment(GROUP_TEMPERATURES_C[i], 50.0f, 101325.0f);
+        devices.push_back(new BME280Device(GROUP_ADDRESSES[i], nullptr, nullptr));
+        devices.back()->begin(false);
+        group.add(devices.back());
+    }
+    GroupResult r = {};
+    r.sensors = n;
+    r.valid = true;
+    double sumT = 0;
+    uint64_t pipelinedUs = 0, serialUs = 0;
+    for (uint32_t i = 0; i < readings; ++i) {
+        uint64_t start = SimClock::nowMicros();
+        BME280Reading median = group.readData();
+        pipelinedUs += SimClock::nowMicros() - start;
+        r.valid &= median.valid && group.validCount() == n && !isnan(median.avgTemperature);
+        sumT += median.avgTemperature;
+        start = SimClock::nowMicros();
+        for (BME280Device* device : devices) device->readData();
+        serialUs += SimClock::nowMicros() - start;
+    }
+    for (BME280Device* device : devices) delete device;
+    r.msPerPass = pipelinedUs / 1000.0 / readings;
+    r.serialMsPerPass = serialUs / 1000.0 / readings;
+    r.medianT = sumT / readings;
+    return r;
+}
+
+// A reading during which the sensor NACKs every transfer has no valid
+// sample: it must end in ERROR with an invalid reading, and the next
+// reading once the bus is back must be valid again
+static bool runBusError() {
+    BME280Device device(BME_ADDRESS, nullptr, nullptr);
+    device.begin();
+    SimI2CBus::setMaxClock(BME_ADDRESS, BUS_HZ / 4);
+    BME280Reading failed = device.readData();
+    BME280Device::State failedState = device.getState();
+    SimI2CBus::setMaxClock(BME_ADDRESS, 0);
+    BME280Reading recovered = device.readData();
+    printf("bus_error,failed_valid=%d,state=%s,error=%s,recovered_valid=%d\n", failed.valid,
+           BME280Device::stateToString(failedState), device.getLastError().c_str(), recovered.valid);
+    return !failed.valid && failedState == BME280Device::ERROR && recovered.valid &&
+           device.getState() == BME280Device::READY;
+}
+
+int SimBmeCheck::run(const SimBmeCheckOptions& options) {
+    uint32_t iterations = options.iterations ? options.iterations : 1;
+    SimClock::setVirtual(true);
+    Wire.setClock(BUS_HZ);
+
+    bool ok = checkReferenceVector();
+    SimBME280& sensor = SimWorld::bme();
+    ok &= checkSweep(sensor.getCalibration());
+
+    // The device's first reading leaves a sample in the data registers for
+    // both paths to read
+    BME280Device device(BME_ADDRESS, nullptr, nullptr);
+    Adafruit_BME280 driver;
+    bool present = driver.begin(BME_ADDRESS);
+    present &= device.begin();
+    if (!check(present, "bus", "BME280 not found")) return 1;
+
+    CountingDevice counter(SimI2CBus::find(BME_ADDRESS));
+    SimI2CBus::attach(BME_ADDRESS, &counter);
+    PathResult adafruit = {}, burst = {};
+    float adafruitT = 0, adafruitH = 0, adafruitP = 0;
+    BME280Reading sample = {};
+    for (int path = 0; path < 2; ++path) {
+        counter.reset();
+        uint64_t start = SimClock::nowMicros();
+        for (uint32_t i = 0; i < iterations; ++i) {
+            if (path == 0) {
+                adafruitT = driver.readTemperature();
+                adafruitH = driver.readHumidity();
+                adafruitP = driver.readPressure() / 100.0f;
+            } else {
+                device.readMeasurement(sample);
+            }
+        }
+        PathResult& r = path == 0 ? adafruit : burst;
+        r.busUsPerSample = (double)(SimClock::nowMicros() - start) / iterations;
+        r.transfersPerSample = (double)counter.transfers / iterations;
+        r.txBytesPerSample = (double)counter.txBytes / iterations;
+        r.rxBytesPerSample = (double)counter.rxBytes / iterations;
+    }
+
+    const int scaleCount = sizeof(NOISE_SCALES) / sizeof(NOISE_SCALES[0]);
+    ModeResult forced[scaleCount], normal[scaleCount], single[scaleCount];
+    for (int n = 0; n < scaleCount; ++n) {
+        forced[n] = runMode(BME280Device::MODE_FORCED, BME280Device::SAMPLES, NOISE_SCALES[n], iterations, counter);
+        normal[n] = runMode(BME280Device::MODE_NORMAL, BME280Device::SAMPLES, NOISE_SCALES[n], iterations, counter);
+        single[n] = runMode(BME280Device::MODE_NORMAL, 1, NOISE_SCALES[n], iterations, counter);
+    }
+    SimWorld::bme().setNoise(NOISE_T_C, NOISE_H_PCT, NOISE_P_PA);
+    const int sweepCount = sizeof(OVERSAMPLING_SWEEP) / sizeof(OVERSAMPLING_SWEEP[0]);
+    TimingResult timing[sweepCount];
+    for (int n = 0; n < sweepCount; ++n) timing[n] = runTiming(OVERSAMPLING_SWEEP[n], iterations, counter);
+    SimI2CBus::attach(BME_ADDRESS, counter.inner);
+
+    // Put the other sensors on the bus unless NATIVE_SIM_BME280_COUNT did
+    const int groupMax = SimWorld::MAX_BME280;
+    bool attachedHere[groupMax] = {};
+    for (int i = 1; i < groupMax; ++i) {
+        if (!SimI2CBus::find(GROUP_ADDRESSES[i])) {
+            SimI2CBus::attach(GROUP_ADDRESSES[i], &SimWorld::bme(i));
+            attachedHere[i] = true;
+        }
+    }
+    GroupResult groups[groupMax];
+    for (int n = 0; n < groupMax; ++n) groups[n] = runGroup(n + 1, iterations);
+    for (int i = 1; i < groupMax; ++i) {
+        if (attachedHere[i]) SimI2CBus::detach(GROUP_ADDRESSES[i]);
+    }
+    SimWorld::bme().setEnvironment(21.0f, 50.0f, 101325.0f);
+    ok &= check(runBusError(), "bus error", "reading without a valid sample did not end in ERROR");
+
+    BME280Compensation comp = toCompensation(sensor.getCalibration());
+    std::vector<BME280Compensation::Raw> raws;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        BME280Compensation::Raw raw = { 480000 + (int32_t)i * 97, 330000 + (int32_t)i * 131, 28000 + (int32_t)i * 53 };
+        raws.push_back(raw);
+    }
+    // Best of a few interleaved rounds; the first is mostly warm-up
+    adafruit.cpuNsPerSample = burst.cpuNsPerSample = INFINITY;
+    for (uint32_t round = 0; round < CPU_ROUNDS; ++round) {
+        adafruit.cpuNsPerSample = fmin(adafruit.cpuNsPerSample, cpuNsPerSample(comp, raws, adafruitMaths));
+        burst.cpuNsPerSample = fmin(burst.cpuNsPerSample, cpuNsPerSample(comp, raws, burstMaths));
+    }
+
+    printf("path,samples,transfers_per_sample,tx_bytes_per_sample,rx_bytes_per_sample,bus_us_per_sample,cpu_ns_per_sample\n");
+    printf("adafruit,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n", iterations, adafruit.transfersPerSample, adafruit.txBytesPerSample,
+           adafruit.rxBytesPerSample, adafruit.busUsPerSample, adafruit.cpuNsPerSample);
+    printf("burst,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n", iterations, burst.transfersPerSample, burst.txBytesPerSample,
+           burst.rxBytesPerSample, burst.busUsPerSample, burst.cpuNsPerSample);
+    printf("saved,,%.1f,%.1f,%.1f,%.1f,%.1f\n", adafruit.transfersPerSample - burst.transfersPerSample,
+           adafruit.txBytesPerSample - burst.txBytesPerSample, adafruit.rxBytesPerSample - burst.rxBytesPerSample,
+           adafruit.busUsPerSample - burst.busUsPerSample, adafruit.cpuNsPerSample - burst.cpuNsPerSample);
+
+    printf("mode,noise_scale,readings,ms_per_reading,transfers_per_reading,rms_t_c,rms_h_pct,rms_p_pa\n");
+    for (int n = 0; n < scaleCount; ++n) {
+        const ModeResult* rows[] = { &forced[n], &normal[n], &single[n] };
+        const char* names[] = { "forced", "normal", "normal_1" };
+        for (int m = 0; m < 3; ++m) {
+            const ModeResult& r = *rows[m];
+            printf("%s,%.0f,%u,%.3f,%.1f,%.4f,%.4f,%.3f\n", names[m], r.noiseScale, r.readings,
+                   r.msPerReading, r.transfersPerReading, r.rmsT, r.rmsH, r.rmsP);
+        }
+    }
+
+    printf("oversampling,typical_ms,max_ms,ms_per_reading,transfers_per_reading\n");
+    for (int n = 0; n < sweepCount; ++n) {
+        const TimingResult& r = timing[n];
+        printf("%u,%.2f,%.2f,%.3f,%.1f\n", r.oversampling, r.typicalMs, r.maxMs, r.msPerReading, r.transfersPerReading);
+    }
+
+    printf("sensors,readings,ms_per_pass,serial_ms_per_pass,median_t_c\n");
+    for (int n = 0; n < groupMax; ++n) {
+        const GroupResult& r = groups[n];
+        printf("%d,%u,%.3f,%.3f,%.3f\n", r.sensors, iterations, r.msPerPass, r.serialMsPerPass, r.medianT);
+    }
+
+    ok &= check(sample.temperature == adafruitT && sample.humidity == adafruitH &&
+                fabsf(sample.pressure - adafruitP) < 0.001f,
+                "bus", "burst sample differs from the driver's");
+    ok &= check(burst.transfersPerSample < adafruit.transfersPerSample && burst.busUsPerSample < adafruit.busUsPerSample,
+                "bus", "burst read is no cheaper than the driver's");
+    for (int n = 0; n < scaleCount; ++n) {
+        // A normal-mode reading averages ten measurements, like forced mode,
+        // so it must be no noisier on any quantity. An RMS over N readings
+        // is good to about 1/sqrt(2N), so allow 2.5 of that (1.25x at the
+        // default 50); temperature also gets half a 0.01 degC count.
+        const ModeResult& f = forced[n];
+        const ModeResult& r = normal[n];
+        double spread = 1.0 + 2.5 / sqrt(2.0 * iterations);
+        ok &= check(r.rmsT <= f.rmsT * spread + FLOOR_T_C && r.rmsH <= f.rmsH * spread && r.rmsP <= f.rmsP * spread,
+                    "normal", "noisier than forced mode");
+        ok &= check(r.transfersPerReading <= 2.0 * BME280Device::SAMPLES && r.transfersPerReading < f.transfersPerReading,
+                    "normal", "more than one burst per sample");
+        // One sample is the fast path and the trade-off: T and P are the IIR
+        // filter alone (one x16 sample's noise times sqrt(1 / (2c - 1))) and
+        // humidity, which the chip does not filter, is one x16 sample
+        const ModeResult& s = single[n];
+        double iirGain = sqrt(1.0 / (2 * IIR_COEFF - 1));
+        double sampleT = NOISE_T_C * NOISE_SCALES[n] / sqrt((double)OVERSAMPLING);
+        double sampleP = NOISE_P_PA * NOISE_SCALES[n] / sqrt((double)OVERSAMPLING);
+        double sampleH = NOISE_H_PCT * NOISE_SCALES[n] / sqrt((double)OVERSAMPLING);
+        ok &= check(s.rmsT <= fmax(sampleT * iirGain * 1.5, FLOOR_T_C) &&
+                    s.rmsP <= fmax(sampleP * iirGain * 1.5, FLOOR_P_PA), "normal_1",
+                    "temperature or pressure noisier than the IIR filter allows");
+        ok &= check(s.rmsH <= sampleH * 1.25 + 0.001, "normal_1", "humidity noisier than one x16 sample");
+        ok &= check(s.transfersPerReading <= 2.0 && s.msPerReading < 1.0, "normal_1", "reading is not a single burst");
+        ok &= check(f.bootValid && r.bootValid && s.bootValid, "modes", "boot reading is NAN");
+    }
+    for (int n = 0; n < sweepCount; ++n) {
+        // The wait follows the oversampling, and ends on the measuring bit
+        // before the maximum (the sim converts in the typical time); a
+        // couple of milliseconds per conversion cover rounding and the bus
+        const TimingResult& r = timing[n];
+        ok &= check(r.valid, "timing", "reading is NAN");
+        ok &= check(r.msPerReading <= READING_SAMPLES * (r.typicalMs + 3.0), "timing",
+                    "conversions not ended by the measuring bit");
+        ok &= check(n == 0 || r.msPerReading > timing[n - 1].msPerReading, "timing",
+                    "reading time does not grow with oversampling");
+    }
+    for (int n = 0; n < groupMax; ++n) {
+        // Every sensor converts at once, so a pass costs one sensor's
+        // reading plus the other sensors' bus traffic; the median of three
+        // is the middle sensor, the hot one ignored
+        const GroupResult& r = groups[n];
+        float middle = n == 1 ? (GROUP_TEMPERATURES_C[0] + GROUP_TEMPERATURES_C[1]) / 2.0f : GROUP_TEMPERATURES_C[n == 0 ? 0 : 1];
+        ok &= check(r.valid, "group", "a sensor's reading is missing or NAN");
+        ok &= check(r.msPerPass <= groups[0].msPerPass * 1.1, "group", "more sensors take longer than one");
+        ok &= check(fabs(r.medianT - middle) < 0.05, "group", "median is off the middle sensor");
+    }
+    return ok ? 0 : 1;
+}
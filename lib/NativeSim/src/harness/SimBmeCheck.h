@@ -0,0 +1,52 @@
+#ifndef SIM_BME_CHECK_H
+#define SIM_BME_CHECK_H
+
+#include <stdint.h>
+
+// Checks BME280Compensation and the burst sample read in BME280Device.
+//
+// The integer formulas are run on the worked example in Bosch's BMP280
+// datasheet (section 8.1 there; the BME280 shares its temperature and
+// pressure trimming and formulas): t_fine must be 128422 and T 25.08 degC
+// exactly, and pressure within 0.1 Pa of 100653.27 Pa. Humidity has no
+// published vector, so a sweep of ADC codes through the simulated sensor's
+// trimming checks all three quantities against the datasheet's double
+// precision formulas instead, and bit for bit against the sim's own copy
+// of the integer code.
+//
+// Then the same sample is read from the simulated BME280 both ways, the
+// Adafruit driver's readTemperature/readHumidity/readPressure and
+// BME280Device::readMeasurement(), printing per sample the I2C
+// transactions and bytes (as seen by the device), bus time at 400 kHz, and
+// host CPU time of the compensation maths alone (reported only; it is too
+// noisy to check). Exits 1 on a mismatch or when the burst is not cheaper
+// on the bus.
+//
+// Last, BME280Device takes readings a minute apart in forced mode and in
+// normal mode (IIR 16, 125 ms standby) with ten samples and with one, at
+// the simulated part's noise and at ten times it, printing time and
+// transfers per reading and the RMS error of each quantity. With ten
+// samples normal mode must be no noisier than forced mode on any quantity,
+// within the spread of the estimate, and use fewer transfers. With one it
+// must read in a single burst, with temperature and pressure within 1.5x
+// of what the IIR filter alone gives and humidity, which the chip does not
+// filter, within one x16 sample's noise.
+// Then forced readings are timed at each oversampling from x1 to x16:
+// reading time must grow with it and stay within the typical conversion
+// times, i.e. the measuring bit must end each wait. Finally one,
+// two and three sensors are read through a BME280Group and one by one: a
+// pass must cost about one sensor's time, and the median must ignore the
+// third sensor, which reads hot. A reading during which the sensor NACKs
+// must end in ERROR with an invalid reading, and the next one must be
+// valid again. No firmware boot.
+struct SimBmeCheckOptions {
+    uint32_t iterations = 50; // Samples read per path; the CPU timing runs 2000x as many
+};
+
+class SimBmeCheck {
+public:
+    // Returns the process exit code: 0 all checks passed, 1 a check failed
+    static int run(const SimBmeCheckOptions& options);
+};
+
+#endif // SIM_BME_CHECK_H
@@ -0,0 +1,55 @@
+#include "harness/SimBoot.h"
+#include "sim/SimClock.h"
+#include "sim/SimScheduler.h"
+#include "sim/SimWorld.h"
+#include "system/SystemManager.h"
+#include "system/MqttManager.h"
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <PubSubClient.h>
+#include <WiFi.h>
+#include <string>
+#include <vector>
+
+// Defined in src/main.cpp.
+extern SystemManager systemManager;
+extern MqttManager mqttManager;
+
+void setup();
+void loop();
+
+void SimBoot::runLoops(int count) {
+    for (int i = 0; i < count; ++i) {
+        SimWorld::tick();
+        loop();
+        SimScheduler::afterLoop();
+    }
+}
+
+bool SimBoot::waitFor(bool (*condition)(), int maxLoops) {
+    for (int i = 0; i < maxLoops; i += 50) {
+        if (condition()) return true;
+        runLoops(50);
+    }
+    return condition();
+}
+
+bool SimBoot::startFirmware(bool verbose) {
+    SimClock::setVirtual(true);
+    Serial.simSetEcho(verbose);
+    SimScheduler::setMaxStepMicros(50000);
+
+    setup();
+    // The web server starts once the boot-time sensor readings are in
+    return waitFor([] { return AsyncWebServer::simRequest(HTTP_GET, "/api/status").code == 200; }, 200000);
+}
+
+void SimBoot::connectMqtt(const char* deviceName) {
+    WiFi.begin(deviceName);
+    SimMqttBroker::setAvailable(true);
+    SimMqttBroker::setRecording(false);
+    waitFor([] { return WiFi.isConnected(); }, 20000);
+    std::vector<std::string> relayNames = { "Zone 1", "Zone 2", "Zone 3", "Zone 4" };
+    mqttManager.begin(deviceName, relayNames, &systemManager.getConfigManager());
+    mqttManager.setInitialized(true);
+}
@@ -0,0 +1,18 @@
+#ifndef SIM_BOOT_H
+#define SIM_BOOT_H
+
+// Shared start-up for the benchmark harnesses: boots the firmware in
+// virtual time until the web server answers, and brings up WiFi plus the
+// simulated MQTT broker so publish paths run end to end.
+class SimBoot {
+public:
+    // setup() and loop() until /api/status returns 200. False on timeout.
+    static bool startFirmware(bool verbose);
+    // Station connection, broker and MqttManager discovery, all done once
+    static void connectMqtt(const char* deviceName);
+
+    static void runLoops(int count);
+    static bool waitFor(bool (*condition)(), int maxLoops);
+};
+
+#endif // SIM_BOOT_H
@@ -0,0 +1,22 @@
+#ifndef SIM_CHECK_H
+#define SIM_CHECK_H
+
+#include <stdio.h>
+
+// Shared pass/fail reporting for the check harnesses. Each keeps one at
+// file scope named check, so call sites read check(ok, what, detail); a
+// failure prints "<harness>: <what>: <detail>" on stderr and ok is passed
+// through, so a run can combine every check and still list each failure.
+class SimCheck {
+public:
+    explicit SimCheck(const char* harness) : harness(harness) {}
+    bool operator()(bool ok, const char* what, const char* detail) const {
+        if (!ok) fprintf(stderr, "%s: %s: %s\n", harness, what, detail);
+        return ok;
+    }
+
+private:
+    const char* harness;
+};
+
+#endif // SIM_CHECK_H
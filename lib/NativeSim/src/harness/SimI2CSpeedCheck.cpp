@@ -0,0 +1,183 @@
+#include "harness/SimI2CSpeedCheck.h"
+#include "harness/SimCheck.h"
+#include "sim/SimClock.h"
+#include "sim/SimI2CBus.h"
+#include "sim/SimWorld.h"
+#include "system/ADS1115Manager.h"
+#include "system/I2CManager.h"
+#include "system/I2CTracer.h"
+#include <Arduino.h>
+#include <Wire.h>
+#include <stdint.h>
+
+static const uint32_t SPEEDS[] = { 100000, 400000, 1000000 };
+static const uint8_t RTC_ADDRESS = 0x68;
+static const uint8_t BME_ADDRESS = 0x76;
+static const uint8_t ADS_ADDRESS = 0x48;
+static const size_t ADS_BURST_SAMPLES = 32;
+
+enum Operation { OP_RTC_TIME, OP_BME_BURST, OP_ADS_READ, OP_ADS_BURST, OP_COUNT };
+static const char* const OP_NAMES[OP_COUNT] = { "rtc_time", "bme_burst", "ads_read", "ads_burst32" };
+static const uint8_t OP_ADDRESSES[OP_COUNT] = { RTC_ADDRESS, BME_ADDRESS, ADS_ADDRESS, ADS_ADDRESS };
+
+struct OpResult {
+    uint32_t ops;
+    uint32_t failures;
+    double usPerOp;
+    double busUsPerOp;
+};
+
+// Pointer write, repeated START and a block read, as the drivers do
+static bool readBlock(I2CTracer& tracer, uint8_t address, uint8_t reg, uint8_t len, const char* label) {
+    I2CTracer::Access access(&tracer, nullptr, address, label);
+    uint8_t buffer[8];
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    access.addTransaction(1, 0);
+    if (Wire.endTransmission(false) != 0) {
+        access.fail();
+        return false;
+    }
+    uint8_t received = Wire.requestFrom(address, len);
+    access.addTransaction(0, received);
+    for (uint8_t i = 0; i < received && i < sizeof(buffer); ++i) buffer[i] = (uint8_t)Wire.read();
+    if (received != len) access.fail();
+    return received == len;
+}
+
+// At the current bus speed; -1 if the read fails
+static int32_t readLoThresh() {
+    Wire.beginTransmission(ADS_ADDRESS);
+    Wire.write(0x02);
+    if (Wire.endTransmission(false) != 0 || Wire.requestFrom(ADS_ADDRESS, (uint8_t)2) != 2) return -1;
+    int32_t hi = Wire.read();
+    return (hi << 8) | Wire.read();
+}
+
+static bool runOp(Operation op, ADS1115Manager& ads, I2CTracer& tracer) {
+    switch (op) {
+        case OP_RTC_TIME:
+            return readBlock(tracer, RTC_ADDRESS, 0x00, 7, "rtc.time");
+        case OP_BME_BURST:
+            return readBlock(tracer, BME_ADDRESS, 0xF7, 8, "bme.burst");
+        case OP_ADS_READ: {
+            uint32_t errors = 0;
+            const I2CTracer::DeviceStats* stats = tracer.findDevice(ADS_ADDRESS);
+            if (stats) errors = stats->errors;
+            ads.readRaw(0, ADS1115Manager::GAIN_ONE, 100);
+            stats = tracer.findDevice(ADS_ADDRESS);
+            return stats && stats->errors == errors;
+        }
+        case OP_ADS_BURST: {
+            int16_t codes[ADS_BURST_SAMPLES];
+            return ads.readBurst(0, ADS1115Manager::GAIN_ONE, ADS1115Manager::SPS_860, codes, ADS_BURST_SAMPLES) ==
+                   ADS_BURST_SAMPLES;
+        }
+        default:
+            return false;
+    }
+}
+
+static OpResult timeOp(Operation op, uint32_t hz, uint32_t iterations, ADS1115Manager& ads, I2CTracer& tracer) {
+    Wire.setClock(hz);
+    tracer.setClockHz(hz);
+    tracer.reset();
+    // Let a conversion left by the previous operation finish
+    delay(2);
+    SimI2CBus::tickAll();
+    OpResult r = {};
+    uint64_t start = SimClock::nowMicros();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        r.ops++;
+        if (!runOp(op, ads, tracer)) r.failures++;
+    }
+    uint64_t elapsed = SimClock::nowMicros() - start;
+    const I2CTracer::DeviceStats* bus = tracer.findDevice(OP_ADDRESSES[op]);
+    r.usPerOp = (double)elapsed / iterations;
+    // ALERT/RDY reads release the bus while converting, so held time is
+    // the transfers; for the others it is the whole operation
+    r.busUsPerOp = bus ? (double)bus->heldUs / iterations : 0;
+    return r;
+}
+
+static const SimCheck check("i2c-speed-check");
+
+int SimI2CSpeedCheck::run(const SimI2CSpeedCheckOptions& options) {
+    uint32_t iterations = options.iterations ? options.iterations : 1;
+    SimClock::setVirtual(true);
+
+    static I2CTracer tracer;
+    tracer.begin(Wire.getClock());
+    ADS1115Manager ads;
+    ads.begin(nullptr, ADS_ADDRESS, &tracer, SimWorld::ADS_ALERT_GPIO);
+
+    const int speedCount = sizeof(SPEEDS) / sizeof(SPEEDS[0]);
+    OpResult results[speedCount][OP_COUNT];
+    printf("speed_hz,operation,ops,failures,us_per_op,bus_us_per_op\n");
+    for (int s = 0; s < speedCount; ++s) {
+        for (int op = 0; op < OP_COUNT; ++op) {
+            const OpResult& r = results[s][op] = timeOp((Operation)op, SPEEDS[s], iterations, ads, tracer);
+            printf("%u,%s,%u,%u,%.1f,%.1f\n", SPEEDS[s], OP_NAMES[op], r.ops, r.failures, r.usPerOp, r.busUsPerOp);
+        }
+    }
+    detachInterrupt(SimWorld::ADS_ALERT_GPIO);
+
+    bool ok = true;
+    for (int s = 0; s < speedCount; ++s) {
+        for (int op = 0; op < OP_COUNT; ++op) {
+            bool supported = SimI2CBus::supportsClock(OP_ADDRESSES[op], SPEEDS[s]);
+            const OpResult& r = results[s][op];
+            ok &= check(supported ? r.failures == 0 : r.failures == r.ops, OP_NAMES[op],
+                        supported ? "failed at a supported speed" : "worked above the device's limit");
+        }
+    }
+    for (int op = 0; op < OP_COUNT; ++op) {
+        ok &= check(results[1][op].busUsPerOp < results[0][op].busUsPerOp, OP_NAMES[op],
+                    "no less bus time at 400 kHz than at 100 kHz");
+    }
+
+    I2CManager i2c;
+    Wire.setClock(I2CManager::STANDARD_FREQUENCY);
+    i2c.autoDetectDevices();
+    uint32_t fast = i2c.negotiateFrequency(400000);
+    uint8_t fastFallback = i2c.getSpeedFallbackDevice();
+    uint32_t plus = i2c.negotiateFrequency(1000000);
+    uint8_t plusFallback = i2c.getSpeedFallbackDevice();
+    SimI2CBus::setMaxClock(RTC_ADDRESS, 100000);
+    uint32_t slowRtc = i2c.negotiateFrequency(1000000);
+    SimI2CBus::setMaxClock(RTC_ADDRESS, 400000);
+    printf("requested_hz,negotiated_hz,fallback_device\n");
+    printf("400000,%u,0x%02X\n", fast, fastFallback);
+    printf("1000000,%u,0x%02X\n", plus, plusFallback);
+    uint8_t slowRtcFallback = i2c.getSpeedFallbackDevice();
+    printf("1000000 (rtc<=100k),%u,0x%02X\n", slowRtc, slowRtcFallback);
+    ok &= check(fast == 400000 && fastFallback == 0, "negotiate", "400 kHz did not hold");
+    ok &= check(plus == 400000 && plusFallback == 0x57, "negotiate", "1 MHz did not fall back to 400 kHz");
+    ok &= check(slowRtc == 100000 && slowRtcFallback == RTC_ADDRESS, "negotiate", "did not step down to 100 kHz for a slow RTC");
+    ok &= check(Wire.getClock() == slowRtc, "negotiate", "bus not left at the negotiated speed");
+
+    // Parts that ACK and read all ones above their limit instead of NACKing
+    int32_t loThreshBefore = readLoThresh();
+    SimI2CBus::setOverclockFloats(ADS_ADDRESS, true);
+    SimI2CBus::setMaxClock(ADS_ADDRESS, 400000);
+    uint32_t floatingAds = i2c.negotiateFrequency(1000000);
+    uint8_t floatingAdsFallback = i2c.getSpeedFallbackDevice();
+    int32_t loThreshAfter = readLoThresh();
+    SimI2CBus::setMaxClock(ADS_ADDRESS, 0);
+    SimI2CBus::setOverclockFloats(ADS_ADDRESS, false);
+    SimI2CBus::setOverclockFloats(RTC_ADDRESS, true);
+    SimI2CBus::setMaxClock(RTC_ADDRESS, 100000);
+    uint32_t floatingRtc = i2c.negotiateFrequency(1000000);
+    uint8_t floatingRtcFallback = i2c.getSpeedFallbackDevice();
+    SimI2CBus::setMaxClock(RTC_ADDRESS, 400000);
+    SimI2CBus::setOverclockFloats(RTC_ADDRESS, false);
+    printf("1000000 (ads<=400k reads 0xFF),%u,0x%02X\n", floatingAds, floatingAdsFallback);
+    printf("1000000 (rtc<=100k reads 0xFF),%u,0x%02X\n", floatingRtc, floatingRtcFallback);
+    ok &= check(floatingAds == 400000 && floatingAdsFallback == ADS_ADDRESS, "negotiate",
+                "an ADS1115 reading all ones passed its self-test");
+    ok &= check(loThreshBefore >= 0 && loThreshAfter == loThreshBefore, "negotiate",
+                "the ADS1115 self-test did not restore Lo_thresh");
+    ok &= check(floatingRtc == 100000 && floatingRtcFallback == RTC_ADDRESS, "negotiate",
+                "a DS3231 reading all ones passed its self-test");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#ifndef SIM_I2C_SPEED_CHECK_H
+#define SIM_I2C_SPEED_CHECK_H
+
+#include <stdint.h>
+
+// Times the I2C operations the firmware repeats at 100 kHz, 400 kHz and
+// 1 MHz in virtual time: an RTC time read (7 bytes from 0x00), a BME280
+// data burst (8 bytes from 0xF7), an ADS1115 single-shot read on
+// ALERT/RDY and a 32-sample ADS1115 burst. Prints per speed and operation
+// the latency and the bus time per operation as CSV; for the ADS1115 the
+// latency is mostly conversion time, so the bus column is the one that
+// moves. The simulated DS3231 and its EEPROM stop at 400 kHz, so their
+// operations fail at 1 MHz.
+//
+// Then checks I2CManager::negotiateFrequency() on the same bus: 400 kHz
+// must hold, 1 MHz must fall back to 400 kHz naming 0x57, and with the
+// DS3231 limited to 100 kHz a 1 MHz request must end at 100 kHz naming
+// 0x68. The same has to hold when the ADS1115 (limited to 400 kHz) or the
+// DS3231 ACKs above its limit and reads all ones, and the self-test must
+// leave the ADS1115's Lo_thresh as it found it. Exits 1 when a
+// negotiation ends elsewhere, an operation fails on a device that
+// supports the speed, or 400 kHz is not faster on the bus than 100 kHz.
+// No firmware boot.
+struct SimI2CSpeedCheckOptions {
+    uint32_t iterations = 50; // Per operation and speed
+};
+
+class SimI2CSpeedCheck {
+public:
+    // Returns the process exit code: 0 all checks passed, 1 a check failed
+    static int run(const SimI2CSpeedCheckOptions& options);
+};
+
+#endif // SIM_I2C_SPEED_CHECK_H
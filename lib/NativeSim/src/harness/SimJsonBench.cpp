@@ -0,0 +1,121 @@
+#include "harness/SimJsonBench.h"
+#include "harness/SimBoot.h"
+#include "system/SystemManager.h"
+#include "system/DashboardManager.h"
+#include "system/MqttManager.h"
+#include "devices/IrrigationManager.h"
+#include "diagnostics/AllocationTracker.h"
+#include <Arduino.h>
+#include <PubSubClient.h>
+#include <time.h>
+
+// Defined in src/main.cpp.
+extern SystemManager systemManager;
+extern MqttManager mqttManager;
+extern IrrigationManager irrigationManager;
+extern DashboardManager* dashboard;
+
+struct JsonBench {
+    const char* name;
+    void (*run)();
+    size_t (*outputBytes)(); // Called once, outside the timed loop
+};
+
+// MQTT payloads PubSubClient refused in the last publishedBytes() call
+static unsigned long lastOversize = 0;
+
+static size_t printedSize(cJSON* json) {
+    char* text = cJSON_PrintUnformatted(json);
+    size_t len = text ? strlen(text) : 0;
+    cJSON_free(text);
+    cJSON_Delete(json);
+    return len;
+}
+
+// Payload bytes one call hands to PubSubClient, including payloads the
+// client refuses for exceeding its buffer
+static size_t publishedBytes(void (*publish)()) {
+    SimMqttBroker::setRecording(true);
+    SimMqttBroker::clearPublished();
+    unsigned long oversizeBefore = SimMqttBroker::oversizeCount();
+    unsigned long oversizeBytesBefore = SimMqttBroker::oversizeBytes();
+    publish();
+    size_t bytes = SimMqttBroker::oversizeBytes() - oversizeBytesBefore;
+    for (const SimMqttBroker::Message& m : SimMqttBroker::published()) bytes += m.payload.size();
+    lastOversize = SimMqttBroker::oversizeCount() - oversizeBefore;
+    SimMqttBroker::clearPublished();
+    SimMqttBroker::setRecording(false);
+    return bytes;
+}
+
+#define MQTT_BENCH(method) \
+    { "MqttManager::" #method, [] { mqttManager.method(); }, [] { return publishedBytes([] { mqttManager.method(); }); } }
+
+static const JsonBench BENCHES[] = {
+    { "DashboardManager::getStatusJson",
+      [] { cJSON_Delete(dashboard->getStatusJson()); },
+      [] { return printedSize(dashboard->getStatusJson()); } },
+    { "DashboardManager::getStatusString",
+      [] { String s = dashboard->getStatusString(); },
+      [] { return (size_t)dashboard->getStatusString().length(); } },
+    { "IrrigationManager::addStatusToJson",
+      [] { cJSON* root = cJSON_CreateObject(); irrigationManager.addStatusToJson(root); cJSON_Delete(root); },
+      [] { cJSON* root = cJSON_CreateObject(); irrigationManager.addStatusToJson(root); return printedSize(root); } },
+    { "I2CManager::getI2CInfoJson",
+      [] { cJSON_Delete(systemManager.getI2CManager().getI2CInfoJson()); },
+      [] { return printedSize(systemManager.getI2CManager().getI2CInfoJson()); } },
+    MQTT_BENCH(publishDiscovery),
+    MQTT_BENCH(publishDiscoveryForBME280Temperature),
+    MQTT_BENCH(publishDiscoveryForBME280Humidity),
+    MQTT_BENCH(publishDiscoveryForBME280Pressure),
+    MQTT_BENCH(publishDiscoveryForBME280HeatIndex),
+    MQTT_BENCH(publishDiscoveryForBME280DewPoint),
+    MQTT_BENCH(publishDiscoveryForSoilMoisture),
+    MQTT_BENCH(publishDiscoveryForMQ135AirQuality),
+};
+
+static uint64_t threadCpuNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int SimJsonBench::run(const SimJsonBenchOptions& options) {
+    if (!SimBoot::startFirmware(options.verbose)) {
+        fprintf(stderr, "json-bench: web server did not start\n");
+        return 2;
+    }
+    if (!dashboard) {
+        fprintf(stderr, "json-bench: dashboard not created\n");
+        return 2;
+    }
+    SimBoot::connectMqtt("json_bench");
+
+    uint32_t iterations = options.iterations ? options.iterations : 1;
+    // Allocations are counted on a separate, shorter pass so the tracker's
+    // own bookkeeping stays out of the timings.
+    uint32_t countedIterations = iterations < 100 ? iterations : 100;
+    printf("operation,iterations,ns_per_op,output_bytes,allocs_per_op,alloc_bytes_per_op,mqtt_oversize\n");
+    for (const JsonBench& bench : BENCHES) {
+        lastOversize = 0;
+        size_t bytes = bench.outputBytes();
+        for (int i = 0; i < 10; ++i) bench.run(); // Warm caches and lazy state
+
+        uint64_t start = threadCpuNs();
+        for (uint32_t i = 0; i < iterations; ++i) bench.run();
+        uint64_t elapsed = threadCpuNs() - start;
+
+        AllocationTracker::reset();
+        for (uint32_t i = 0; i < countedIterations; ++i) {
+            AllocationTracker::Scope scope(bench.name);
+            bench.run();
+        }
+        const AllocationTracker::Operation* op = AllocationTracker::findOperation(bench.name);
+        double allocs = op && op->calls ? (double)op->allocs / op->calls : 0;
+        double allocBytes = op && op->calls ? (double)op->bytes / op->calls : 0;
+
+        printf("%s,%u,%.0f,%zu,%.1f,%.1f,%lu\n", bench.name, iterations, (double)elapsed / iterations, bytes,
+               allocs, allocBytes, lastOversize);
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+#ifndef SIM_JSON_BENCH_H
+#define SIM_JSON_BENCH_H
+
+#include <stdint.h>
+
+// Host benchmark for the JSON builders behind /api/status and Home
+// Assistant discovery: DashboardManager::getStatusJson/getStatusString,
+// IrrigationManager::addStatusToJson, I2CManager::getI2CInfoJson and the
+// MqttManager publishDiscovery* paths. Boots the firmware like
+// SimAllocBench, then prints host CPU ns per call, output bytes and heap
+// allocations per call as CSV. Timings are for the host, so compare runs
+// on the same machine; allocation counts and sizes carry over to the board.
+// mqtt_oversize counts payloads PubSubClient would drop for exceeding its
+// buffer (256 bytes unless setBufferSize() is called).
+struct SimJsonBenchOptions {
+    uint32_t iterations = 2000;
+    bool verbose = false;
+};
+
+class SimJsonBench {
+public:
+    // Returns the process exit code: 0 done, 2 setup failure
+    static int run(const SimJsonBenchOptions& options);
+};
+
+#endif // SIM_JSON_BENCH_H
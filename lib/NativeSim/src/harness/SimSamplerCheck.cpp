@@ -0,0 +1,238 @@
+#include "harness/SimSamplerCheck.h"
+#include "harness/SimCheck.h"
+#include "devices/SoilMoistureSensor.h"
+#include "sim/SimClock.h"
+#include "sim/SimWorld.h"
+#include "system/ADS1115Manager.h"
+#include "system/ADS1115Sampler.h"
+#include "system/I2CTracer.h"
+#include <Arduino.h>
+#include <Wire.h>
+#include <math.h>
+
+static const uint8_t ADS_ADDRESS = 0x48;
+static const uint8_t SIDE_CHANNEL = 1; // MQ135 input
+static const ADS1115Manager::Gain SIDE_GAIN = ADS1115Manager::GAIN_TWOTHIRDS;
+static const size_t WINDOW = 32;
+static const float TOLERANCE_VOLTS = 0.010f;
+// Give up on a reading that has not completed by then
+static const uint64_t READING_LIMIT_US = 2000000;
+
+struct SamplerResult {
+    uint32_t readings;
+    uint32_t badReadings;
+    uint32_t maxCallUs;
+    double iterationsPerReading;
+    double msPerReading;
+    float maxErrorVolts;
+    uint32_t sideWindows;
+    uint32_t sideBad;
+};
+
+static float meanVolts(const int16_t* codes, size_t n, ADS1115Manager::Gain gain) {
+    float sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += ADS1115Manager::codeToVolts(codes[i], gain);
+    return n ? sum / n : 0;
+}
+
+static SamplerResult runMode(ADS1115Manager& ads, ADS1115Sampler* sampler, uint32_t readings) {
+    SimADS1115& chip = SimWorld::ads();
+    SoilMoistureSensor soil;
+    soil.begin(&ads);
+    soil.setStabilisationTimeSec(0);
+    if (sampler) soil.setSampler(sampler);
+    int sideId = sampler ? sampler->addChannel(SIDE_CHANNEL, SIDE_GAIN) : -1;
+
+    SamplerResult r = {};
+    uint64_t iterations = 0;
+    uint64_t totalUs = 0;
+    for (uint32_t n = 0; n < readings; ++n) {
+        soil.beginStabilisation();
+        if (sampler) sampler->request(sideId, WINDOW);
+        uint64_t start = SimClock::nowMicros();
+        bool done = false;
+        while (!done && SimClock::nowMicros() - start < READING_LIMIT_US) {
+            // What loop() does in SOIL_STABILISING
+            uint64_t callStart = SimClock::nowMicros();
+            if (soil.readyForReading()) {
+                soil.takeReading();
+                done = true;
+            }
+            uint32_t callUs = (uint32_t)(SimClock::nowMicros() - callStart);
+            if (callUs > r.maxCallUs) r.maxCallUs = callUs;
+            iterations++;
+            if (!done) delay(1);
+        }
+        totalUs += SimClock::nowMicros() - start;
+        r.readings++;
+        float error = fabsf(soil.getLastReading().avgVoltage - chip.getInputVoltage(0));
+        if (error > r.maxErrorVolts) r.maxErrorVolts = error;
+        if (!done || error > TOLERANCE_VOLTS) r.badReadings++;
+
+        if (sampler) {
+            uint64_t waitStart = SimClock::nowMicros();
+            while (sampler->available(sideId) < WINDOW && SimClock::nowMicros() - waitStart < READING_LIMIT_US) delay(1);
+            int16_t codes[WINDOW];
+            size_t got = sampler->readWindow(sideId, codes, WINDOW);
+            r.sideWindows++;
+            if (got != WINDOW || fabsf(meanVolts(codes, got, SIDE_GAIN) - chip.getInputVoltage(SIDE_CHANNEL)) > TOLERANCE_VOLTS) {
+                r.sideBad++;
+            }
+        }
+    }
+    r.iterationsPerReading = readings ? (double)iterations / readings : 0;
+    r.msPerReading = readings ? totalUs / 1000.0 / readings : 0;
+    return r;
+}
+
+// Holds the sampler task at the write that ends its first burst (back to
+// single-shot), after the burst was read and before it is pushed, until
+// the loop side has replaced the request
+struct BurstEndGate {
+    SemaphoreHandle_t reached = xSemaphoreCreateBinary();
+    SemaphoreHandle_t release = xSemaphoreCreateBinary();
+    bool armed = false;
+
+    static void onConfig(void* arg, uint16_t config) {
+        BurstEndGate* gate = static_cast<BurstEndGate*>(arg);
+        if (!gate->armed || !(config & 0x0100)) return;
+        gate->armed = false;
+        xSemaphoreGive(gate->reached);
+        xSemaphoreTake(gate->release, portMAX_DELAY);
+    }
+};
+
+// Replaces each request while its first chunk is in flight, with the input
+// moved in between; the window must hold only samples of the new input.
+// Lands the new request() either inside the burst or, with atBurstEnd,
+// once the chunk has been read and not yet pushed.
+static uint32_t runReplace(ADS1115Sampler& sampler, int id, uint32_t windows, bool atBurstEnd) {
+    SimADS1115& chip = SimWorld::ads();
+    static BurstEndGate gate;
+    if (atBurstEnd) chip.setConfigHook(BurstEndGate::onConfig, &gate);
+    float before = chip.getInputVoltage(SIDE_CHANNEL);
+    uint32_t bad = 0;
+    for (uint32_t n = 0; n < windows; ++n) {
+        chip.setInputVoltage(SIDE_CHANNEL, 1.0f);
+        gate.armed = atBurstEnd;
+        sampler.request(id, WINDOW);
+        if (atBurstEnd) xSemaphoreTake(gate.reached, portMAX_DELAY);
+        else delay(2); // Inside the first 8-sample burst at 860 SPS
+        chip.setInputVoltage(SIDE_CHANNEL, 2.0f);
+        // Same count, so a count-down meant for the old request would fit
+        sampler.request(id, WINDOW);
+        if (atBurstEnd) xSemaphoreGive(gate.release);
+        uint64_t waitStart = SimClock::nowMicros();
+        while (sampler.available(id) < WINDOW && SimClock::nowMicros() - waitStart < READING_LIMIT_US) delay(1);
+        int16_t codes[WINDOW];
+        size_t got = sampler.readWindow(id, codes, WINDOW);
+        bool stale = false;
+        for (size_t i = 0; i < got; ++i) {
+            if (fabsf(ADS1115Manager::codeToVolts(codes[i], SIDE_GAIN) - 2.0f) > TOLERANCE_VOLTS) stale = true;
+        }
+        if (got != WINDOW || stale) bad++;
+    }
+    chip.setConfigHook(nullptr, nullptr);
+    chip.setInputVoltage(SIDE_CHANNEL, before);
+    return bad;
+}
+
+struct ScanResult {
+    uint32_t maxCallUs;
+    uint32_t bad;
+    uint32_t minScans;
+};
+
+static const char* SCAN_CONFIG =
+    "[{\"name\":\"soil_bed_2\",\"channel\":2,\"gain\":0,\"rate\":860,\"samples\":16,\"interval_ms\":100,"
+    "\"wet\":4400,\"dry\":10700},"
+    "{\"name\":\"aux\",\"channel\":3,\"gain\":1,\"rate\":475,\"samples\":9,\"filter\":\"median\",\"interval_ms\":200}]";
+
+static ScanResult runScans(ADS1115Sampler& sampler) {
+    SimADS1115& chip = SimWorld::ads();
+    chip.setInputVoltage(2, 1.80f);
+    chip.setInputVoltage(3, 0.90f);
+    cJSON* list = cJSON_Parse(SCAN_CONFIG);
+    int added = sampler.configureScans(list);
+    cJSON_Delete(list);
+
+    ScanResult r = {};
+    uint64_t start = SimClock::nowMicros();
+    while (SimClock::nowMicros() - start < SimSamplerCheckOptions::SCAN_RUN_MS * 1000ULL) {
+        uint64_t callStart = SimClock::nowMicros();
+        sampler.update();
+        uint32_t callUs = (uint32_t)(SimClock::nowMicros() - callStart);
+        if (callUs > r.maxCallUs) r.maxCallUs = callUs;
+        delay(1);
+    }
+    r.minScans = added == 2 ? UINT32_MAX : 0;
+    printf("scan,name,channel,raw,voltage,percent,scans,failures\n");
+    for (int i = 0; i < sampler.getScanCount(); ++i) {
+        const ADS1115Sampler::ScanConfig& cfg = sampler.getScanConfig(i);
+        ADS1115Sampler::ScanValue value = {};
+        bool valid = sampler.getScanValue(i, value);
+        printf("scan,%s,%u,%.1f,%.4f,%.1f,%u,%u\n", cfg.name, cfg.channel, value.code, value.volts, value.percent,
+               value.scans, value.failures);
+        if (value.scans < r.minScans) r.minScans = value.scans;
+        float expectedPercent = cfg.calibrated
+            ? SoilMoistureSensor::rawToPercent((int16_t)lroundf(chip.getInputVoltage(cfg.channel) / ADS1115Manager::codeToVolts(1, cfg.gain)), cfg.wet, cfg.dry)
+            : 0.0f;
+        if (!valid || value.failures || fabsf(value.volts - chip.getInputVoltage(cfg.channel)) > TOLERANCE_VOLTS ||
+            fabsf(value.percent - expectedPercent) > 1.0f) {
+            r.bad++;
+        }
+    }
+    if (r.minScans == UINT32_MAX) r.minScans = 0;
+    return r;
+}
+
+static const SimCheck check("sampler-check");
+
+int SimSamplerCheck::run(const SimSamplerCheckOptions& options) {
+    uint32_t readings = options.iterations ? options.iterations : 1;
+    // The sampler task is a separate thread; in virtual time both threads
+    // would move the clock and every call would look slow
+    SimClock::setVirtual(false);
+
+    static I2CTracer tracer;
+    static SemaphoreHandle_t busMutex = xSemaphoreCreateMutex();
+    tracer.begin(Wire.getClock());
+    ADS1115Manager ads;
+    ads.begin(busMutex, ADS_ADDRESS, &tracer);
+    ADS1115Sampler sampler;
+    if (!check(sampler.begin(&ads), "sampler", "task did not start")) return 1;
+
+    printf("mode,readings,bad_readings,max_error_mv,max_loop_call_us,loop_iterations_per_reading,ms_per_reading,"
+           "side_windows,side_bad\n");
+    SamplerResult sampled = runMode(ads, &sampler, readings);
+    SamplerResult direct = runMode(ads, nullptr, readings);
+    const SamplerResult* results[] = { &sampled, &direct };
+    const char* names[] = { "sampler", "direct" };
+    for (int i = 0; i < 2; ++i) {
+        const SamplerResult& r = *results[i];
+        printf("%s,%u,%u,%.2f,%u,%.1f,%.1f,%u,%u\n", names[i], r.readings, r.badReadings, r.maxErrorVolts * 1000.0f,
+               r.maxCallUs, r.iterationsPerReading, r.msPerReading, r.sideWindows, r.sideBad);
+    }
+    int replaceId = sampler.addChannel(SIDE_CHANNEL, SIDE_GAIN);
+    uint32_t replaceBad = runReplace(sampler, replaceId, readings, false);
+    uint32_t replaceEndBad = runReplace(sampler, replaceId, readings, true);
+    printf("# replaced requests=%u stale_windows=%u at_burst_end=%u\n", readings, replaceBad, replaceEndBad);
+    ScanResult scan = runScans(sampler);
+    ADS1115Sampler::Stats stats = sampler.getStats();
+    printf("# sampler requests=%u samples=%u bursts=%u failures=%u\n", stats.requests, stats.samples, stats.bursts,
+           stats.failures);
+
+    bool ok = true;
+    ok &= check(sampled.badReadings == 0 && direct.badReadings == 0, "both", "readings do not match the simulated input");
+    ok &= check(sampled.maxCallUs <= SimSamplerCheckOptions::LOOP_BUDGET_US, "sampler", "a loop-side call blocked");
+    ok &= check(sampled.iterationsPerReading > 1.0, "sampler", "loop did not keep running during acquisition");
+    ok &= check(sampled.sideBad == 0, "sampler", "second channel window short or off");
+    ok &= check(stats.failures == 0, "sampler", "bursts failed");
+    ok &= check(replaceBad == 0 && replaceEndBad == 0, "replace", "window short or holds samples read for the request it replaced");
+    ok &= check(direct.maxCallUs > SimSamplerCheckOptions::LOOP_BUDGET_US, "direct", "direct reads did not block");
+    ok &= check(scan.bad == 0, "scan", "scan values missing or off");
+    // 100 ms and 200 ms intervals over SCAN_RUN_MS, with slack for host scheduling
+    ok &= check(scan.minScans >= SimSamplerCheckOptions::SCAN_RUN_MS / 200 / 2, "scan", "too few scans");
+    ok &= check(scan.maxCallUs <= SimSamplerCheckOptions::LOOP_BUDGET_US, "scan", "update() blocked");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+#ifndef SIM_SAMPLER_CHECK_H
+#define SIM_SAMPLER_CHECK_H
+
+#include <stdint.h>
+
+// Checks that ADS1115Sampler takes ADC work off the loop task. Runs in real
+// time (the sampler task is a host thread) against the simulated ADS1115:
+// a SoilMoistureSensor drives readings through the loop() pattern the
+// firmware uses (readyForReading() then takeReading()) while a second
+// channel is requested alongside it, first with the sampler and then
+// reading the ADS1115 directly for comparison. Prints per mode the longest
+// single call from the loop side, loop iterations per reading and the
+// reading error as CSV. Exits 1 when a sampled call blocks for longer than
+// LOOP_BUDGET_US, a window is short or off, or the direct mode does not
+// show the blocking the sampler is meant to remove.
+//
+// A replace pass re-requests a window while its first chunk is in flight,
+// moving the input in between, and checks that the new window is full and
+// holds no sample of the replaced request. It lands the new request()
+// once inside the burst and once, held by a hook on the simulated chip,
+// after the chunk has been read and before the task pushes it.
+//
+// A last pass configures ads1115_scan entries for A2 and A3 (a calibrated
+// soil probe and a median-filtered input), calls update() from the loop
+// side for SCAN_RUN_MS and checks each scan's latest value, count and the
+// loop-side call time. No firmware boot.
+struct SimSamplerCheckOptions {
+    static const uint32_t LOOP_BUDGET_US = 5000;
+    static const uint32_t SCAN_RUN_MS = 1000;
+    uint32_t iterations = 20; // Readings per mode
+};
+
+class SimSamplerCheck {
+public:
+    // Returns the process exit code: 0 all checks passed, 1 a check failed
+    static int run(const SimSamplerCheckOptions& options);
+};
+
+#endif // SIM_SAMPLER_CHECK_H
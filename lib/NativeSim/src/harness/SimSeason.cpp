@@ -0,0 +1,255 @@
+#include "harness/SimSeason.h"
+#include "sim/SimClock.h"
+#include "sim/SimGpio.h"
+#include "sim/SimScheduler.h"
+#include "sim/SimWorld.h"
+#include "system/SystemManager.h"
+#include "devices/SoilMoistureSensor.h"
+#include "devices/MQ135Sensor.h"
+#include "devices/IrrigationManager.h"
+#include "devices/RelayController.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+// Defined in src/main.cpp.
+extern SystemManager systemManager;
+extern SoilMoistureSensor soilMoistureSensor;
+extern MQ135Sensor mq135Sensor;
+extern IrrigationManager irrigationManager;
+extern RelayController relayController;
+
+void setup();
+void loop();
+
+static const int RELAY_COUNT = 4;
+
+struct RelayEvent {
+    uint32_t rtcTime;
+    uint64_t simMicros;
+    int relay;
+    bool on;
+};
+
+struct DayStats {
+    uint64_t loops = 0;
+    uint64_t jumps = 0;
+    uint64_t cpuNs = 0;
+    uint64_t activeUs = 0;
+    uint32_t relaySwitches = 0;
+};
+
+static std::vector<RelayEvent> relayEvents;
+static int relayPins[RELAY_COUNT];
+static bool relayActiveHigh[RELAY_COUNT];
+
+static void onOutputChange(uint8_t pin, uint8_t level) {
+    for (int i = 0; i < RELAY_COUNT; ++i) {
+        if (relayPins[i] != pin) continue;
+        bool on = relayActiveHigh[i] ? level == HIGH : level == LOW;
+        relayEvents.push_back({SimWorld::rtc().getTime(), SimClock::nowMicros(), i, on});
+    }
+}
+
+static uint64_t threadCpuNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static std::string formatTime(uint32_t t, bool withTime) {
+    time_t tt = (time_t)t;
+    struct tm tmv;
+    gmtime_r(&tt, &tmv);
+    char buf[24];
+    strftime(buf, sizeof(buf), withTime ? "%Y-%m-%d %H:%M:%S" : "%Y-%m-%d", &tmv);
+    return buf;
+}
+
+// RTC wall-clock deadline: the next time the RTC reads hh:mm:00.
+static uint64_t nextDailyTime(int hour, int minute) {
+    SimDS3231& rtc = SimWorld::rtc();
+    uint32_t now = rtc.getTime();
+    uint32_t candidate = now - now % 86400UL + (uint32_t)(hour * 3600 + minute * 60);
+    if (candidate <= now) candidate += 86400UL;
+    return rtc.microsAt(candidate);
+}
+
+void SimSeason::registerDeadlines() {
+    SimScheduler::addSource("alarm1", []() -> uint64_t {
+        uint32_t t = SimWorld::rtc().nextAlarmTime(1, SimWorld::rtc().getTime());
+        return t ? SimWorld::rtc().microsAt(t) : SimScheduler::NO_DEADLINE;
+    });
+    SimScheduler::addSource("alarm2", []() -> uint64_t {
+        uint32_t t = SimWorld::rtc().nextAlarmTime(2, SimWorld::rtc().getTime());
+        return t ? SimWorld::rtc().microsAt(t) : SimScheduler::NO_DEADLINE;
+    });
+    SimScheduler::addSource("irrigation_schedule", []() -> uint64_t {
+        ConfigManager& config = systemManager.getConfigManager();
+        return nextDailyTime(config.getInt("irrigation_scheduled_hour", 13),
+                             config.getInt("irrigation_scheduled_minute", 15));
+    });
+    // ReadingManager's hourly reading, midnight setAlarmsForToday() and
+    // the 02:00/03:00 DST transitions all sit on hour boundaries.
+    SimScheduler::addSource("hour", []() -> uint64_t {
+        uint32_t now = SimWorld::rtc().getTime();
+        return SimWorld::rtc().microsAt(now - now % 3600UL + 3600UL);
+    });
+    SimScheduler::addSource("soil_stabilisation", []() -> uint64_t {
+        if (soilMoistureSensor.getState() != SoilMoistureSensor::STABILISING) return SimScheduler::NO_DEADLINE;
+        return ((uint64_t)soilMoistureSensor.getStabilisationStart() +
+                (uint64_t)soilMoistureSensor.getStabilisationTimeSec() * 1000ULL) * 1000ULL;
+    });
+    SimScheduler::addSource("bme280_step", []() -> uint64_t {
+        uint64_t next = SimScheduler::NO_DEADLINE;
+        for (const auto& bme : systemManager.getI2CManager().getBME280Devices()) {
+            if (bme->isReading()) next = std::min<uint64_t>(next, (uint64_t)bme->getNextStepMs() * 1000ULL);
+        }
+        return next;
+    });
+    SimScheduler::addSource("mq135_warmup", []() -> uint64_t {
+        if (!mq135Sensor.isWarmingUp()) return SimScheduler::NO_DEADLINE;
+        return ((uint64_t)mq135Sensor.getWarmupStart() + (uint64_t)mq135Sensor.getWarmupTimeSec() * 1000ULL) * 1000ULL;
+    });
+    SimScheduler::addSource("watering", []() -> uint64_t {
+        if (!irrigationManager.isWateringActive()) return SimScheduler::NO_DEADLINE;
+        return (uint64_t)irrigationManager.getWateringEnd() * 1000ULL;
+    });
+}
+
+// Iteration times are virtual: delay(), busy-waits and I2C transfers advance
+// the clock, so they match what the board would spend in loop().
+static void printStalls(const LoopProfiler& profiler) {
+    printf("\n# slowest loop iterations (over %.0f ms)\n", LoopProfiler::DEFAULT_STALL_THRESHOLD_US / 1e3);
+    printf("rank,duration_ms,site,site_ms,section,section_ms\n");
+    for (int i = 0; i < profiler.getStallCount(); ++i) {
+        const LoopProfiler::Stall& s = profiler.getStall(i);
+        printf("%d,%.1f,%s,%.1f,%s,%.1f\n", i + 1, s.durationUs / 1e3, s.site ? s.site : "",
+               s.siteUs / 1e3, LoopProfiler::getSectionName(s.section), s.sectionUs / 1e3);
+    }
+    printf("\n# stalls per site\n");
+    printf("site,stalls,max_ms,total_ms\n");
+    for (int i = 0; i < profiler.getOffenderCount(); ++i) {
+        const LoopProfiler::Offender& o = profiler.getOffender(i);
+        printf("%s,%u,%.1f,%.1f\n", o.name, o.stalls, o.maxUs / 1e3, o.totalUs / 1e3);
+    }
+    cJSON* stalls = profiler.getStallsJson();
+    printf("\n# loop latency histogram\n");
+    printf("upper_us,count\n");
+    cJSON* bucket = nullptr;
+    cJSON_ArrayForEach(bucket, cJSON_GetObjectItem(stalls, "histogram")) {
+        printf("%.0f,%.0f\n", cJSON_GetArrayItem(bucket, 0)->valuedouble, cJSON_GetArrayItem(bucket, 1)->valuedouble);
+    }
+    printf("# loops %.0f, over threshold %.0f, p50 %.0f us, p99 %.0f us, max %.0f us\n",
+           cJSON_GetObjectItem(stalls, "loops")->valuedouble, cJSON_GetObjectItem(stalls, "stalls")->valuedouble,
+           cJSON_GetObjectItem(stalls, "p50_us")->valuedouble, cJSON_GetObjectItem(stalls, "p99_us")->valuedouble,
+           cJSON_GetObjectItem(stalls, "max_us")->valuedouble);
+    cJSON_Delete(stalls);
+}
+
+static void printReport(const std::map<std::string, DayStats>& days, double hostSeconds) {
+    ConfigManager& config = systemManager.getConfigManager();
+    cJSON* names = cJSON_GetObjectItemCaseSensitive(config.getRoot(), "relay_names");
+
+    printf("# relay timeline\n");
+    printf("rtc_time,sim_seconds,relay,name,state\n");
+    for (const RelayEvent& e : relayEvents) {
+        cJSON* name = names ? cJSON_GetArrayItem(names, e.relay) : nullptr;
+        printf("%s,%.3f,%d,%s,%s\n", formatTime(e.rtcTime, true).c_str(), e.simMicros / 1e6, e.relay,
+               cJSON_IsString(name) ? name->valuestring : "", e.on ? "ON" : "OFF");
+    }
+
+    printf("\n# cpu per simulated day\n");
+    printf("date,loops,jumps,active_sim_s,host_cpu_ms,cpu_us_per_loop,relay_switches\n");
+    uint64_t totalLoops = 0, totalCpuNs = 0;
+    for (const auto& entry : days) {
+        const DayStats& d = entry.second;
+        printf("%s,%llu,%llu,%.1f,%.2f,%.2f,%u\n", entry.first.c_str(), (unsigned long long)d.loops,
+               (unsigned long long)d.jumps, d.activeUs / 1e6, d.cpuNs / 1e6,
+               d.loops ? d.cpuNs / 1e3 / d.loops : 0.0, d.relaySwitches);
+        totalLoops += d.loops;
+        totalCpuNs += d.cpuNs;
+    }
+    // Virtual-time runs charge Wire transfers to the clock, so held time here
+    // is bus time plus whatever the caller did while holding the bus.
+    I2CTracer& tracer = systemManager.getI2CManager().getTracer();
+    printf("\n# i2c per address\n");
+    printf("address,name,calls,transactions,tx_bytes,rx_bytes,errors,bus_ms,held_ms,mutex_wait_ms\n");
+    static const uint8_t ADDRESSES[] = { I2CTracer::SCAN_ADDRESS, 0x48, 0x68, 0x76, 0x77 };
+    for (uint8_t address : ADDRESSES) {
+        const I2CTracer::DeviceStats* s = tracer.findDevice(address);
+        if (!s) continue;
+        printf("0x%02X,%s,%u,%u,%u,%u,%u,%.1f,%.1f,%.1f\n", address,
+               address == I2CTracer::SCAN_ADDRESS ? "Scan" : I2CManager::getDeviceName(address),
+               s->calls, s->transactions, s->txBytes, s->rxBytes, s->errors,
+               tracer.estimateBusMicros(s->transactions, s->txBytes + s->rxBytes) / 1e3,
+               s->heldUs / 1e3, s->mutexWaitUs / 1e3);
+    }
+
+    printStalls(systemManager.getLoopProfiler());
+
+    printf("\n# simulated %zu days in %.2f s host time: %llu loops, %llu jumps, %.1f ms CPU in loop(), %zu relay events\n",
+           days.size(), hostSeconds, (unsigned long long)totalLoops,
+           (unsigned long long)SimScheduler::getJumpCount(), totalCpuNs / 1e6, relayEvents.size());
+}
+
+int SimSeason::run(const SimSeasonOptions& options) {
+    SimClock::setVirtual(true);
+    Serial.simSetEcho(options.verbose);
+    SimScheduler::setMaxStepMicros((uint64_t)options.maxStepSec * 1000000ULL);
+
+    setup();
+
+    // A fresh config forces the RTC to build time on first boot, so the
+    // start date is applied afterwards, the way a user would set it.
+    if (options.startLocal) {
+        SimClock::setUnixTimeUtc(options.startLocal - 3600UL); // CET, the default timezone_offset
+        TimeManager& timeManager = systemManager.getTimeManager();
+        timeManager.setTime(DateTime(options.startLocal));
+        timeManager.setAlarmsForToday();
+    }
+
+    ConfigManager& config = systemManager.getConfigManager();
+    for (int i = 0; i < RELAY_COUNT; ++i) {
+        relayPins[i] = relayController.getRelayGpio(i);
+        char key[24];
+        snprintf(key, sizeof(key), "relay_active_high_%d", i);
+        relayActiveHigh[i] = config.getBool(key, true);
+    }
+    SimGpio::setOutputListener(onOutputChange);
+    registerDeadlines();
+
+    std::map<std::string, DayStats> days;
+    uint64_t endMicros = SimClock::nowMicros() + (uint64_t)options.days * 86400ULL * 1000000ULL;
+    uint64_t hostStart = threadCpuNs();
+    while (SimClock::nowMicros() < endMicros) {
+        DayStats& day = days[formatTime(SimWorld::rtc().getTime(), false)];
+        size_t eventsBefore = relayEvents.size();
+        uint64_t simBefore = SimClock::nowMicros();
+        uint64_t cpuBefore = threadCpuNs();
+
+        SimWorld::tick();
+        loop();
+
+        day.cpuNs += threadCpuNs() - cpuBefore;
+        day.activeUs += SimClock::nowMicros() - simBefore;
+        day.loops++;
+        day.relaySwitches += (uint32_t)(relayEvents.size() - eventsBefore);
+        if (SimScheduler::afterLoop()) day.jumps++;
+    }
+    SimGpio::setOutputListener(nullptr);
+    fflush(stdout);
+    printReport(days, (threadCpuNs() - hostStart) / 1e9);
+
+    const LoopProfiler& profiler = systemManager.getLoopProfiler();
+    if (options.stallBudgetMs && profiler.getStallCount() > 0 &&
+        profiler.getStall(0).durationUs > options.stallBudgetMs * 1000ULL) {
+        const LoopProfiler::Stall& worst = profiler.getStall(0);
+        fprintf(stderr, "stall budget exceeded: %.1f ms > %u ms in %s\n", worst.durationUs / 1e3,
+                options.stallBudgetMs, worst.site ? worst.site : LoopProfiler::getSectionName(worst.section));
+        return 1;
+    }
+    return 0;
+}
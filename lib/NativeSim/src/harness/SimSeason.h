@@ -0,0 +1,29 @@
+#ifndef SIM_SEASON_H
+#define SIM_SEASON_H
+
+#include <stdint.h>
+
+// Virtual-time run of the firmware over many days. SimScheduler jumps the
+// clock between deadlines (RTC alarms, the irrigation schedule, hour
+// boundaries for ReadingManager/DST, BME280 conversion steps, soil
+// stabilisation, MQ135 warm-up and watering), so a season finishes in
+// seconds. Prints the relay actuation
+// timeline, a per-simulated-day CPU report and the slowest loop()
+// iterations as CSV.
+struct SimSeasonOptions {
+    uint32_t days = 30;
+    uint32_t startLocal = 0;     // RTC local time to start from; 0 keeps the boot time
+    uint32_t maxStepSec = 600;   // TimeManager checks DST every 10 minutes
+    bool verbose = false;        // echo the firmware's serial output
+    uint32_t stallBudgetMs = 0;  // fail (exit 1) when a loop() iteration takes longer; 0 = report only
+};
+
+class SimSeason {
+public:
+    static int run(const SimSeasonOptions& options);
+    // SimScheduler deadline sources for the firmware's timers; also used
+    // by SimSoak
+    static void registerDeadlines();
+};
+
+#endif // SIM_SEASON_H
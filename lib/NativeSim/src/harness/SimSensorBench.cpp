@@ -0,0 +1,201 @@
+#include "harness/SimSensorBench.h"
+#include "devices/BME280Device.h"
+#include "devices/SoilMoistureSensor.h"
+#include "devices/MQ135Sensor.h"
+#include <math.h>
+#include <random>
+#include <time.h>
+#include <vector>
+
+static const int WINDOWS[] = { 4, 8, 10, 16, 32, 64, 128, 256 };
+// Independent windows per size, cycled through by the timed loop so the
+// inputs are not the same few cache lines every call
+static const int TRACES = 64;
+
+// Noise-free values the traces are built around
+static const float TRUE_TEMPERATURE = 22.0f;
+static const float TRUE_HUMIDITY = 55.0f;
+static const float TRUE_PRESSURE = 1013.25f;
+static const float TRUE_SOIL_RAW = 6000.0f;
+static const float TRUE_MQ135_RAW = 2500.0f;
+static const int SOIL_WET = 0;
+static const int SOIL_DRY = 11300;
+// ADS1115 LSB for the gains the sensors use
+static const float SOIL_VOLTS_PER_BIT = 4.096f / 32768.0f;
+static const float MQ135_VOLTS_PER_BIT = 6.144f / 32768.0f;
+
+// One window size worth of inputs, TRACES windows laid out back to back
+struct SensorTrace {
+    int window = 0;
+    std::vector<BME280Reading> bme;
+    std::vector<float> soilRaw, soilVolt, soilPercent;
+    std::vector<float> mqRaw, mqVolt;
+    // Heat index/dew point inputs span both sides of the 26 C cut-off
+    std::vector<float> hiTemp, hiHumidity;
+    std::vector<int16_t> soilRawInt;
+};
+
+// Keeps the optimiser from discarding results
+static volatile float sink;
+
+// Gaussian noise with a 2% chance of a spike of +/- 10 sigma, the kind a
+// loose connector or a relay switching nearby produces
+static float noisy(std::mt19937& rng, float truth, float sigma) {
+    std::normal_distribution<float> noise(0.0f, sigma);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float v = truth + noise(rng);
+    if (unit(rng) < 0.02f) v += (unit(rng) < 0.5f ? -10.0f : 10.0f) * sigma;
+    return v;
+}
+
+static SensorTrace makeTrace(int window, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> tempRange(18.0f, 34.0f);
+    std::uniform_real_distribution<float> humidityRange(30.0f, 90.0f);
+    SensorTrace t;
+    t.window = window;
+    size_t n = (size_t)window * TRACES;
+    t.bme.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        BME280Reading& r = t.bme[i];
+        r.temperature = noisy(rng, TRUE_TEMPERATURE, 0.1f);
+        r.humidity = noisy(rng, TRUE_HUMIDITY, 0.5f);
+        r.pressure = noisy(rng, TRUE_PRESSURE, 0.05f);
+        r.heatIndex = BME280Device::computeHeatIndex(r.temperature, r.humidity);
+        r.dewPoint = BME280Device::computeDewPoint(r.temperature, r.humidity);
+        r.valid = true;
+
+        float raw = roundf(noisy(rng, TRUE_SOIL_RAW, 60.0f));
+        t.soilRawInt.push_back((int16_t)raw);
+        t.soilRaw.push_back(raw);
+        t.soilVolt.push_back(raw * SOIL_VOLTS_PER_BIT);
+        t.soilPercent.push_back(SoilMoistureSensor::rawToPercent((int16_t)raw, SOIL_WET, SOIL_DRY));
+
+        float mq = roundf(noisy(rng, TRUE_MQ135_RAW, 40.0f));
+        t.mqRaw.push_back(mq);
+        t.mqVolt.push_back(mq * MQ135_VOLTS_PER_BIT);
+
+        t.hiTemp.push_back(tempRange(rng));
+        t.hiHumidity.push_back(humidityRange(rng));
+    }
+    return t;
+}
+
+struct SensorBench {
+    const char* name;
+    // Processes window k of the trace, k < TRACES
+    void (*run)(SensorTrace& t, int k);
+    // Filtered value for window k and the truth it should recover; null
+    // for the per-sample functions
+    float (*filtered)(SensorTrace& t, int k);
+    float (*mean)(SensorTrace& t, int k);
+    float truth;
+};
+
+static float meanOf(const float* v, int n) {
+    float sum = 0;
+    for (int i = 0; i < n; ++i) sum += v[i];
+    return sum / n;
+}
+
+static float bmeFiltered(SensorTrace& t, int k) {
+    BME280Reading result;
+    BME280Device::filterAndAverage(&t.bme[(size_t)k * t.window], t.window, result);
+    return result.avgTemperature;
+}
+
+static float bmeMean(SensorTrace& t, int k) {
+    float sum = 0;
+    for (int i = 0; i < t.window; ++i) sum += t.bme[(size_t)k * t.window + i].temperature;
+    return sum / t.window;
+}
+
+static float soilFiltered(SensorTrace& t, int k) {
+    size_t at = (size_t)k * t.window;
+    float raw, volt, percent;
+    SoilMoistureSensor::filterAndAverage(&t.soilRaw[at], &t.soilVolt[at], &t.soilPercent[at], t.window, raw, volt, percent);
+    return raw;
+}
+
+static float mqFiltered(SensorTrace& t, int k) {
+    size_t at = (size_t)k * t.window;
+    float raw, volt;
+    MQ135Sensor::filterAndAverage(&t.mqRaw[at], &t.mqVolt[at], t.window, raw, volt);
+    return raw;
+}
+
+static const SensorBench BENCHES[] = {
+    { "BME280Device::filterAndAverage",
+      [](SensorTrace& t, int k) { sink = bmeFiltered(t, k); },
+      bmeFiltered, bmeMean, TRUE_TEMPERATURE },
+    { "SoilMoistureSensor::filterAndAverage",
+      [](SensorTrace& t, int k) { sink = soilFiltered(t, k); },
+      soilFiltered,
+      [](SensorTrace& t, int k) { return meanOf(&t.soilRaw[(size_t)k * t.window], t.window); },
+      TRUE_SOIL_RAW },
+    { "MQ135Sensor::filterAndAverage",
+      [](SensorTrace& t, int k) { sink = mqFiltered(t, k); },
+      mqFiltered,
+      [](SensorTrace& t, int k) { return meanOf(&t.mqRaw[(size_t)k * t.window], t.window); },
+      TRUE_MQ135_RAW },
+    { "BME280Device::computeHeatIndex",
+      [](SensorTrace& t, int k) {
+          size_t at = (size_t)k * t.window;
+          for (int i = 0; i < t.window; ++i) sink = BME280Device::computeHeatIndex(t.hiTemp[at + i], t.hiHumidity[at + i]);
+      },
+      nullptr, nullptr, 0 },
+    { "BME280Device::computeDewPoint",
+      [](SensorTrace& t, int k) {
+          size_t at = (size_t)k * t.window;
+          for (int i = 0; i < t.window; ++i) sink = BME280Device::computeDewPoint(t.hiTemp[at + i], t.hiHumidity[at + i]);
+      },
+      nullptr, nullptr, 0 },
+    { "SoilMoistureSensor::rawToPercent",
+      [](SensorTrace& t, int k) {
+          size_t at = (size_t)k * t.window;
+          for (int i = 0; i < t.window; ++i) sink = SoilMoistureSensor::rawToPercent(t.soilRawInt[at + i], SOIL_WET, SOIL_DRY);
+      },
+      nullptr, nullptr, 0 },
+};
+
+// RMS error over all TRACES windows of a window size
+static float rmsError(SensorTrace& t, float (*estimate)(SensorTrace&, int), float truth) {
+    double sum = 0;
+    for (int k = 0; k < TRACES; ++k) {
+        double e = estimate(t, k) - truth;
+        sum += e * e;
+    }
+    return (float)sqrt(sum / TRACES);
+}
+
+static uint64_t threadCpuNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int SimSensorBench::run(const SimSensorBenchOptions& options) {
+    uint32_t iterations = options.iterations ? options.iterations : 1;
+    std::vector<SensorTrace> traces;
+    for (int window : WINDOWS) traces.push_back(makeTrace(window, 1000u + (uint32_t)window));
+
+    printf("function,window,iterations,ns_per_call,ns_per_sample,rms_error,rms_error_mean\n");
+    for (const SensorBench& bench : BENCHES) {
+        for (SensorTrace& t : traces) {
+            for (int k = 0; k < TRACES; ++k) bench.run(t, k); // Warm caches
+
+            uint64_t start = threadCpuNs();
+            for (uint32_t i = 0; i < iterations; ++i) bench.run(t, (int)(i % TRACES));
+            uint64_t elapsed = threadCpuNs() - start;
+            double nsPerCall = (double)elapsed / iterations;
+
+            printf("%s,%d,%u,%.1f,%.2f,", bench.name, t.window, iterations, nsPerCall, nsPerCall / t.window);
+            if (bench.filtered) {
+                printf("%.4f,%.4f\n", rmsError(t, bench.filtered, bench.truth), rmsError(t, bench.mean, bench.truth));
+            } else {
+                printf(",\n");
+            }
+        }
+    }
+    return 0;
+}
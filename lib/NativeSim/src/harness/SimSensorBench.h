@@ -0,0 +1,24 @@
+#ifndef SIM_SENSOR_BENCH_H
+#define SIM_SENSOR_BENCH_H
+
+#include <stdint.h>
+
+// Host micro-benchmark for the sensor pipeline maths: the min/max-rejecting
+// filterAndAverage of BME280Device, SoilMoistureSensor and MQ135Sensor,
+// BME280Device::computeHeatIndex/computeDewPoint and the wet/dry mapping
+// behind SoilMoistureSensor::readPercent. Each runs over seeded synthetic
+// traces (Gaussian noise plus occasional spikes) for a range of window
+// sizes and prints host CPU ns per call and per sample as CSV, with the
+// RMS error of each filter against the noise-free value. No firmware boot;
+// the firmware currently uses a window of 10.
+struct SimSensorBenchOptions {
+    uint32_t iterations = 2000;
+};
+
+class SimSensorBench {
+public:
+    // Returns the process exit code: 0 done
+    static int run(const SimSensorBenchOptions& options);
+};
+
+#endif // SIM_SENSOR_BENCH_H
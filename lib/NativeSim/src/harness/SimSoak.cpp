@@ -0,0 +1,279 @@
+#include "harness/SimSoak.h"
+#include "harness/SimBoot.h"
+#include "harness/SimSeason.h"
+#include "sim/SimClock.h"
+#include "sim/SimHeap.h"
+#include "sim/SimScheduler.h"
+#include "sim/SimWorld.h"
+#include "system/SystemManager.h"
+#include "system/MqttManager.h"
+#include "diagnostics/AllocationTracker.h"
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include <PubSubClient.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+// Defined in src/main.cpp.
+extern SystemManager systemManager;
+extern MqttManager mqttManager;
+
+void loop();
+
+static const char* DEVICE_NAME = "soak";
+
+// Relay names the config POSTs rotate through, so the stored strings
+// change length the way they do when a user renames zones
+static const char* const RELAY_NAME_SETS[][4] = {
+    { "Zone 1", "Zone 2", "Zone 3", "Zone 4" },
+    { "Front lawn", "Vegetable beds", "Greenhouse drip line", "Hanging baskets" },
+    { "A", "B", "C", "D" },
+};
+
+struct SoakSample {
+    uint64_t simMicros;
+    uint32_t rtcTime;
+    AllocationTracker::Totals totals;
+    SimHeap::Stats heap;
+    uint32_t requests;
+    uint32_t mqttCommands;
+};
+
+struct SoakTraffic {
+    uint64_t nextStatus;
+    uint64_t nextConfig;
+    uint64_t nextRelay;
+    uint64_t nextMqtt;
+    uint64_t nextSample;
+    uint32_t requests = 0;
+    uint32_t failedRequests = 0;
+    uint32_t mqttCommands = 0;
+    uint32_t configPosts = 0;
+};
+
+static SoakTraffic traffic;
+
+// Per web route, bytes its scope counted as retained that the server freed
+// once the response was sent: the response body, handed off, not leaked.
+// Keyed by the tracker's entry so lookups do not allocate.
+static std::map<const AllocationTracker::Operation*, int64_t> handedOffBytes;
+
+static std::string configBody(uint32_t post) {
+    cJSON* body = cJSON_Duplicate(systemManager.getConfigManager().getRoot(), 1);
+    const char* const* names = RELAY_NAME_SETS[post % (sizeof(RELAY_NAME_SETS) / sizeof(RELAY_NAME_SETS[0]))];
+    cJSON_DeleteItemFromObjectCaseSensitive(body, "relay_names");
+    cJSON_AddItemToObject(body, "relay_names", cJSON_CreateStringArray(names, 4));
+    char* text = cJSON_PrintUnformatted(body);
+    std::string result = text ? text : "";
+    cJSON_free(text);
+    cJSON_Delete(body);
+    return result;
+}
+
+// Client mode with MQTT on, written before boot the way a configured unit
+// comes up; keys the soak does not need are left as they are.
+static void prepareConfig() {
+    LittleFS.begin();
+    std::string text;
+    File in = LittleFS.open("/config.json", "r");
+    if (in) {
+        text = in.readString().c_str();
+        in.close();
+    }
+    cJSON* root = cJSON_Parse(text.c_str());
+    if (!root) root = cJSON_CreateObject();
+    cJSON_DeleteItemFromObjectCaseSensitive(root, "wifi_mode");
+    cJSON_AddStringToObject(root, "wifi_mode", "client");
+    cJSON_DeleteItemFromObjectCaseSensitive(root, "mqtt_enabled");
+    cJSON_AddBoolToObject(root, "mqtt_enabled", true);
+    cJSON_DeleteItemFromObjectCaseSensitive(root, "device_name");
+    cJSON_AddStringToObject(root, "device_name", DEVICE_NAME);
+    char* out = cJSON_PrintUnformatted(root);
+    File file = LittleFS.open("/config.json", "w");
+    file.print(out);
+    file.close();
+    cJSON_free(out);
+    cJSON_Delete(root);
+}
+
+static void request(WebRequestMethod method, const char* url, const char* body = nullptr) {
+    char name[AllocationTracker::NAME_LENGTH];
+    snprintf(name, sizeof(name), "%s %s", method == HTTP_GET ? "GET" : "POST", url);
+    const AllocationTracker::Operation* op = AllocationTracker::findOperation(name);
+    int64_t netBefore = op ? op->netBytes : 0;
+    int32_t liveBefore = AllocationTracker::getTotals().liveBytes;
+    traffic.requests++;
+    if (AsyncWebServer::simRequest(method, url, body).code != 200) traffic.failedRequests++;
+    // The response has been sent and freed by now
+    int32_t retained = AllocationTracker::getTotals().liveBytes - liveBefore;
+    op = AllocationTracker::findOperation(name);
+    if (op) handedOffBytes[op] += op->netBytes - netBefore - retained;
+}
+
+static void postConfig() {
+    std::string body = configBody(traffic.configPosts++);
+    request(HTTP_POST, "/api/config", body.c_str());
+}
+
+static SoakSample takeSample() {
+    SoakSample s;
+    s.simMicros = SimClock::nowMicros();
+    s.rtcTime = SimWorld::rtc().getTime();
+    s.totals = AllocationTracker::getTotals();
+    s.heap = SimHeap::getStats();
+    s.requests = traffic.requests;
+    s.mqttCommands = traffic.mqttCommands;
+    return s;
+}
+
+// Runs whatever traffic is due; called after every loop()
+static void driveTraffic(const SimSoakOptions& options, std::vector<SoakSample>& samples) {
+    uint64_t now = SimClock::nowMicros();
+    if (now >= traffic.nextStatus) {
+        request(HTTP_GET, "/api/status");
+        traffic.nextStatus = now + options.statusPollSec * 1000000ULL;
+    }
+    if (now >= traffic.nextConfig) {
+        postConfig();
+        traffic.nextConfig = now + options.configPostSec * 1000000ULL;
+    }
+    if (now >= traffic.nextRelay) {
+        // Toggled twice so the web UI leaves the relays as it found them
+        char body[48];
+        snprintf(body, sizeof(body), "{\"relay\":%u,\"command\":\"toggle\"}", traffic.requests % 4);
+        request(HTTP_POST, "/api/relay", body);
+        request(HTTP_POST, "/api/relay", body);
+        traffic.nextRelay = now + options.relayCommandSec * 1000000ULL;
+    }
+    if (now >= traffic.nextMqtt) {
+        char topic[64];
+        snprintf(topic, sizeof(topic), "homeassistant/%s/relay%u/set", DEVICE_NAME, traffic.mqttCommands % 4 + 1);
+        SimMqttBroker::inject(topic, "ON");
+        SimMqttBroker::inject(topic, "OFF");
+        traffic.mqttCommands += 2;
+        traffic.nextMqtt = now + options.mqttCommandSec * 1000000ULL;
+    }
+    if (now >= traffic.nextSample) {
+        samples.push_back(takeSample());
+        traffic.nextSample = now + options.sampleSec * 1000000ULL;
+    }
+}
+
+static void printSamples(const std::vector<SoakSample>& samples, uint64_t startMicros) {
+    printf("# heap over time\n");
+    printf("sim_day,rtc_time,live_blocks,live_bytes,peak_live_bytes,heap_used,heap_high_water,"
+           "largest_free_block,min_largest_free_block,free_fragments,failed_allocs,requests,mqtt_commands\n");
+    for (const SoakSample& s : samples) {
+        time_t t = (time_t)s.rtcTime;
+        struct tm tmv;
+        gmtime_r(&t, &tmv);
+        char rtc[24];
+        strftime(rtc, sizeof(rtc), "%Y-%m-%d %H:%M", &tmv);
+        printf("%.2f,%s,%u,%d,%d,%u,%u,%u,%u,%u,%u,%u,%u\n", (s.simMicros - startMicros) / 86400e6, rtc,
+               s.totals.liveBlocks, s.totals.liveBytes, s.totals.peakLiveBytes, s.heap.usedBytes,
+               s.heap.highWaterBytes, s.heap.largestFreeBlock, s.heap.minLargestFreeBlock, s.heap.freeFragments,
+               s.heap.failedAllocs, s.requests, s.mqttCommands);
+    }
+}
+
+// Bytes each operation still held when its calls returned, and how much
+// of that the web server freed with the response. A path that leaks shows
+// retained bytes that keep growing with its call count.
+static int64_t retainedBytes(const AllocationTracker::Operation* op) {
+    auto it = handedOffBytes.find(op);
+    return op->netBytes - (it == handedOffBytes.end() ? 0 : it->second);
+}
+
+static void printRetained() {
+    std::vector<const AllocationTracker::Operation*> ops;
+    for (int i = 0; i < AllocationTracker::getOperationCount(); ++i) {
+        const AllocationTracker::Operation* op = AllocationTracker::getOperation(i);
+        if (op->calls) ops.push_back(op);
+    }
+    std::sort(ops.begin(), ops.end(), [](const AllocationTracker::Operation* a, const AllocationTracker::Operation* b) {
+        return retainedBytes(a) > retainedBytes(b);
+    });
+    printf("\n# retained per operation\n");
+    printf("operation,calls,avg_allocs,peak_bytes,net_bytes,response_bytes,retained_bytes,retained_bytes_per_call\n");
+    for (const AllocationTracker::Operation* op : ops) {
+        int64_t retained = retainedBytes(op);
+        printf("%s,%u,%.1f,%u,%lld,%lld,%lld,%.2f\n", op->name, op->calls, (double)op->allocs / op->calls,
+               op->maxPeakBytes, (long long)op->netBytes, (long long)(op->netBytes - retained), (long long)retained,
+               (double)retained / op->calls);
+    }
+}
+
+int SimSoak::run(const SimSoakOptions& options) {
+    // Attached before setup() so boot-time allocations occupy the model
+    // the way they occupy the board's heap
+    prepareConfig();
+    SimMqttBroker::setAvailable(true);
+    SimMqttBroker::setRecording(false);
+    SimHeap::attach();
+    if (!SimBoot::startFirmware(options.verbose)) {
+        fprintf(stderr, "soak: web server did not start\n");
+        return 2;
+    }
+    if (!SimBoot::waitFor([] { return mqttManager.isInitialized(); }, 200000)) {
+        fprintf(stderr, "soak: MQTT did not come up\n");
+        return 2;
+    }
+
+    SimScheduler::setMaxStepMicros(600ULL * 1000000ULL);
+    SimSeason::registerDeadlines();
+    SimScheduler::addSource("soak_traffic", []() -> uint64_t {
+        return std::min(std::min(traffic.nextStatus, traffic.nextConfig),
+                        std::min(std::min(traffic.nextRelay, traffic.nextMqtt), traffic.nextSample));
+    });
+
+    uint64_t startMicros = SimClock::nowMicros();
+    uint64_t endMicros = startMicros + (uint64_t)options.days * 86400ULL * 1000000ULL;
+    traffic.nextStatus = startMicros;
+    traffic.nextConfig = startMicros + options.configPostSec * 1000000ULL;
+    traffic.nextRelay = startMicros;
+    traffic.nextMqtt = startMicros;
+    traffic.nextSample = startMicros;
+
+    // Operations report what the soak itself did, not the boot
+    AllocationTracker::reset();
+    // Reserved up front so the harness's own bookkeeping is not counted as growth
+    std::vector<SoakSample> samples;
+    samples.reserve(options.days * 86400ULL / options.sampleSec + 2);
+    while (SimClock::nowMicros() < endMicros) {
+        SimWorld::tick();
+        loop();
+        driveTraffic(options, samples);
+        SimScheduler::afterLoop();
+    }
+    samples.push_back(takeSample());
+    fflush(stdout);
+    printSamples(samples, startMicros);
+    printRetained();
+
+    const SoakSample& last = samples.back();
+    const SoakSample* baseline = &samples.front();
+    for (const SoakSample& s : samples) {
+        baseline = &s;
+        if (s.simMicros - startMicros >= 86400ULL * 1000000ULL) break;
+    }
+    int32_t growth = last.totals.liveBytes - baseline->totals.liveBytes;
+    printf("\n# %u days, %u requests (%u failed), %u config posts, %u mqtt commands; "
+           "live bytes %+d since day %.0f, heap high-water %u of %u, min largest free block %u\n",
+           options.days, traffic.requests, traffic.failedRequests, traffic.configPosts, traffic.mqttCommands,
+           growth, (baseline->simMicros - startMicros) / 86400e6, last.heap.highWaterBytes, SimHeap::ARENA_BYTES,
+           last.heap.minLargestFreeBlock);
+
+    if (traffic.failedRequests || last.heap.failedAllocs) {
+        fprintf(stderr, "soak: %u failed requests, %u allocations the board could not satisfy\n",
+                traffic.failedRequests, last.heap.failedAllocs);
+        return 1;
+    }
+    if (options.maxGrowthBytes && growth > (int32_t)options.maxGrowthBytes) {
+        fprintf(stderr, "soak: live bytes grew by %d, budget %u\n", growth, options.maxGrowthBytes);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef SIM_SOAK_H
+#define SIM_SOAK_H
+
+#include <stdint.h>
+
+// Long-uptime heap run. Boots the firmware in virtual time with the
+// SimHeap model attached, switches it to WiFi client mode with MQTT, and
+// for the given number of days keeps up the traffic a dashboard and Home
+// Assistant generate: /api/status polls, full-config POSTs to /api/config,
+// /api/relay toggles and MQTT relay commands, on top of the firmware's own
+// schedule (see SimSeason). Samples live allocations, the model's heap
+// high-water mark and largest free block as CSV, then lists the bytes each
+// operation left allocated, less the response bodies the web server frees
+// once they are sent. Exits 1 when live bytes at the end exceed the
+// first-day sample by more than maxGrowthBytes.
+struct SimSoakOptions {
+    uint32_t days = 30;
+    uint32_t statusPollSec = 300;
+    uint32_t configPostSec = 6 * 3600;
+    uint32_t relayCommandSec = 1800;
+    uint32_t mqttCommandSec = 900;
+    uint32_t sampleSec = 6 * 3600;
+    // A 30-day run ends within about 150 bytes of day 1; a leak of one byte
+    // per status poll is 8.6 KB. 0 = report only
+    uint32_t maxGrowthBytes = 1024;
+    bool verbose = false;
+};
+
+class SimSoak {
+public:
+    // Returns the process exit code: 0 done, 1 growth over budget, 2 setup failure
+    static int run(const SimSoakOptions& options);
+};
+
+#endif // SIM_SOAK_H
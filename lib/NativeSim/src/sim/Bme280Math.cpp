@@ -0,0 +1,107 @@
+#include "sim/Bme280Math.h"
+
+void Bme280Calibration::parse(const uint8_t* tp, const uint8_t* h) {
+    T1 = (uint16_t)(tp[0] | (tp[1] << 8));
+    T2 = (int16_t)(tp[2] | (tp[3] << 8));
+    T3 = (int16_t)(tp[4] | (tp[5] << 8));
+    P1 = (uint16_t)(tp[6] | (tp[7] << 8));
+    P2 = (int16_t)(tp[8] | (tp[9] << 8));
+    P3 = (int16_t)(tp[10] | (tp[11] << 8));
+    P4 = (int16_t)(tp[12] | (tp[13] << 8));
+    P5 = (int16_t)(tp[14] | (tp[15] << 8));
+    P6 = (int16_t)(tp[16] | (tp[17] << 8));
+    P7 = (int16_t)(tp[18] | (tp[19] << 8));
+    P8 = (int16_t)(tp[20] | (tp[21] << 8));
+    P9 = (int16_t)(tp[22] | (tp[23] << 8));
+    H1 = tp[25];
+    H2 = (int16_t)(h[0] | (h[1] << 8));
+    H3 = h[2];
+    H4 = (int16_t)(((int8_t)h[3] * 16) | (h[4] & 0x0F));
+    H5 = (int16_t)(((int8_t)h[5] * 16) | (h[4] >> 4));
+    H6 = (int8_t)h[6];
+}
+
+void Bme280Calibration::serialise(uint8_t* tp, uint8_t* h) const {
+    const uint16_t words[12] = {T1, (uint16_t)T2, (uint16_t)T3, P1, (uint16_t)P2, (uint16_t)P3,
+                                (uint16_t)P4, (uint16_t)P5, (uint16_t)P6, (uint16_t)P7, (uint16_t)P8, (uint16_t)P9};
+    for (int i = 0; i < 12; ++i) {
+        tp[i * 2] = (uint8_t)(words[i] & 0xFF);
+        tp[i * 2 + 1] = (uint8_t)(words[i] >> 8);
+    }
+    tp[24] = 0;
+    tp[25] = H1;
+    h[0] = (uint8_t)(H2 & 0xFF);
+    h[1] = (uint8_t)((uint16_t)H2 >> 8);
+    h[2] = H3;
+    h[3] = (uint8_t)(H4 >> 4);
+    h[4] = (uint8_t)((H4 & 0x0F) | ((H5 & 0x0F) << 4));
+    h[5] = (uint8_t)(H5 >> 4);
+    h[6] = (uint8_t)H6;
+}
+
+int32_t Bme280Calibration::compensateT(int32_t adcT, int32_t& tFine) const {
+    int32_t var1 = ((((adcT >> 3) - ((int32_t)T1 << 1))) * ((int32_t)T2)) >> 11;
+    int32_t var2 = (((((adcT >> 4) - ((int32_t)T1)) * ((adcT >> 4) - ((int32_t)T1))) >> 12) * ((int32_t)T3)) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t Bme280Calibration::compensateP64(int32_t adcP, int32_t tFine) const {
+    int64_t var1 = ((int64_t)tFine) - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)P6;
+    var2 = var2 + ((var1 * (int64_t)P5) << 17);
+    var2 = var2 + (((int64_t)P4) << 35);
+    var1 = ((var1 * var1 * (int64_t)P3) >> 8) + ((var1 * (int64_t)P2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)P1) >> 33;
+    if (var1 == 0) return 0;
+    int64_t p = 1048576 - adcP;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)P9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((int64_t)P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)P7) << 4);
+    return (uint32_t)p;
+}
+
+uint32_t Bme280Calibration::compensateH(int32_t adcH, int32_t tFine) const {
+    int32_t v = tFine - ((int32_t)76800);
+    v = (((((adcH << 14) - (((int32_t)H4) << 20) - (((int32_t)H5) * v)) + ((int32_t)16384)) >> 15) *
+         (((((((v * ((int32_t)H6)) >> 10) * (((v * ((int32_t)H3)) >> 11) + ((int32_t)32768))) >> 10) +
+            ((int32_t)2097152)) * ((int32_t)H2) + 8192) >> 14));
+    v = (v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)H1)) >> 4));
+    v = (v < 0 ? 0 : v);
+    v = (v > 419430400 ? 419430400 : v);
+    return (uint32_t)(v >> 12);
+}
+
+double Bme280Calibration::compensateTDouble(int32_t adcT, double& tFine) const {
+    double var1 = (((double)adcT) / 16384.0 - ((double)T1) / 1024.0) * ((double)T2);
+    double var2 = ((((double)adcT) / 131072.0 - ((double)T1) / 8192.0) *
+                   (((double)adcT) / 131072.0 - ((double)T1) / 8192.0)) * ((double)T3);
+    tFine = var1 + var2;
+    return (var1 + var2) / 5120.0;
+}
+
+double Bme280Calibration::compensatePDouble(int32_t adcP, double tFine) const {
+    double var1 = (tFine / 2.0) - 64000.0;
+    double var2 = var1 * var1 * ((double)P6) / 32768.0;
+    var2 = var2 + var1 * ((double)P5) * 2.0;
+    var2 = (var2 / 4.0) + (((double)P4) * 65536.0);
+    var1 = (((double)P3) * var1 * var1 / 524288.0 + ((double)P2) * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * ((double)P1);
+    if (var1 == 0.0) return 0;
+    double p = 1048576.0 - (double)adcP;
+    p = (p - (var2 / 4096.0)) * 6250.0 / var1;
+    var1 = ((double)P9) * p * p / 2147483648.0;
+    var2 = p * ((double)P8) / 32768.0;
+    return p + (var1 + var2 + ((double)P7)) / 16.0;
+}
+
+double Bme280Calibration::compensateHDouble(int32_t adcH, double tFine) const {
+    double h = tFine - 76800.0;
+    h = (adcH - (((double)H4) * 64.0 + ((double)H5) / 16384.0 * h)) *
+        (((double)H2) / 65536.0 * (1.0 + ((double)H6) / 67108864.0 * h * (1.0 + ((double)H3) / 67108864.0 * h)));
+    h = h * (1.0 - ((double)H1) * h / 524288.0);
+    if (h > 100.0) h = 100.0;
+    else if (h < 0.0) h = 0.0;
+    return h;
+}
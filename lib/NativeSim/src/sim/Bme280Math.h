@@ -0,0 +1,34 @@
+#ifndef BME280_MATH_H
+#define BME280_MATH_H
+
+#include <stdint.h>
+
+// Trimming parameters and the compensation formulas from section 4.2.3 and
+// appendix 8 of the Bosch BME280 datasheet (BST-BME280-DS002). Shared by the
+// simulated sensor (which runs them backwards to synthesise ADC codes) and
+// the Adafruit_BME280 stand-in (which runs them forwards like the real
+// library does).
+struct Bme280Calibration {
+    uint16_t T1; int16_t T2; int16_t T3;
+    uint16_t P1; int16_t P2; int16_t P3; int16_t P4; int16_t P5;
+    int16_t P6; int16_t P7; int16_t P8; int16_t P9;
+    uint8_t H1; int16_t H2; uint8_t H3; int16_t H4; int16_t H5; int8_t H6;
+
+    // Parse the 0x88..0xA1 (26 bytes) and 0xE1..0xE7 (7 bytes) blocks.
+    void parse(const uint8_t* tp, const uint8_t* h);
+    // Serialise into the same two register blocks.
+    void serialise(uint8_t* tp, uint8_t* h) const;
+
+    // Integer versions; t_fine is produced by compensateT and consumed by
+    // compensateP64/compensateH.
+    int32_t compensateT(int32_t adcT, int32_t& tFine) const;         // 0.01 degC
+    uint32_t compensateP64(int32_t adcP, int32_t tFine) const;       // Q24.8 Pa
+    uint32_t compensateH(int32_t adcH, int32_t tFine) const;         // Q22.10 %RH
+
+    // Double precision versions.
+    double compensateTDouble(int32_t adcT, double& tFine) const;     // degC
+    double compensatePDouble(int32_t adcP, double tFine) const;      // Pa
+    double compensateHDouble(int32_t adcH, double tFine) const;      // %RH
+};
+
+#endif // BME280_MATH_H
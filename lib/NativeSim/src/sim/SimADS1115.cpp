@@ -0,0 +1,199 @@
+#include "sim/SimADS1115.h"
+#include "sim/SimClock.h"
+#include "sim/SimGpio.h"
+#include <Arduino.h>
+#include <math.h>
+
+static const uint16_t OS_BIT = 0x8000;
+static const uint16_t MODE_SINGLE = 0x0100;
+static const uint16_t COMP_MODE_WINDOW = 0x0010;
+static const uint16_t COMP_POL = 0x0008;
+static const uint16_t COMP_LAT = 0x0004;
+static const uint16_t COMP_QUE_MASK = 0x0003;
+static const float FULL_SCALE[8] = {6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f, 0.256f, 0.256f};
+static const uint16_t DATA_RATE[8] = {8, 16, 32, 64, 128, 250, 475, 860};
+
+SimADS1115::SimADS1115() : rng(1115) {
+    regs[REG_CONVERSION] = 0x0000;
+    regs[REG_CONFIG] = 0x8583;
+    regs[REG_LO_THRESH] = 0x8000;
+    regs[REG_HI_THRESH] = 0x7FFF;
+}
+
+void SimADS1115::setInputVoltage(int input, float volts) {
+    if (input >= 0 && input < 4) inputs[input] = volts;
+}
+
+float SimADS1115::getInputVoltage(int input) const {
+    return (input >= 0 && input < 4) ? inputs[input] : 0.0f;
+}
+
+void SimADS1115::setAlertPin(int gpio) {
+    alertPin = gpio;
+    setAlert(false);
+}
+
+bool SimADS1115::conversionReadyMode() const {
+    return (regs[REG_HI_THRESH] & 0x8000) && !(regs[REG_LO_THRESH] & 0x8000) &&
+           (regs[REG_CONFIG] & COMP_QUE_MASK) != COMP_QUE_MASK;
+}
+
+bool SimADS1115::comparatorEnabled() const {
+    return !conversionReadyMode() && (regs[REG_CONFIG] & COMP_QUE_MASK) != COMP_QUE_MASK;
+}
+
+void SimADS1115::updateComparator(int16_t code) {
+    if (!comparatorEnabled()) return;
+    uint16_t config = regs[REG_CONFIG];
+    int16_t lo = (int16_t)regs[REG_LO_THRESH];
+    int16_t hi = (int16_t)regs[REG_HI_THRESH];
+    bool window = config & COMP_MODE_WINDOW;
+    bool beyond = window ? (code > hi || code < lo) : code > hi;
+    bool back = window ? !beyond : code < lo;
+    static const uint8_t QUEUE[3] = {1, 2, 4};
+    if (beyond) {
+        if (comparatorCount < 255) comparatorCount++;
+        if (!comparatorAsserted && comparatorCount >= QUEUE[config & COMP_QUE_MASK]) {
+            comparatorAsserted = true;
+            setAlert(true);
+        }
+        return;
+    }
+    comparatorCount = 0;
+    if (comparatorAsserted && back && !(config & COMP_LAT)) {
+        comparatorAsserted = false;
+        setAlert(false);
+    }
+}
+
+// ALERT/RDY is open-drain: the inactive level comes from the pull-up, and
+// with neither conversion-ready mode nor the comparator on the pin is left
+// released
+void SimADS1115::setAlert(bool asserted) {
+    if (alertPin < 0) return;
+    if (!conversionReadyMode() && !comparatorEnabled()) {
+        SimGpio::releaseInput((uint8_t)alertPin);
+        return;
+    }
+    bool activeHigh = regs[REG_CONFIG] & COMP_POL;
+    if (asserted != activeHigh) SimGpio::driveInput((uint8_t)alertPin, LOW);
+    else SimGpio::releaseInput((uint8_t)alertPin);
+    if (asserted) alerts++;
+}
+
+uint64_t SimADS1115::conversionTimeUs() const {
+    uint16_t sps = DATA_RATE[(regs[REG_CONFIG] >> 5) & 0x07];
+    // Datasheet: conversion takes 1/DR plus ~25 us wake-up in single-shot mode
+    return 1000000ULL / sps + 25;
+}
+
+int16_t SimADS1115::sampleCode() {
+    uint16_t config = regs[REG_CONFIG];
+    int mux = (config >> 12) & 0x07;
+    float volts;
+    switch (mux) {
+        case 0: volts = inputs[0] - inputs[1]; break;
+        case 1: volts = inputs[0] - inputs[3]; break;
+        case 2: volts = inputs[1] - inputs[3]; break;
+        case 3: volts = inputs[2] - inputs[3]; break;
+        default: volts = inputs[mux - 4]; break;
+    }
+    if (noiseRms > 0.0f) {
+        std::normal_distribution<float> noise(0.0f, noiseRms);
+        volts += noise(rng);
+    }
+    float fsr = FULL_SCALE[(config >> 9) & 0x07];
+    long code = lroundf(volts / fsr * 32768.0f);
+    if (code > 32767) code = 32767;
+    if (code < -32768) code = -32768;
+    return (int16_t)code;
+}
+
+void SimADS1115::startConversion() {
+    converting = true;
+    conversionDoneUs = SimClock::nowMicros() + conversionTimeUs();
+    regs[REG_CONFIG] &= (uint16_t)~OS_BIT;
+    setAlert(false);
+}
+
+void SimADS1115::completeConversion() {
+    regs[REG_CONVERSION] = (uint16_t)sampleCode();
+    conversions++;
+    resultUnread = true;
+    updateComparator((int16_t)regs[REG_CONVERSION]);
+    bool ready = conversionReadyMode();
+    if (regs[REG_CONFIG] & MODE_SINGLE) {
+        converting = false;
+        regs[REG_CONFIG] |= OS_BIT;
+        if (ready) setAlert(true);
+    } else {
+        conversionDoneUs += conversionTimeUs();
+        // ~8 us pulse at the end of each conversion
+        if (ready) {
+            setAlert(true);
+            setAlert(false);
+        }
+    }
+}
+
+void SimADS1115::tick() {
+    uint64_t now = SimClock::nowMicros();
+    // In continuous mode only the most recent result is observable, so
+    // skip straight to the last conversion that finished before now.
+    if (converting && !(regs[REG_CONFIG] & MODE_SINGLE) && now > conversionDoneUs) {
+        uint64_t period = conversionTimeUs();
+        uint64_t missed = (now - conversionDoneUs) / period;
+        conversionDoneUs += missed * period;
+        // The comparator saw those conversions too; four fill any queue
+        for (uint64_t i = 0; i < missed && i < 4 && comparatorEnabled(); ++i) updateComparator(sampleCode());
+    }
+    while (converting && now >= conversionDoneUs) {
+        completeConversion();
+    }
+}
+
+bool SimADS1115::onWrite(const uint8_t* data, size_t len) {
+    tick();
+    if (len == 0) return true;
+    pointer = data[0] & 0x03;
+    if (len < 3) return true;
+    uint16_t value = (uint16_t)((data[1] << 8) | data[2]);
+    if (pointer == REG_CONVERSION) return true; // read-only
+    if (pointer == REG_CONFIG) {
+        bool start = value & OS_BIT;
+        regs[REG_CONFIG] = (uint16_t)((value & ~OS_BIT) | (regs[REG_CONFIG] & OS_BIT));
+        comparatorAsserted = false;
+        comparatorCount = 0;
+        if (!(value & MODE_SINGLE)) {
+            if (!converting) startConversion();
+        } else if (start && !converting) {
+            startConversion();
+        } else if (!converting) {
+            regs[REG_CONFIG] |= OS_BIT;
+        }
+        if (!conversionReadyMode()) setAlert(false);
+        if (configHook) configHook(configHookArg, value);
+        return true;
+    }
+    regs[pointer] = value;
+    if (!conversionReadyMode()) setAlert(false);
+    return true;
+}
+
+size_t SimADS1115::onRead(uint8_t* data, size_t len) {
+    tick();
+    uint16_t value = regs[pointer];
+    if (pointer == REG_CONVERSION && len > 0) {
+        if (!resultUnread) staleReads++;
+        resultUnread = false;
+        if (comparatorAsserted && (regs[REG_CONFIG] & COMP_LAT)) {
+            comparatorAsserted = false;
+            comparatorCount = 0;
+            setAlert(false);
+        }
+    }
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = (i % 2 == 0) ? (uint8_t)(value >> 8) : (uint8_t)(value & 0xFF);
+    }
+    return len;
+}
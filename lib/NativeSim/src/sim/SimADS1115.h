@@ -0,0 +1,76 @@
+#ifndef SIM_ADS1115_H
+#define SIM_ADS1115_H
+
+#include "sim/SimI2CBus.h"
+#include <random>
+
+// Register-level model of a TI ADS1115: pointer register, config,
+// conversion and threshold registers, single-shot and continuous modes
+// with data-rate dependent conversion time.
+//
+// With an ALERT/RDY GPIO set, the pin follows conversion-ready mode (Hi_thresh
+// MSB set, Lo_thresh MSB clear, comparator queue enabled): in single-shot
+// it is released while converting and asserted when the result is ready,
+// in continuous mode it pulses once per conversion. COMP_POL picks the
+// active level.
+//
+// Otherwise, with the comparator queue enabled, the pin follows the
+// comparator: traditional mode asserts above Hi_thresh and releases below
+// Lo_thresh, window mode asserts outside [Lo_thresh, Hi_thresh] and
+// releases inside. It asserts after 1, 2 or 4 consecutive conversions per
+// COMP_QUE. With COMP_LAT it stays asserted until the conversion register
+// is read. Writing the config register resets the comparator.
+class SimADS1115 : public SimI2CDevice {
+public:
+    SimADS1115();
+    bool onWrite(const uint8_t* data, size_t len) override;
+    size_t onRead(uint8_t* data, size_t len) override;
+    void tick() override;
+
+    // Analog front end: per-input voltage plus gaussian noise (V rms).
+    void setInputVoltage(int input, float volts);
+    float getInputVoltage(int input) const;
+    void setNoise(float voltsRms) { noiseRms = voltsRms; }
+
+    uint16_t getConfig() const { return regs[REG_CONFIG]; }
+    uint32_t getConversionCount() const { return conversions; }
+    // Conversion register reads that returned a result already read
+    uint32_t getStaleReads() const { return staleReads; }
+    void setAlertPin(int gpio);
+    uint32_t getAlertCount() const { return alerts; } // Times ALERT/RDY asserted
+    bool isComparatorAsserted() const { return comparatorAsserted; }
+    // Called on the writing thread after each config register write, e.g.
+    // to make another thread act at an exact point of a driver sequence
+    typedef void (*ConfigHook)(void* arg, uint16_t config);
+    void setConfigHook(ConfigHook hook, void* arg) { configHook = hook; configHookArg = arg; }
+
+private:
+    enum { REG_CONVERSION = 0, REG_CONFIG = 1, REG_LO_THRESH = 2, REG_HI_THRESH = 3 };
+    uint16_t regs[4];
+    uint8_t pointer = REG_CONVERSION;
+    bool converting = false;
+    uint64_t conversionDoneUs = 0;
+    float inputs[4] = {0, 0, 0, 0};
+    float noiseRms = 0.0f;
+    uint32_t conversions = 0;
+    bool resultUnread = false;
+    uint32_t staleReads = 0;
+    int alertPin = -1;
+    uint32_t alerts = 0;
+    bool comparatorAsserted = false;
+    uint8_t comparatorCount = 0; // Consecutive conversions out of bounds
+    ConfigHook configHook = nullptr;
+    void* configHookArg = nullptr;
+    std::mt19937 rng;
+
+    uint64_t conversionTimeUs() const;
+    int16_t sampleCode();
+    void startConversion();
+    void completeConversion();
+    bool conversionReadyMode() const;
+    bool comparatorEnabled() const;
+    void updateComparator(int16_t code);
+    void setAlert(bool asserted);
+};
+
+#endif // SIM_ADS1115_H
@@ -0,0 +1,215 @@
+#include "sim/SimBME280.h"
+#include "sim/SimClock.h"
+#include <math.h>
+#include <string.h>
+
+enum {
+    REG_CALIB_TP = 0x88, REG_CHIP_ID = 0xD0, REG_RESET = 0xE0, REG_CALIB_H = 0xE1,
+    REG_CTRL_HUM = 0xF2, REG_STATUS = 0xF3, REG_CTRL_MEAS = 0xF4, REG_CONFIG = 0xF5,
+    REG_PRESS = 0xF7, REG_TEMP = 0xFA, REG_HUM = 0xFD
+};
+static const uint8_t OSR_COUNT[8] = {0, 1, 2, 4, 8, 16, 16, 16};
+static const uint32_t STANDBY_US[8] = {500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000};
+static const uint8_t FILTER_COEFF[8] = {1, 2, 4, 8, 16, 16, 16, 16};
+
+SimBME280::SimBME280() : rng(280) {
+    // Trimming values from the worked example in the BMP280 datasheet
+    // (section 8.1) for T and P; humidity trimming from a production part.
+    calib.T1 = 27504; calib.T2 = 26435; calib.T3 = -1000;
+    calib.P1 = 36477; calib.P2 = -10685; calib.P3 = 3024; calib.P4 = 2855;
+    calib.P5 = 140; calib.P6 = -7; calib.P7 = 15500; calib.P8 = -14600; calib.P9 = 6000;
+    calib.H1 = 75; calib.H2 = 370; calib.H3 = 0; calib.H4 = 313; calib.H5 = 50; calib.H6 = 30;
+    reset();
+}
+
+void SimBME280::reset() {
+    memset(regs, 0, sizeof(regs));
+    regs[REG_CHIP_ID] = 0x60;
+    calib.serialise(&regs[REG_CALIB_TP], &regs[REG_CALIB_H]);
+    regs[REG_PRESS] = 0x80;
+    regs[REG_TEMP] = 0x80;
+    regs[REG_HUM] = 0x80;
+    measuring = false;
+    filterPrimed = false;
+    nvmCopyDoneUs = SimClock::nowMicros() + 2000;
+}
+
+void SimBME280::setEnvironment(float temperatureC, float humidityPct, float pressurePa) {
+    envT = temperatureC;
+    envH = humidityPct;
+    envP = pressurePa;
+}
+
+void SimBME280::setNoise(float temperatureC, float humidityPct, float pressurePa) {
+    noiseT = temperatureC;
+    noiseH = humidityPct;
+    noiseP = pressurePa;
+}
+
+uint64_t SimBME280::measurementTimeUs() const {
+    int osrsT = OSR_COUNT[(regs[REG_CTRL_MEAS] >> 5) & 0x07];
+    int osrsP = OSR_COUNT[(regs[REG_CTRL_MEAS] >> 2) & 0x07];
+    int osrsH = OSR_COUNT[regs[REG_CTRL_HUM] & 0x07];
+    double ms = 1.25 + 2.3 * osrsT;
+    if (osrsP) ms += 2.3 * osrsP + 0.575;
+    if (osrsH) ms += 2.3 * osrsH + 0.575;
+    return (uint64_t)(ms * 1000.0);
+}
+
+uint64_t SimBME280::typicalMeasurementTimeUs() const {
+    int osrsT = OSR_COUNT[(regs[REG_CTRL_MEAS] >> 5) & 0x07];
+    int osrsP = OSR_COUNT[(regs[REG_CTRL_MEAS] >> 2) & 0x07];
+    int osrsH = OSR_COUNT[regs[REG_CTRL_HUM] & 0x07];
+    double ms = 1.0 + 2.0 * osrsT;
+    if (osrsP) ms += 2.0 * osrsP + 0.5;
+    if (osrsH) ms += 2.0 * osrsH + 0.5;
+    return (uint64_t)(ms * 1000.0);
+}
+
+uint64_t SimBME280::standbyUs() const {
+    return STANDBY_US[(regs[REG_CONFIG] >> 5) & 0x07];
+}
+
+void SimBME280::startMeasurement(uint64_t atUs) {
+    measuring = true;
+    measureDoneUs = atUs + typicalMeasurementTimeUs();
+}
+
+int32_t SimBME280::rawTemperature(double degC, double& tFine) const {
+    int32_t lo = 0, hi = (1 << 20) - 1;
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        double tf;
+        if (calib.compensateTDouble(mid, tf) < degC) lo = mid + 1;
+        else hi = mid;
+    }
+    calib.compensateTDouble(lo, tFine);
+    return lo;
+}
+
+int32_t SimBME280::rawPressure(double pa, double tFine) const {
+    // Pressure falls as the ADC code rises
+    int32_t lo = 0, hi = (1 << 20) - 1;
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        if (calib.compensatePDouble(mid, tFine) > pa) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int32_t SimBME280::rawHumidity(double pct, double tFine) const {
+    int32_t lo = 0, hi = 0xFFFF;
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        if (calib.compensateHDouble(mid, tFine) < pct) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+void SimBME280::completeMeasurement() {
+    int osrsT = OSR_COUNT[(regs[REG_CTRL_MEAS] >> 5) & 0x07];
+    int osrsP = OSR_COUNT[(regs[REG_CTRL_MEAS] >> 2) & 0x07];
+    int osrsH = OSR_COUNT[regs[REG_CTRL_HUM] & 0x07];
+    std::normal_distribution<double> unit(0.0, 1.0);
+    double t = envT + (osrsT ? noiseT / sqrt((double)osrsT) * unit(rng) : 0.0);
+    double p = envP + (osrsP ? noiseP / sqrt((double)osrsP) * unit(rng) : 0.0);
+    double h = envH + (osrsH ? noiseH / sqrt((double)osrsH) * unit(rng) : 0.0);
+
+    // The IIR filter runs on T and P only (datasheet 3.4.4)
+    int coeff = FILTER_COEFF[(regs[REG_CONFIG] >> 2) & 0x07];
+    if (!filterPrimed || coeff == 1) {
+        filteredT = t;
+        filteredP = p;
+        filterPrimed = true;
+    } else {
+        filteredT = (filteredT * (coeff - 1) + t) / coeff;
+        filteredP = (filteredP * (coeff - 1) + p) / coeff;
+    }
+
+    double tFine;
+    int32_t adcT = rawTemperature(filteredT, tFine);
+    int32_t adcP = rawPressure(filteredP, tFine);
+    int32_t adcH = rawHumidity(h, tFine);
+    if (osrsT) {
+        regs[REG_TEMP] = (uint8_t)(adcT >> 12);
+        regs[REG_TEMP + 1] = (uint8_t)(adcT >> 4);
+        regs[REG_TEMP + 2] = (uint8_t)((adcT & 0x0F) << 4);
+    }
+    if (osrsP) {
+        regs[REG_PRESS] = (uint8_t)(adcP >> 12);
+        regs[REG_PRESS + 1] = (uint8_t)(adcP >> 4);
+        regs[REG_PRESS + 2] = (uint8_t)((adcP & 0x0F) << 4);
+    }
+    if (osrsH) {
+        regs[REG_HUM] = (uint8_t)(adcH >> 8);
+        regs[REG_HUM + 1] = (uint8_t)(adcH & 0xFF);
+    }
+    measurements++;
+}
+
+void SimBME280::tick() {
+    uint64_t now = SimClock::nowMicros();
+    if (mode() == 0x03) {
+        // Normal mode: measure, stand by, repeat. After a long gap only the
+        // last few cycles matter since the filter has converged by then.
+        uint64_t period = typicalMeasurementTimeUs() + standbyUs();
+        if (measuring && now >= measureDoneUs) {
+            uint64_t missed = (now - measureDoneUs) / period;
+            if (missed > 64) measureDoneUs += (missed - 64) * period;
+        }
+        while (measuring && now >= measureDoneUs) {
+            completeMeasurement();
+            measureDoneUs += period;
+        }
+    } else if (measuring && now >= measureDoneUs) {
+        completeMeasurement();
+        measuring = false;
+        regs[REG_CTRL_MEAS] &= (uint8_t)~0x03; // forced mode returns to sleep
+    }
+    uint8_t status = 0;
+    if (measuring && now + typicalMeasurementTimeUs() >= measureDoneUs) status |= 0x08;
+    if (now < nvmCopyDoneUs) status |= 0x01;
+    regs[REG_STATUS] = status;
+}
+
+bool SimBME280::onWrite(const uint8_t* data, size_t len) {
+    tick();
+    if (len == 0) return true;
+    pointer = data[0];
+    // Writes are (register, value) pairs after the first pointer byte
+    for (size_t i = 1; i < len; i += 2) {
+        uint8_t reg = (i == 1) ? pointer : data[i - 1];
+        uint8_t value = data[i];
+        if (reg == REG_RESET) {
+            if (value == 0xB6) reset();
+        } else if (reg == REG_CTRL_HUM) {
+            regs[reg] = value & 0x07;
+        } else if (reg == REG_CONFIG) {
+            regs[reg] = value;
+        } else if (reg == REG_CTRL_MEAS) {
+            uint8_t previousMode = mode();
+            regs[reg] = value;
+            uint8_t newMode = value & 0x03;
+            if (newMode == 0x01 || newMode == 0x02) {
+                if (!measuring) startMeasurement(SimClock::nowMicros());
+            } else if (newMode == 0x03 && previousMode != 0x03) {
+                startMeasurement(SimClock::nowMicros());
+            } else if (newMode == 0x00 && previousMode == 0x03) {
+                measuring = false;
+            }
+        }
+    }
+    tick();
+    return true;
+}
+
+size_t SimBME280::onRead(uint8_t* data, size_t len) {
+    tick();
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = regs[pointer];
+        pointer++;
+    }
+    return len;
+}
@@ -0,0 +1,56 @@
+#ifndef SIM_BME280_H
+#define SIM_BME280_H
+
+#include "sim/SimI2CBus.h"
+#include "sim/Bme280Math.h"
+#include <random>
+
+// Register-level model of a Bosch BME280: chip id, soft reset, trimming
+// NVM, ctrl_hum/ctrl_meas/config, the status measuring bit, forced and
+// normal mode timing (datasheet 9.1) and the IIR filter on T and P. A
+// measurement takes the datasheet's typical time, as real parts mostly do;
+// firmware has to allow for the maximum.
+class SimBME280 : public SimI2CDevice {
+public:
+    SimBME280();
+    bool onWrite(const uint8_t* data, size_t len) override;
+    size_t onRead(uint8_t* data, size_t len) override;
+    void tick() override;
+
+    // Ambient conditions the sensor observes.
+    void setEnvironment(float temperatureC, float humidityPct, float pressurePa);
+    // RMS noise at oversampling x1; scaled by 1/sqrt(osr) like the datasheet.
+    void setNoise(float temperatureC, float humidityPct, float pressurePa);
+    const Bme280Calibration& getCalibration() const { return calib; }
+    uint32_t getMeasurementCount() const { return measurements; }
+
+    // Datasheet 9.1 maximum and typical measurement time for the current
+    // ctrl registers.
+    uint64_t measurementTimeUs() const;
+    uint64_t typicalMeasurementTimeUs() const;
+
+private:
+    uint8_t regs[256];
+    uint8_t pointer = 0;
+    Bme280Calibration calib;
+    float envT = 21.0f, envH = 50.0f, envP = 101325.0f;
+    float noiseT = 0.02f, noiseH = 0.07f, noiseP = 3.3f;
+    bool measuring = false;
+    uint64_t measureDoneUs = 0;
+    uint64_t nvmCopyDoneUs = 0;
+    bool filterPrimed = false;
+    double filteredT = 0, filteredP = 0;
+    uint32_t measurements = 0;
+    std::mt19937 rng;
+
+    void reset();
+    uint8_t mode() const { return regs[0xF4] & 0x03; }
+    uint64_t standbyUs() const;
+    void startMeasurement(uint64_t atUs);
+    void completeMeasurement();
+    int32_t rawTemperature(double degC, double& tFine) const;
+    int32_t rawPressure(double pa, double tFine) const;
+    int32_t rawHumidity(double pct, double tFine) const;
+};
+
+#endif // SIM_BME280_H
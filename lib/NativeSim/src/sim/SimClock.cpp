@@ -0,0 +1,63 @@
+#include "sim/SimClock.h"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <thread>
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+static int64_t utcAtBoot = (int64_t)time(nullptr);
+static std::atomic<bool> virtualMode(false);
+static std::atomic<uint64_t> virtualNow(0);
+static SimClock::WaitHook waitHook = nullptr;
+
+static uint64_t realMicros() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+}
+
+uint64_t SimClock::nowMicros() {
+    return virtualMode ? virtualNow.load() : realMicros();
+}
+
+void SimClock::sleepMicros(uint64_t us) {
+    if (virtualMode) {
+        virtualNow += us;
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void SimClock::setVirtual(bool enabled) {
+    if (enabled == virtualMode) return;
+    // Continue from the current reading so time never runs backwards.
+    if (enabled) virtualNow = realMicros();
+    virtualMode = enabled;
+}
+
+bool SimClock::isVirtual() {
+    return virtualMode;
+}
+
+void SimClock::elapseMicros(uint64_t us) {
+    if (virtualMode) virtualNow += us;
+}
+
+void SimClock::advanceTo(uint64_t us) {
+    if (virtualMode && us > virtualNow) virtualNow = us;
+}
+
+void SimClock::setWaitHook(WaitHook hook) {
+    waitHook = hook;
+}
+
+SimClock::WaitHook SimClock::getWaitHook() {
+    return waitHook;
+}
+
+uint32_t SimClock::unixTimeUtc() {
+    return (uint32_t)(utcAtBoot + (int64_t)(nowMicros() / 1000000ULL));
+}
+
+void SimClock::setUnixTimeUtc(uint32_t unixTime) {
+    utcAtBoot = (int64_t)unixTime - (int64_t)(nowMicros() / 1000000ULL);
+}
@@ -0,0 +1,39 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <stdint.h>
+
+// Time base for the native build. millis()/micros(), delay() and vTaskDelay()
+// all go through here so the firmware sees one consistent clock.
+//
+// In real-time mode the clock follows the host's steady clock. In virtual
+// mode it only moves when the firmware sleeps, when simulated hardware
+// charges time (I2C transfers) or when a harness calls advanceTo(); this is
+// what lets SimScheduler skip straight to the next deadline.
+class SimClock {
+public:
+    static uint64_t nowMicros();
+    static void sleepMicros(uint64_t us);
+
+    static void setVirtual(bool enabled);
+    static bool isVirtual();
+    // Virtual mode only: account for time spent in simulated hardware.
+    // No-op in real-time mode, where the host clock already moves.
+    static void elapseMicros(uint64_t us);
+    // Virtual mode only: jump forward to an absolute time.
+    static void advanceTo(uint64_t us);
+
+    // Called repeatedly while the firmware blocks on a binary semaphore
+    // (an ISR handshake) so simulated peripherals get to raise the
+    // interrupt it is waiting for.
+    typedef void (*WaitHook)();
+    static void setWaitHook(WaitHook hook);
+    static WaitHook getWaitHook();
+
+    // UTC wall clock of the simulated world, used to answer NTP. Defaults
+    // to the host clock at start-up.
+    static uint32_t unixTimeUtc();
+    static void setUnixTimeUtc(uint32_t unixTime);
+};
+
+#endif // SIM_CLOCK_H
@@ -0,0 +1,212 @@
+#include "sim/SimDS3231.h"
+#include "sim/SimClock.h"
+#include "sim/SimGpio.h"
+#include <Arduino.h>
+#include <string.h>
+
+enum {
+    REG_SECONDS = 0x00, REG_ALARM1 = 0x07, REG_ALARM2 = 0x0B,
+    REG_CONTROL = 0x0E, REG_STATUS = 0x0F, REG_TEMP_MSB = 0x11
+};
+static const uint8_t CTRL_INTCN = 0x04, CTRL_A2IE = 0x02, CTRL_A1IE = 0x01;
+static const uint8_t STAT_OSF = 0x80, STAT_A2F = 0x02, STAT_A1F = 0x01;
+
+static uint8_t bin2bcd(int v) { return (uint8_t)(((v / 10) << 4) | (v % 10)); }
+static int bcd2bin(uint8_t v) { return (v >> 4) * 10 + (v & 0x0F); }
+
+// Howard Hinnant's civil calendar conversions
+static long daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const long era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (long)doe - 719468;
+}
+
+static void civilFromDays(long z, int& y, int& m, int& d) {
+    z += 719468;
+    const long era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = (unsigned)(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    y = (int)(yoe + era * 400 + (m <= 2));
+}
+
+SimDS3231::SimDS3231() {
+    memset(regs, 0, sizeof(regs));
+    regs[REG_CONTROL] = 0x1C;  // power-on default: INTCN set, RS2/RS1 set
+    regs[REG_STATUS] = 0x08;   // EN32kHz
+    regs[REG_TEMP_MSB] = 25;
+    setTime(946684800UL);      // 2000-01-01 00:00:00
+}
+
+void SimDS3231::setTime(uint32_t unixTime) {
+    baseTime = unixTime;
+    baseMicros = SimClock::nowMicros();
+    lastEvaluated = unixTime;
+    syncTimeRegisters();
+}
+
+uint32_t SimDS3231::getTime() const {
+    return baseTime + (uint32_t)((SimClock::nowMicros() - baseMicros) / 1000000ULL);
+}
+
+uint64_t SimDS3231::microsAt(uint32_t rtcTime) const {
+    if (rtcTime <= baseTime) return baseMicros;
+    return baseMicros + (uint64_t)(rtcTime - baseTime) * 1000000ULL;
+}
+
+void SimDS3231::setLostPower(bool lost) {
+    if (lost) regs[REG_STATUS] |= STAT_OSF;
+    else regs[REG_STATUS] &= (uint8_t)~STAT_OSF;
+}
+
+void SimDS3231::syncTimeRegisters() {
+    uint32_t t = getTime();
+    long days = (long)(t / 86400UL);
+    uint32_t secs = t % 86400UL;
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    regs[0] = bin2bcd(secs % 60);
+    regs[1] = bin2bcd((secs / 60) % 60);
+    regs[2] = bin2bcd(secs / 3600);          // 24-hour mode
+    regs[3] = (uint8_t)(((days + 4) % 7) + 1); // 1970-01-01 was a Thursday; 1 = Sunday
+    regs[4] = bin2bcd(d);
+    regs[5] = bin2bcd(m) | (y >= 2100 ? 0x80 : 0);
+    regs[6] = bin2bcd(y % 100);
+}
+
+void SimDS3231::latchTimeRegisters() {
+    int sec = bcd2bin(regs[0] & 0x7F);
+    int min = bcd2bin(regs[1] & 0x7F);
+    int hour = bcd2bin(regs[2] & 0x3F);
+    int day = bcd2bin(regs[4] & 0x3F);
+    int month = bcd2bin(regs[5] & 0x1F);
+    int year = 2000 + bcd2bin(regs[6]) + ((regs[5] & 0x80) ? 100 : 0);
+    long days = daysFromCivil(year, (unsigned)month, (unsigned)day);
+    setTime((uint32_t)(days * 86400L + hour * 3600L + min * 60L + sec));
+}
+
+// Alarm register layout: [sec (A1 only)] min hour day/date, bit 7 of each
+// byte is the AxMy mask bit; bit 6 of day/date selects day-of-week.
+bool SimDS3231::alarmMatches(int alarm, uint32_t t) const {
+    const uint8_t* a = alarm == 1 ? &regs[REG_ALARM1] : &regs[REG_ALARM2] - 1;
+    uint32_t secs = t % 86400UL;
+    long days = (long)(t / 86400UL);
+    int y, m, d;
+    civilFromDays(days, y, m, d);
+    int dow = (int)((days + 4) % 7) + 1;
+    if (alarm == 1) {
+        if (!(a[0] & 0x80) && bcd2bin(a[0] & 0x7F) != (int)(secs % 60)) return false;
+    } else if (secs % 60 != 0) {
+        return false;
+    }
+    if (!(a[1] & 0x80) && bcd2bin(a[1] & 0x7F) != (int)((secs / 60) % 60)) return false;
+    if (!(a[2] & 0x80) && bcd2bin(a[2] & 0x3F) != (int)(secs / 3600)) return false;
+    if (!(a[3] & 0x80)) {
+        if (a[3] & 0x40) {
+            if ((a[3] & 0x0F) != dow) return false;
+        } else if (bcd2bin(a[3] & 0x3F) != d) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t SimDS3231::nextAlarmTime(int alarm, uint32_t after) const {
+    uint8_t enableBit = alarm == 1 ? CTRL_A1IE : CTRL_A2IE;
+    if (!(regs[REG_CONTROL] & enableBit)) return 0;
+    // Narrow the search with the coarsest unmasked field, then scan. Every
+    // mode repeats at least once per 31 days.
+    uint32_t step = 1;
+    const uint8_t* a = alarm == 1 ? &regs[REG_ALARM1] : &regs[REG_ALARM2] - 1;
+    if (alarm == 2 || !(a[0] & 0x80)) step = 60;
+    uint32_t t = after + 1;
+    if (step == 60) t = ((t + 59) / 60) * 60;
+    if (alarm == 1 && !(a[0] & 0x80)) t += (uint32_t)((bcd2bin(a[0] & 0x7F) - (int)(t % 60) + 60) % 60);
+    for (uint32_t limit = t + 32UL * 86400UL; t < limit; t += step) {
+        if (alarmMatches(alarm, t)) return t;
+    }
+    return 0;
+}
+
+void SimDS3231::evaluateAlarms() {
+    uint32_t now = getTime();
+    if (now <= lastEvaluated) return;
+    for (int alarm = 1; alarm <= 2; ++alarm) {
+        uint8_t flag = alarm == 1 ? STAT_A1F : STAT_A2F;
+        if (regs[REG_STATUS] & flag) continue;
+        // The flag sets whether or not the interrupt is enabled, so scan
+        // for matches directly rather than through nextAlarmTime().
+        uint32_t t = lastEvaluated + 1;
+        if (now - lastEvaluated > 60) {
+            uint8_t saved = regs[REG_CONTROL];
+            regs[REG_CONTROL] |= CTRL_A1IE | CTRL_A2IE;
+            uint32_t next = nextAlarmTime(alarm, lastEvaluated);
+            regs[REG_CONTROL] = saved;
+            if (next && next <= now) regs[REG_STATUS] |= flag;
+            continue;
+        }
+        for (; t <= now; ++t) {
+            if (alarmMatches(alarm, t)) {
+                regs[REG_STATUS] |= flag;
+                break;
+            }
+        }
+    }
+    lastEvaluated = now;
+}
+
+void SimDS3231::updateIntPin() {
+    if (intPin < 0) return;
+    uint8_t ctrl = regs[REG_CONTROL];
+    uint8_t stat = regs[REG_STATUS];
+    bool asserted = (ctrl & CTRL_INTCN) &&
+                    (((ctrl & CTRL_A1IE) && (stat & STAT_A1F)) || ((ctrl & CTRL_A2IE) && (stat & STAT_A2F)));
+    if (asserted) SimGpio::driveInput((uint8_t)intPin, LOW);
+    else SimGpio::releaseInput((uint8_t)intPin);
+}
+
+void SimDS3231::tick() {
+    evaluateAlarms();
+    updateIntPin();
+}
+
+bool SimDS3231::onWrite(const uint8_t* data, size_t len) {
+    tick();
+    if (len == 0) return true;
+    syncTimeRegisters();
+    pointer = data[0];
+    bool timeWritten = false;
+    for (size_t i = 1; i < len; ++i) {
+        uint8_t reg = pointer;
+        if (reg < sizeof(regs)) {
+            if (reg == REG_STATUS) {
+                // Alarm and OSF flags can only be cleared by writing 0
+                uint8_t clearable = STAT_OSF | STAT_A2F | STAT_A1F;
+                regs[reg] = (uint8_t)((data[i] & ~clearable) | (regs[reg] & data[i] & clearable));
+            } else if (reg < REG_TEMP_MSB) {
+                regs[reg] = data[i];
+            }
+            if (reg <= 0x06) timeWritten = true;
+        }
+        pointer = (uint8_t)((pointer + 1) % sizeof(regs));
+    }
+    if (timeWritten) latchTimeRegisters();
+    updateIntPin();
+    return true;
+}
+
+size_t SimDS3231::onRead(uint8_t* data, size_t len) {
+    tick();
+    syncTimeRegisters();
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = pointer < sizeof(regs) ? regs[pointer] : 0;
+        pointer = (uint8_t)((pointer + 1) % sizeof(regs));
+    }
+    return len;
+}
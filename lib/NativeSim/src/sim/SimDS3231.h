@@ -0,0 +1,43 @@
+#ifndef SIM_DS3231_H
+#define SIM_DS3231_H
+
+#include "sim/SimI2CBus.h"
+
+// Register-level model of a Maxim DS3231: BCD time keeping driven by
+// SimClock, both alarms with their mask modes, the control/status flags
+// and the active-low INT/SQW output.
+class SimDS3231 : public SimI2CDevice {
+public:
+    SimDS3231();
+    bool onWrite(const uint8_t* data, size_t len) override;
+    size_t onRead(uint8_t* data, size_t len) override;
+    void tick() override;
+
+    // Seconds since 1970-01-01 in whatever zone the firmware keeps the RTC
+    // (local time for this project).
+    void setTime(uint32_t unixTime);
+    uint32_t getTime() const;
+    // SimClock time at which the RTC will read rtcTime (00 of that second).
+    uint64_t microsAt(uint32_t rtcTime) const;
+    // First second strictly after 'after' at which alarm 1/2 matches, or 0
+    // if the alarm is not enabled.
+    uint32_t nextAlarmTime(int alarm, uint32_t after) const;
+    void setIntPin(int gpio) { intPin = gpio; updateIntPin(); }
+    void setLostPower(bool lost);
+
+private:
+    uint8_t regs[0x13];
+    uint8_t pointer = 0;
+    uint32_t baseTime = 0;
+    uint64_t baseMicros = 0;
+    uint32_t lastEvaluated = 0;
+    int intPin = -1;
+
+    void syncTimeRegisters();
+    void latchTimeRegisters();
+    bool alarmMatches(int alarm, uint32_t t) const;
+    void evaluateAlarms();
+    void updateIntPin();
+};
+
+#endif // SIM_DS3231_H
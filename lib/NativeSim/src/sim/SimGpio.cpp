@@ -0,0 +1,116 @@
+#include "sim/SimGpio.h"
+#include <Arduino.h>
+
+struct PinState {
+    uint8_t mode = INPUT;
+    uint8_t outputLevel = LOW;
+    bool driven = false;
+    uint8_t drivenLevel = HIGH;
+    uint16_t analogMv = 0;
+    uint16_t touchValue = 80;
+    void (*isr)(void) = nullptr;
+    void (*isrWithArg)(void*) = nullptr;
+    void* isrArg = nullptr;
+    int isrMode = 0;
+};
+
+static PinState pins[SimGpio::PIN_COUNT];
+static SimGpio::OutputListener outputListener = nullptr;
+static uint32_t changeCount = 0;
+
+void SimGpio::setMode(uint8_t pin, uint8_t mode) {
+    if (pin < PIN_COUNT) pins[pin].mode = mode;
+}
+
+uint8_t SimGpio::getMode(uint8_t pin) {
+    return pin < PIN_COUNT ? pins[pin].mode : INPUT;
+}
+
+void SimGpio::writeOutput(uint8_t pin, uint8_t level) {
+    if (pin >= PIN_COUNT) return;
+    level = level ? HIGH : LOW;
+    bool changed = pins[pin].outputLevel != level;
+    pins[pin].outputLevel = level;
+    if (!changed) return;
+    changeCount++;
+    if (outputListener) outputListener(pin, level);
+}
+
+uint8_t SimGpio::readLevel(uint8_t pin) {
+    if (pin >= PIN_COUNT) return LOW;
+    const PinState& p = pins[pin];
+    if (p.mode == OUTPUT) return p.outputLevel;
+    if (p.driven) return p.drivenLevel;
+    if (p.mode == INPUT_PULLUP) return HIGH;
+    return LOW;
+}
+
+static void fireOnEdge(uint8_t pin, uint8_t before, uint8_t after) {
+    const PinState& p = pins[pin];
+    if ((!p.isr && !p.isrWithArg) || before == after) return;
+    bool rising = after == HIGH;
+    if (p.isrMode == CHANGE || (p.isrMode == RISING && rising) || (p.isrMode == FALLING && !rising)) {
+        if (p.isr) p.isr();
+        else p.isrWithArg(p.isrArg);
+    }
+}
+
+void SimGpio::driveInput(uint8_t pin, uint8_t level) {
+    if (pin >= PIN_COUNT) return;
+    uint8_t before = readLevel(pin);
+    pins[pin].driven = true;
+    pins[pin].drivenLevel = level ? HIGH : LOW;
+    fireOnEdge(pin, before, readLevel(pin));
+}
+
+void SimGpio::releaseInput(uint8_t pin) {
+    if (pin >= PIN_COUNT) return;
+    uint8_t before = readLevel(pin);
+    pins[pin].driven = false;
+    fireOnEdge(pin, before, readLevel(pin));
+}
+
+void SimGpio::setAnalogMillivolts(uint8_t pin, uint16_t mv) {
+    if (pin < PIN_COUNT) pins[pin].analogMv = mv;
+}
+
+uint16_t SimGpio::getAnalogMillivolts(uint8_t pin) {
+    return pin < PIN_COUNT ? pins[pin].analogMv : 0;
+}
+
+void SimGpio::setTouchValue(uint8_t pin, uint16_t value) {
+    if (pin < PIN_COUNT) pins[pin].touchValue = value;
+}
+
+uint16_t SimGpio::getTouchValue(uint8_t pin) {
+    return pin < PIN_COUNT ? pins[pin].touchValue : 0;
+}
+
+void SimGpio::setOutputListener(OutputListener listener) {
+    outputListener = listener;
+}
+
+uint32_t SimGpio::getChangeCount() {
+    return changeCount;
+}
+
+void SimGpio::attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+    if (pin >= PIN_COUNT) return;
+    pins[pin].isr = handler;
+    pins[pin].isrWithArg = nullptr;
+    pins[pin].isrMode = mode;
+}
+
+void SimGpio::attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode) {
+    if (pin >= PIN_COUNT) return;
+    pins[pin].isr = nullptr;
+    pins[pin].isrWithArg = handler;
+    pins[pin].isrArg = arg;
+    pins[pin].isrMode = mode;
+}
+
+void SimGpio::detachInterrupt(uint8_t pin) {
+    if (pin >= PIN_COUNT) return;
+    pins[pin].isr = nullptr;
+    pins[pin].isrWithArg = nullptr;
+}
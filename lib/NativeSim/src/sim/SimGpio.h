@@ -0,0 +1,38 @@
+#ifndef SIM_GPIO_H
+#define SIM_GPIO_H
+
+#include <stdint.h>
+
+// Pin state for the native build. The firmware drives outputs through
+// digitalWrite(); simulated peripherals drive inputs (DS3231 INT/SQW,
+// ADS1115 ALERT, touch pad, supply divider) through the setters below.
+class SimGpio {
+public:
+    static const uint8_t PIN_COUNT = 40;
+    typedef void (*OutputListener)(uint8_t pin, uint8_t level);
+
+    static void setMode(uint8_t pin, uint8_t mode);
+    static uint8_t getMode(uint8_t pin);
+    static void writeOutput(uint8_t pin, uint8_t level);
+    static uint8_t readLevel(uint8_t pin);
+
+    static void driveInput(uint8_t pin, uint8_t level);
+    static void releaseInput(uint8_t pin);
+    static void setAnalogMillivolts(uint8_t pin, uint16_t mv);
+    static uint16_t getAnalogMillivolts(uint8_t pin);
+    static void setTouchValue(uint8_t pin, uint16_t value);
+    static uint16_t getTouchValue(uint8_t pin);
+
+    // Called on every output level change; used for the relay/LED trace.
+    static void setOutputListener(OutputListener listener);
+    // Number of output level changes so far.
+    static uint32_t getChangeCount();
+
+    // attachInterrupt() backend; handlers fire when driveInput() produces
+    // a matching edge.
+    static void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+    static void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode);
+    static void detachInterrupt(uint8_t pin);
+};
+
+#endif // SIM_GPIO_H
@@ -0,0 +1,120 @@
+#include "sim/SimHeap.h"
+#include "diagnostics/AllocationTracker.h"
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+struct PlacedBlock {
+    uint32_t offset;
+    uint32_t size;
+};
+
+static bool attached = false;
+static std::mutex heapLock;
+// The model's own containers allocate through operator new as well; those
+// calls come back into the listener and must not be placed.
+static thread_local bool inModel = false;
+// Never destroyed: static destructors elsewhere
+// still free memory after main() returns
+static std::map<uint32_t, uint32_t>& freeRegions = *new std::map<uint32_t, uint32_t>; // offset -> size, address order
+static std::unordered_map<void*, PlacedBlock>& placed = *new std::unordered_map<void*, PlacedBlock>;
+static uint32_t usedBytes = 0;
+static uint32_t highWaterBytes = 0;
+static uint32_t minLargestFree = SimHeap::ARENA_BYTES;
+static uint32_t failedAllocs = 0;
+
+static uint32_t largestRegion() {
+    uint32_t largest = 0;
+    for (const auto& region : freeRegions) {
+        if (region.second > largest) largest = region.second;
+    }
+    return largest;
+}
+
+static uint32_t usable(uint32_t regionSize) {
+    return regionSize > SimHeap::BLOCK_OVERHEAD ? regionSize - SimHeap::BLOCK_OVERHEAD : 0;
+}
+
+void SimHeap::attach() {
+    std::lock_guard<std::mutex> guard(heapLock);
+    if (attached) return;
+    inModel = true;
+    freeRegions[0] = ARENA_BYTES;
+    inModel = false;
+    attached = true;
+    AllocationTracker::setListener(onAllocate, onFree);
+}
+
+bool SimHeap::isAttached() {
+    return attached;
+}
+
+void SimHeap::onAllocate(void* ptr, size_t size) {
+    if (inModel) return;
+    std::lock_guard<std::mutex> guard(heapLock);
+    inModel = true;
+    uint32_t need = (uint32_t)((size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT) + BLOCK_OVERHEAD;
+    auto it = freeRegions.begin();
+    while (it != freeRegions.end() && it->second < need) ++it;
+    if (it == freeRegions.end()) {
+        failedAllocs++;
+    } else {
+        uint32_t offset = it->first;
+        uint32_t remaining = it->second - need;
+        freeRegions.erase(it);
+        // Remainders too small to hold a block stay with the allocation
+        if (remaining > BLOCK_OVERHEAD) {
+            freeRegions[offset + need] = remaining;
+        } else {
+            need += remaining;
+        }
+        placed[ptr] = { offset, need };
+        usedBytes += need;
+        if (usedBytes > highWaterBytes) highWaterBytes = usedBytes;
+        uint32_t largest = usable(largestRegion());
+        if (largest < minLargestFree) minLargestFree = largest;
+    }
+    inModel = false;
+}
+
+void SimHeap::onFree(void* ptr) {
+    if (inModel) return;
+    std::lock_guard<std::mutex> guard(heapLock);
+    auto found = placed.find(ptr);
+    if (found == placed.end()) return;
+    inModel = true;
+    PlacedBlock block = found->second;
+    placed.erase(found);
+    usedBytes -= block.size;
+
+    auto next = freeRegions.lower_bound(block.offset);
+    if (next != freeRegions.end() && block.offset + block.size == next->first) {
+        block.size += next->second;
+        next = freeRegions.erase(next);
+    }
+    if (next != freeRegions.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == block.offset) {
+            prev->second += block.size;
+            inModel = false;
+            return;
+        }
+    }
+    freeRegions[block.offset] = block.size;
+    inModel = false;
+}
+
+SimHeap::Stats SimHeap::getStats() {
+    std::lock_guard<std::mutex> guard(heapLock);
+    Stats stats;
+    stats.usedBytes = usedBytes;
+    stats.highWaterBytes = highWaterBytes;
+    stats.liveBlocks = (uint32_t)placed.size();
+    stats.freeBytes = ARENA_BYTES - usedBytes;
+    stats.largestFreeBlock = usable(largestRegion());
+    stats.minLargestFreeBlock = minLargestFree;
+    stats.freeFragments = (uint32_t)freeRegions.size();
+    stats.failedAllocs = failedAllocs;
+    return stats;
+}
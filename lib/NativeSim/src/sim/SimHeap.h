@@ -0,0 +1,43 @@
+#ifndef SIM_HEAP_H
+#define SIM_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Model of the ESP32's DRAM heap for long host runs. Fed every allocation
+// and free AllocationTracker sees (operator new, cJSON; on the host that
+// includes String), it places blocks first-fit with address-ordered
+// coalescing in an arena the size of the board's free heap after boot.
+// The host allocator never runs out or fragments the way a 240 KB heap
+// does, so the model's free bytes and largest free block stand in for
+// ESP.getFreeHeap() and ESP.getMaxAllocHeap() while it is attached.
+//
+// Allocations made before attach() are not placed; their frees are
+// ignored. Block overhead and alignment approximate multi_heap.
+class SimHeap {
+public:
+    static const uint32_t ARENA_BYTES = 240 * 1024;
+    static const uint32_t BLOCK_OVERHEAD = 8;
+    static const uint32_t ALIGNMENT = 4;
+
+    struct Stats {
+        uint32_t usedBytes;          // Including block overhead
+        uint32_t highWaterBytes;
+        uint32_t liveBlocks;
+        uint32_t freeBytes;
+        uint32_t largestFreeBlock;   // Largest single allocation that would succeed
+        uint32_t minLargestFreeBlock;
+        uint32_t freeFragments;      // Separate free regions
+        uint32_t failedAllocs;       // Would have returned NULL on the board
+    };
+
+    static void attach();
+    static bool isAttached();
+    static Stats getStats();
+
+private:
+    static void onAllocate(void* ptr, size_t size);
+    static void onFree(void* ptr);
+};
+
+#endif // SIM_HEAP_H
@@ -0,0 +1,39 @@
+#include "sim/SimI2CBus.h"
+
+static SimI2CDevice* devices[128] = {nullptr};
+static uint32_t maxClocks[128] = {0};
+static bool overclockFloats[128] = {false};
+
+void SimI2CBus::attach(uint8_t address, SimI2CDevice* device) {
+    if (address < 128) devices[address] = device;
+}
+
+void SimI2CBus::detach(uint8_t address) {
+    if (address < 128) devices[address] = nullptr;
+}
+
+SimI2CDevice* SimI2CBus::find(uint8_t address) {
+    return address < 128 ? devices[address] : nullptr;
+}
+
+void SimI2CBus::setMaxClock(uint8_t address, uint32_t hz) {
+    if (address < 128) maxClocks[address] = hz;
+}
+
+bool SimI2CBus::supportsClock(uint8_t address, uint32_t hz) {
+    return address < 128 && (maxClocks[address] == 0 || hz <= maxClocks[address]);
+}
+
+void SimI2CBus::setOverclockFloats(uint8_t address, bool floats) {
+    if (address < 128) overclockFloats[address] = floats;
+}
+
+bool SimI2CBus::floatsAbove(uint8_t address) {
+    return address < 128 && overclockFloats[address];
+}
+
+void SimI2CBus::tickAll() {
+    for (SimI2CDevice* device : devices) {
+        if (device) device->tick();
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef SIM_I2C_BUS_H
+#define SIM_I2C_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// A simulated I2C peripheral. The first byte of a write is normally the
+// register pointer; reads continue from the current pointer.
+class SimI2CDevice {
+public:
+    virtual ~SimI2CDevice() {}
+    // Return false to NACK the transfer.
+    virtual bool onWrite(const uint8_t* data, size_t len) = 0;
+    // Fill up to len bytes; return the number of bytes supplied.
+    virtual size_t onRead(uint8_t* data, size_t len) = 0;
+    // Advance internal state to the current simulated time.
+    virtual void tick() {}
+};
+
+// Address map of the simulated bus the native Wire stand-in talks to.
+// A device driven faster than its maximum SCL rate NACKs its address, or
+// with setOverclockFloats() ACKs, loses writes and reads all ones, as a
+// real part that misses the clock edges can.
+class SimI2CBus {
+public:
+    static void attach(uint8_t address, SimI2CDevice* device);
+    static void detach(uint8_t address);
+    static SimI2CDevice* find(uint8_t address);
+    static void setMaxClock(uint8_t address, uint32_t hz); // 0: no limit
+    static bool supportsClock(uint8_t address, uint32_t hz);
+    static void setOverclockFloats(uint8_t address, bool floats);
+    static bool floatsAbove(uint8_t address); // Acks above its maximum clock, reading 0xFF
+    static void tickAll();
+};
+
+// Acknowledges its address and ignores traffic (e.g. the AT24C32 EEPROM
+// that sits next to the DS3231 on most breakout boards).
+class SimI2CAckOnlyDevice : public SimI2CDevice {
+public:
+    bool onWrite(const uint8_t*, size_t) override { return true; }
+    size_t onRead(uint8_t* data, size_t len) override {
+        for (size_t i = 0; i < len; ++i) data[i] = 0xFF;
+        return len;
+    }
+};
+
+#endif // SIM_I2C_BUS_H
@@ -0,0 +1,44 @@
+#include "sim/SimScheduler.h"
+#include "sim/SimClock.h"
+#include "sim/SimGpio.h"
+#include <Arduino.h>
+
+std::vector<SimScheduler::Source> SimScheduler::sources;
+uint64_t SimScheduler::maxStepUs = 600ULL * 1000000ULL;
+int SimScheduler::settleIterations = 3;
+int SimScheduler::quietIterations = 0;
+uint64_t SimScheduler::lastSerialBytes = 0;
+uint32_t SimScheduler::lastGpioChanges = 0;
+uint64_t SimScheduler::jumps = 0;
+uint64_t SimScheduler::skippedUs = 0;
+const char* SimScheduler::lastReason = "";
+
+void SimScheduler::addSource(const char* name, DeadlineSource source) {
+    sources.push_back({name, source});
+}
+
+bool SimScheduler::afterLoop() {
+    uint64_t serialBytes = Serial.simBytesWritten();
+    uint32_t gpioChanges = SimGpio::getChangeCount();
+    bool active = serialBytes != lastSerialBytes || gpioChanges != lastGpioChanges;
+    lastSerialBytes = serialBytes;
+    lastGpioChanges = gpioChanges;
+    quietIterations = active ? 0 : quietIterations + 1;
+    if (!SimClock::isVirtual() || quietIterations < settleIterations) return false;
+
+    uint64_t now = SimClock::nowMicros();
+    uint64_t target = now + maxStepUs;
+    lastReason = "max-step";
+    for (const Source& source : sources) {
+        uint64_t deadline = source.next();
+        if (deadline > now && deadline < target) {
+            target = deadline;
+            lastReason = source.name.c_str();
+        }
+    }
+    SimClock::advanceTo(target);
+    skippedUs += target - now;
+    jumps++;
+    quietIterations = 0;
+    return true;
+}
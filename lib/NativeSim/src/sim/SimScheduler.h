@@ -0,0 +1,55 @@
+#ifndef SIM_SCHEDULER_H
+#define SIM_SCHEDULER_H
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Discrete-event driver for virtual-time runs. Between loop() iterations
+// it moves SimClock straight to the earliest pending deadline reported by
+// the registered sources instead of letting the firmware spin through
+// delay(10) for hours.
+//
+// A jump is only taken once the firmware has settled: a few consecutive
+// iterations with no console output and no GPIO change. State machines
+// that advance one step per loop() therefore run at their normal cadence,
+// and only genuinely idle stretches are skipped. Jumps are capped at
+// maxStep so millis()-interval checks the sources do not know about still
+// run at least that often.
+class SimScheduler {
+public:
+    static const uint64_t NO_DEADLINE = UINT64_MAX;
+    // Returns an absolute SimClock time in microseconds, or NO_DEADLINE.
+    typedef std::function<uint64_t()> DeadlineSource;
+
+    static void addSource(const char* name, DeadlineSource source);
+    static void setMaxStepMicros(uint64_t us) { maxStepUs = us; }
+    static void setSettleIterations(int n) { settleIterations = n; }
+
+    // Call once after every loop(). Returns true if the clock jumped.
+    static bool afterLoop();
+
+    static uint64_t getJumpCount() { return jumps; }
+    static uint64_t getSkippedMicros() { return skippedUs; }
+    // Name of the source that set the most recent jump ("max-step" when the
+    // cap won).
+    static const char* getLastReason() { return lastReason; }
+
+private:
+    struct Source {
+        std::string name;
+        DeadlineSource next;
+    };
+    static std::vector<Source> sources;
+    static uint64_t maxStepUs;
+    static int settleIterations;
+    static int quietIterations;
+    static uint64_t lastSerialBytes;
+    static uint32_t lastGpioChanges;
+    static uint64_t jumps;
+    static uint64_t skippedUs;
+    static const char* lastReason;
+};
+
+#endif // SIM_SCHEDULER_H
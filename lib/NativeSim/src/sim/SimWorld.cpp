@@ -0,0 +1,89 @@
+#include "sim/SimWorld.h"
+#include "sim/SimClock.h"
+#include "sim/SimGpio.h"
+#include "sim/SimI2CBus.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <filesystem>
+#include <stdlib.h>
+
+static SimADS1115 adsDevice;
+static SimBME280 bmeDevices[SimWorld::MAX_BME280];
+static int attachedBmeCount = 1;
+static SimDS3231 rtcDevice;
+static SimI2CAckOnlyDevice eepromDevice;
+
+// Defaults from ConfigManager: soil on A0, MQ135 on A1, DS3231 INT on 27.
+static const int SOIL_CHANNEL = 0;
+static const int MQ135_CHANNEL = 1;
+static const int RTC_INT_GPIO = 27;
+// PowerManager reads the 3.3 V rail through a 1:2 divider on GPIO34.
+static const int SUPPLY_SENSE_GPIO = 34;
+static const uint16_t SUPPLY_SENSE_MV = 1650;
+
+static void seedFileSystem(const char* dataDir) {
+    namespace stdfs = std::filesystem;
+    std::error_code ec;
+    const char* root = LittleFS.getHostRoot();
+    if (stdfs::exists(root, ec) || !dataDir || !stdfs::is_directory(dataDir, ec)) return;
+    stdfs::create_directories(root, ec);
+    stdfs::copy(dataDir, root, stdfs::copy_options::recursive, ec);
+    if (ec) {
+        Serial.printf("[Sim] Failed to seed %s from %s: %s\n", root, dataDir, ec.message().c_str());
+    } else {
+        Serial.printf("[Sim] Seeded %s from %s\n", root, dataDir);
+    }
+}
+
+void SimWorld::begin(const char* dataDir) {
+    seedFileSystem(dataDir);
+
+    adsDevice.setInputVoltage(SOIL_CHANNEL, 1.6f);
+    adsDevice.setInputVoltage(MQ135_CHANNEL, 0.4f);
+    adsDevice.setNoise(0.002f);
+    adsDevice.setAlertPin(SimWorld::ADS_ALERT_GPIO);
+    SimI2CBus::attach(0x48, &adsDevice);
+    // NATIVE_SIM_BME280_COUNT adds sensors at 0x77 and 0x70, each reading
+    // a little warmer than the last so their median is the middle one
+    const char* bmeEnv = getenv("NATIVE_SIM_BME280_COUNT");
+    if (bmeEnv) {
+        int n = atoi(bmeEnv);
+        attachedBmeCount = n < 1 ? 1 : n > MAX_BME280 ? MAX_BME280 : n;
+    }
+    static const uint8_t BME_ADDRESSES[MAX_BME280] = {0x76, 0x77, 0x70};
+    for (int i = 0; i < attachedBmeCount; ++i) {
+        bmeDevices[i].setEnvironment(21.0f + 0.5f * i, 50.0f, 101325.0f);
+        SimI2CBus::attach(BME_ADDRESSES[i], &bmeDevices[i]);
+    }
+    SimI2CBus::attach(0x57, &eepromDevice);
+    SimI2CBus::attach(0x68, &rtcDevice);
+    // DS3231 and AT24C32 stop at fast mode; the ADS1115 and BME280 take
+    // high-speed mode, above anything the ESP32 drives
+    SimI2CBus::setMaxClock(0x57, 400000);
+    SimI2CBus::setMaxClock(0x68, 400000);
+
+    SimGpio::setAnalogMillivolts(SUPPLY_SENSE_GPIO, SUPPLY_SENSE_MV);
+
+    // The firmware keeps the RTC in local time.
+    time_t utc = (time_t)SimClock::unixTimeUtc();
+    struct tm local;
+    localtime_r(&utc, &local);
+    rtcDevice.setTime((uint32_t)timegm(&local));
+    // ...and formats it with localtime(), which on the device has no TZ
+    // set and therefore behaves as UTC. Match that on the host.
+    setenv("TZ", "UTC0", 1);
+    tzset();
+    rtcDevice.setIntPin(RTC_INT_GPIO);
+    SimClock::setWaitHook(SimI2CBus::tickAll);
+}
+
+void SimWorld::tick() {
+    SimI2CBus::tickAll();
+    WiFi.poll();
+}
+
+SimADS1115& SimWorld::ads() { return adsDevice; }
+SimBME280& SimWorld::bme(int index) { return bmeDevices[index]; }
+int SimWorld::bmeCount() { return attachedBmeCount; }
+SimDS3231& SimWorld::rtc() { return rtcDevice; }
@@ -0,0 +1,31 @@
+#ifndef SIM_WORLD_H
+#define SIM_WORLD_H
+
+#include "sim/SimADS1115.h"
+#include "sim/SimBME280.h"
+#include "sim/SimDS3231.h"
+
+// The simulated board: the peripherals on the I2C bus plus the analog
+// inputs they see. Harnesses reach the device models through here to
+// change conditions while the firmware runs.
+class SimWorld {
+public:
+    // ADS1115 ALERT/RDY; the firmware only uses it with ads1115_alert_gpio set to this.
+    static const int ADS_ALERT_GPIO = 19;
+    // BME280s at 0x76, 0x77 and 0x70; NATIVE_SIM_BME280_COUNT attaches more than the first
+    static const int MAX_BME280 = 3;
+
+    // Attach the devices, seed the LittleFS directory from dataDir when it
+    // does not exist yet, and start the RTC at the host's local time.
+    static void begin(const char* dataDir);
+    // Advance peripherals and deliver pending WiFi events; called once per
+    // loop() iteration.
+    static void tick();
+
+    static SimADS1115& ads();
+    static SimBME280& bme(int index = 0);
+    static int bmeCount();
+    static SimDS3231& rtc();
+};
+
+#endif // SIM_WORLD_H
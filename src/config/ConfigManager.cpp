@@ -1,5 +1,6 @@
 #include "config/ConfigManager.h"
 #include "diagnostics/DiagnosticManager.h"
+#include "system/BootTimeline.h"
 
 void ConfigManager::setRoot(cJSON* newRoot) {
     if (configRoot) cJSON_Delete(configRoot);
@@ -10,13 +11,17 @@ bool ConfigManager::begin(FileSystemManager& fsMgr, DiagnosticManager* diag) {
     fsManager = &fsMgr;
     diagnosticManager = diag;
     // Load defaults, then try to load config file if it exists
-    loadDefaults();
+    {
+        BootTimeline::Scope phase("ConfigManager::loadDefaults");
+        loadDefaults();
+    }
     load();
 
     return true;
 }
 
 bool ConfigManager::load() {
+    BootTimeline::Scope phase("ConfigManager::load");
     if (configRoot) {
         cJSON_Delete(configRoot);
         configRoot = nullptr;
@@ -72,6 +77,7 @@ bool ConfigManager::load() {
                     }
                 }
                 // Merge missing keys from defaults
+                BootTimeline::Scope mergePhase("ConfigManager::mergeDefaults");
                 mergeDefaults();
                 return true;
             } else {
@@ -132,6 +138,8 @@ void ConfigManager::loadDefaults() {
     cJSON_AddNumberToObject(configRoot, "touch_gpio", 4);
     cJSON_AddNumberToObject(configRoot, "touch_long_press", 5000);
     cJSON_AddNumberToObject(configRoot, "int_sqw_gpio", 27); // DS3231 INT/SQW pin GPIO for interrupt polling
+    cJSON_AddNumberToObject(configRoot, "ads1115_alert_gpio", -1); // ADS1115 ALERT/RDY GPIO, -1 = poll for conversion ready
+    cJSON_AddItemToObject(configRoot, "ads1115_scan", cJSON_CreateArray()); // Always-powered inputs scanned in the background, e.g. extra soil probes on A2/A3
     
     
     // 7-day alarm schedule
@@ -205,6 +213,7 @@ void ConfigManager::loadDefaults() {
     // I2C defaults
     cJSON_AddNumberToObject(configRoot, "i2c_sda", 21);
     cJSON_AddNumberToObject(configRoot, "i2c_scl", 22);
+    cJSON_AddNumberToObject(configRoot, "i2c_frequency", 400000); // Hz; lowered at boot if a device fails at it
     // Time defaults
     cJSON_AddStringToObject(configRoot, "default_time", "");
     // NTP server configuration
@@ -236,8 +245,28 @@ void ConfigManager::loadDefaults() {
     cJSON_AddNumberToObject(soilMoisture, "wet", 4400); // 4400 = fully wet (glass of water)
     cJSON_AddNumberToObject(soilMoisture, "dry", 10700); // 10700 = fully dry
     cJSON_AddNumberToObject(soilMoisture, "stabilisation_time", 10); // 10 seconds default
+    cJSON_AddBoolToObject(soilMoisture, "auto_gain", true); // Read at the tightest range, raw kept in gain's scale
+    cJSON_AddBoolToObject(soilMoisture, "dry_watch", false); // ADS1115 comparator watches for dry soil between cycles
     cJSON_AddItemToObject(configRoot, "soil_moisture", soilMoisture);
 
+    // MQ135 air quality sensor
+    cJSON* mq135 = cJSON_CreateObject();
+    cJSON_AddNumberToObject(mq135, "ads_channel", 1);
+    cJSON_AddNumberToObject(mq135, "gain", 0);
+    cJSON_AddBoolToObject(mq135, "auto_gain", true);
+    cJSON_AddNumberToObject(mq135, "warmup_time", 60);
+    cJSON_AddItemToObject(configRoot, "mq135", mq135);
+
+    // BME280: forced = ten conversions per reading, filtered in software;
+    // normal = the chip measures continuously through its IIR filter
+    cJSON* bme280 = cJSON_CreateObject();
+    cJSON_AddStringToObject(bme280, "mode", "forced");
+    cJSON_AddNumberToObject(bme280, "standby_ms", 125); // Normal mode: 0.5, 10, 20, 62.5, 125, 250, 500 or 1000
+    cJSON_AddNumberToObject(bme280, "iir", 16); // IIR coefficient on temperature and pressure: 0 (off), 2, 4, 8 or 16
+    cJSON_AddNumberToObject(bme280, "normal_samples", 10); // Normal mode: samples per reading, one period apart; 1 = single burst
+    cJSON_AddNumberToObject(bme280, "oversampling", 16); // T, P and H: 1, 2, 4, 8 or 16; sets the measurement time
+    cJSON_AddItemToObject(configRoot, "bme280", bme280);
+
     // Soil moisture power control GPIO (default 16)
     cJSON_AddNumberToObject(configRoot, "soil_power_gpio", 16);
 
@@ -283,34 +312,62 @@ void ConfigManager::mergeDefaults() {
     if (!cJSON_HasObjectItem(configRoot, "int_sqw_gpio")) {
         cJSON_AddNumberToObject(configRoot, "int_sqw_gpio", 27);
     }
+    if (!cJSON_HasObjectItem(configRoot, "ads1115_alert_gpio")) {
+        cJSON_AddNumberToObject(configRoot, "ads1115_alert_gpio", -1);
+    }
+    if (!cJSON_HasObjectItem(configRoot, "ads1115_scan")) {
+        cJSON_AddItemToObject(configRoot, "ads1115_scan", cJSON_CreateArray());
+    }
     
-    // Soil moisture sensor config
-    if (!cJSON_HasObjectItem(configRoot, "soil_moisture")) {
-        cJSON* soilMoisture = cJSON_CreateObject();
-        cJSON_AddNumberToObject(soilMoisture, "ads_channel", 0);
-        cJSON_AddNumberToObject(soilMoisture, "gain", 0); // GAIN_TWOTHIRDS = ±6.144V range (won't saturate at 2.1V)
-        cJSON_AddNumberToObject(soilMoisture, "stabilisation_time", 10); // 10 seconds
-        cJSON_AddNumberToObject(soilMoisture, "wet", 4400); // 4400 = fully wet (glass of water)
-        cJSON_AddNumberToObject(soilMoisture, "dry", 10700); // 10700 = fully dry
-        cJSON_AddItemToObject(configRoot, "soil_moisture", soilMoisture);
+    // Sensor sections: a missing section is added, and a section saved by
+    // an older build gets the keys added since
+    auto mergeSection = [this](const char* name) -> cJSON* {
+        cJSON* section = cJSON_GetObjectItemCaseSensitive(configRoot, name);
+        if (section) return cJSON_IsObject(section) ? section : nullptr;
+        section = cJSON_CreateObject();
+        cJSON_AddItemToObject(configRoot, name, section);
         if (diagnosticManager) {
-            diagnosticManager->log(DiagnosticManager::LOG_INFO, "Config", 
-                "Added missing config section: soil_moisture");
+            diagnosticManager->log(DiagnosticManager::LOG_INFO, "Config",
+                "Added missing config section: %s", name);
         }
-    }
-    
-    // MQ135 sensor config
-    if (!cJSON_HasObjectItem(configRoot, "mq135")) {
-        cJSON* mq135 = cJSON_CreateObject();
-        cJSON_AddNumberToObject(mq135, "ads_channel", 1);
-        cJSON_AddNumberToObject(mq135, "gain", 0);
-        cJSON_AddNumberToObject(mq135, "warmup_time", 60);
-        cJSON_AddItemToObject(configRoot, "mq135", mq135);
+        return section;
+    };
+    auto mergeKey = [this](cJSON* section, const char* name, const char* key, cJSON* value) {
+        if (!section || cJSON_HasObjectItem(section, key)) {
+            cJSON_Delete(value);
+            return;
+        }
+        cJSON_AddItemToObject(section, key, value);
         if (diagnosticManager) {
-            diagnosticManager->log(DiagnosticManager::LOG_INFO, "Config", 
-                "Added missing config section: mq135");
+            diagnosticManager->log(DiagnosticManager::LOG_INFO, "Config",
+                "Added missing config key: %s.%s", name, key);
         }
-    }
+    };
+
+    // Soil moisture sensor config
+    cJSON* soilMoisture = mergeSection("soil_moisture");
+    mergeKey(soilMoisture, "soil_moisture", "ads_channel", cJSON_CreateNumber(0));
+    mergeKey(soilMoisture, "soil_moisture", "gain", cJSON_CreateNumber(0)); // GAIN_TWOTHIRDS = ±6.144V range (won't saturate at 2.1V)
+    mergeKey(soilMoisture, "soil_moisture", "auto_gain", cJSON_CreateBool(true)); // Read at the tightest range, raw kept in gain's scale
+    mergeKey(soilMoisture, "soil_moisture", "dry_watch", cJSON_CreateBool(false)); // ADS1115 comparator watches for dry soil between cycles
+    mergeKey(soilMoisture, "soil_moisture", "stabilisation_time", cJSON_CreateNumber(10)); // 10 seconds
+    mergeKey(soilMoisture, "soil_moisture", "wet", cJSON_CreateNumber(4400)); // 4400 = fully wet (glass of water)
+    mergeKey(soilMoisture, "soil_moisture", "dry", cJSON_CreateNumber(10700)); // 10700 = fully dry
+
+    // BME280 config
+    cJSON* bme280 = mergeSection("bme280");
+    mergeKey(bme280, "bme280", "mode", cJSON_CreateString("forced"));
+    mergeKey(bme280, "bme280", "standby_ms", cJSON_CreateNumber(125));
+    mergeKey(bme280, "bme280", "iir", cJSON_CreateNumber(16));
+    mergeKey(bme280, "bme280", "normal_samples", cJSON_CreateNumber(10));
+    mergeKey(bme280, "bme280", "oversampling", cJSON_CreateNumber(16));
+
+    // MQ135 sensor config
+    cJSON* mq135 = mergeSection("mq135");
+    mergeKey(mq135, "mq135", "ads_channel", cJSON_CreateNumber(1));
+    mergeKey(mq135, "mq135", "gain", cJSON_CreateNumber(0));
+    mergeKey(mq135, "mq135", "auto_gain", cJSON_CreateBool(true));
+    mergeKey(mq135, "mq135", "warmup_time", cJSON_CreateNumber(60));
     
     // Removed legacy root-level alarm1 and alarm2 config section creation
     
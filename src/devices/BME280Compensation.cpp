@@ -0,0 +1,84 @@
+#include <math.h>
+
+#include "devices/BME280Compensation.h"
+
+static uint16_t le16(const uint8_t* b) {
+    return (uint16_t)(b[0] | (b[1] << 8));
+}
+
+void BME280Compensation::parse(const uint8_t* tp, const uint8_t* h) {
+    T1 = le16(tp + 0);
+    T2 = (int16_t)le16(tp + 2);
+    T3 = (int16_t)le16(tp + 4);
+    P1 = le16(tp + 6);
+    P2 = (int16_t)le16(tp + 8);
+    P3 = (int16_t)le16(tp + 10);
+    P4 = (int16_t)le16(tp + 12);
+    P5 = (int16_t)le16(tp + 14);
+    P6 = (int16_t)le16(tp + 16);
+    P7 = (int16_t)le16(tp + 18);
+    P8 = (int16_t)le16(tp + 20);
+    P9 = (int16_t)le16(tp + 22);
+    H1 = tp[25]; // 0xA1; 0xA0 is unused
+    H2 = (int16_t)le16(h + 0);
+    H3 = h[2];
+    // dig_H4 and dig_H5 are 12-bit, sharing the nibbles of 0xE5
+    H4 = (int16_t)(((int8_t)h[3] * 16) | (h[4] & 0x0F));
+    H5 = (int16_t)(((int8_t)h[5] * 16) | (h[4] >> 4));
+    H6 = (int8_t)h[6];
+    loaded = true;
+}
+
+BME280Compensation::Raw BME280Compensation::parseData(const uint8_t* data) {
+    Raw raw;
+    raw.adcP = (int32_t)(((uint32_t)data[0] << 12) | ((uint32_t)data[1] << 4) | (data[2] >> 4));
+    raw.adcT = (int32_t)(((uint32_t)data[3] << 12) | ((uint32_t)data[4] << 4) | (data[5] >> 4));
+    raw.adcH = (int32_t)(((uint32_t)data[6] << 8) | data[7]);
+    return raw;
+}
+
+int32_t BME280Compensation::compensateT(int32_t adcT, int32_t& tFine) const {
+    int32_t var1 = ((((adcT >> 3) - ((int32_t)T1 << 1))) * ((int32_t)T2)) >> 11;
+    int32_t var2 = (((((adcT >> 4) - ((int32_t)T1)) * ((adcT >> 4) - ((int32_t)T1))) >> 12) * ((int32_t)T3)) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t BME280Compensation::compensateP(int32_t adcP, int32_t tFine) const {
+    int64_t var1 = ((int64_t)tFine) - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)P6;
+    var2 = var2 + ((var1 * (int64_t)P5) << 17);
+    var2 = var2 + (((int64_t)P4) << 35);
+    var1 = ((var1 * var1 * (int64_t)P3) >> 8) + ((var1 * (int64_t)P2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)P1) >> 33;
+    if (var1 == 0) return 0; // Avoid a division by zero
+    int64_t p = 1048576 - adcP;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)P9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((int64_t)P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)P7) << 4);
+    return (uint32_t)p;
+}
+
+uint32_t BME280Compensation::compensateH(int32_t adcH, int32_t tFine) const {
+    int32_t v = tFine - ((int32_t)76800);
+    v = (((((adcH << 14) - (((int32_t)H4) << 20) - (((int32_t)H5) * v)) + ((int32_t)16384)) >> 15) *
+         (((((((v * ((int32_t)H6)) >> 10) * (((v * ((int32_t)H3)) >> 11) + ((int32_t)32768))) >> 10) +
+            ((int32_t)2097152)) * ((int32_t)H2) + 8192) >> 14));
+    v = (v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)H1)) >> 4));
+    v = (v < 0 ? 0 : v);
+    v = (v > 419430400 ? 419430400 : v); // 100 %RH
+    return (uint32_t)(v >> 12);
+}
+
+void BME280Compensation::compensate(const Raw& raw, float& temperature, float& humidity, float& pressure) const {
+    if (raw.adcT == SKIPPED_TP) {
+        // Pressure and humidity both need t_fine
+        temperature = humidity = pressure = NAN;
+        return;
+    }
+    int32_t tFine = 0;
+    temperature = compensateT(raw.adcT, tFine) / 100.0f;
+    humidity = raw.adcH == SKIPPED_H ? NAN : compensateH(raw.adcH, tFine) / 1024.0f;
+    pressure = raw.adcP == SKIPPED_TP ? NAN : compensateP(raw.adcP, tFine) / 25600.0f;
+}
@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include <Wire.h>
 
 #include "devices/BME280Device.h"
 
@@ -13,20 +14,93 @@ void BME280Device::forceIdle() {
 }
 
 #include "system/TimeManager.h"
+#include "system/LoopProfiler.h"
+
+// Wire traffic of the Adafruit driver calls, for the bus tracer. begin()
+// is approximate (chip id, reset, status polls, 32 calibration bytes).
+// Samples are read by readRegisters() below, which counts its own traffic.
+static const I2CTracer::Cost BME_BEGIN = {50, 32, 35};
+static const I2CTracer::Cost BME_SET_SAMPLING = {4, 8, 0};
+
+// Chip settings, in the units setMode() takes
+static const struct { float ms; Adafruit_BME280::standby_duration code; } STANDBY_SETTINGS[] = {
+    {0.5f, Adafruit_BME280::STANDBY_MS_0_5}, {10.0f, Adafruit_BME280::STANDBY_MS_10},
+    {20.0f, Adafruit_BME280::STANDBY_MS_20}, {62.5f, Adafruit_BME280::STANDBY_MS_62_5},
+    {125.0f, Adafruit_BME280::STANDBY_MS_125}, {250.0f, Adafruit_BME280::STANDBY_MS_250},
+    {500.0f, Adafruit_BME280::STANDBY_MS_500}, {1000.0f, Adafruit_BME280::STANDBY_MS_1000}
+};
+static const struct { uint8_t samples; Adafruit_BME280::sensor_sampling code; } OVERSAMPLING_SETTINGS[] = {
+    {1, Adafruit_BME280::SAMPLING_X1}, {2, Adafruit_BME280::SAMPLING_X2}, {4, Adafruit_BME280::SAMPLING_X4},
+    {8, Adafruit_BME280::SAMPLING_X8}, {16, Adafruit_BME280::SAMPLING_X16}
+};
+static const struct { uint8_t coefficient; Adafruit_BME280::sensor_filter code; } FILTER_SETTINGS[] = {
+    {0, Adafruit_BME280::FILTER_OFF}, {2, Adafruit_BME280::FILTER_X2}, {4, Adafruit_BME280::FILTER_X4},
+    {8, Adafruit_BME280::FILTER_X8}, {16, Adafruit_BME280::FILTER_X16}
+};
 
 BME280Device::BME280Device(uint8_t addr, I2CManager* i2c, DiagnosticManager* diag)
     : address(addr), i2cManager(i2c), diagnosticManager(diag) {}
 
+void BME280Device::setMode(Mode newMode, float standbyMsWanted, uint8_t iirCoefficient, uint8_t samplesWanted) {
+    mode = newMode;
+    size_t best = 0;
+    for (size_t i = 1; i < sizeof(STANDBY_SETTINGS) / sizeof(STANDBY_SETTINGS[0]); ++i) {
+        if (fabsf(STANDBY_SETTINGS[i].ms - standbyMsWanted) < fabsf(STANDBY_SETTINGS[best].ms - standbyMsWanted)) best = i;
+    }
+    standby = STANDBY_SETTINGS[best].code;
+    standbyMs = STANDBY_SETTINGS[best].ms;
+    normalSamples = samplesWanted < 1 ? 1 : (samplesWanted > SAMPLES ? SAMPLES : samplesWanted);
+    best = 0;
+    for (size_t i = 1; i < sizeof(FILTER_SETTINGS) / sizeof(FILTER_SETTINGS[0]); ++i) {
+        if (abs(FILTER_SETTINGS[i].coefficient - iirCoefficient) < abs(FILTER_SETTINGS[best].coefficient - iirCoefficient)) best = i;
+    }
+    filter = FILTER_SETTINGS[best].code;
+}
+
+void BME280Device::setOversampling(uint8_t samples) {
+    size_t best = 0;
+    for (size_t i = 1; i < sizeof(OVERSAMPLING_SETTINGS) / sizeof(OVERSAMPLING_SETTINGS[0]); ++i) {
+        if (abs(OVERSAMPLING_SETTINGS[i].samples - samples) < abs(OVERSAMPLING_SETTINGS[best].samples - samples)) best = i;
+    }
+    oversampling = OVERSAMPLING_SETTINGS[best].samples;
+    sampling = OVERSAMPLING_SETTINGS[best].code;
+}
+
+uint32_t BME280Device::maxMeasurementUs(uint8_t osrsT, uint8_t osrsP, uint8_t osrsH) {
+    uint32_t us = 1250 + 2300 * osrsT;
+    if (osrsP) us += 2300 * osrsP + 575;
+    if (osrsH) us += 2300 * osrsH + 575;
+    return us;
+}
+
+uint32_t BME280Device::typicalMeasurementUs(uint8_t osrsT, uint8_t osrsP, uint8_t osrsH) {
+    uint32_t us = 1000 + 2000 * osrsT;
+    if (osrsP) us += 2000 * osrsP + 500;
+    if (osrsH) us += 2000 * osrsH + 500;
+    return us;
+}
+
+unsigned long BME280Device::measurementMs(bool typical) const {
+    uint32_t us = typical ? typicalMeasurementUs(oversampling, oversampling, oversampling)
+                          : maxMeasurementUs(oversampling, oversampling, oversampling);
+    return (us + 999) / 1000 + 1;
+}
+
 void BME280Device::setTimeManager(TimeManager* timeMgr) {
     timeManager = timeMgr;
 }
 
-bool BME280Device::begin() {
+bool BME280Device::begin(bool firstReading) {
     state = READING;
     bool ok = false;
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-    ok = bme.begin(address);
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
+    {
+        I2CTracer::Access access(i2cManager, address, "bme.begin");
+        ok = bme.begin(address);
+        access.add(BME_BEGIN);
+        if (!ok) access.fail();
+    }
+    // The driver keeps its trimming private; read a copy for readMeasurement()
+    if (ok) ok = loadCompensation();
     if (!ok) {
         if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_WARN, "BME280", "Device not found at 0x%02X", address);
         initialized = false;
@@ -34,77 +108,225 @@ bool BME280Device::begin() {
         lastError = "Device not found";
         return false;
     }
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-    bme.setSampling(Adafruit_BME280::MODE_SLEEP, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::FILTER_X16, Adafruit_BME280::STANDBY_MS_0_5);
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
+    if (mode == MODE_NORMAL) {
+        applySampling(Adafruit_BME280::MODE_NORMAL);
+        firstResultMs = millis() + measurementMs(false);
+    } else {
+        applySampling(Adafruit_BME280::MODE_SLEEP);
+    }
     initialized = true;
     state = READY;
-    if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "BME280", "Initialized at 0x%02X", address);
+    if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "BME280", "Initialized at 0x%02X, %s mode", address, modeToString(mode));
+    if (!firstReading) return true;
     // Take a full set of readings after initialization
-    readData();
+    {
+        BootTimeline::Scope phase("BME280Device::readData (first)");
+        readData();
+    }
+    logInitialReading();
+    return true;
+}
+
+void BME280Device::logInitialReading() {
     if (diagnosticManager) {
-        diagnosticManager->log(DiagnosticManager::LOG_INFO, "BME280", "Initial reading: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC, ts=%04d-%02d-%02d %02d:%02d:%02d", 
-            lastReading.temperature, lastReading.humidity, lastReading.pressure, lastReading.heatIndex, lastReading.dewPoint,
+        diagnosticManager->log(DiagnosticManager::LOG_INFO, "BME280", "Initial reading at 0x%02X: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC, ts=%04d-%02d-%02d %02d:%02d:%02d", 
+            address, lastReading.temperature, lastReading.humidity, lastReading.pressure, lastReading.heatIndex, lastReading.dewPoint,
             lastReading.timestamp.year(), lastReading.timestamp.month(), lastReading.timestamp.day(),
             lastReading.timestamp.hour(), lastReading.timestamp.minute(), lastReading.timestamp.second());
         diagnosticManager->log(DiagnosticManager::LOG_INFO, "BME280", "Averaged: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC", 
             lastReading.avgTemperature, lastReading.avgHumidity, lastReading.avgPressure, lastReading.avgHeatIndex, lastReading.avgDewPoint);
     }
-    return true;
 }
 
 BME280Reading BME280Device::readData() {
+    LoopProfiler::Site stallSite("BME280Device::readData");
+    if (!startReading()) {
+        BME280Reading result;
+        result.valid = false;
+        return result;
+    }
+    while (!update()) {
+        vTaskDelay(1); // Yield to RTOS, non-blocking
+    }
+    return lastReading;
+}
+
+bool BME280Device::startReading() {
+    if (step != STEP_IDLE) return true; // Already under way; the caller gets this one
+    if (!initialized && !begin(false)) {
+        state = ERROR;
+        lastError = "Not initialized";
+        return false;
+    }
     state = UPDATING;
-    const int N = 10;
-    BME280Reading readings[N];
-    // Non-blocking wait for BME280 stabilization after wake (250ms)
-    {
-        unsigned long start = millis();
-        while (millis() - start < 250) {
-            vTaskDelay(1); // Yield to RTOS, non-blocking
-        }
+    sampleCount = 0;
+    if (mode == MODE_NORMAL) {
+        // Only the first reading after begin() has to wait for a measurement
+        long wait = (long)(firstResultMs - millis());
+        beginStep(STEP_LATEST, wait > 0 ? (unsigned long)wait : 0);
+    } else {
+        // A forced write wakes the chip from sleep and starts converting at
+        // once; the 2 ms start-up time is only after power-on, which
+        // begin() has long waited out
+        triggerConversion();
     }
-    for (int i = 0; i < N; ++i) {
-        if (!initialized) {
-            if (!begin()) {
-                BME280Reading result;
-                result.valid = false;
-                state = ERROR;
-                lastError = "Not initialized";
-                return result;
+    return true;
+}
+
+void BME280Device::beginStep(Step next, unsigned long waitMs) {
+    step = next;
+    stepStart = millis();
+    stepWaitMs = waitMs;
+}
+
+void BME280Device::applySampling(Adafruit_BME280::sensor_mode chipMode) {
+    const char* label = chipMode == Adafruit_BME280::MODE_SLEEP ? "bme.sleep" :
+                        chipMode == Adafruit_BME280::MODE_FORCED ? "bme.forced" : "bme.normal";
+    I2CTracer::Access access(i2cManager, address, label);
+    bme.setSampling(chipMode, sampling, sampling, sampling, filter, standby);
+    access.add(BME_SET_SAMPLING);
+}
+
+void BME280Device::requestReading() {
+    readRequested = true;
+}
+
+bool BME280Device::update() {
+    if (readRequested.exchange(false) && step == STEP_IDLE) startReading();
+    unsigned long now = millis();
+    switch (step) {
+        case STEP_IDLE:
+            return false;
+        case STEP_CONVERTING:
+            if (now - stepStart < stepWaitMs) return false;
+            // Past the typical time: poll once a millisecond until the chip
+            // is done or the maximum has passed
+            if (now - stepStart < conversionMaxMs && !conversionDone()) {
+                stepWaitMs = now - stepStart + 1;
+                return false;
             }
-        }
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-        bme.setSampling(Adafruit_BME280::MODE_FORCED, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::FILTER_X16, Adafruit_BME280::STANDBY_MS_0_5);
-        unsigned long start = millis();
-        while (millis() - start < 250) {
-            vTaskDelay(1); // Yield to RTOS, non-blocking
-        }
-        readings[i].temperature = bme.readTemperature();
-        readings[i].humidity = bme.readHumidity();
-        readings[i].pressure = bme.readPressure() / 100.0F;
-        readings[i].heatIndex = computeHeatIndex(readings[i].temperature, readings[i].humidity);
-        readings[i].dewPoint = computeDewPoint(readings[i].temperature, readings[i].humidity);
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
-        readings[i].timestamp = timeManager ? timeManager->getTime() : DateTime();
-        // Defensive check for invalid timestamp
-        if (!readings[i].timestamp.isValid() || readings[i].timestamp.year() < 2000 || readings[i].timestamp.month() < 1 || readings[i].timestamp.month() > 12 || readings[i].timestamp.day() < 1 || readings[i].timestamp.day() > 31) {
-            if (diagnosticManager) {
-                diagnosticManager->log(DiagnosticManager::LOG_WARN, "BME280", "Invalid timestamp detected after reading (year=%d, month=%d, day=%d) - setting to 0", readings[i].timestamp.year(), readings[i].timestamp.month(), readings[i].timestamp.day());
+            collectSample();
+            if (sampleCount < SAMPLES) {
+                triggerConversion();
+                return false;
+            }
+            finishReading();
+            return true;
+        case STEP_LATEST:
+            // The chip has filtered the values already
+            if (now - stepStart < stepWaitMs) return false;
+            collectSample();
+            if (sampleCount < normalSamples) {
+                // The next measurement, so each sample brings new humidity noise
+                beginStep(STEP_LATEST, measurementMs(true) + (unsigned long)ceilf(standbyMs));
+                return false;
             }
-            readings[i].timestamp = DateTime(1970, 1, 1, 0, 0, 0); // Set to known invalid value
+            finishReading();
+            return true;
+    }
+    return false;
+}
+
+void BME280Device::triggerConversion() {
+    applySampling(Adafruit_BME280::MODE_FORCED);
+    beginStep(STEP_CONVERTING, measurementMs(true));
+    conversionMaxMs = measurementMs(false);
+}
+
+bool BME280Device::conversionDone() {
+    uint8_t status = 0;
+    I2CTracer::Access access(i2cManager, address, "bme.status");
+    return readRegisters(access, 0xF3, &status, 1) && !(status & 0x08);
+}
+
+// Pointer write joined to the read by a repeated START
+bool BME280Device::readRegisters(I2CTracer::Access& access, uint8_t reg, uint8_t* buffer, uint8_t len) {
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    access.addTransaction(1, 0);
+    if (Wire.endTransmission(false) != 0) {
+        access.fail();
+        return false;
+    }
+    uint8_t received = Wire.requestFrom(address, len);
+    access.addTransaction(0, received);
+    for (uint8_t i = 0; i < received; ++i) buffer[i] = (uint8_t)Wire.read();
+    if (received != len) {
+        access.fail();
+        return false;
+    }
+    return true;
+}
+
+bool BME280Device::loadCompensation() {
+    uint8_t tp[BME280Compensation::CALIB_TP_LEN];
+    uint8_t h[BME280Compensation::CALIB_H_LEN];
+    I2CTracer::Access access(i2cManager, address, "bme.calibration");
+    if (!readRegisters(access, BME280Compensation::CALIB_TP_REG, tp, sizeof(tp)) ||
+        !readRegisters(access, BME280Compensation::CALIB_H_REG, h, sizeof(h))) {
+        return false;
+    }
+    compensation.parse(tp, h);
+    return true;
+}
+
+bool BME280Device::readMeasurement(BME280Reading& sample) {
+    uint8_t data[BME280Compensation::DATA_LEN];
+    bool ok;
+    {
+        I2CTracer::Access access(i2cManager, address, "bme.sample");
+        ok = readRegisters(access, BME280Compensation::DATA_REG, data, sizeof(data));
+    }
+    if (!ok) {
+        sample.temperature = sample.humidity = sample.pressure = NAN;
+        return false;
+    }
+    compensation.compensate(BME280Compensation::parseData(data), sample.temperature, sample.humidity, sample.pressure);
+    return true;
+}
+
+void BME280Device::collectSample() {
+    BME280Reading& sample = samples[sampleCount++];
+    sample.valid = readMeasurement(sample);
+    if (!sample.valid) {
+        // Left out of the average by finishReading()
+        if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_WARN, "BME280", "Sample read failed at 0x%02X", address);
+        return;
+    }
+    sample.heatIndex = computeHeatIndex(sample.temperature, sample.humidity);
+    sample.dewPoint = computeDewPoint(sample.temperature, sample.humidity);
+    sample.timestamp = timeManager ? timeManager->getTime() : DateTime();
+    // Defensive check for invalid timestamp
+    if (!sample.timestamp.isValid() || sample.timestamp.year() < 2000 || sample.timestamp.month() < 1 || sample.timestamp.month() > 12 || sample.timestamp.day() < 1 || sample.timestamp.day() > 31) {
+        if (diagnosticManager) {
+            diagnosticManager->log(DiagnosticManager::LOG_WARN, "BME280", "Invalid timestamp detected after reading (year=%d, month=%d, day=%d) - setting to 0", sample.timestamp.year(), sample.timestamp.month(), sample.timestamp.day());
         }
-        readings[i].valid = true;
+        sample.timestamp = DateTime(1970, 1, 1, 0, 0, 0); // Set to known invalid value
+    }
+}
+
+void BME280Device::finishReading() {
+    // Keep only the samples that were read without a bus error
+    int validCount = 0;
+    for (int i = 0; i < sampleCount; ++i) {
+        if (samples[i].valid) samples[validCount++] = samples[i];
+    }
+    if (mode == MODE_FORCED) applySampling(Adafruit_BME280::MODE_SLEEP);
+    step = STEP_IDLE;
+    if (validCount == 0) {
+        lastReading.valid = false;
+        state = ERROR;
+        lastError = "No valid samples";
+        if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_ERROR, "BME280", "Reading at 0x%02X failed: no valid samples", address);
+        return;
     }
     // Store the first reading as the 'single' value
-    BME280Reading result = readings[0];
-    // Filter outliers and average
-    filterAndAverage(readings, N, result);
+    BME280Reading result = samples[0];
+    // Filter outliers and average; a normal-mode reading is one sample
+    filterAndAverage(samples, validCount, result);
     lastReading = result;
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-    bme.setSampling(Adafruit_BME280::MODE_SLEEP, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::FILTER_X16, Adafruit_BME280::STANDBY_MS_0_5);
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
     state = READY;
+    readingCount++;
     // Publish averaged temperature to MQTT/Home Assistant only if MQTT is enabled and in client mode
     if (lastReading.valid) {
         const char* wifiMode = systemManager.getConfigManager().get("wifi_mode");
@@ -120,14 +342,9 @@ BME280Reading BME280Device::readData() {
         }
         bool isClientMode = wifiMode && (strcmp(wifiMode, "client") == 0 || strcmp(wifiMode, "wifi") == 0);
         if (mqttEnabled && isClientMode && mqttManager.isInitialized()) {
-            mqttManager.publishBME280Temperature(lastReading.avgTemperature);
-            mqttManager.publishBME280Humidity(lastReading.avgHumidity);
-            mqttManager.publishBME280Pressure(lastReading.avgPressure);
-            mqttManager.publishBME280HeatIndex(lastReading.avgHeatIndex);
-            mqttManager.publishBME280DewPoint(lastReading.avgDewPoint);
+            mqttManager.publishBME280Reading(this);
         }
     }
-    return result;
 }
 
 void BME280Device::filterAndAverage(const BME280Reading* readings, int count, BME280Reading& avgResult) {
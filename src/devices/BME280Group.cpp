@@ -0,0 +1,105 @@
+#include <Arduino.h>
+#include <math.h>
+
+#include "devices/BME280Group.h"
+#include "system/LoopProfiler.h"
+
+bool BME280Group::add(BME280Device* device) {
+    if (!device || count >= MAX_SENSORS) return false;
+    devices[count++] = device;
+    return true;
+}
+
+int BME280Group::startReading() {
+    int started = 0;
+    for (int i = 0; i < count; ++i) {
+        if (devices[i]->startReading()) started++;
+    }
+    return started;
+}
+
+void BME280Group::requestReading() {
+    for (int i = 0; i < count; ++i) devices[i]->requestReading();
+}
+
+bool BME280Group::isReading() const {
+    for (int i = 0; i < count; ++i) {
+        if (devices[i]->isReading()) return true;
+    }
+    return false;
+}
+
+void BME280Group::forceIdle() {
+    for (int i = 0; i < count; ++i) devices[i]->forceIdle();
+}
+
+BME280Reading BME280Group::readData() {
+    LoopProfiler::Site stallSite("BME280Group::readData");
+    startReading();
+    while (isReading()) {
+        for (int i = 0; i < count; ++i) devices[i]->update();
+        vTaskDelay(1); // Yield to RTOS, non-blocking
+    }
+    return getMedianReading();
+}
+
+int BME280Group::validCount() const {
+    int n = 0;
+    for (int i = 0; i < count; ++i) {
+        if (devices[i]->getLastReading().valid) n++;
+    }
+    return n;
+}
+
+float BME280Group::median(float* values, int n) {
+    // Drop NaNs, then insertion sort; n is at most MAX_SENSORS
+    int kept = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!isnan(values[i])) values[kept++] = values[i];
+    }
+    if (kept == 0) return NAN;
+    for (int i = 1; i < kept; ++i) {
+        float v = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > v) {
+            values[j + 1] = values[j];
+            --j;
+        }
+        values[j + 1] = v;
+    }
+    return kept % 2 ? values[kept / 2] : (values[kept / 2 - 1] + values[kept / 2]) / 2.0f;
+}
+
+BME280Reading BME280Group::getMedianReading() const {
+    BME280Reading result{};
+    const BME280Reading* valid[MAX_SENSORS];
+    int n = 0;
+    for (int i = 0; i < count; ++i) {
+        const BME280Reading& r = devices[i]->getLastReading();
+        if (r.valid) valid[n++] = &r;
+    }
+    result.valid = n > 0;
+    if (!result.valid) return result;
+    float values[MAX_SENSORS];
+    // The same quantity of every valid sensor into values, then its median
+    auto take = [&](float BME280Reading::* field) {
+        for (int i = 0; i < n; ++i) values[i] = valid[i]->*field;
+        return median(values, n);
+    };
+    result.temperature = take(&BME280Reading::temperature);
+    result.humidity = take(&BME280Reading::humidity);
+    result.pressure = take(&BME280Reading::pressure);
+    result.heatIndex = take(&BME280Reading::heatIndex);
+    result.dewPoint = take(&BME280Reading::dewPoint);
+    result.avgTemperature = take(&BME280Reading::avgTemperature);
+    result.avgHumidity = take(&BME280Reading::avgHumidity);
+    result.avgPressure = take(&BME280Reading::avgPressure);
+    result.avgHeatIndex = take(&BME280Reading::avgHeatIndex);
+    result.avgDewPoint = take(&BME280Reading::avgDewPoint);
+    // The newest of the readings it was made from
+    result.timestamp = valid[0]->timestamp;
+    for (int i = 1; i < n; ++i) {
+        if (valid[i]->timestamp.unixtime() > result.timestamp.unixtime()) result.timestamp = valid[i]->timestamp;
+    }
+    return result;
+}
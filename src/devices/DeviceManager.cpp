@@ -35,3 +35,8 @@ SoilMoistureSensor* DeviceManager::getSoilMoistureSensor() {
 void DeviceManager::setBME280Device(BME280Device* device) {
     bme280Device = device;
 }
+
+void DeviceManager::addBME280Device(BME280Device* device) {
+    if (!bme280Device) bme280Device = device;
+    bme280Group.add(device);
+}
@@ -40,7 +40,7 @@ void IrrigationManager::stopNow() {
 }
 
 
-void IrrigationManager::begin(BME280Device* bme, SoilMoistureSensor* soil, TimeManager* timeMgr) {
+void IrrigationManager::begin(BME280Group* bme, SoilMoistureSensor* soil, TimeManager* timeMgr) {
     bme280 = bme;
     soilSensor = soil;
     timeManager = timeMgr;
@@ -78,6 +78,8 @@ void IrrigationManager::update() {
     static unsigned long lastProgressPrint = 0;
     static BME280Reading bmeAvg{};
     static SoilMoistureSensor::Reading soilAvg{};
+    static bool bmePending = false;
+    static bool soilDone = false;
     static float wateringThreshold = 0;
     float k = 0.5f;
     float t0 = 25.0f;
@@ -86,8 +88,24 @@ void IrrigationManager::update() {
             break;
         case START:
             Serial.println("[IrrigationManager] Starting BME280 reading...");
-            if (bme280) {
-                BME280Reading r = bme280->readData();
+            // All sensors at once, alongside the soil stabilisation; update() in loop() drives them
+            bmePending = bme280 && bme280->startReading() > 0;
+            if (bme280 && !bmePending) {
+                Serial.println("[IrrigationManager][BME280] Reading: not valid");
+                bmeAvg = BME280Reading{};
+            }
+            soilDone = soilSensor == nullptr;
+            if (soilSensor) {
+                Serial.println("[IrrigationManager] Starting soil moisture sensor stabilisation...");
+                soilSensor->beginStabilisation();
+                lastProgressPrint = millis();
+            }
+            startNextState(BME_READING);
+            break;
+        case BME_READING:
+            if (bmePending && !bme280->isReading()) {
+                bmePending = false;
+                BME280Reading r = bme280->getMedianReading();
                 if (r.valid) {
                     char timeStr[32] = "";
                     if (r.timestamp.isValid()) {
@@ -95,24 +113,16 @@ void IrrigationManager::update() {
                     } else {
                         strcpy(timeStr, "N/A");
                     }
-                    Serial.printf("[IrrigationManager][BME280] Reading: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC | avgT=%.2fC, avgH=%.2f%%, avgP=%.2fhPa, avgHI=%.2fC, avgDP=%.2fC, time=%s\n",
-                        r.temperature, r.humidity, r.pressure, r.heatIndex, r.dewPoint,
+                    Serial.printf("[IrrigationManager][BME280] Median of %d: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC | avgT=%.2fC, avgH=%.2f%%, avgP=%.2fhPa, avgHI=%.2fC, avgDP=%.2fC, time=%s\n",
+                        bme280->validCount(), r.temperature, r.humidity, r.pressure, r.heatIndex, r.dewPoint,
                         r.avgTemperature, r.avgHumidity, r.avgPressure, r.avgHeatIndex, r.avgDewPoint, timeStr);
                     bmeAvg = r;
                 } else {
                     Serial.println("[IrrigationManager][BME280] Reading: not valid");
-                    memset(&bmeAvg, 0, sizeof(bmeAvg));
+                    bmeAvg = BME280Reading{};
                 }
             }
-            if (soilSensor) {
-                Serial.println("[IrrigationManager] Starting soil moisture sensor stabilisation...");
-                soilSensor->beginStabilisation();
-                lastProgressPrint = millis();
-            }
-            startNextState(BME_READING);
-            break;
-        case BME_READING:
-            if (soilSensor) {
+            if (soilSensor && !soilDone) {
                 unsigned long now = millis();
                 int elapsed = (now - soilSensor->getStabilisationStart()) / 1000;
                 int total = soilSensor->getStabilisationTimeSec();
@@ -128,9 +138,10 @@ void IrrigationManager::update() {
                     // Clamp soil moisture percent to [0, 100]
                     soilAvg.avgPercent = std::max(0.0f, std::min(100.0f, soilAvg.avgPercent));
                     soilAvg.percent = std::max(0.0f, std::min(100.0f, soilAvg.percent));
-                    startNextState(SOIL_READING);
+                    soilDone = true;
                 }
             }
+            if (soilDone && !bmePending) startNextState(SOIL_READING);
             break;
         case SOIL_READING: {
             // Run watering logic here using available data
@@ -11,6 +11,7 @@ void MQ135Sensor::forceIdle() {
 
 #include "devices/MQ135Sensor.h"
 #include <time.h>
+#include "system/LoopProfiler.h"
 
 MQ135Sensor::MQ135Sensor() { state = IDLE; }
 
@@ -26,6 +27,12 @@ void MQ135Sensor::begin(ADS1115Manager* adsMgr, ConfigManager* configMgr, RelayC
             if (cJSON_IsNumber(warmup)) {
                 warmupTimeSec = warmup->valueint;
             }
+            cJSON* channelItem = cJSON_GetObjectItem(mq135Section, "ads_channel");
+            cJSON* gainItem = cJSON_GetObjectItem(mq135Section, "gain");
+            cJSON* autoGainItem = cJSON_GetObjectItem(mq135Section, "auto_gain");
+            if (cJSON_IsNumber(channelItem) && channelItem->valueint >= 0 && channelItem->valueint <= 3) channel = (uint8_t)channelItem->valueint;
+            if (cJSON_IsNumber(gainItem) && gainItem->valueint >= ADS1115Manager::GAIN_TWOTHIRDS && gainItem->valueint <= ADS1115Manager::GAIN_SIXTEEN) gain = (ADS1115Manager::Gain)gainItem->valueint;
+            if (cJSON_IsBool(autoGainItem)) autoGain = cJSON_IsTrue(autoGainItem);
         }
     }
     warmingUp = false;
@@ -38,32 +45,63 @@ void MQ135Sensor::startReading() {
     relay->activateRelay(3); // GPIO 26
     warmupStart = millis();
     warmingUp = true;
+    acquiring = false;
     state = WARMING_UP;
 }
 
-bool MQ135Sensor::readyForReading() const {
-    return warmingUp && (millis() - warmupStart) >= (unsigned long)(warmupTimeSec * 1000);
+bool MQ135Sensor::readyForReading() {
+    if (!warmingUp || (millis() - warmupStart) < (unsigned long)(warmupTimeSec * 1000)) return false;
+    if (!sampler || !sampler->isRunning() || samplerId < 0) return true;
+    if (!acquiring) {
+        // Warmed up: sample in the background from now on
+        acquiring = sampler->request(samplerId, BURST_SAMPLES);
+        acquireStart = millis();
+        return !acquiring;
+    }
+    return sampler->available(samplerId) >= BURST_SAMPLES || millis() - acquireStart >= ACQUIRE_TIMEOUT_MS;
+}
+
+void MQ135Sensor::setSampler(ADS1115Sampler* adsSampler) {
+    if (adsSampler == sampler) return;
+    sampler = adsSampler;
+    samplerId = sampler ? sampler->addChannel(channel, gain, 0, autoGain) : -1;
 }
 
 void MQ135Sensor::takeReading() {
     if (!ads || !relay) { state = ERROR; return; }
+    LoopProfiler::Site stallSite("MQ135Sensor::takeReading");
     state = READING;
-    // Take 10 readings in quick succession
-    const int N = 10;
-    float rawVals[N], voltVals[N];
-    for (int i = 0; i < N; ++i) {
-        rawVals[i] = (float)ads->readRaw(channel, gain, 100);
-        voltVals[i] = ads->readVoltage(channel, gain, 100);
-        unsigned long start = millis();
-        while (millis() - start < 250) {
-            vTaskDelay(1); // Yield to RTOS, non-blocking
-        }
+    int16_t codes[BURST_SAMPLES];
+    size_t N;
+    ADS1115Manager::Gain codeGain = gain;
+    if (acquiring) {
+        // Collected by the sampler task since readyForReading()
+        N = sampler->readWindow(samplerId, codes, BURST_SAMPLES);
+        codeGain = sampler->getWindowGain(samplerId);
+        acquiring = false;
+    } else {
+        // One continuous-mode burst, ~40 ms at 860 SPS
+        N = autoGain ? ads->readBurstAuto(channel, BURST_RATE, codes, BURST_SAMPLES, codeGain)
+                     : ads->readBurst(channel, gain, BURST_RATE, codes, BURST_SAMPLES);
+    }
+    if (N == 0) {
+        // Keep the reading flowing the way a failed single-shot read did
+        if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_WARN, "MQ135Sensor", "No ADS1115 samples, taking one single-shot sample");
+        codeGain = gain;
+        codes[0] = autoGain ? (int16_t)ads->readRawAuto(channel, codeGain, 100) : (int16_t)ads->readRaw(channel, gain, 100);
+        N = 1;
+    }
+    float rawVals[BURST_SAMPLES], voltVals[BURST_SAMPLES];
+    for (size_t i = 0; i < N; ++i) {
+        // Raw stays in gain's scale whatever range it was read at
+        rawVals[i] = ADS1115Manager::rescaleCode(codes[i], codeGain, gain);
+        voltVals[i] = ADS1115Manager::codeToVolts(codes[i], codeGain);
     }
     // Store the first reading as the 'single' value
-    lastReading.raw = (int16_t)rawVals[0];
+    lastReading.raw = (int16_t)lroundf(rawVals[0]);
     lastReading.voltage = voltVals[0];
     // Filter outliers and average
-    filterAndAverage(rawVals, voltVals, N, lastReading.avgRaw, lastReading.avgVoltage);
+    filterAndAverage(rawVals, voltVals, (int)N, lastReading.avgRaw, lastReading.avgVoltage);
     if (timeManager) {
         DateTime dt = timeManager->getLocalTime();
         if (!dt.isValid() || dt.year() < 2000 || dt.month() < 1 || dt.month() > 12 || dt.day() < 1 || dt.day() > 31) {
@@ -28,6 +28,7 @@ void SoilMoistureSensor::forceIdle() {
 #include "config/ConfigManager.h"
 #include <time.h>
 #include "system/TimeManager.h"
+#include "system/LoopProfiler.h"
 
 SoilMoistureSensor::SoilMoistureSensor() {}
 
@@ -37,6 +38,7 @@ void SoilMoistureSensor::begin(ADS1115Manager* adsMgr, ConfigManager* configMgr,
     timeManager = timeMgr;
     diagnosticManager = diagMgr;
     state = IDLE;
+    loadCalibration();
     // Get stabilisation time from config->soil_moisture if available
     if (config) {
         cJSON* soilSection = config->getSection("soil_moisture");
@@ -45,6 +47,14 @@ void SoilMoistureSensor::begin(ADS1115Manager* adsMgr, ConfigManager* configMgr,
             int t = 10;
             if (cJSON_IsNumber(stabItem)) t = stabItem->valueint;
             if (t > 0) stabilisationTimeSec = t;
+            cJSON* channelItem = cJSON_GetObjectItem(soilSection, "ads_channel");
+            cJSON* gainItem = cJSON_GetObjectItem(soilSection, "gain");
+            cJSON* autoGainItem = cJSON_GetObjectItem(soilSection, "auto_gain");
+            cJSON* dryWatchItem = cJSON_GetObjectItem(soilSection, "dry_watch");
+            if (cJSON_IsNumber(channelItem) && channelItem->valueint >= 0 && channelItem->valueint <= 3) channel = (uint8_t)channelItem->valueint;
+            if (cJSON_IsNumber(gainItem) && gainItem->valueint >= ADS1115Manager::GAIN_TWOTHIRDS && gainItem->valueint <= ADS1115Manager::GAIN_SIXTEEN) gain = (ADS1115Manager::Gain)gainItem->valueint;
+            if (cJSON_IsBool(autoGainItem)) autoGain = cJSON_IsTrue(autoGainItem);
+            dryWatch = cJSON_IsTrue(dryWatchItem);
         }
         // Get soil power gpio from config
         soilPowerGpio = config->getInt("soil_power_gpio", 16);
@@ -83,39 +93,72 @@ void SoilMoistureSensor::printReading() const {
 }
 
 void SoilMoistureSensor::beginStabilisation() {
+    disarmDryWatch();
     stabilisationStart = millis();
     state = STABILISING;
+    acquiring = false;
+    loadCalibration();
     if (soilPowerGpio >= 0) {
         digitalWrite(soilPowerGpio, HIGH); // Power on sensor
     }
 }
 
-bool SoilMoistureSensor::readyForReading() const {
-    return (millis() - stabilisationStart) >= (unsigned long)(stabilisationTimeSec * 1000);
+bool SoilMoistureSensor::readyForReading() {
+    if ((millis() - stabilisationStart) < (unsigned long)(stabilisationTimeSec * 1000)) return false;
+    if (!sampler || !sampler->isRunning() || samplerId < 0) return true;
+    if (!acquiring) {
+        // Stabilised: sample in the background from now on
+        acquiring = sampler->request(samplerId, BURST_SAMPLES);
+        acquireStart = millis();
+        return !acquiring;
+    }
+    return sampler->available(samplerId) >= BURST_SAMPLES || millis() - acquireStart >= ACQUIRE_TIMEOUT_MS;
+}
+
+void SoilMoistureSensor::setSampler(ADS1115Sampler* adsSampler) {
+    if (adsSampler == sampler) return;
+    sampler = adsSampler;
+    samplerId = sampler ? sampler->addChannel(channel, gain, 0, autoGain) : -1;
 }
 
 void SoilMoistureSensor::takeReading() {
+    LoopProfiler::Site stallSite("SoilMoistureSensor::takeReading");
     state = READING;
-    // Take 10 readings in quick succession
-    const int N = 10;
-    float rawVals[N], voltVals[N], percentVals[N];
-    for (int i = 0; i < N; ++i) {
-        rawVals[i] = (float)readRaw();
-        voltVals[i] = readVoltage();
-        percentVals[i] = readPercent();
-        unsigned long start = millis();
-        while (millis() - start < 250) {
-            vTaskDelay(1); // Yield to RTOS, non-blocking
-        }
+    int16_t codes[BURST_SAMPLES];
+    size_t N = 0;
+    ADS1115Manager::Gain codeGain = gain;
+    if (acquiring) {
+        // Collected by the sampler task since readyForReading()
+        N = sampler->readWindow(samplerId, codes, BURST_SAMPLES);
+        codeGain = sampler->getWindowGain(samplerId);
+        acquiring = false;
+    } else if (ads) {
+        // One continuous-mode burst, ~40 ms at 860 SPS
+        N = autoGain ? ads->readBurstAuto(channel, BURST_RATE, codes, BURST_SAMPLES, codeGain)
+                     : ads->readBurst(channel, gain, BURST_RATE, codes, BURST_SAMPLES);
+    }
+    if (N == 0) {
+        // Keep the reading flowing the way a failed single-shot read did
+        if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_WARN, "SoilMoistureSensor", "No ADS1115 samples, taking one single-shot sample");
+        codes[0] = readCode(codeGain);
+        N = 1;
+    }
+    float rawVals[BURST_SAMPLES], voltVals[BURST_SAMPLES], percentVals[BURST_SAMPLES];
+    for (size_t i = 0; i < N; ++i) {
+        Sample sample = toSample(codes[i], codeGain);
+        // Unrounded, so the average keeps the finer range's resolution
+        rawVals[i] = ADS1115Manager::rescaleCode(codes[i], codeGain, gain);
+        voltVals[i] = sample.voltage;
+        percentVals[i] = sample.percent;
     }
     // Store the first reading as the 'single' value
-    lastReading.raw = (int16_t)rawVals[0];
+    lastReading.raw = toSample(codes[0], codeGain).raw;
     lastReading.voltage = voltVals[0];
     lastReading.percent = percentVals[0];
     // Call onNewReading to trigger MQTT publish and any listeners
     onNewReading(lastReading.percent);
     // Filter outliers and average
-    filterAndAverage(rawVals, voltVals, percentVals, N, lastReading.avgRaw, lastReading.avgVoltage, lastReading.avgPercent);
+    filterAndAverage(rawVals, voltVals, percentVals, (int)N, lastReading.avgRaw, lastReading.avgVoltage, lastReading.avgPercent);
     if (timeManager) {
         DateTime dt = timeManager->getLocalTime();
         if (!dt.isValid() || dt.year() < 2000 || dt.month() < 1 || dt.month() > 12 || dt.day() < 1 || dt.day() > 31) {
@@ -129,7 +172,8 @@ void SoilMoistureSensor::takeReading() {
     } else {
         lastReading.timestamp = time(nullptr);
     }
-    if (soilPowerGpio >= 0) {
+    if (dryWatch) armDryWatch();
+    if (soilPowerGpio >= 0 && !dryWatchArmed) {
         digitalWrite(soilPowerGpio, LOW); // Power off sensor after reading
     }
     state = IDLE;
@@ -174,33 +218,100 @@ const SoilMoistureSensor::Reading& SoilMoistureSensor::getLastReading() const {
 }
 
 int16_t SoilMoistureSensor::readRaw() {
+    return readSample().raw;
+}
+
+int16_t SoilMoistureSensor::readCode(ADS1115Manager::Gain& codeGain) {
+    codeGain = gain;
     if (!ads) return 0;
-    // Use single-ended mode, channel 0 (A0)
-    uint16_t raw = ads->readRaw(channel, gain, 100);
-    return (int16_t)raw;
+    // Single-ended on the configured input
+    if (autoGain) return (int16_t)ads->readRawAuto(channel, codeGain, 100);
+    return (int16_t)ads->readRaw(channel, gain, 100);
 }
 
 float SoilMoistureSensor::readVoltage() {
-    if (!ads) return 0.0f;
-    return ads->readVoltage(channel, gain, 100);
+    return readSample().voltage;
 }
 
 void SoilMoistureSensor::readBoth(int16_t& raw, float& voltage) {
-    raw = readRaw();
-    voltage = readVoltage();
+    Sample sample = readSample();
+    raw = sample.raw;
+    voltage = sample.voltage;
 }
 
 float SoilMoistureSensor::readPercent() {
-    if (!config) return 0.0f;
+    return readSample().percent;
+}
+
+SoilMoistureSensor::Sample SoilMoistureSensor::readSample() {
+    if (!ads) return Sample{0, 0.0f, 0.0f};
+    ADS1115Manager::Gain codeGain;
+    int16_t code = readCode(codeGain);
+    return toSample(code, codeGain);
+}
+
+SoilMoistureSensor::Sample SoilMoistureSensor::toSample(int16_t code, ADS1115Manager::Gain codeGain) const {
+    long raw = lroundf(ADS1115Manager::rescaleCode(code, codeGain, gain));
+    Sample sample;
+    sample.raw = (int16_t)(raw > 32767 ? 32767 : (raw < -32768 ? -32768 : raw));
+    sample.voltage = ADS1115Manager::codeToVolts(code, codeGain);
+    sample.percent = calibrated ? rawToPercent(sample.raw, calibrationWet, calibrationDry) : 0.0f;
+    return sample;
+}
+
+void SoilMoistureSensor::armDryWatch() {
+    if (!ads || !config || !calibrated || calibrationDry == calibrationWet) return;
+    float threshold = (float)config->getInt("watering_threshold", 50);
+    // Already dry: the reading just taken is the one irrigation acts on
+    if (lastReading.avgPercent <= threshold) return;
+    int16_t thresholdRaw = (int16_t)lroundf(calibrationDry - threshold / 100.0f * (calibrationDry - calibrationWet));
+    // Raw rises as the soil dries unless the probe is wired the other way
+    // round; the window's other bound is pinned to the end of the scale
+    bool risesWhenDry = calibrationDry > calibrationWet;
+    int16_t lo = risesWhenDry ? INT16_MIN : thresholdRaw;
+    int16_t hi = risesWhenDry ? thresholdRaw : INT16_MAX;
+    dryWatchArmed = ads->startWatch(channel, gain, lo, hi);
+    if (dryWatchArmed) {
+        Serial.printf("[SoilMoistureSensor] Dry watch armed at raw %d (%.0f%%)\n", thresholdRaw, threshold);
+    } else {
+        Serial.println("[SoilMoistureSensor] Dry watch needs ads1115_alert_gpio, sensor powered off as usual");
+    }
+}
+
+void SoilMoistureSensor::disarmDryWatch() {
+    if (!dryWatchArmed) return;
+    dryWatchArmed = false;
+    if (ads) ads->stopWatch();
+}
+
+bool SoilMoistureSensor::checkDryWatch() {
+    if (!dryWatchArmed || !ads->watchTripped()) return false;
+    int16_t code = 0;
+    ads->stopWatch(&code);
+    dryWatchArmed = false;
+    if (soilPowerGpio >= 0) {
+        digitalWrite(soilPowerGpio, LOW);
+    }
+    Serial.printf("[SoilMoistureSensor] ADS1115 comparator: soil passed the dryness threshold (raw %d, %.1f%%)\n",
+                  code, calibrated ? rawToPercent(code, calibrationWet, calibrationDry) : 0.0f);
+    return true;
+}
+
+void SoilMoistureSensor::loadCalibration() {
+    calibrated = false;
+    calibrationWet = 0;
+    calibrationDry = 11300;
+    if (!config) return;
     cJSON* soilSection = config->getSection("soil_moisture");
-    if (!soilSection) return 0.0f;
-    int wet = 0;
-    int dry = 11300;
+    if (!soilSection) return;
     cJSON* wetItem = cJSON_GetObjectItem(soilSection, "wet");
     cJSON* dryItem = cJSON_GetObjectItem(soilSection, "dry");
-    if (cJSON_IsNumber(wetItem)) wet = wetItem->valueint;
-    if (cJSON_IsNumber(dryItem)) dry = dryItem->valueint;
-    int16_t raw = readRaw();
+    if (cJSON_IsNumber(wetItem)) calibrationWet = wetItem->valueint;
+    if (cJSON_IsNumber(dryItem)) calibrationDry = dryItem->valueint;
+    calibrated = true;
+}
+
+float SoilMoistureSensor::rawToPercent(int16_t raw, int wet, int dry) {
     float percent = 0.0f;
     if (dry != wet) {
         percent = 100.0f * (float)(dry - raw) / (float)(dry - wet);
@@ -0,0 +1,237 @@
+#include "diagnostics/AllocationTracker.h"
+#include <esp_heap_caps.h>
+#include <atomic>
+#include <new>
+
+static AllocationTracker::Operation operations[AllocationTracker::MAX_OPERATIONS];
+static int operationCount = 0;
+static SemaphoreHandle_t registryMutex = nullptr;
+static thread_local AllocationTracker::Scope* currentScope = nullptr;
+// Updated from every task without the registry mutex
+static std::atomic<uint32_t> liveBlocks(0);
+static std::atomic<int32_t> liveBytes(0);
+static std::atomic<int32_t> peakLiveBytes(0);
+static std::atomic<uint64_t> totalAllocs(0);
+static AllocationTracker::AllocateListener allocateListener = nullptr;
+static AllocationTracker::FreeListener freeListener = nullptr;
+
+#ifdef ALLOC_TRACKING
+static void* trackedMalloc(size_t size) {
+    void* ptr = malloc(size);
+    AllocationTracker::noteAllocation(ptr, size);
+    return ptr;
+}
+
+static void trackedFree(void* ptr) {
+    AllocationTracker::noteFree(ptr);
+    free(ptr);
+}
+#endif
+
+void AllocationTracker::begin() {
+    if (!registryMutex) registryMutex = xSemaphoreCreateMutex();
+#ifdef ALLOC_TRACKING
+    // cJSON strings printed with these hooks may still be released with
+    // plain free(); the hooks only observe, they do not change the heap.
+    cJSON_Hooks hooks = { trackedMalloc, trackedFree };
+    cJSON_InitHooks(&hooks);
+#endif
+}
+
+void AllocationTracker::reset() {
+    if (registryMutex) xSemaphoreTake(registryMutex, portMAX_DELAY);
+    // Names stay registered so scopes that are still open keep a valid slot
+    for (int i = 0; i < operationCount; ++i) {
+        Operation& op = operations[i];
+        op.calls = 0;
+        op.allocs = 0;
+        op.bytes = 0;
+        op.maxAllocs = 0;
+        op.maxBytes = 0;
+        op.maxPeakBytes = 0;
+        op.netBytes = 0;
+    }
+    if (registryMutex) xSemaphoreGive(registryMutex);
+}
+
+int AllocationTracker::getOperationCount() {
+    return operationCount;
+}
+
+const AllocationTracker::Operation* AllocationTracker::getOperation(int index) {
+    return (index >= 0 && index < operationCount) ? &operations[index] : nullptr;
+}
+
+// Stored names are truncated to NAME_LENGTH - 1, so compare only that much
+const AllocationTracker::Operation* AllocationTracker::findOperation(const char* name) {
+    for (int i = 0; i < operationCount; ++i) {
+        if (strncmp(operations[i].name, name, NAME_LENGTH - 1) == 0) return &operations[i];
+    }
+    return nullptr;
+}
+
+int AllocationTracker::findOrAdd(const char* name) {
+    for (int i = 0; i < operationCount; ++i) {
+        if (strncmp(operations[i].name, name, NAME_LENGTH - 1) == 0) return i;
+    }
+    if (operationCount >= MAX_OPERATIONS) return -1;
+    Operation& op = operations[operationCount];
+    memset(&op, 0, sizeof(op));
+    strncpy(op.name, name, NAME_LENGTH - 1);
+    return operationCount++;
+}
+
+AllocationTracker::Scope::Scope(const char* operation) : parent(currentScope) {
+    if (registryMutex) xSemaphoreTake(registryMutex, portMAX_DELAY);
+    index = findOrAdd(operation);
+    if (registryMutex) xSemaphoreGive(registryMutex);
+    currentScope = this;
+}
+
+AllocationTracker::Scope::~Scope() {
+    currentScope = parent;
+    AllocationTracker::finish(*this);
+}
+
+void AllocationTracker::finish(Scope& scope) {
+    if (scope.parent) {
+        Scope& parent = *scope.parent;
+        parent.allocs += scope.allocs;
+        parent.bytes += scope.bytes;
+        if (parent.liveBytes + scope.peakBytes > parent.peakBytes) parent.peakBytes = parent.liveBytes + scope.peakBytes;
+        parent.liveBytes += scope.liveBytes;
+    }
+    if (scope.index < 0) return;
+    if (registryMutex) xSemaphoreTake(registryMutex, portMAX_DELAY);
+    Operation& op = operations[scope.index];
+    op.calls++;
+    op.allocs += scope.allocs;
+    op.bytes += scope.bytes;
+    if (scope.allocs > op.maxAllocs) op.maxAllocs = scope.allocs;
+    if (scope.bytes > op.maxBytes) op.maxBytes = scope.bytes;
+    if (scope.peakBytes > 0 && (uint32_t)scope.peakBytes > op.maxPeakBytes) op.maxPeakBytes = (uint32_t)scope.peakBytes;
+    op.netBytes += scope.liveBytes;
+    if (registryMutex) xSemaphoreGive(registryMutex);
+}
+
+AllocationTracker::Totals AllocationTracker::getTotals() {
+    Totals totals;
+    totals.liveBlocks = liveBlocks.load();
+    totals.liveBytes = liveBytes.load();
+    totals.peakLiveBytes = peakLiveBytes.load();
+    totals.allocs = totalAllocs.load();
+    return totals;
+}
+
+void AllocationTracker::setListener(AllocateListener onAllocate, FreeListener onFree) {
+    allocateListener = onAllocate;
+    freeListener = onFree;
+}
+
+void AllocationTracker::noteAllocation(void* ptr, size_t size) {
+    if (!ptr) return;
+    int32_t usable = (int32_t)heap_caps_get_allocated_size(ptr);
+    liveBlocks++;
+    totalAllocs++;
+    int32_t live = liveBytes += usable;
+    int32_t peak = peakLiveBytes.load();
+    while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live)) {}
+    if (allocateListener) allocateListener(ptr, size);
+
+    Scope* scope = currentScope;
+    if (!scope) return;
+    scope->allocs++;
+    scope->bytes += (uint32_t)size;
+    scope->liveBytes += usable;
+    if (scope->liveBytes > scope->peakBytes) scope->peakBytes = scope->liveBytes;
+}
+
+void AllocationTracker::noteFree(void* ptr) {
+    if (!ptr) return;
+    int32_t usable = (int32_t)heap_caps_get_allocated_size(ptr);
+    liveBlocks--;
+    liveBytes -= usable;
+    if (freeListener) freeListener(ptr);
+
+    Scope* scope = currentScope;
+    if (!scope) return;
+    scope->liveBytes -= usable;
+}
+
+cJSON* AllocationTracker::getStatsJson() {
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddBoolToObject(root, "tracking", isEnabled());
+    cJSON* ops = cJSON_AddArrayToObject(root, "operations");
+    for (int i = 0; i < operationCount; ++i) {
+        const Operation& op = operations[i];
+        if (op.calls == 0) continue;
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "name", op.name);
+        cJSON_AddNumberToObject(item, "calls", op.calls);
+        cJSON_AddNumberToObject(item, "allocs", (double)op.allocs);
+        cJSON_AddNumberToObject(item, "bytes", (double)op.bytes);
+        cJSON_AddNumberToObject(item, "avg_allocs", (double)op.allocs / op.calls);
+        cJSON_AddNumberToObject(item, "avg_bytes", (double)op.bytes / op.calls);
+        cJSON_AddNumberToObject(item, "max_allocs", op.maxAllocs);
+        cJSON_AddNumberToObject(item, "max_bytes", op.maxBytes);
+        cJSON_AddNumberToObject(item, "peak_bytes", op.maxPeakBytes);
+        cJSON_AddNumberToObject(item, "net_bytes", (double)op.netBytes);
+        cJSON_AddItemToArray(ops, item);
+    }
+    Totals totals = getTotals();
+    cJSON_AddNumberToObject(root, "live_blocks", totals.liveBlocks);
+    cJSON_AddNumberToObject(root, "live_bytes", totals.liveBytes);
+    cJSON_AddNumberToObject(root, "peak_live_bytes", totals.peakLiveBytes);
+    cJSON_AddNumberToObject(root, "free_heap", ESP.getFreeHeap());
+    cJSON_AddNumberToObject(root, "min_free_heap", ESP.getMinFreeHeap());
+    cJSON_AddNumberToObject(root, "largest_free_block", ESP.getMaxAllocHeap());
+    return root;
+}
+
+#ifdef ALLOC_TRACKING
+// Global operator new/delete, so std::string, std::vector and new'd
+// objects are attributed to the active scope as well.
+void* operator new(size_t size) {
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+#if __cpp_exceptions
+        throw std::bad_alloc();
+#else
+        abort();
+#endif
+    }
+    AllocationTracker::noteAllocation(ptr, size);
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    void* ptr = malloc(size ? size : 1);
+    AllocationTracker::noteAllocation(ptr, size);
+    return ptr;
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    AllocationTracker::noteFree(ptr);
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+#endif // ALLOC_TRACKING
@@ -54,6 +54,7 @@ void setup() {
 
     // ...existing initialization code...
     systemManager.begin();
+    BootTimeline::Scope setupPhase("setup() sensors and devices");
     // Set soil power GPIO LOW at boot (redundant safety)
     int soilPowerGpio = systemManager.getConfigManager().getInt("soil_power_gpio", 16);
     if (soilPowerGpio >= 0) {
@@ -63,6 +64,8 @@ void setup() {
     soilMoistureSensor.begin(&systemManager.getADS1115Manager(), &systemManager.getConfigManager(), &systemManager.getTimeManager());
     mq135Sensor.begin(&systemManager.getADS1115Manager(), &systemManager.getConfigManager(), &relayController);
     mq135Sensor.setTimeManager(&systemManager.getTimeManager());
+    soilMoistureSensor.setSampler(&systemManager.getADS1115Sampler());
+    mq135Sensor.setSampler(&systemManager.getADS1115Sampler());
     soilReadingTaken = false;
     soilReadingRequested = false;
     mq135ReadingTaken = false;
@@ -70,7 +73,7 @@ void setup() {
     lastStabilisationPrint = 0;
     mq135LastProgressPrint = 0;
     sensorState = IDLE;
-    irrigationManager.begin(systemManager.getDeviceManager().getBME280Device(), &soilMoistureSensor, &systemManager.getTimeManager());
+    irrigationManager.begin(&systemManager.getDeviceManager().getBME280Group(), &soilMoistureSensor, &systemManager.getTimeManager());
     irrigationManager.setConfigManager(&systemManager.getConfigManager());
     irrigationManager.setRelayController(&relayController);
     irrigationManager.setMQ135Sensor(&mq135Sensor);
@@ -156,6 +159,8 @@ void setup() {
 }
 
 void loop() {
+    LoopProfiler& profiler = systemManager.getLoopProfiler();
+    unsigned long loopStart = micros();
     systemManager.update();
     static ReadingManager* readingManager = nullptr;
     static bool readingManagerInitialized = false;
@@ -172,6 +177,7 @@ void loop() {
                 soilMoistureSensor.beginStabilisation();
                 Serial.println("[INIT] Starting soil sensor stabilisation (override 3s)...");
                 initState = INIT_SOIL_STABILISING;
+                systemManager.getBootTimeline().enterState("INIT_SOIL_STABILISING");
                 lastStabilisationPrint = millis();
                 break;
             }
@@ -189,6 +195,7 @@ void loop() {
                     soilMoistureSensor.printReading();
                     soilMoistureSensor.setStabilisationTimeSec(originalSoilStab);
                     initState = INIT_SOIL_DONE;
+                    systemManager.getBootTimeline().enterState("INIT_SOIL_DONE");
                 }
                 break;
             }
@@ -198,6 +205,7 @@ void loop() {
                 Serial.println("[INIT] Soil sensor done, starting MQ135 warmup (override 5s)...");
                 mq135Sensor.startReading();
                 initState = INIT_MQ135_WARMUP;
+                systemManager.getBootTimeline().enterState("INIT_MQ135_WARMUP");
                 mq135LastProgressPrint = millis();
                 break;
             }
@@ -219,6 +227,7 @@ void loop() {
                     Serial.printf("[INIT][MQ135Sensor] Reading: raw=%d, voltage=%.4f V | avgRaw=%.1f, avgVoltage=%.4f V, AQI=%s, timestamp=%s\n",
                         r.raw, r.voltage, r.avgRaw, r.avgVoltage, MQ135Sensor::getAirQualityLabel(r.avgVoltage), timeStr);
                     initState = INIT_MQ135_DONE;
+                    systemManager.getBootTimeline().enterState("INIT_MQ135_DONE");
                 }
                 break;
             }
@@ -227,6 +236,9 @@ void loop() {
                 Serial.println("[INIT] All sensors initialized!");
                 sensorsInitialized = true;
                 initState = INIT_COMPLETE;
+                // Runs until the web server starts on the first valid sensor data
+                systemManager.getBootTimeline().enterState("INIT_COMPLETE");
+                BootTimeline::Scope dashboardPhase("dashboard and MQTT start");
                 dashboard = new DashboardManager(
                     &systemManager.getTimeManager(),
                     &systemManager.getConfigManager(),
@@ -237,6 +249,7 @@ void loop() {
                     &touch,
                     systemManager.getDeviceManager().getBME280Device()
                 );
+                dashboard->setBME280Group(&systemManager.getDeviceManager().getBME280Group());
                 dashboard->setSoilMoistureSensor(&soilMoistureSensor);
                 dashboard->setMQ135Sensor(&mq135Sensor);
                 dashboard->setIrrigationManager(&irrigationManager);
@@ -262,8 +275,11 @@ void loop() {
                     } else {
                         relayNames = {"Zone 1", "Zone 2", "Zone 3", "Zone 4"};
                     }
-                    mqttManager.begin(deviceName, relayNames, &systemManager.getConfigManager());
-                    mqttManager.setInitialized(true);
+                    {
+                        BootTimeline::Scope mqttPhase("MqttManager::begin");
+                        mqttManager.begin(deviceName, relayNames, &systemManager.getConfigManager());
+                        mqttManager.setInitialized(true);
+                    }
                     // Publish initial BME280 temperature to Home Assistant
                     BME280Device* bme = systemManager.getDeviceManager().getBME280Device();
                     if (bme) {
@@ -282,15 +298,20 @@ void loop() {
             case INIT_COMPLETE:
                 break;
         }
+        profiler.record(LoopProfiler::LOOP_TOTAL, micros() - loopStart);
         return;
     }
 
     // --- WebServerManager initialization ---
     if (!webServerStarted && dashboard && dashboard->hasValidSensorData()) {
         Serial.println("[DEBUG] Initializing WebServerManager...");
-        webServerManager = new WebServerManager(dashboard, &systemManager.getDiagnosticManager());
-        webServerManager->begin();
+        {
+            BootTimeline::Scope phase("WebServerManager::begin");
+            webServerManager = new WebServerManager(dashboard, &systemManager.getDiagnosticManager());
+            webServerManager->begin();
+        }
         webServerStarted = true;
+        systemManager.getBootTimeline().finish();
         Serial.println("[WebServerManager] Started after valid sensor data detected.");
     }
     // --- ReadingManager initialization ---
@@ -300,7 +321,7 @@ void loop() {
     }
     if (!readingManagerInitialized && sensorsInitialized && webServerStarted) {
         Serial.println("[DEBUG] Initializing ReadingManager...");
-        readingManager = new ReadingManager(systemManager.getDeviceManager().getBME280Device(), &soilMoistureSensor);
+        readingManager = new ReadingManager(&systemManager.getDeviceManager().getBME280Group(), &soilMoistureSensor);
         readingManager->begin();
         readingManagerInitialized = true;
         char timeStr[32] = "";
@@ -353,7 +374,7 @@ void loop() {
     }
     if (!readingManagerInitialized && sensorsInitialized && webServerStarted) {
         Serial.println("[DEBUG] Initializing ReadingManager...");
-        readingManager = new ReadingManager(systemManager.getDeviceManager().getBME280Device(), &soilMoistureSensor);
+        readingManager = new ReadingManager(&systemManager.getDeviceManager().getBME280Group(), &soilMoistureSensor);
         readingManager->begin();
         readingManagerInitialized = true;
         char timeStr[32] = "";
@@ -385,15 +406,31 @@ void loop() {
             }
         }
     }
-    if (readingManagerInitialized && readingManager) readingManager->loop(now);
+    if (readingManagerInitialized && readingManager) {
+        LoopProfiler::Scope timing(profiler, LoopProfiler::READINGS);
+        readingManager->loop(now);
+    }
     // MQTT loop
-    if (mqttManagerInitialized) mqttManager.loop();
+    if (mqttManagerInitialized) {
+        LoopProfiler::Scope timing(profiler, LoopProfiler::MQTT);
+        mqttManager.loop();
+    }
     
     if (sensorsInitialized && initState == INIT_COMPLETE) {
+        LoopProfiler::Scope timing(profiler, LoopProfiler::IRRIGATION);
+        if (soilMoistureSensor.checkDryWatch()) {
+            Serial.println("[IrrigationManager] Soil dried out between cycles, triggering irrigation.");
+            irrigationManager.trigger();
+        }
         irrigationManager.update();
         irrigationManager.checkAndRunScheduled();
     }
 
+    unsigned long sensorsStart = micros();
+    // BME280 readings run as a state machine; this takes their next step
+    for (const auto& bme : systemManager.getI2CManager().getBME280Devices()) {
+        bme->update();
+    }
     switch (sensorState) {
         case IDLE:
             // If a manual MQ135 reading was requested, start warmup
@@ -486,14 +523,22 @@ void loop() {
             sensorState = IDLE; // Always return to IDLE so deferred readings can trigger
             break;
     }
+    profiler.record(LoopProfiler::SENSORS, micros() - sensorsStart);
     // Poll INT/SQW GPIO for hardware interrupt detection
-    if (systemManager.getTimeManager().pollInterruptPin()) {
-        systemManager.getTimeManager().handleAlarmInterrupt();
-    } else {
-        systemManager.getTimeManager().handleAlarmInterrupt();
+    {
+        LoopProfiler::Scope timing(profiler, LoopProfiler::ALARMS);
+        if (systemManager.getTimeManager().pollInterruptPin()) {
+            systemManager.getTimeManager().handleAlarmInterrupt();
+        } else {
+            systemManager.getTimeManager().handleAlarmInterrupt();
+        }
+    }
+    {
+        LoopProfiler::Scope timing(profiler, LoopProfiler::RELAYS);
+        systemManager.getTimeManager().updateRelayFromIntSqw();
     }
-    systemManager.getTimeManager().updateRelayFromIntSqw();
     // --- Touch sensor actions ---
+    unsigned long touchStart = micros();
     // Only bring up AP if in AP mode, AP is not active, and touch is pressed (short press)
     NetworkManager& netMgr = systemManager.getNetworkManager();
     ConfigManager& cfgMgr = systemManager.getConfigManager();
@@ -507,5 +552,7 @@ void loop() {
         delay(1000); // Give user feedback
         ESP.restart();
     }
+    profiler.record(LoopProfiler::TOUCH, micros() - touchStart);
+    profiler.record(LoopProfiler::LOOP_TOTAL, micros() - loopStart);
     delay(10);
 }
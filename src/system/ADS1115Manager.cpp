@@ -3,18 +3,26 @@
 
 ADS1115Manager::ADS1115Manager() {}
 
-void ADS1115Manager::begin(SemaphoreHandle_t mutex, uint8_t i2cAddress) {
+void ADS1115Manager::begin(SemaphoreHandle_t mutex, uint8_t i2cAddress, I2CTracer* tracer, int alertPin) {
     address = i2cAddress;
     i2cMutex = mutex;
+    i2cTracer = tracer;
+    alertGpio = alertPin;
+    if (conversionMutex == nullptr) {
+        conversionMutex = xSemaphoreCreateMutex();
+    }
+    forgetRegisters();
     Wire.begin();
     connected = checkConnection();
+    if (connected && alertGpio >= 0) enableAlert();
 }
 
 bool ADS1115Manager::checkConnection() {
-    if (i2cMutex) xSemaphoreTake(i2cMutex, portMAX_DELAY);
+    I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.probe");
     Wire.beginTransmission(address);
+    access.addTransaction(0, 0);
     uint8_t error = Wire.endTransmission();
-    if (i2cMutex) xSemaphoreGive(i2cMutex);
+    if (error != 0) access.fail();
     return (error == 0);
 }
 
@@ -26,46 +34,457 @@ uint8_t ADS1115Manager::getAddress() const {
     return address;
 }
 
+// Conversion-ready mode: Hi_thresh MSB set, Lo_thresh MSB clear. Each read
+// then enables the comparator queue so ALERT/RDY falls when it completes.
+bool ADS1115Manager::enableAlert() {
+    bool ok;
+    {
+        I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.alertSetup");
+        ok = writeRegister(access, 0x02, 0x0000) && writeRegister(access, 0x03, 0x8000);
+        if (!ok) access.fail();
+    }
+    if (!ok) {
+        Serial.printf("[ADS1115] Could not set up ALERT/RDY at 0x%02X, polling for conversions\n", address);
+        return false;
+    }
+    if (alertReady == nullptr) {
+        alertReady = xSemaphoreCreateBinary();
+    }
+    attachAlert();
+    consecutiveMisses = 0;
+    alertMode = true;
+    Serial.printf("[ADS1115] Conversion ready on ALERT/RDY, GPIO %d\n", alertGpio);
+    return true;
+}
+
+void ADS1115Manager::attachAlert() {
+    if (alertAttached) return;
+    pinMode(alertGpio, INPUT_PULLUP);
+    attachInterruptArg(digitalPinToInterrupt(alertGpio), onAlert, this, FALLING);
+    alertAttached = true;
+}
+
+void ADS1115Manager::disableAlert() {
+    // The watch still needs the interrupt
+    if (!watch.armed) {
+        detachInterrupt(digitalPinToInterrupt(alertGpio));
+        alertAttached = false;
+    }
+    alertMode = false;
+    Serial.printf("[ADS1115] No ALERT/RDY on GPIO %d for %d reads, falling back to polling\n", alertGpio, MAX_MISSED_ALERTS);
+}
+
+void IRAM_ATTR ADS1115Manager::onAlert(void* arg) {
+    ADS1115Manager* self = (ADS1115Manager*)arg;
+    if (self->watch.armed) {
+        if (!self->watch.paused) {
+            self->watch.tripped = true;
+            self->readStats.watchTrips++;
+        }
+        return;
+    }
+    if (!self->alertReady) return;
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(self->alertReady, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
 uint16_t ADS1115Manager::readRaw(uint8_t channel, Gain gain, uint16_t timeoutMs) {
-    if (i2cMutex) xSemaphoreTake(i2cMutex, portMAX_DELAY);
     // Config register bits
     uint16_t config = 0x8000; // Start single conversion
     // Set MUX for single-ended mode: 0x04,0x05,0x06,0x07 for A0-A3
     config |= (0x04 + (channel & 0x03)) << 12;
     config |= (gain & 0x07) << 9;     // PGA bits
     config |= 0x0100; // Single-shot mode
-    config |= 0x0083; // 128SPS, disable comparator
+    config |= 0x0080; // 128SPS
+
+    // Held for the whole conversion: in ALERT/RDY mode the bus is released
+    // while it runs, and nothing else may restart the chip meanwhile
+    if (conversionMutex) xSemaphoreTake(conversionMutex, portMAX_DELAY);
+    pauseWatch();
+    uint16_t raw = alertMode && !watch.armed ? readOnAlert(config, timeoutMs) // Comparator queue 00: ALERT/RDY after one conversion
+                                             : readPolled(config | 0x0003, timeoutMs); // Comparator disabled
+    // Under the mutex: the fallback reads watch.armed and detaches the pin
+    if (alertMode && consecutiveMisses >= MAX_MISSED_ALERTS) disableAlert();
+    resumeWatch();
+    if (conversionMutex) xSemaphoreGive(conversionMutex);
+    return raw;
+}
+
+uint16_t ADS1115Manager::readPolled(uint16_t config, uint16_t timeoutMs) {
+    I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.readRaw");
+    if (!writeRegister(access, 0x01, config)) access.fail();
+    if (!waitForConversion(access, timeoutMs)) access.fail();
+    readStats.polledReads++;
+    return readConversion(access);
+}
+
+uint16_t ADS1115Manager::readOnAlert(uint16_t config, uint16_t timeoutMs) {
+    xSemaphoreTake(alertReady, 0); // Drop an edge left over from a missed read
+    {
+        I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.start");
+        if (!writeRegister(access, 0x01, config)) access.fail();
+    }
+    bool signalled = xSemaphoreTake(alertReady, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+    I2CTracer::Access access(i2cTracer, i2cMutex, address, signalled ? "ads.result" : "ads.readRaw");
+    if (signalled) {
+        readStats.alertReads++;
+        consecutiveMisses = 0;
+    } else {
+        // The OS bit still tells whether the result is there
+        readStats.missedAlerts++;
+        consecutiveMisses++;
+        if (!waitForConversion(access, timeoutMs)) access.fail();
+    }
+    return readConversion(access);
+}
+
+void ADS1115Manager::setRegisterCache(bool enabled) {
+    registerCache = enabled;
+    forgetRegisters();
+}
+
+void ADS1115Manager::forgetRegisters() {
+    pointerShadow = -1;
+    for (int i = 0; i < 4; ++i) registerShadow[i] = -1;
+}
 
-    // Write config
+bool ADS1115Manager::writeRegister(I2CTracer::Access& access, uint8_t reg, uint16_t value) {
+    reg &= 0x03;
+    // OS set in single-shot mode starts a conversion, so that write always goes out
+    bool startsConversion = reg == 0x01 && (value & 0x8000);
+    int32_t shadow = reg == 0x01 ? (value & 0x7FFF) : value;
+    if (registerCache && !startsConversion && registerShadow[reg] == shadow) {
+        readStats.elidedWrites++;
+        return true;
+    }
     Wire.beginTransmission(address);
-    Wire.write(0x01); // Config register
-    Wire.write((config >> 8) & 0xFF);
-    Wire.write(config & 0xFF);
-    Wire.endTransmission();
+    Wire.write(reg);
+    Wire.write((value >> 8) & 0xFF);
+    Wire.write(value & 0xFF);
+    access.addTransaction(3, 0);
+    bool ok = Wire.endTransmission() == 0;
+    if (!ok) {
+        forgetRegisters();
+        return false;
+    }
+    pointerShadow = reg;
+    registerShadow[reg] = shadow;
+    return true;
+}
 
-    // Wait for conversion
+bool ADS1115Manager::selectRegister(I2CTracer::Access& access, uint8_t reg) {
+    if (registerCache && pointerShadow == reg) return true;
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    access.addTransaction(1, 0);
+    // Repeated START: the read that follows needs no second arbitration
+    bool ok = Wire.endTransmission(!registerCache) == 0;
+    pointerShadow = ok ? reg : -1;
+    return ok;
+}
+
+bool ADS1115Manager::readRegister(I2CTracer::Access& access, uint8_t reg, uint16_t& value) {
+    if (!selectRegister(access, reg)) return false;
+    uint8_t received = Wire.requestFrom(address, (uint8_t)2);
+    access.addTransaction(0, received);
+    if (received != 2) {
+        forgetRegisters();
+        return false;
+    }
+    value = ((uint16_t)Wire.read() << 8) | Wire.read();
+    return true;
+}
+
+// Polls the OS bit of the config register. After the config write the
+// pointer is already there, so each poll is a bare read.
+bool ADS1115Manager::waitForConversion(I2CTracer::Access& access, uint16_t timeoutMs) {
     uint32_t start = millis();
     while (millis() - start < timeoutMs) {
-        Wire.beginTransmission(address);
-        Wire.write(0x01);
-        Wire.endTransmission();
-        Wire.requestFrom(address, (uint8_t)2);
-        uint8_t hi = Wire.read();
-        uint8_t lo = Wire.read();
-        if (hi & 0x80) break; // Conversion ready
-    }
-    // Read conversion result
-    Wire.beginTransmission(address);
-    Wire.write(0x00); // Conversion register
-    Wire.endTransmission();
-    Wire.requestFrom(address, (uint8_t)2);
-    uint16_t raw = ((uint16_t)Wire.read() << 8) | Wire.read();
-    if (i2cMutex) xSemaphoreGive(i2cMutex);
+        uint16_t config = 0;
+        if (readRegister(access, 0x01, config) && (config & 0x8000)) return true; // Conversion ready
+    }
+    readStats.timeouts++;
+    return false;
+}
+
+uint16_t ADS1115Manager::readConversion(I2CTracer::Access& access) {
+    uint16_t raw = 0;
+    if (!readRegister(access, 0x00, raw)) access.fail();
     return raw;
 }
 
-float ADS1115Manager::readVoltage(uint8_t channel, Gain gain, uint16_t timeoutMs) {
-    uint16_t raw = readRaw(channel, gain, timeoutMs);
+// Sleeps through most of the wait and spins the last tick
+static void waitUntilMicros(unsigned long dueUs) {
+    long remaining = (long)(dueUs - micros());
+    if (remaining > 2000) vTaskDelay(pdMS_TO_TICKS(remaining / 1000 - 1));
+    remaining = (long)(dueUs - micros());
+    if (remaining > 0) delayMicroseconds((uint32_t)remaining);
+}
+
+size_t ADS1115Manager::readBurst(uint8_t channel, Gain gain, DataRate rate, int16_t* samples, size_t count, uint16_t timeoutMs) {
+    BurstJob job = { this, channel, gain, rate, samples, count, 0 };
+    readBurstGroup(&job, 1, timeoutMs);
+    return job.taken;
+}
+
+void ADS1115Manager::readBurstGroup(BurstJob* jobs, size_t jobCount, uint16_t timeoutMs) {
+    // Start every chip before reading any, so they convert side by side
+    bool started[MAX_GROUP_JOBS] = {};
+    if (jobCount > MAX_GROUP_JOBS) jobCount = MAX_GROUP_JOBS;
+    for (size_t i = 0; i < jobCount; ++i) {
+        jobs[i].taken = 0;
+        if (jobs[i].ads && jobs[i].samples && jobs[i].count > 0) {
+            started[i] = jobs[i].ads->burstBegin(jobs[i].channel, jobs[i].gain, jobs[i].rate);
+        }
+    }
+    // Round-robin: while one chip is waited for, the others keep converting
+    bool pending = true;
+    while (pending) {
+        pending = false;
+        for (size_t i = 0; i < jobCount; ++i) {
+            BurstJob& job = jobs[i];
+            if (!started[i] || job.taken >= job.count) continue;
+            if (job.ads->burstNext(job.samples[job.taken], timeoutMs)) {
+                job.taken++;
+                pending |= job.taken < job.count;
+            } else {
+                // Bus error: stop this chip, keep the others going
+                job.ads->burstEnd(job.taken);
+                started[i] = false;
+            }
+        }
+    }
+    for (size_t i = 0; i < jobCount; ++i) {
+        if (started[i]) jobs[i].ads->burstEnd(jobs[i].taken);
+    }
+}
+
+bool ADS1115Manager::burstBegin(uint8_t channel, Gain gain, DataRate rate) {
+    uint16_t config = 0; // MODE clear: continuous conversion
+    config |= (0x04 + (channel & 0x03)) << 12;
+    config |= (gain & 0x07) << 9;
+    config |= (rate & 0x07) << 5;
+
+    if (conversionMutex) xSemaphoreTake(conversionMutex, portMAX_DELAY);
+    pauseWatch();
+    // In conversion-ready mode ALERT/RDY pulses once per conversion
+    uint16_t comparator = alertMode && !watch.armed ? 0x0000 : 0x0003;
+    burst.config = config;
+    burst.paceUs = conversionPeriodUs(rate) * PACE_MARGIN_PERCENT / 100;
+    burst.onAlert = alertMode && !watch.armed;
+    burst.taken = 0;
+    if (burst.onAlert) xSemaphoreTake(alertReady, 0);
+    bool ok;
+    {
+        I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.burstStart");
+        ok = writeRegister(access, 0x01, config | comparator);
+        if (!ok) access.fail();
+    }
+    if (!ok) {
+        burstEnd(0);
+        return false;
+    }
+    burst.due = micros() + burst.paceUs;
+    return true;
+}
+
+bool ADS1115Manager::burstNext(int16_t& code, uint16_t timeoutMs) {
+    if (burst.onAlert) {
+        if (xSemaphoreTake(alertReady, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+            // Pace the rest of the burst by time instead
+            readStats.missedAlerts++;
+            consecutiveMisses++;
+            burst.onAlert = false;
+            burst.due = micros();
+        } else {
+            consecutiveMisses = 0;
+        }
+    }
+    if (!burst.onAlert) waitUntilMicros(burst.due);
+    burst.due += burst.paceUs;
+    I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.burstSample");
+    // The pointer stays on the conversion register after the first sample
+    uint16_t raw = 0;
+    if (!readRegister(access, 0x00, raw)) {
+        access.fail();
+        return false;
+    }
+    code = (int16_t)raw;
+    burst.taken++;
+    return true;
+}
+
+void ADS1115Manager::burstEnd(size_t taken) {
+    {
+        // Back to single-shot so the chip powers down between reads
+        I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.burstStop");
+        if (!writeRegister(access, 0x01, burst.config | 0x0100 | 0x0003)) access.fail();
+    }
+    readStats.bursts++;
+    readStats.burstSamples += taken;
+    if (alertMode && consecutiveMisses >= MAX_MISSED_ALERTS) disableAlert();
+    resumeWatch();
+    if (conversionMutex) xSemaphoreGive(conversionMutex);
+}
+
+bool ADS1115Manager::writeThresholds(int16_t lo, int16_t hi) {
+    I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.thresholds");
+    bool ok = writeRegister(access, 0x02, (uint16_t)lo) && writeRegister(access, 0x03, (uint16_t)hi);
+    if (!ok) access.fail();
+    return ok;
+}
+
+bool ADS1115Manager::startWatch(uint8_t channel, Gain gain, int16_t loThresh, int16_t hiThresh, ComparatorMode mode, DataRate rate) {
+    if (!connected || alertGpio < 0) return false;
+    uint16_t config = 0; // MODE clear: continuous conversion
+    config |= (0x04 + (channel & 0x03)) << 12;
+    config |= (gain & 0x07) << 9;
+    config |= (rate & 0x07) << 5;
+    if (mode == COMPARATOR_WINDOW) config |= 0x0010;
+    config |= 0x0004; // COMP_LAT: stay asserted until stopWatch()
+    config |= 0x0002; // COMP_QUE: four conversions out of bounds
+
+    if (conversionMutex) xSemaphoreTake(conversionMutex, portMAX_DELAY);
+    bool ok = writeThresholds(loThresh, hiThresh);
+    if (ok) {
+        watch.config = config;
+        watch.idleTimeoutMs = (uint16_t)(conversionPeriodUs(rate) * PACE_MARGIN_PERCENT / 100 / 1000 + 2);
+        watch.lo = loThresh;
+        watch.hi = hiThresh;
+        watch.tripped = false;
+        watch.paused = true;
+        watch.armed = true;
+        attachAlert();
+        resumeWatch();
+    }
+    if (conversionMutex) xSemaphoreGive(conversionMutex);
+    if (!ok) {
+        Serial.printf("[ADS1115] Could not set comparator thresholds at 0x%02X\n", address);
+        return false;
+    }
+    return true;
+}
+
+void ADS1115Manager::stopWatch(int16_t* lastCode) {
+    if (!watch.armed) return;
+    if (conversionMutex) xSemaphoreTake(conversionMutex, portMAX_DELAY);
+    pauseWatch();
+    if (lastCode) {
+        I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.watchStop");
+        *lastCode = (int16_t)readConversion(access);
+    }
+    watch.armed = false;
+    watch.paused = false;
+    // Give the thresholds back: conversion-ready mode, or the power-on values
+    bool restored = alertMode ? writeThresholds(0x0000, (int16_t)0x8000) : writeThresholds((int16_t)0x8000, 0x7FFF);
+    if (!restored && alertMode) alertMode = false;
+    if (!alertMode && alertAttached) {
+        detachInterrupt(digitalPinToInterrupt(alertGpio));
+        alertAttached = false;
+    }
+    if (conversionMutex) xSemaphoreGive(conversionMutex);
+}
+
+void ADS1115Manager::pauseWatch() {
+    if (!watch.armed) return;
+    watch.paused = true;
+    I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.watchPause");
+    // Single-shot with the comparator off powers down and releases ALERT/RDY
+    // once the conversion in flight is done; a read started before then
+    // would be ignored
+    if (!writeRegister(access, 0x01, (watch.config & 0xFFE0) | 0x0100 | 0x0003) ||
+        !waitForConversion(access, watch.idleTimeoutMs)) {
+        access.fail();
+    }
+}
+
+void ADS1115Manager::resumeWatch() {
+    if (!watch.armed) return;
+    {
+        // Restarts continuous conversion on the watched input, comparator armed
+        I2CTracer::Access access(i2cTracer, i2cMutex, address, "ads.watchArm");
+        if (!writeRegister(access, 0x01, watch.config)) access.fail();
+    }
+    watch.paused = false;
+}
+
+uint32_t ADS1115Manager::conversionPeriodUs(DataRate rate) {
+    static const uint16_t SPS[8] = { 8, 16, 32, 64, 128, 250, 475, 860 };
+    return 1000000UL / SPS[rate & 0x07];
+}
+
+float ADS1115Manager::fullScaleVolts(Gain gain) {
+    return codeToVolts(32767, gain) + codeToVolts(1, gain);
+}
+
+float ADS1115Manager::rescaleCode(float code, Gain from, Gain to) {
+    return code * (fullScaleVolts(from) / fullScaleVolts(to));
+}
+
+ADS1115Manager::Gain ADS1115Manager::getAutoGain(uint8_t channel, uint16_t timeoutMs) {
+    channel &= 0x03;
+    if (autoGain[channel] < 0) {
+        // Widest range first; the result says how far in we can go
+        int16_t code = (int16_t)readRaw(channel, GAIN_TWOTHIRDS, timeoutMs);
+        readStats.rangeFinds++;
+        autoGain[channel] = GAIN_TWOTHIRDS;
+        updateAutoGain(channel, GAIN_TWOTHIRDS, &code, 1);
+    }
+    return (Gain)autoGain[channel];
+}
+
+bool ADS1115Manager::updateAutoGain(uint8_t channel, Gain gain, const int16_t* codes, size_t count) {
+    channel &= 0x03;
+    if (!codes || count == 0) return true;
+    int32_t peak = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t magnitude = codes[i] < 0 ? -(int32_t)codes[i] : codes[i];
+        if (magnitude > peak) peak = magnitude;
+    }
+    int8_t previous = autoGain[channel];
+    bool clipped = peak >= CLIP_CODE;
+    if (clipped) {
+        // Off the scale: no telling how far, so range-find again next time
+        autoGain[channel] = gain == GAIN_TWOTHIRDS ? (int8_t)GAIN_TWOTHIRDS : (int8_t)-1;
+        if (autoGain[channel] != previous) readStats.gainChanges++;
+        return gain == GAIN_TWOTHIRDS;
+    }
+    float peakVolts = codeToVolts((int16_t)peak, gain);
+    int next = gain;
+    if (peakVolts > fullScaleVolts(gain) * AUTO_RANGE_LOOSEN_PERCENT / 100) {
+        while (next > GAIN_TWOTHIRDS && peakVolts > fullScaleVolts((Gain)next) * AUTO_RANGE_HEADROOM_PERCENT / 100) next--;
+    } else {
+        while (next < GAIN_SIXTEEN && peakVolts <= fullScaleVolts((Gain)(next + 1)) * AUTO_RANGE_HEADROOM_PERCENT / 100) next++;
+    }
+    autoGain[channel] = (int8_t)next;
+    if (previous >= 0 && next != previous) readStats.gainChanges++;
+    return true;
+}
+
+uint16_t ADS1115Manager::readRawAuto(uint8_t channel, Gain& gain, uint16_t timeoutMs) {
+    gain = getAutoGain(channel, timeoutMs);
+    int16_t code = (int16_t)readRaw(channel, gain, timeoutMs);
+    if (!updateAutoGain(channel, gain, &code, 1)) {
+        gain = getAutoGain(channel, timeoutMs);
+        code = (int16_t)readRaw(channel, gain, timeoutMs);
+        updateAutoGain(channel, gain, &code, 1);
+    }
+    return (uint16_t)code;
+}
+
+size_t ADS1115Manager::readBurstAuto(uint8_t channel, DataRate rate, int16_t* samples, size_t count, Gain& gain, uint16_t timeoutMs) {
+    gain = getAutoGain(channel, timeoutMs);
+    size_t taken = readBurst(channel, gain, rate, samples, count, timeoutMs);
+    if (!updateAutoGain(channel, gain, samples, taken)) {
+        gain = getAutoGain(channel, timeoutMs);
+        taken = readBurst(channel, gain, rate, samples, count, timeoutMs);
+        updateAutoGain(channel, gain, samples, taken);
+    }
+    return taken;
+}
+
+float ADS1115Manager::codeToVolts(int16_t code, Gain gain) {
     float multiplier = 0.1875f / 1000.0f; // Default for GAIN_TWOTHIRDS
     switch (gain) {
         case GAIN_TWOTHIRDS: multiplier = 0.1875f / 1000.0f; break;
@@ -75,6 +494,10 @@ float ADS1115Manager::readVoltage(uint8_t channel, Gain gain, uint16_t timeoutMs
         case GAIN_EIGHT:     multiplier = 0.015625f / 1000.0f; break;
         case GAIN_SIXTEEN:   multiplier = 0.0078125f / 1000.0f; break;
     }
-    int16_t value = (int16_t)raw;
-    return value * multiplier;
+    return code * multiplier;
+}
+
+float ADS1115Manager::readVoltage(uint8_t channel, Gain gain, uint16_t timeoutMs) {
+    uint16_t raw = readRaw(channel, gain, timeoutMs);
+    return codeToVolts((int16_t)raw, gain);
 }
@@ -0,0 +1,374 @@
+#include "system/ADS1115Sampler.h"
+#include "devices/SoilMoistureSensor.h"
+
+// Below WiFi and the async TCP/web tasks, level with loop(), on the core
+// loop() does not run on: time-paced bursts spin between samples
+static const UBaseType_t TASK_PRIORITY = 1;
+static const BaseType_t TASK_CORE = 0;
+static const uint32_t TASK_STACK = 3072;
+
+bool ADS1115Sampler::begin(ADS1115Manager* adsMgr, ADS1115Manager::DataRate dataRate) {
+    devices[0] = adsMgr;
+    rate = dataRate;
+    if (task) return true;
+    bool anyConnected = false;
+    for (int i = 0; i < MAX_DEVICES; ++i) anyConnected |= hasDevice(i);
+    if (!anyConnected) {
+        Serial.println("[ADS1115Sampler] ADS1115 not connected, sensors will read it directly");
+        return false;
+    }
+    if (!workReady) workReady = xSemaphoreCreateBinary();
+    if (!valueMutex) valueMutex = xSemaphoreCreateMutex();
+    if (!workReady || xTaskCreatePinnedToCore(taskEntry, "ads1115Sampler", TASK_STACK, this, TASK_PRIORITY, &task, TASK_CORE) != pdPASS) {
+        task = nullptr;
+        Serial.println("[ADS1115Sampler] Failed to start sampling task, sensors will read the ADS1115 directly");
+        return false;
+    }
+    Serial.printf("[ADS1115Sampler] Sampling task started, %lu us per conversion\n",
+        (unsigned long)ADS1115Manager::conversionPeriodUs(rate));
+    return true;
+}
+
+void ADS1115Sampler::addDevice(int device, ADS1115Manager* adsMgr) {
+    if (device > 0 && device < MAX_DEVICES && !task) devices[device] = adsMgr;
+}
+
+bool ADS1115Sampler::hasDevice(int device) const {
+    return device >= 0 && device < MAX_DEVICES && devices[device] && devices[device]->isConnected();
+}
+
+int ADS1115Sampler::addChannel(uint8_t channel, ADS1115Manager::Gain gain, int device, bool autoGain) {
+    int id = channelCount.load();
+    if (id >= MAX_CHANNELS || device < 0 || device >= MAX_DEVICES || !devices[device]) return -1;
+    channels[id].device = (uint8_t)device;
+    channels[id].channel = channel;
+    channels[id].gain = gain;
+    channels[id].autoGain = autoGain;
+    channels[id].windowGain.store(gain);
+    // Publish the slot only once it is filled in
+    channelCount.store(id + 1);
+    return id;
+}
+
+bool ADS1115Sampler::request(int id, size_t count) {
+    if (!task || id < 0 || id >= channelCount.load() || count == 0) return false;
+    Channel& c = channels[id];
+    if (count > RING_SAMPLES) count = RING_SAMPLES;
+    uint32_t generation = ((c.work.load() >> 16) + 1) & 0xFFFF;
+    c.ring.clear();
+    // A chunk the task is still reading for the old request is pushed with
+    // the old generation and dropped by available()/readWindow()
+    c.work.store(generation << 16 | (uint32_t)count);
+    requests++;
+    xSemaphoreGive(workReady);
+    return true;
+}
+
+void ADS1115Sampler::dropStale(Channel& c) {
+    // Old samples can only sit in front of the current ones: the task
+    // finishes a chunk before it starts one for the new request
+    uint16_t generation = (uint16_t)(c.work.load() >> 16);
+    Sample s;
+    bool dropped = false;
+    while (c.ring.peek(s) && s.generation != generation) {
+        c.ring.pop(s);
+        dropped = true;
+    }
+    // The task may be waiting for the room
+    if (dropped) xSemaphoreGive(workReady);
+}
+
+size_t ADS1115Sampler::available(int id) {
+    if (id < 0 || id >= channelCount.load()) return 0;
+    dropStale(channels[id]);
+    return channels[id].ring.size();
+}
+
+size_t ADS1115Sampler::readWindow(int id, int16_t* out, size_t max) {
+    if (!out || id < 0 || id >= channelCount.load()) return 0;
+    Channel& c = channels[id];
+    dropStale(c);
+    size_t n = 0;
+    Sample s;
+    while (n < max && c.ring.pop(s)) out[n++] = s.code;
+    return n;
+}
+
+ADS1115Manager::Gain ADS1115Sampler::getWindowGain(int id) const {
+    if (id < 0 || id >= channelCount.load()) return ADS1115Manager::GAIN_TWOTHIRDS;
+    return (ADS1115Manager::Gain)channels[id].windowGain.load();
+}
+
+ADS1115Sampler::Stats ADS1115Sampler::getStats() const {
+    Stats stats;
+    stats.requests = requests.load();
+    stats.samples = samples.load();
+    stats.bursts = bursts.load();
+    stats.failures = failures.load();
+    return stats;
+}
+
+void ADS1115Sampler::taskEntry(void* arg) {
+    static_cast<ADS1115Sampler*>(arg)->run();
+}
+
+void ADS1115Sampler::run() {
+    for (;;) {
+        bool busy = false;
+        int count = channelCount.load();
+        for (int i = 0; i < count; ++i) {
+            if (service(channels[i])) busy = true;
+        }
+        // Sensor windows first; one scan pass keeps them waiting at most one burst
+        if (!busy) busy = serviceScans();
+        if (!busy) xSemaphoreTake(workReady, portMAX_DELAY);
+    }
+}
+
+bool ADS1115Sampler::service(Channel& c) {
+    uint32_t work = c.work.load();
+    uint32_t wanted = work & 0xFFFF;
+    if (wanted == 0) return false;
+    uint16_t generation = (uint16_t)(work >> 16);
+    size_t n = wanted < CHUNK_SAMPLES ? wanted : CHUNK_SAMPLES;
+    size_t room = c.ring.freeSpace();
+    if (n > room) n = room;
+    // request() empties the ring, so only samples of a replaced request
+    // can fill it; wait for dropStale() to make room
+    if (n == 0) return false;
+    ADS1115Manager* ads = devices[c.device];
+    if (generation != c.servedGeneration) {
+        // One gain per window, so the consumer can convert it as a whole
+        c.servedGeneration = generation;
+        c.windowGain.store(c.autoGain ? ads->getAutoGain(c.channel) : c.gain);
+    }
+    ADS1115Manager::Gain gain = (ADS1115Manager::Gain)c.windowGain.load();
+    int16_t chunk[CHUNK_SAMPLES];
+    size_t got = ads->readBurst(c.channel, gain, rate, chunk, n);
+    // Aims the next window; this one keeps its gain
+    if (c.autoGain) ads->updateAutoGain(c.channel, gain, chunk, got);
+    bursts++;
+    for (size_t i = 0; i < got; ++i) {
+        if (c.ring.push(Sample{ chunk[i], generation })) samples++;
+    }
+    // A request() made meanwhile has already set a new generation; leave it
+    uint32_t remaining = got < n ? 0 : wanted - (uint32_t)got;
+    if (got < n) failures++;
+    c.work.compare_exchange_strong(work, (work & 0xFFFF0000) | remaining);
+    return true;
+}
+
+static bool parseRate(int sps, ADS1115Manager::DataRate& rate) {
+    static const int SPS[8] = { 8, 16, 32, 64, 128, 250, 475, 860 };
+    for (int i = 0; i < 8; ++i) {
+        if (SPS[i] == sps) {
+            rate = (ADS1115Manager::DataRate)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+int ADS1115Sampler::configureScans(cJSON* list) {
+    if (!cJSON_IsArray(list)) return 0;
+    int added = 0;
+    int index = 0;
+    cJSON* entry = nullptr;
+    cJSON_ArrayForEach(entry, list) {
+        ScanConfig scan = {};
+        cJSON* name = cJSON_GetObjectItem(entry, "name");
+        cJSON* device = cJSON_GetObjectItem(entry, "device");
+        cJSON* channel = cJSON_GetObjectItem(entry, "channel");
+        cJSON* gain = cJSON_GetObjectItem(entry, "gain");
+        cJSON* autoGain = cJSON_GetObjectItem(entry, "auto_gain");
+        cJSON* sps = cJSON_GetObjectItem(entry, "rate");
+        cJSON* count = cJSON_GetObjectItem(entry, "samples");
+        cJSON* filter = cJSON_GetObjectItem(entry, "filter");
+        cJSON* interval = cJSON_GetObjectItem(entry, "interval_ms");
+        cJSON* wet = cJSON_GetObjectItem(entry, "wet");
+        cJSON* dry = cJSON_GetObjectItem(entry, "dry");
+        int ch = cJSON_IsNumber(channel) ? channel->valueint : -1;
+        if (ch < 0 || ch > 3) {
+            Serial.printf("[ADS1115Sampler] ads1115_scan[%d]: channel must be 0-3, skipped\n", index++);
+            continue;
+        }
+        int dev = cJSON_IsNumber(device) ? device->valueint : 0;
+        if (!hasDevice(dev)) {
+            Serial.printf("[ADS1115Sampler] ads1115_scan[%d]: no ADS1115 at device %d, skipped\n", index++, dev);
+            continue;
+        }
+        snprintf(scan.name, sizeof(scan.name), "%s", cJSON_IsString(name) ? name->valuestring : "");
+        if (!scan.name[0]) snprintf(scan.name, sizeof(scan.name), "d%da%d", dev, ch);
+        scan.device = (uint8_t)dev;
+        scan.channel = (uint8_t)ch;
+        int g = cJSON_IsNumber(gain) ? gain->valueint : ADS1115Manager::GAIN_TWOTHIRDS;
+        scan.gain = (ADS1115Manager::Gain)(g >= ADS1115Manager::GAIN_TWOTHIRDS && g <= ADS1115Manager::GAIN_SIXTEEN ? g : ADS1115Manager::GAIN_TWOTHIRDS);
+        scan.autoGain = !cJSON_IsBool(autoGain) || cJSON_IsTrue(autoGain);
+        scan.rate = ADS1115Manager::SPS_860;
+        if (cJSON_IsNumber(sps) && !parseRate(sps->valueint, scan.rate)) {
+            Serial.printf("[ADS1115Sampler] ads1115_scan[%d]: rate %d is not an ADS1115 data rate, using 860\n", index, sps->valueint);
+        }
+        int n = cJSON_IsNumber(count) ? count->valueint : 8;
+        scan.samples = (uint8_t)(n < 1 ? 1 : (n > (int)MAX_SCAN_SAMPLES ? MAX_SCAN_SAMPLES : n));
+        scan.filter = FILTER_TRIMMED_MEAN;
+        if (cJSON_IsString(filter)) {
+            if (!strcmp(filter->valuestring, "mean")) scan.filter = FILTER_MEAN;
+            else if (!strcmp(filter->valuestring, "median")) scan.filter = FILTER_MEDIAN;
+        }
+        int ms = cJSON_IsNumber(interval) ? interval->valueint : 5000;
+        scan.intervalMs = (uint32_t)(ms < 100 ? 100 : ms);
+        scan.calibrated = cJSON_IsNumber(wet) && cJSON_IsNumber(dry);
+        scan.wet = scan.calibrated ? wet->valueint : 0;
+        scan.dry = scan.calibrated ? dry->valueint : 0;
+        if (addScan(scan) < 0) {
+            Serial.printf("[ADS1115Sampler] ads1115_scan[%d]: more than %d scans, skipped\n", index, MAX_SCANS);
+        } else {
+            Serial.printf("[ADS1115Sampler] Scanning %s on 0x%02X A%d every %lu ms\n", scan.name, 0x48 + dev, ch, (unsigned long)scan.intervalMs);
+            added++;
+        }
+        index++;
+    }
+    return added;
+}
+
+int ADS1115Sampler::addScan(const ScanConfig& scan) {
+    int id = scanCount.load();
+    if (id >= MAX_SCANS) return -1;
+    scans[id].config = scan;
+    scans[id].value = ScanValue();
+    // Due on the first update()
+    scans[id].lastQueuedMs = millis() - scan.intervalMs;
+    scanCount.store(id + 1);
+    return id;
+}
+
+void ADS1115Sampler::update() {
+    if (!task) return;
+    unsigned long now = millis();
+    bool queued = false;
+    int count = scanCount.load();
+    for (int i = 0; i < count; ++i) {
+        Scan& s = scans[i];
+        if (s.pending.load() || now - s.lastQueuedMs < s.config.intervalMs) continue;
+        s.lastQueuedMs = now;
+        s.pending.store(true);
+        queued = true;
+    }
+    if (queued) xSemaphoreGive(workReady);
+}
+
+bool ADS1115Sampler::serviceScans() {
+    // First pending scan of each chip
+    Scan* batch[MAX_DEVICES] = {};
+    int count = scanCount.load();
+    for (int i = 0; i < count; ++i) {
+        Scan& s = scans[i];
+        if (s.pending.load() && !batch[s.config.device]) batch[s.config.device] = &s;
+    }
+    ADS1115Manager::BurstJob jobs[MAX_DEVICES];
+    int16_t codes[MAX_DEVICES][MAX_SCAN_SAMPLES];
+    Scan* jobScans[MAX_DEVICES];
+    size_t jobCount = 0;
+    for (int d = 0; d < MAX_DEVICES; ++d) {
+        if (!batch[d]) continue;
+        const ScanConfig& cfg = batch[d]->config;
+        ADS1115Manager::Gain gain = cfg.autoGain ? devices[d]->getAutoGain(cfg.channel) : cfg.gain;
+        jobs[jobCount] = { devices[d], cfg.channel, gain, cfg.rate, codes[jobCount], cfg.samples, 0 };
+        jobScans[jobCount++] = batch[d];
+    }
+    if (jobCount == 0) return false;
+    ADS1115Manager::readBurstGroup(jobs, jobCount);
+    bursts += (uint32_t)jobCount;
+    bool clipped[MAX_DEVICES] = {};
+    for (size_t j = 0; j < jobCount; ++j) {
+        const ScanConfig& cfg = jobScans[j]->config;
+        if (cfg.autoGain) clipped[j] = !jobs[j].ads->updateAutoGain(cfg.channel, jobs[j].gain, codes[j], jobs[j].taken);
+    }
+
+    xSemaphoreTake(valueMutex, portMAX_DELAY);
+    for (size_t j = 0; j < jobCount; ++j) {
+        const ScanConfig& cfg = jobScans[j]->config;
+        ScanValue& value = jobScans[j]->value;
+        if (clipped[j]) continue; // Stays pending, read again at the wider range
+        if (jobs[j].taken == cfg.samples) {
+            float code = filterCodes(codes[j], jobs[j].taken, cfg.filter);
+            float scaled = ADS1115Manager::rescaleCode(code, jobs[j].gain, cfg.gain);
+            long r = lroundf(scaled);
+            int16_t rounded = (int16_t)(r > 32767 ? 32767 : (r < -32768 ? -32768 : r));
+            value.code = scaled;
+            value.readGain = jobs[j].gain;
+            value.volts = code * ADS1115Manager::codeToVolts(1, jobs[j].gain);
+            value.percent = cfg.calibrated ? SoilMoistureSensor::rawToPercent(rounded, cfg.wet, cfg.dry) : 0.0f;
+            value.updatedMs = millis();
+            value.valid = true;
+            value.scans++;
+        } else {
+            value.failures++;
+            failures++;
+        }
+    }
+    xSemaphoreGive(valueMutex);
+    for (size_t j = 0; j < jobCount; ++j) {
+        if (!clipped[j]) jobScans[j]->pending.store(false);
+    }
+    return true;
+}
+
+bool ADS1115Sampler::getScanValue(int id, ScanValue& value) const {
+    if (id < 0 || id >= scanCount.load() || !valueMutex) return false;
+    xSemaphoreTake(valueMutex, portMAX_DELAY);
+    value = scans[id].value;
+    xSemaphoreGive(valueMutex);
+    return value.valid;
+}
+
+cJSON* ADS1115Sampler::getScanJson() const {
+    cJSON* list = cJSON_CreateArray();
+    int count = scanCount.load();
+    for (int i = 0; i < count; ++i) {
+        const ScanConfig& cfg = scans[i].config;
+        ScanValue value = {};
+        getScanValue(i, value);
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "name", cfg.name);
+        cJSON_AddNumberToObject(item, "device", cfg.device);
+        cJSON_AddNumberToObject(item, "channel", cfg.channel);
+        cJSON_AddBoolToObject(item, "valid", value.valid);
+        cJSON_AddNumberToObject(item, "raw", value.code);
+        cJSON_AddNumberToObject(item, "voltage", value.volts);
+        if (cfg.autoGain && value.valid) cJSON_AddNumberToObject(item, "read_gain", value.readGain);
+        if (cfg.calibrated) cJSON_AddNumberToObject(item, "percent", value.percent);
+        cJSON_AddNumberToObject(item, "age_ms", value.valid ? millis() - value.updatedMs : 0);
+        cJSON_AddNumberToObject(item, "scans", value.scans);
+        if (value.failures) cJSON_AddNumberToObject(item, "failures", value.failures);
+        cJSON_AddItemToArray(list, item);
+    }
+    return list;
+}
+
+float ADS1115Sampler::filterCodes(const int16_t* codes, size_t count, Filter filter) {
+    if (count == 0) return 0;
+    if (filter == FILTER_MEDIAN) {
+        int16_t sorted[MAX_SCAN_SAMPLES];
+        size_t n = count < MAX_SCAN_SAMPLES ? count : MAX_SCAN_SAMPLES;
+        for (size_t i = 0; i < n; ++i) {
+            int16_t v = codes[i];
+            size_t j = i;
+            while (j > 0 && sorted[j - 1] > v) {
+                sorted[j] = sorted[j - 1];
+                --j;
+            }
+            sorted[j] = v;
+        }
+        return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0f;
+    }
+    int32_t sum = 0;
+    int16_t lo = codes[0], hi = codes[0];
+    for (size_t i = 0; i < count; ++i) {
+        sum += codes[i];
+        if (codes[i] < lo) lo = codes[i];
+        if (codes[i] > hi) hi = codes[i];
+    }
+    if (filter == FILTER_TRIMMED_MEAN && count > 2) return (float)(sum - lo - hi) / (count - 2);
+    return (float)sum / count;
+}
@@ -0,0 +1,114 @@
+#include "system/BootTimeline.h"
+
+// Set by start(); Scopes and milestones before that, or after finish(), see null
+static BootTimeline* activeTimeline = nullptr;
+
+void BootTimeline::start() {
+    activeTimeline = this;
+    setupStartUs = micros();
+}
+
+int BootTimeline::open(const char* name, bool milestone) {
+    if (complete) return -1;
+    if (phaseCount >= MAX_PHASES) {
+        droppedPhases++;
+        return -1;
+    }
+    Phase& p = phases[phaseCount];
+    p.name = name;
+    p.startUs = micros();
+    p.durationUs = 0;
+    p.depth = (uint8_t)depth;
+    p.milestone = milestone;
+    p.open = !milestone;
+    if (!milestone) depth++;
+    return phaseCount++;
+}
+
+void BootTimeline::close(int index) {
+    if (index < 0 || !phases[index].open) return;
+    phases[index].durationUs = micros() - phases[index].startUs;
+    phases[index].open = false;
+    if (depth > 0) depth--;
+}
+
+BootTimeline::Scope::Scope(const char* name) : timeline(activeTimeline), index(-1) {
+    if (timeline) index = timeline->open(name, false);
+}
+
+BootTimeline::Scope::~Scope() {
+    if (timeline) timeline->close(index);
+}
+
+void BootTimeline::enterState(const char* name) {
+    if (complete) return;
+    close(stateIndex);
+    stateIndex = name ? open(name, false) : -1;
+}
+
+void BootTimeline::mark(const char* name) {
+    if (activeTimeline) activeTimeline->open(name, true);
+}
+
+void BootTimeline::finish() {
+    if (complete) return;
+    enterState(nullptr);
+    finishUs = micros();
+    complete = true;
+    activeTimeline = nullptr;
+    printReport();
+}
+
+uint32_t BootTimeline::getTotalUs() const {
+    return complete ? finishUs : (uint32_t)micros();
+}
+
+cJSON* BootTimeline::getJson() const {
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddBoolToObject(root, "complete", complete);
+    cJSON_AddNumberToObject(root, "setup_start_ms", setupStartUs / 1000.0);
+    cJSON_AddNumberToObject(root, "total_ms", getTotalUs() / 1000.0);
+    if (droppedPhases) cJSON_AddNumberToObject(root, "dropped_phases", droppedPhases);
+    cJSON* list = cJSON_AddArrayToObject(root, "phases");
+    for (int i = 0; i < phaseCount; ++i) {
+        const Phase& p = phases[i];
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "name", p.name);
+        cJSON_AddNumberToObject(item, "start_ms", p.startUs / 1000.0);
+        if (p.milestone) {
+            cJSON_AddBoolToObject(item, "milestone", true);
+        } else {
+            uint32_t us = p.open ? (uint32_t)micros() - p.startUs : p.durationUs;
+            cJSON_AddNumberToObject(item, "ms", us / 1000.0);
+            if (p.open) cJSON_AddBoolToObject(item, "open", true);
+        }
+        cJSON_AddNumberToObject(item, "depth", p.depth);
+        cJSON_AddItemToArray(list, item);
+    }
+    return root;
+}
+
+void BootTimeline::printReport() const {
+    uint32_t total = getTotalUs();
+    // Time between top-level phases: setup() code outside any scope and the
+    // gap before the first loop() iteration
+    uint32_t covered = 0;
+    for (int i = 0; i < phaseCount; ++i) {
+        if (phases[i].depth == 0 && !phases[i].milestone) covered += phases[i].durationUs;
+    }
+    uint32_t outside = total - setupStartUs > covered ? total - setupStartUs - covered : 0;
+    Serial.printf("[Boot] Cold boot to web UI: %.2f s (setup() entered at %.2f s, %.2f s outside the phases below)\n",
+        total / 1e6, setupStartUs / 1e6, outside / 1e6);
+    Serial.println("[Boot]   start_ms   duration_ms  share  phase");
+    for (int i = 0; i < phaseCount; ++i) {
+        const Phase& p = phases[i];
+        int indent = p.depth * 2;
+        if (p.milestone) {
+            Serial.printf("[Boot] %10.1f              -      -  %*s* %s\n", p.startUs / 1000.0, indent, "", p.name);
+        } else {
+            Serial.printf("[Boot] %10.1f %13.1f %5.1f%%  %*s%s\n", p.startUs / 1000.0, p.durationUs / 1000.0,
+                total ? 100.0 * p.durationUs / total : 0.0, indent, "", p.name);
+        }
+    }
+    if (droppedPhases) Serial.printf("[Boot] %u phases dropped, table holds %d\n", droppedPhases, MAX_PHASES);
+}
@@ -5,6 +5,7 @@
 #include "devices/RelayController.h"
 #include "devices/TouchSensorDevice.h"
 #include "devices/BME280Device.h"
+#include "devices/BME280Group.h"
 #include "devices/SoilMoistureSensor.h"
 #include "devices/MQ135Sensor.h"
 
@@ -77,6 +78,10 @@ void DashboardManager::setBME280Device(BME280Device* bme280Dev) {
     bme280Device = bme280Dev;
 }
 
+void DashboardManager::setBME280Group(BME280Group* group) {
+    bme280Group = group;
+}
+
 void DashboardManager::setSoilMoistureSensor(SoilMoistureSensor* soilSensor) {
     soilMoistureSensor = soilSensor;
 }
@@ -89,6 +94,51 @@ void DashboardManager::setIrrigationManager(IrrigationManager* irrigationMgr) {
     irrigationManager = irrigationMgr;
 }
 
+// Raw and averaged values of one reading
+static cJSON* bme280ReadingJson(const BME280Reading& r) {
+    cJSON* readingJson = cJSON_CreateObject();
+    cJSON_AddNumberToObject(readingJson, "temperature", r.temperature);
+    cJSON_AddNumberToObject(readingJson, "humidity", r.humidity);
+    cJSON_AddNumberToObject(readingJson, "pressure", r.pressure);
+    cJSON_AddNumberToObject(readingJson, "heat_index", r.heatIndex);
+    cJSON_AddNumberToObject(readingJson, "dew_point", r.dewPoint);
+    cJSON_AddBoolToObject(readingJson, "valid", r.valid);
+    cJSON_AddNumberToObject(readingJson, "avg_temperature", r.avgTemperature);
+    cJSON_AddNumberToObject(readingJson, "avg_humidity", r.avgHumidity);
+    cJSON_AddNumberToObject(readingJson, "avg_pressure", r.avgPressure);
+    cJSON_AddNumberToObject(readingJson, "avg_heat_index", r.avgHeatIndex);
+    cJSON_AddNumberToObject(readingJson, "avg_dew_point", r.avgDewPoint);
+    char tsStr[32] = "";
+    if (r.timestamp.isValid()) {
+        snprintf(tsStr, sizeof(tsStr), "%04d-%02d-%02d %02d:%02d:%02d", r.timestamp.year(), r.timestamp.month(), r.timestamp.day(), r.timestamp.hour(), r.timestamp.minute(), r.timestamp.second());
+    } else {
+        strcpy(tsStr, "N/A");
+    }
+    cJSON_AddStringToObject(readingJson, "timestamp", tsStr);
+    return readingJson;
+}
+
+static cJSON* bme280Json(BME280Device* bme) {
+    cJSON* bmeJson = cJSON_CreateObject();
+    if (bme) {
+        char addrStr[6];
+        snprintf(addrStr, sizeof(addrStr), "0x%02X", bme->getAddress());
+        cJSON_AddStringToObject(bmeJson, "address", addrStr);
+        cJSON_AddStringToObject(bmeJson, "state", BME280Device::stateToString(bme->getState()));
+        cJSON_AddBoolToObject(bmeJson, "initialized", bme->isInitialized());
+        cJSON_AddStringToObject(bmeJson, "mode", BME280Device::modeToString(bme->getMode()));
+        if (bme->getMode() == BME280Device::MODE_NORMAL) cJSON_AddNumberToObject(bmeJson, "normal_samples", bme->getNormalSamples());
+        cJSON_AddStringToObject(bmeJson, "last_error", bme->getLastError().c_str());
+        cJSON_AddItemToObject(bmeJson, "last_reading", bme280ReadingJson(bme->getLastReading()));
+    } else {
+        cJSON_AddStringToObject(bmeJson, "address", "none");
+        cJSON_AddStringToObject(bmeJson, "state", "not_present");
+        cJSON_AddBoolToObject(bmeJson, "initialized", false);
+        cJSON_AddStringToObject(bmeJson, "last_error", "not available");
+    }
+    return bmeJson;
+}
+
 cJSON* DashboardManager::getStatusJson() {
     if (ledDevice) {
         ledDevice->update();
@@ -112,44 +162,32 @@ cJSON* DashboardManager::getStatusJson() {
     if (configManager) {
         cJSON_AddBoolToObject(root, "sunday_watering", configManager->getSundayWatering());
     }
-    // Always add BME280 state
-    cJSON* bmeJson = cJSON_CreateObject();
-    if (bme280Device) {
-        char addrStr[6];
-        snprintf(addrStr, sizeof(addrStr), "0x%02X", bme280Device->getAddress());
-        cJSON_AddStringToObject(bmeJson, "address", addrStr);
-        cJSON_AddStringToObject(bmeJson, "state", BME280Device::stateToString(bme280Device->getState()));
-        cJSON_AddBoolToObject(bmeJson, "initialized", bme280Device->getState() == BME280Device::READY);
-        cJSON_AddStringToObject(bmeJson, "last_error", bme280Device->getLastError().c_str());
-        // Add last reading (raw and averaged)
-        const BME280Reading& r = bme280Device->getLastReading();
-        cJSON* readingJson = cJSON_CreateObject();
-        cJSON_AddNumberToObject(readingJson, "temperature", r.temperature);
-        cJSON_AddNumberToObject(readingJson, "humidity", r.humidity);
-        cJSON_AddNumberToObject(readingJson, "pressure", r.pressure);
-        cJSON_AddNumberToObject(readingJson, "heat_index", r.heatIndex);
-        cJSON_AddNumberToObject(readingJson, "dew_point", r.dewPoint);
-        cJSON_AddBoolToObject(readingJson, "valid", r.valid);
-        cJSON_AddNumberToObject(readingJson, "avg_temperature", r.avgTemperature);
-        cJSON_AddNumberToObject(readingJson, "avg_humidity", r.avgHumidity);
-        cJSON_AddNumberToObject(readingJson, "avg_pressure", r.avgPressure);
-        cJSON_AddNumberToObject(readingJson, "avg_heat_index", r.avgHeatIndex);
-        cJSON_AddNumberToObject(readingJson, "avg_dew_point", r.avgDewPoint);
-        char tsStr[32] = "";
-        if (r.timestamp.isValid()) {
-            snprintf(tsStr, sizeof(tsStr), "%04d-%02d-%02d %02d:%02d:%02d", r.timestamp.year(), r.timestamp.month(), r.timestamp.day(), r.timestamp.hour(), r.timestamp.minute(), r.timestamp.second());
-        } else {
-            strcpy(tsStr, "N/A");
+    // Each BME280 once, in bme280_sensors; bme280_primary is the index of
+    // the one the single-sensor views use. "bme280" only without sensors
+    int bmeCount = bme280Group ? bme280Group->size() : 0;
+    int primary = -1;
+    for (int i = 0; i < bmeCount; ++i) {
+        if (bme280Group->get(i) == bme280Device) primary = i;
+    }
+    if (primary < 0) cJSON_AddItemToObject(root, "bme280", bme280Json(bme280Device));
+    if (bmeCount > 0) {
+        cJSON* sensorsJson = cJSON_AddArrayToObject(root, "bme280_sensors");
+        for (int i = 0; i < bmeCount; ++i) {
+            cJSON_AddItemToArray(sensorsJson, bme280Json(bme280Group->get(i)));
         }
-        cJSON_AddStringToObject(readingJson, "timestamp", tsStr);
-        cJSON_AddItemToObject(bmeJson, "last_reading", readingJson);
-    } else {
-        cJSON_AddStringToObject(bmeJson, "address", "none");
-        cJSON_AddStringToObject(bmeJson, "state", "not_present");
-        cJSON_AddBoolToObject(bmeJson, "initialized", false);
-        cJSON_AddStringToObject(bmeJson, "last_error", "not available");
+        if (primary >= 0) cJSON_AddNumberToObject(root, "bme280_primary", primary);
+    }
+    if (bmeCount > 1) {
+        // What the irrigation decision uses; with one sensor it is that sensor
+        BME280Reading median = bme280Group->getMedianReading();
+        cJSON* medianJson = cJSON_CreateObject();
+        cJSON_AddBoolToObject(medianJson, "valid", median.valid);
+        cJSON_AddNumberToObject(medianJson, "avg_temperature", median.avgTemperature);
+        cJSON_AddNumberToObject(medianJson, "avg_humidity", median.avgHumidity);
+        cJSON_AddNumberToObject(medianJson, "avg_pressure", median.avgPressure);
+        cJSON_AddNumberToObject(medianJson, "sensors", bme280Group->validCount());
+        cJSON_AddItemToObject(root, "bme280_median", medianJson);
     }
-    cJSON_AddItemToObject(root, "bme280", bmeJson);
     // Add LED state if available
     if (ledDevice) {
         cJSON* ledJson = cJSON_CreateObject();
@@ -219,6 +257,7 @@ cJSON* DashboardManager::getStatusJson() {
         cJSON_AddNumberToObject(soilJson, "avg_raw", r.avgRaw);
         cJSON_AddNumberToObject(soilJson, "avg_voltage", r.avgVoltage);
         cJSON_AddNumberToObject(soilJson, "avg_percent", r.avgPercent);
+        if (soilMoistureSensor->isDryWatchArmed()) cJSON_AddBoolToObject(soilJson, "dry_watch", true);
         char tsStr[32] = "";
         if (r.timestamp > 0) {
             struct tm* tm_info = localtime(&r.timestamp);
@@ -320,6 +359,10 @@ cJSON* DashboardManager::getStatusJson() {
         cJSON_AddItemToObject(root, "health", healthInfo);
         cJSON* i2cInfo = systemManager->getI2CInfoJson();
         cJSON_AddItemToObject(root, "i2c", i2cInfo);
+        cJSON_AddItemToObject(root, "boot", systemManager->getBootTimeline().getJson());
+        if (systemManager->getADS1115Sampler().getScanCount() > 0) {
+            cJSON_AddItemToObject(root, "ads1115_scan", systemManager->getADS1115Sampler().getScanJson());
+        }
     }
     return root;
 }
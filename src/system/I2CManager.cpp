@@ -1,7 +1,12 @@
 #include "system/I2CManager.h"
 #include "devices/BME280Device.h"
+#include "devices/BME280Group.h"
 #include "devices/DeviceManager.h"
 #include "system/TimeManager.h"
+#include "system/BootTimeline.h"
+
+// Speeds the self-test steps down through, fastest first
+static const uint32_t BUS_SPEEDS[] = { I2CManager::MAX_FREQUENCY, 400000, I2CManager::STANDARD_FREQUENCY };
 
 void I2CManager::begin(ConfigManager* config, DiagnosticManager* diag) {
     configManager = config;
@@ -13,16 +18,109 @@ void I2CManager::begin(ConfigManager* config, DiagnosticManager* diag) {
     const char* sclStr = configManager->get("i2c_scl");
     sdaPin = sdaStr && *sdaStr ? atoi(sdaStr) : 21;
     sclPin = sclStr && *sclStr ? atoi(sclStr) : 22;
-    Wire.begin(sdaPin, sclPin);
+    // Scan at standard mode so a part that cannot keep up still shows
+    Wire.begin(sdaPin, sclPin, STANDARD_FREQUENCY);
+    tracer.begin(Wire.getClock());
     if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "I2C", "I2C bus initialized: SDA=%d, SCL=%d", sdaPin, sclPin);
     autoDetectDevices();
+    negotiateFrequency((uint32_t)configManager->getInt("i2c_frequency", 400000));
+}
+
+uint32_t I2CManager::negotiateFrequency(uint32_t requestedHz) {
+    BootTimeline::Scope phase("I2CManager::negotiateFrequency");
+    if (requestedHz > MAX_FREQUENCY) requestedHz = MAX_FREQUENCY;
+    if (requestedHz < STANDARD_FREQUENCY) requestedHz = STANDARD_FREQUENCY;
+    requestedFrequency = requestedHz;
+    speedFailAddress = 0;
+    uint32_t hz = requestedHz;
+    size_t next = 0;
+    while (true) {
+        Wire.setClock(hz);
+        tracer.setClockHz(hz);
+        uint8_t failed = 0;
+        for (uint8_t addr : detectedDevices) {
+            if (!selfTestDevice(addr)) {
+                failed = addr;
+                break;
+            }
+        }
+        if (!failed) break;
+        // The last failure is the one that set the final speed
+        speedFailAddress = failed;
+        while (next < sizeof(BUS_SPEEDS) / sizeof(BUS_SPEEDS[0]) && BUS_SPEEDS[next] >= hz) ++next;
+        if (next == sizeof(BUS_SPEEDS) / sizeof(BUS_SPEEDS[0])) {
+            if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_WARN, "I2C", "Device 0x%02X fails its self-test even at %lu Hz", failed, (unsigned long)hz);
+            break;
+        }
+        if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_WARN, "I2C", "Device 0x%02X failed at %lu Hz, trying %lu Hz", failed, (unsigned long)hz, (unsigned long)BUS_SPEEDS[next]);
+        hz = BUS_SPEEDS[next];
+    }
+    busFrequency = hz;
+    if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "I2C", "I2C bus at %lu Hz (requested %lu Hz)", (unsigned long)busFrequency, (unsigned long)requestedFrequency);
+    return busFrequency;
+}
+
+bool I2CManager::selfTestDevice(uint8_t address) {
+    // Each test compares with a known value, so a bus that reads all ones fails
+    if (address == 0x76 || address == 0x77 || address == 0x70) {
+        uint8_t chipId = 0;
+        return readRegisters(address, 0xD0, &chipId, 1) && chipId == 0x60;
+    }
+    if (address >= 0x48 && address <= 0x4B) {
+        // Lo_thresh takes any value: write its complement, read it back, restore
+        uint8_t saved[2], pattern[2], readBack[2];
+        if (!readRegisters(address, 0x02, saved, 2)) return false;
+        pattern[0] = (uint8_t)~saved[0];
+        pattern[1] = (uint8_t)~saved[1];
+        bool ok = writeRegisters(address, 0x02, pattern, 2) && readRegisters(address, 0x02, readBack, 2) &&
+                  memcmp(pattern, readBack, 2) == 0;
+        return writeRegisters(address, 0x02, saved, 2) && ok;
+    }
+    if (address == 0x68) {
+        // Bits 6:4 of the DS3231 status register always read 0
+        uint8_t status = 0xFF;
+        return readRegisters(address, 0x0F, &status, 1) && (status & 0x70) == 0;
+    }
+    return devicePresent(address);
+}
+
+bool I2CManager::writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, uint8_t len) {
+    I2CTracer::Access access(this, address, "selfTest");
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    for (uint8_t i = 0; i < len; ++i) Wire.write(data[i]);
+    access.addTransaction(1 + len, 0);
+    if (Wire.endTransmission() != 0) {
+        access.fail();
+        return false;
+    }
+    return true;
+}
+
+bool I2CManager::readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, uint8_t len) {
+    I2CTracer::Access access(this, address, "selfTest");
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    access.addTransaction(1, 0);
+    if (Wire.endTransmission(false) != 0) {
+        access.fail();
+        return false;
+    }
+    uint8_t received = Wire.requestFrom(address, len);
+    access.addTransaction(0, received);
+    for (uint8_t i = 0; i < received; ++i) buffer[i] = (uint8_t)Wire.read();
+    if (received != len) access.fail();
+    return received == len;
 }
 
 void I2CManager::autoDetectDevices() {
+    BootTimeline::Scope phase("I2CManager::autoDetectDevices");
     detectedDevices.clear();
     if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "I2C", "Auto-detecting I2C devices...");
+    I2CTracer::Access access(this, I2CTracer::SCAN_ADDRESS, "autodetect", false);
     for (uint8_t addr = 1; addr < 127; ++addr) {
         Wire.beginTransmission(addr);
+        access.addTransaction(0, 0);
         if (Wire.endTransmission() == 0) {
             detectedDevices.push_back(addr);
             if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "I2C", "Device detected at 0x%02X", addr);
@@ -38,16 +136,45 @@ void I2CManager::autoRegisterBME280s(TimeManager* timeMgr, class DeviceManager*
         if (addr == 0x76 || addr == 0x77 || addr == 0x70) {
             std::unique_ptr<BME280Device> dev(new BME280Device(addr, this, diagnosticManager));
             dev->setTimeManager(timeMgr);
-            if (dev->begin()) {
-                // Register the first BME280 device with DeviceManager if provided
-                if (deviceMgr && bme280Devices.empty()) {
-                    deviceMgr->setBME280Device(dev.get());
+            cJSON* bmeSection = configManager ? configManager->getSection("bme280") : nullptr;
+            if (bmeSection) {
+                cJSON* modeItem = cJSON_GetObjectItem(bmeSection, "mode");
+                cJSON* standbyItem = cJSON_GetObjectItem(bmeSection, "standby_ms");
+                cJSON* iirItem = cJSON_GetObjectItem(bmeSection, "iir");
+                cJSON* normalSamplesItem = cJSON_GetObjectItem(bmeSection, "normal_samples");
+                cJSON* oversamplingItem = cJSON_GetObjectItem(bmeSection, "oversampling");
+                bool normal = cJSON_IsString(modeItem) && strcmp(modeItem->valuestring, "normal") == 0;
+                dev->setMode(normal ? BME280Device::MODE_NORMAL : BME280Device::MODE_FORCED,
+                             cJSON_IsNumber(standbyItem) ? (float)standbyItem->valuedouble : 125.0f,
+                             cJSON_IsNumber(iirItem) && iirItem->valueint >= 0 ? (uint8_t)iirItem->valueint : 16,
+                             cJSON_IsNumber(normalSamplesItem) && normalSamplesItem->valueint > 0
+                                 ? (uint8_t)(normalSamplesItem->valueint > 255 ? 255 : normalSamplesItem->valueint) // setMode() clamps
+                                 : (uint8_t)BME280Device::SAMPLES);
+                if (cJSON_IsNumber(oversamplingItem) && oversamplingItem->valueint > 0) {
+                    dev->setOversampling((uint8_t)(oversamplingItem->valueint > 16 ? 16 : oversamplingItem->valueint));
                 }
+            }
+            bool found;
+            {
+                BootTimeline::Scope phase("BME280Device::begin");
+                found = dev->begin(false);
+            }
+            if (found) {
+                // Register every BME280 with DeviceManager if provided; the first is the primary
+                if (deviceMgr) deviceMgr->addBME280Device(dev.get());
                 bme280Devices.push_back(std::move(dev));
                 if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "I2C", "BME280 auto-registered at 0x%02X", addr);
             }
         }
     }
+    // First readings of all sensors in one pass, their waits overlapping
+    BME280Group group;
+    for (auto& dev : bme280Devices) group.add(dev.get());
+    if (group.size() > 0) {
+        BootTimeline::Scope phase("BME280Group::readData (first)");
+        group.readData();
+    }
+    for (auto& dev : bme280Devices) dev->logInitialReading();
 }
 
 void I2CManager::rescanDevices() {
@@ -56,8 +183,10 @@ void I2CManager::rescanDevices() {
 
 void I2CManager::scanBus() {
     if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "I2C", "Scanning I2C bus...");
+    I2CTracer::Access access(this, I2CTracer::SCAN_ADDRESS, "scan", false);
     for (uint8_t addr = 1; addr < 127; ++addr) {
         Wire.beginTransmission(addr);
+        access.addTransaction(0, 0);
         if (Wire.endTransmission() == 0) {
             if (diagnosticManager) diagnosticManager->log(DiagnosticManager::LOG_INFO, "I2C", "Device found at 0x%02X", addr);
         }
@@ -65,25 +194,35 @@ void I2CManager::scanBus() {
 }
 
 bool I2CManager::devicePresent(uint8_t address) {
+    I2CTracer::Access access(this, address, "probe", false);
     Wire.beginTransmission(address);
-    return Wire.endTransmission() == 0;
+    access.addTransaction(0, 0);
+    bool present = Wire.endTransmission() == 0;
+    if (!present) access.fail();
+    return present;
 }
 
 void I2CManager::writeByte(uint8_t address, uint8_t reg, uint8_t value) {
+    I2CTracer::Access access(this, address, "writeByte", false);
     Wire.beginTransmission(address);
     Wire.write(reg);
     Wire.write(value);
-    Wire.endTransmission();
+    access.addTransaction(2, 0);
+    if (Wire.endTransmission() != 0) access.fail();
 }
 
 uint8_t I2CManager::readByte(uint8_t address, uint8_t reg) {
+    I2CTracer::Access access(this, address, "readByte", false);
     Wire.beginTransmission(address);
     Wire.write(reg);
-    Wire.endTransmission(false);
-    Wire.requestFrom(address, (uint8_t)1);
+    access.addTransaction(1, 0);
+    if (Wire.endTransmission(false) != 0) access.fail();
+    uint8_t received = Wire.requestFrom(address, (uint8_t)1);
+    access.addTransaction(0, received);
     if (Wire.available()) {
         return Wire.read();
     }
+    access.fail();
     return 0xFF;
 }
 
@@ -104,23 +243,33 @@ int I2CManager::read() {
     return Wire.read();
 }
 
+// Map known addresses to device names
+const char* I2CManager::getDeviceName(uint8_t addr) {
+    if (addr == 0x76 || addr == 0x77) return "BME280";
+    if (addr == 0x68) return "DS3231";
+    if (addr >= 0x48 && addr <= 0x4B) return "ADS1115";
+    if (addr == 0x57) return "DS3231_ALARM";
+    return "Unknown";
+}
+
 cJSON* I2CManager::getI2CInfoJson() const {
     cJSON* info = cJSON_CreateObject();
     cJSON_AddNumberToObject(info, "sda_pin", sdaPin);
     cJSON_AddNumberToObject(info, "scl_pin", sclPin);
+    cJSON_AddNumberToObject(info, "frequency", busFrequency);
+    cJSON_AddNumberToObject(info, "requested_frequency", requestedFrequency);
+    if (speedFailAddress) {
+        char failStr[6];
+        snprintf(failStr, sizeof(failStr), "0x%02X", speedFailAddress);
+        cJSON_AddStringToObject(info, "speed_fallback_device", failStr);
+    }
     cJSON* devices = cJSON_CreateArray();
     for (uint8_t addr : detectedDevices) {
         cJSON* dev = cJSON_CreateObject();
         char addrStr[6];
         snprintf(addrStr, sizeof(addrStr), "0x%02X", addr);
         cJSON_AddStringToObject(dev, "address", addrStr);
-        // Map known addresses to device names
-        const char* name = "Unknown";
-        if (addr == 0x76 || addr == 0x77) name = "BME280";
-        else if (addr == 0x68) name = "DS3231";
-        else if (addr == 0x48) name = "ADS1115";
-        else if (addr == 0x57) name = "DS3231_ALARM";
-        cJSON_AddStringToObject(dev, "name", name);
+        cJSON_AddStringToObject(dev, "name", getDeviceName(addr));
         cJSON_AddItemToArray(devices, dev);
     }
     cJSON_AddItemToObject(info, "devices", devices);
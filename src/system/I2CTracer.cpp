@@ -0,0 +1,184 @@
+#include "system/I2CTracer.h"
+#include "system/I2CManager.h"
+
+static const uint8_t OVERFLOW_ADDRESS = 0xFF;
+
+I2CTracer::Access::Access(I2CManager* i2c, uint8_t addr, const char* name, bool lockBus)
+    : tracer(i2c ? &i2c->getTracer() : nullptr),
+      mutex(i2c && lockBus ? i2c->getI2CMutex() : nullptr),
+      address(addr), label(name) {
+    acquire();
+}
+
+I2CTracer::Access::Access(I2CTracer* t, SemaphoreHandle_t m, uint8_t addr, const char* name)
+    : tracer(t), mutex(m), address(addr), label(name) {
+    acquire();
+}
+
+void I2CTracer::Access::acquire() {
+    unsigned long requested = micros();
+    if (mutex) xSemaphoreTake(mutex, portMAX_DELAY);
+    startUs = micros();
+    waitUs = (uint32_t)(startUs - requested);
+}
+
+I2CTracer::Access::~Access() {
+    uint32_t heldUs = (uint32_t)(micros() - startUs);
+    // Recorded before the bus is released so entries from different tasks
+    // land in the trace in bus order
+    if (tracer) tracer->record(address, label, cost, error, heldUs, waitUs);
+    if (mutex) xSemaphoreGive(mutex);
+}
+
+void I2CTracer::Access::add(const Cost& c, uint16_t times) {
+    cost.transactions += c.transactions * times;
+    cost.txBytes += c.txBytes * times;
+    cost.rxBytes += c.rxBytes * times;
+}
+
+void I2CTracer::Access::addTransaction(uint16_t txBytes, uint16_t rxBytes) {
+    cost.transactions++;
+    cost.txBytes += txBytes;
+    cost.rxBytes += rxBytes;
+}
+
+void I2CTracer::begin(uint32_t hz) {
+    if (!tracerMutex) tracerMutex = xSemaphoreCreateMutex();
+    if (hz) clockHz = hz;
+    reset();
+}
+
+I2CTracer::DeviceStats* I2CTracer::slotFor(uint8_t address) {
+    for (int i = 0; i < deviceCount; ++i) {
+        if (devices[i].address == address) return &devices[i];
+    }
+    if (deviceCount < MAX_DEVICES) {
+        DeviceStats* slot = &devices[deviceCount++];
+        slot->address = address;
+        return slot;
+    }
+    devices[MAX_DEVICES].address = OVERFLOW_ADDRESS;
+    return &devices[MAX_DEVICES];
+}
+
+void I2CTracer::record(uint8_t address, const char* label, const Cost& cost, bool error, uint32_t heldUs, uint32_t mutexWaitUs) {
+    if (tracerMutex) xSemaphoreTake(tracerMutex, portMAX_DELAY);
+    DeviceStats* s = slotFor(address);
+    s->calls++;
+    s->transactions += cost.transactions;
+    s->txBytes += cost.txBytes;
+    s->rxBytes += cost.rxBytes;
+    if (error) s->errors++;
+    s->heldUs += heldUs;
+    s->mutexWaitUs += mutexWaitUs;
+    if (heldUs > s->maxHeldUs) s->maxHeldUs = heldUs;
+    if (mutexWaitUs > s->maxMutexWaitUs) s->maxMutexWaitUs = mutexWaitUs;
+
+    TraceEntry& e = trace[traceHead % TRACE_SIZE];
+    e.timeMs = millis();
+    e.label = label;
+    e.address = address;
+    e.error = error;
+    e.transactions = cost.transactions;
+    e.txBytes = cost.txBytes;
+    e.rxBytes = cost.rxBytes;
+    e.heldUs = heldUs;
+    e.mutexWaitUs = mutexWaitUs;
+    traceHead++;
+    if (tracerMutex) xSemaphoreGive(tracerMutex);
+}
+
+void I2CTracer::reset() {
+    if (tracerMutex) xSemaphoreTake(tracerMutex, portMAX_DELAY);
+    memset(devices, 0, sizeof(devices));
+    deviceCount = 0;
+    traceHead = 0;
+    windowStart = millis();
+    if (tracerMutex) xSemaphoreGive(tracerMutex);
+}
+
+const I2CTracer::DeviceStats* I2CTracer::findDevice(uint8_t address) const {
+    for (int i = 0; i < deviceCount; ++i) {
+        if (devices[i].address == address) return &devices[i];
+    }
+    return nullptr;
+}
+
+// Same framing as a Wire transfer: START, address byte and STOP per
+// transaction, nine clocks (eight bits plus ACK) per payload byte.
+uint32_t I2CTracer::estimateBusMicros(uint32_t transactions, uint32_t bytes) const {
+    uint64_t bits = (uint64_t)transactions * 11 + (uint64_t)bytes * 9;
+    return (uint32_t)((bits * 1000000ULL + clockHz - 1) / clockHz);
+}
+
+static void addAddress(cJSON* item, uint8_t address) {
+    char addrStr[6];
+    snprintf(addrStr, sizeof(addrStr), "0x%02X", address);
+    cJSON_AddStringToObject(item, "address", addrStr);
+}
+
+cJSON* I2CTracer::getUtilisationJson() const {
+    if (tracerMutex) xSemaphoreTake(tracerMutex, portMAX_DELAY);
+    unsigned long windowMs = millis() - windowStart;
+    double windowUs = windowMs ? windowMs * 1000.0 : 1.0;
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "clock_hz", clockHz);
+    cJSON_AddNumberToObject(root, "window_ms", windowMs);
+    cJSON* list = cJSON_AddArrayToObject(root, "devices");
+    uint64_t totalBusUs = 0;
+    uint64_t totalHeldUs = 0;
+    int slots = deviceCount + (devices[MAX_DEVICES].calls ? 1 : 0);
+    for (int i = 0; i < slots; ++i) {
+        const DeviceStats& s = (i < deviceCount) ? devices[i] : devices[MAX_DEVICES];
+        uint32_t busUs = estimateBusMicros(s.transactions, s.txBytes + s.rxBytes);
+        totalBusUs += busUs;
+        totalHeldUs += s.heldUs;
+        cJSON* item = cJSON_CreateObject();
+        addAddress(item, s.address);
+        const char* name = "Other";
+        if (s.address == SCAN_ADDRESS) name = "Scan";
+        else if (s.address != OVERFLOW_ADDRESS) name = I2CManager::getDeviceName(s.address);
+        cJSON_AddStringToObject(item, "name", name);
+        cJSON_AddNumberToObject(item, "calls", s.calls);
+        cJSON_AddNumberToObject(item, "transactions", s.transactions);
+        cJSON_AddNumberToObject(item, "tx_bytes", s.txBytes);
+        cJSON_AddNumberToObject(item, "rx_bytes", s.rxBytes);
+        cJSON_AddNumberToObject(item, "errors", s.errors);
+        cJSON_AddNumberToObject(item, "bus_ms", busUs / 1000.0);
+        cJSON_AddNumberToObject(item, "bus_pct", busUs * 100.0 / windowUs);
+        cJSON_AddNumberToObject(item, "held_ms", (double)s.heldUs / 1000.0);
+        cJSON_AddNumberToObject(item, "held_pct", (double)s.heldUs * 100.0 / windowUs);
+        cJSON_AddNumberToObject(item, "max_held_us", s.maxHeldUs);
+        cJSON_AddNumberToObject(item, "mutex_wait_ms", (double)s.mutexWaitUs / 1000.0);
+        cJSON_AddNumberToObject(item, "max_mutex_wait_us", s.maxMutexWaitUs);
+        cJSON_AddItemToArray(list, item);
+    }
+    cJSON_AddNumberToObject(root, "bus_pct", (double)totalBusUs * 100.0 / windowUs);
+    cJSON_AddNumberToObject(root, "held_pct", (double)totalHeldUs * 100.0 / windowUs);
+    if (tracerMutex) xSemaphoreGive(tracerMutex);
+    return root;
+}
+
+cJSON* I2CTracer::getTraceJson() const {
+    if (tracerMutex) xSemaphoreTake(tracerMutex, portMAX_DELAY);
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "total", traceHead);
+    cJSON* entries = cJSON_AddArrayToObject(root, "entries");
+    uint32_t first = traceHead > TRACE_SIZE ? traceHead - TRACE_SIZE : 0;
+    for (uint32_t n = first; n < traceHead; ++n) {
+        const TraceEntry& e = trace[n % TRACE_SIZE];
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "t_ms", e.timeMs);
+        addAddress(item, e.address);
+        cJSON_AddStringToObject(item, "op", e.label ? e.label : "");
+        cJSON_AddNumberToObject(item, "transactions", e.transactions);
+        cJSON_AddNumberToObject(item, "tx", e.txBytes);
+        cJSON_AddNumberToObject(item, "rx", e.rxBytes);
+        cJSON_AddNumberToObject(item, "held_us", e.heldUs);
+        cJSON_AddNumberToObject(item, "wait_us", e.mutexWaitUs);
+        if (e.error) cJSON_AddTrueToObject(item, "error");
+        cJSON_AddItemToArray(entries, item);
+    }
+    if (tracerMutex) xSemaphoreGive(tracerMutex);
+    return root;
+}
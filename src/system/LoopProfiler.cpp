@@ -0,0 +1,208 @@
+#include "system/LoopProfiler.h"
+
+static const char* const SECTION_NAMES[LoopProfiler::SECTION_COUNT] = {
+    "power", "health", "network", "time", "devices",
+    "readings", "mqtt", "irrigation", "sensors", "alarms", "relays", "touch",
+    "loop"
+};
+
+// Set on the loop task by its first record(); Sites on other tasks see null
+static thread_local LoopProfiler* loopTaskProfiler = nullptr;
+static thread_local LoopProfiler::Site* currentSite = nullptr;
+
+const char* LoopProfiler::getSectionName(Section section) {
+    return (section >= 0 && section < SECTION_COUNT) ? SECTION_NAMES[section] : "unknown";
+}
+
+void LoopProfiler::record(Section section, unsigned long durationUs) {
+    loopTaskProfiler = this;
+    if (resetPending) reset();
+    if (section < 0 || section >= SECTION_COUNT) return;
+    Stats& s = stats[section];
+    uint32_t us = (uint32_t)durationUs;
+    if (s.count == 0 || us < s.minUs) s.minUs = us;
+    if (us > s.maxUs) s.maxUs = us;
+    s.totalUs += us;
+    s.buckets[bucketIndex(us)]++;
+    s.count++;
+    if (section == LOOP_TOTAL) finishIteration(us);
+    else iterationSectionUs[section] += us;
+}
+
+void LoopProfiler::reset() {
+    memset(stats, 0, sizeof(stats));
+    memset(topStalls, 0, sizeof(topStalls));
+    topStallCount = 0;
+    memset(offenders, 0, sizeof(offenders));
+    offenderCount = 0;
+    stallTotal = 0;
+    windowStart = millis();
+    resetPending = false;
+}
+
+LoopProfiler::Site::Site(const char* siteName)
+    : profiler(loopTaskProfiler), name(siteName), start(micros()), parent(currentSite) {
+    if (profiler) currentSite = this;
+}
+
+LoopProfiler::Site::~Site() {
+    if (!profiler) return;
+    uint32_t elapsed = (uint32_t)(micros() - start);
+    currentSite = parent;
+    if (parent) parent->childUs += elapsed;
+    profiler->recordSite(name, elapsed > childUs ? elapsed - childUs : 0);
+}
+
+void LoopProfiler::recordSite(const char* name, uint32_t us) {
+    for (int i = 0; i < iterationSiteCount; ++i) {
+        if (iterationSites[i].name == name || strcmp(iterationSites[i].name, name) == 0) {
+            iterationSites[i].us += us;
+            return;
+        }
+    }
+    if (iterationSiteCount < MAX_SITES) iterationSites[iterationSiteCount++] = { name, us };
+}
+
+void LoopProfiler::finishIteration(uint32_t durationUs) {
+    if (durationUs >= stallThresholdUs) {
+        stallTotal++;
+        Stall stall = {};
+        stall.timeMs = millis();
+        stall.durationUs = durationUs;
+        for (int i = 0; i < iterationSiteCount; ++i) {
+            if (iterationSites[i].us > stall.siteUs) {
+                stall.site = iterationSites[i].name;
+                stall.siteUs = iterationSites[i].us;
+            }
+        }
+        stall.section = LOOP_TOTAL;
+        for (int i = 0; i < LOOP_TOTAL; ++i) {
+            if (iterationSectionUs[i] > stall.sectionUs) {
+                stall.section = (Section)i;
+                stall.sectionUs = iterationSectionUs[i];
+            }
+        }
+        const char* culprit = stall.site ? stall.site : getSectionName(stall.section);
+        int o = 0;
+        while (o < offenderCount && strcmp(offenders[o].name, culprit) != 0) o++;
+        if (o == offenderCount && offenderCount < MAX_OFFENDERS) offenders[offenderCount++].name = culprit;
+        if (o < offenderCount) {
+            offenders[o].stalls++;
+            offenders[o].totalUs += durationUs;
+            if (durationUs > offenders[o].maxUs) offenders[o].maxUs = durationUs;
+        }
+        // Keep the list sorted, slowest first; a full list drops its fastest
+        int pos = topStallCount < TOP_STALLS ? topStallCount : TOP_STALLS - 1;
+        if (topStallCount < TOP_STALLS || durationUs > topStalls[pos].durationUs) {
+            while (pos > 0 && topStalls[pos - 1].durationUs < durationUs) {
+                topStalls[pos] = topStalls[pos - 1];
+                pos--;
+            }
+            topStalls[pos] = stall;
+            if (topStallCount < TOP_STALLS) topStallCount++;
+        }
+    }
+    memset(iterationSectionUs, 0, sizeof(iterationSectionUs));
+    iterationSiteCount = 0;
+}
+
+int LoopProfiler::bucketIndex(uint32_t us) {
+    if (us < LINEAR_BUCKETS) return (int)us;
+    int octave = 31 - __builtin_clz(us);
+    if (octave >= MAX_OCTAVE) return BUCKET_COUNT - 1;
+    int sub = (us >> (octave - 2)) & (SUB_BUCKETS - 1);
+    return LINEAR_BUCKETS + (octave - 4) * SUB_BUCKETS + sub;
+}
+
+uint32_t LoopProfiler::bucketUpper(int index) {
+    if (index < LINEAR_BUCKETS) return (uint32_t)index;
+    int octave = 4 + (index - LINEAR_BUCKETS) / SUB_BUCKETS;
+    int sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+    uint32_t width = 1UL << (octave - 2);
+    return (1UL << octave) + (uint32_t)(sub + 1) * width - 1;
+}
+
+// Upper bound of the bucket holding the requested rank, clamped to the
+// observed range so a single sample reports exactly.
+uint32_t LoopProfiler::percentile(const Stats& s, float fraction) {
+    if (s.count == 0) return 0;
+    uint32_t rank = (uint32_t)ceilf(fraction * s.count);
+    if (rank == 0) rank = 1;
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += s.buckets[i];
+        if (seen >= rank) {
+            uint32_t value = bucketUpper(i);
+            if (value > s.maxUs) value = s.maxUs;
+            if (value < s.minUs) value = s.minUs;
+            return value;
+        }
+    }
+    return s.maxUs;
+}
+
+cJSON* LoopProfiler::getMetricsJson() const {
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "uptime_ms", millis());
+    cJSON_AddNumberToObject(root, "window_ms", millis() - windowStart);
+    cJSON* sections = cJSON_AddArrayToObject(root, "sections");
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        const Stats& s = stats[i];
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "name", SECTION_NAMES[i]);
+        cJSON_AddNumberToObject(item, "count", s.count);
+        cJSON_AddNumberToObject(item, "min_us", s.minUs);
+        cJSON_AddNumberToObject(item, "p50_us", percentile(s, 0.50f));
+        cJSON_AddNumberToObject(item, "p99_us", percentile(s, 0.99f));
+        cJSON_AddNumberToObject(item, "max_us", s.maxUs);
+        cJSON_AddNumberToObject(item, "avg_us", s.count ? (double)s.totalUs / s.count : 0);
+        cJSON_AddNumberToObject(item, "total_ms", (double)s.totalUs / 1000.0);
+        cJSON_AddItemToArray(sections, item);
+    }
+    return root;
+}
+
+cJSON* LoopProfiler::getStallsJson() const {
+    const Stats& loop = stats[LOOP_TOTAL];
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "window_ms", millis() - windowStart);
+    cJSON_AddNumberToObject(root, "threshold_us", stallThresholdUs);
+    cJSON_AddNumberToObject(root, "loops", loop.count);
+    cJSON_AddNumberToObject(root, "stalls", stallTotal);
+    cJSON_AddNumberToObject(root, "p50_us", percentile(loop, 0.50f));
+    cJSON_AddNumberToObject(root, "p99_us", percentile(loop, 0.99f));
+    cJSON_AddNumberToObject(root, "p999_us", percentile(loop, 0.999f));
+    cJSON_AddNumberToObject(root, "max_us", loop.maxUs);
+    // Non-empty buckets as [upper bound in us, count]
+    cJSON* histogram = cJSON_AddArrayToObject(root, "histogram");
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        if (!loop.buckets[i]) continue;
+        cJSON* bucket = cJSON_CreateArray();
+        cJSON_AddItemToArray(bucket, cJSON_CreateNumber(bucketUpper(i)));
+        cJSON_AddItemToArray(bucket, cJSON_CreateNumber(loop.buckets[i]));
+        cJSON_AddItemToArray(histogram, bucket);
+    }
+    cJSON* list = cJSON_AddArrayToObject(root, "offenders");
+    for (int i = 0; i < offenderCount; ++i) {
+        const Offender& o = offenders[i];
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "name", o.name);
+        cJSON_AddNumberToObject(item, "stalls", o.stalls);
+        cJSON_AddNumberToObject(item, "max_us", o.maxUs);
+        cJSON_AddNumberToObject(item, "total_ms", (double)o.totalUs / 1000.0);
+        cJSON_AddItemToArray(list, item);
+    }
+    cJSON* top = cJSON_AddArrayToObject(root, "top");
+    for (int i = 0; i < topStallCount; ++i) {
+        const Stall& st = topStalls[i];
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "t_ms", st.timeMs);
+        cJSON_AddNumberToObject(item, "duration_us", st.durationUs);
+        cJSON_AddStringToObject(item, "site", st.site ? st.site : "");
+        cJSON_AddNumberToObject(item, "site_us", st.siteUs);
+        cJSON_AddStringToObject(item, "section", getSectionName(st.section));
+        cJSON_AddNumberToObject(item, "section_us", st.sectionUs);
+        cJSON_AddItemToArray(top, item);
+    }
+    return root;
+}
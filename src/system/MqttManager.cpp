@@ -6,8 +6,11 @@
 #include "devices/RelayController.h"
 #include "devices/MQ135Sensor.h"
 #include "devices/BME280Device.h"
+#include "devices/BME280Group.h"
 #include "devices/SoilMoistureSensor.h"
 #include "system/SystemManager.h"
+#include "diagnostics/AllocationTracker.h"
+#include "system/LoopProfiler.h"
 #include <cJSON.h>
 #include <string>
 #include <vector>
@@ -31,14 +34,17 @@ extern SystemManager systemManager;
 MqttManager::MqttManager() : initialized(false) {}
 
 // Publish Home Assistant MQTT Discovery for BME280 temperature sensor
-void MqttManager::publishDiscoveryForBME280Temperature() {
+void MqttManager::publishDiscoveryForBME280Temperature(const char* key, const char* label) {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForBME280Temperature");
     char state_topic[128], availability_topic[128], topic[128], unique_id[128];
-    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/bme280_temperature/state", deviceName.c_str());
+    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/%s_temperature/state", deviceName.c_str(), key);
     snprintf(availability_topic, sizeof(availability_topic), "homeassistant/esp32/%s/availability", deviceName.c_str());
-    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_bme280_temperature/config", deviceName.c_str());
-    snprintf(unique_id, sizeof(unique_id), "%s_bme280_temperature", deviceName.c_str());
+    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_%s_temperature/config", deviceName.c_str(), key);
+    snprintf(unique_id, sizeof(unique_id), "%s_%s_temperature", deviceName.c_str(), key);
     cJSON* root = cJSON_CreateObject();
-    cJSON_AddStringToObject(root, "name", "BME280 Temperature");
+    char name[48];
+    snprintf(name, sizeof(name), "%s Temperature", label);
+    cJSON_AddStringToObject(root, "name", name);
     cJSON_AddStringToObject(root, "state_topic", state_topic);
     cJSON_AddStringToObject(root, "unit_of_measurement", "°C");
     cJSON_AddStringToObject(root, "device_class", "temperature");
@@ -56,9 +62,10 @@ void MqttManager::publishDiscoveryForBME280Temperature() {
 }
 
 // Publish BME280 temperature value to MQTT
-void MqttManager::publishBME280Temperature(float temperature) {
+void MqttManager::publishBME280Temperature(float temperature, const char* key) {
+    AllocationTracker::Scope allocScope("MQTT publishBME280Temperature");
     char topic[128];
-    snprintf(topic, sizeof(topic), "homeassistant/%s/bme280_temperature/state", deviceName.c_str());
+    snprintf(topic, sizeof(topic), "homeassistant/%s/%s_temperature/state", deviceName.c_str(), key);
     // Add random jitter between 0.01 and 0.02
     float jitter = ((float)random(10, 21)) / 100.0f; // 0.10 to 0.20, but we want 0.01 to 0.02
     jitter = jitter / 10.0f; // 0.01 to 0.02
@@ -69,7 +76,8 @@ void MqttManager::publishBME280Temperature(float temperature) {
 }
 
 // Publish BME280 humidity value to MQTT (with config checks)
-void MqttManager::publishBME280Humidity(float humidity) {
+void MqttManager::publishBME280Humidity(float humidity, const char* key) {
+    AllocationTracker::Scope allocScope("MQTT publishBME280Humidity");
     cJSON* config = systemManager.getConfigManager().getRoot();
     cJSON* wifiModeItem = cJSON_GetObjectItemCaseSensitive(config, "wifi_mode");
     cJSON* mqttEnabledItem = cJSON_GetObjectItemCaseSensitive(config, "mqtt_enabled");
@@ -87,7 +95,7 @@ void MqttManager::publishBME280Humidity(float humidity) {
     std::string wifiMode = wifiModeItem && cJSON_IsString(wifiModeItem) ? wifiModeItem->valuestring : "client";
     if (mqttEnabled && (wifiMode == "client" || wifiMode == "wifi")) {
         char topic[128];
-        snprintf(topic, sizeof(topic), "homeassistant/%s/bme280_humidity/state", deviceName.c_str());
+        snprintf(topic, sizeof(topic), "homeassistant/%s/%s_humidity/state", deviceName.c_str(), key);
         // Add random jitter between 0.01 and 0.02
         float jitter = ((float)random(10, 21)) / 100.0f;
         jitter = jitter / 10.0f;
@@ -99,7 +107,8 @@ void MqttManager::publishBME280Humidity(float humidity) {
 }
 
 // Publish BME280 pressure value to MQTT (with config checks)
-void MqttManager::publishBME280Pressure(float pressure) {
+void MqttManager::publishBME280Pressure(float pressure, const char* key) {
+    AllocationTracker::Scope allocScope("MQTT publishBME280Pressure");
     cJSON* config = systemManager.getConfigManager().getRoot();
     cJSON* wifiModeItem = cJSON_GetObjectItemCaseSensitive(config, "wifi_mode");
     cJSON* mqttEnabledItem = cJSON_GetObjectItemCaseSensitive(config, "mqtt_enabled");
@@ -117,7 +126,7 @@ void MqttManager::publishBME280Pressure(float pressure) {
     std::string wifiMode = wifiModeItem && cJSON_IsString(wifiModeItem) ? wifiModeItem->valuestring : "client";
     if (mqttEnabled && (wifiMode == "client" || wifiMode == "wifi")) {
         char topic[128];
-        snprintf(topic, sizeof(topic), "homeassistant/%s/bme280_pressure/state", deviceName.c_str());
+        snprintf(topic, sizeof(topic), "homeassistant/%s/%s_pressure/state", deviceName.c_str(), key);
         // Add random jitter between 0.01 and 0.02
         float jitter = ((float)random(10, 21)) / 100.0f;
         jitter = jitter / 10.0f;
@@ -129,7 +138,8 @@ void MqttManager::publishBME280Pressure(float pressure) {
 }
 
 // Publish BME280 heat index value to MQTT (with config checks)
-void MqttManager::publishBME280HeatIndex(float heatIndex) {
+void MqttManager::publishBME280HeatIndex(float heatIndex, const char* key) {
+    AllocationTracker::Scope allocScope("MQTT publishBME280HeatIndex");
     cJSON* config = systemManager.getConfigManager().getRoot();
     cJSON* wifiModeItem = cJSON_GetObjectItemCaseSensitive(config, "wifi_mode");
     cJSON* mqttEnabledItem = cJSON_GetObjectItemCaseSensitive(config, "mqtt_enabled");
@@ -147,7 +157,7 @@ void MqttManager::publishBME280HeatIndex(float heatIndex) {
     std::string wifiMode = wifiModeItem && cJSON_IsString(wifiModeItem) ? wifiModeItem->valuestring : "client";
     if (mqttEnabled && (wifiMode == "client" || wifiMode == "wifi")) {
         char topic[128];
-        snprintf(topic, sizeof(topic), "homeassistant/%s/bme280_heat_index/state", deviceName.c_str());
+        snprintf(topic, sizeof(topic), "homeassistant/%s/%s_heat_index/state", deviceName.c_str(), key);
         // Add random jitter between 0.01 and 0.02
         float jitter = ((float)random(10, 21)) / 100.0f;
         jitter = jitter / 10.0f;
@@ -159,7 +169,8 @@ void MqttManager::publishBME280HeatIndex(float heatIndex) {
 }
 
 // Publish BME280 dew point value to MQTT (with config checks)
-void MqttManager::publishBME280DewPoint(float dewPoint) {
+void MqttManager::publishBME280DewPoint(float dewPoint, const char* key) {
+    AllocationTracker::Scope allocScope("MQTT publishBME280DewPoint");
     cJSON* config = systemManager.getConfigManager().getRoot();
     cJSON* wifiModeItem = cJSON_GetObjectItemCaseSensitive(config, "wifi_mode");
     cJSON* mqttEnabledItem = cJSON_GetObjectItemCaseSensitive(config, "mqtt_enabled");
@@ -177,7 +188,7 @@ void MqttManager::publishBME280DewPoint(float dewPoint) {
     std::string wifiMode = wifiModeItem && cJSON_IsString(wifiModeItem) ? wifiModeItem->valuestring : "client";
     if (mqttEnabled && (wifiMode == "client" || wifiMode == "wifi")) {
         char topic[128];
-        snprintf(topic, sizeof(topic), "homeassistant/%s/bme280_dew_point/state", deviceName.c_str());
+        snprintf(topic, sizeof(topic), "homeassistant/%s/%s_dew_point/state", deviceName.c_str(), key);
         // Add random jitter between 0.01 and 0.02
         float jitter = ((float)random(10, 21)) / 100.0f;
         jitter = jitter / 10.0f;
@@ -189,14 +200,17 @@ void MqttManager::publishBME280DewPoint(float dewPoint) {
 }
 
 // Publish Home Assistant MQTT Discovery for BME280 humidity sensor
-void MqttManager::publishDiscoveryForBME280Humidity() {
+void MqttManager::publishDiscoveryForBME280Humidity(const char* key, const char* label) {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForBME280Humidity");
     char state_topic[128], availability_topic[128], topic[128], unique_id[128];
-    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/bme280_humidity/state", deviceName.c_str());
+    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/%s_humidity/state", deviceName.c_str(), key);
     snprintf(availability_topic, sizeof(availability_topic), "homeassistant/esp32/%s/availability", deviceName.c_str());
-    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_bme280_humidity/config", deviceName.c_str());
-    snprintf(unique_id, sizeof(unique_id), "%s_bme280_humidity", deviceName.c_str());
+    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_%s_humidity/config", deviceName.c_str(), key);
+    snprintf(unique_id, sizeof(unique_id), "%s_%s_humidity", deviceName.c_str(), key);
     cJSON* root = cJSON_CreateObject();
-    cJSON_AddStringToObject(root, "name", "BME280 Humidity");
+    char name[48];
+    snprintf(name, sizeof(name), "%s Humidity", label);
+    cJSON_AddStringToObject(root, "name", name);
     cJSON_AddStringToObject(root, "state_topic", state_topic);
     cJSON_AddStringToObject(root, "unit_of_measurement", "%");
     cJSON_AddStringToObject(root, "device_class", "humidity");
@@ -214,14 +228,17 @@ void MqttManager::publishDiscoveryForBME280Humidity() {
 }
 
 // Publish Home Assistant MQTT Discovery for BME280 pressure sensor
-void MqttManager::publishDiscoveryForBME280Pressure() {
+void MqttManager::publishDiscoveryForBME280Pressure(const char* key, const char* label) {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForBME280Pressure");
     char state_topic[128], availability_topic[128], topic[128], unique_id[128];
-    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/bme280_pressure/state", deviceName.c_str());
+    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/%s_pressure/state", deviceName.c_str(), key);
     snprintf(availability_topic, sizeof(availability_topic), "homeassistant/esp32/%s/availability", deviceName.c_str());
-    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_bme280_pressure/config", deviceName.c_str());
-    snprintf(unique_id, sizeof(unique_id), "%s_bme280_pressure", deviceName.c_str());
+    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_%s_pressure/config", deviceName.c_str(), key);
+    snprintf(unique_id, sizeof(unique_id), "%s_%s_pressure", deviceName.c_str(), key);
     cJSON* root = cJSON_CreateObject();
-    cJSON_AddStringToObject(root, "name", "BME280 Pressure");
+    char name[48];
+    snprintf(name, sizeof(name), "%s Pressure", label);
+    cJSON_AddStringToObject(root, "name", name);
     cJSON_AddStringToObject(root, "state_topic", state_topic);
     cJSON_AddStringToObject(root, "unit_of_measurement", "hPa");
     cJSON_AddStringToObject(root, "device_class", "pressure");
@@ -239,14 +256,17 @@ void MqttManager::publishDiscoveryForBME280Pressure() {
 }
 
 // Publish Home Assistant MQTT Discovery for BME280 heat index sensor
-void MqttManager::publishDiscoveryForBME280HeatIndex() {
+void MqttManager::publishDiscoveryForBME280HeatIndex(const char* key, const char* label) {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForBME280HeatIndex");
     char state_topic[128], availability_topic[128], topic[128], unique_id[128];
-    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/bme280_heat_index/state", deviceName.c_str());
+    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/%s_heat_index/state", deviceName.c_str(), key);
     snprintf(availability_topic, sizeof(availability_topic), "homeassistant/esp32/%s/availability", deviceName.c_str());
-    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_bme280_heat_index/config", deviceName.c_str());
-    snprintf(unique_id, sizeof(unique_id), "%s_bme280_heat_index", deviceName.c_str());
+    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_%s_heat_index/config", deviceName.c_str(), key);
+    snprintf(unique_id, sizeof(unique_id), "%s_%s_heat_index", deviceName.c_str(), key);
     cJSON* root = cJSON_CreateObject();
-    cJSON_AddStringToObject(root, "name", "BME280 Heat Index");
+    char name[48];
+    snprintf(name, sizeof(name), "%s Heat Index", label);
+    cJSON_AddStringToObject(root, "name", name);
     cJSON_AddStringToObject(root, "state_topic", state_topic);
     cJSON_AddStringToObject(root, "unit_of_measurement", "°C");
     cJSON_AddStringToObject(root, "device_class", "temperature");
@@ -264,14 +284,17 @@ void MqttManager::publishDiscoveryForBME280HeatIndex() {
 }
 
 // Publish Home Assistant MQTT Discovery for BME280 dew point sensor
-void MqttManager::publishDiscoveryForBME280DewPoint() {
+void MqttManager::publishDiscoveryForBME280DewPoint(const char* key, const char* label) {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForBME280DewPoint");
     char state_topic[128], availability_topic[128], topic[128], unique_id[128];
-    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/bme280_dew_point/state", deviceName.c_str());
+    snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/%s_dew_point/state", deviceName.c_str(), key);
     snprintf(availability_topic, sizeof(availability_topic), "homeassistant/esp32/%s/availability", deviceName.c_str());
-    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_bme280_dew_point/config", deviceName.c_str());
-    snprintf(unique_id, sizeof(unique_id), "%s_bme280_dew_point", deviceName.c_str());
+    snprintf(topic, sizeof(topic), "homeassistant/sensor/%s_%s_dew_point/config", deviceName.c_str(), key);
+    snprintf(unique_id, sizeof(unique_id), "%s_%s_dew_point", deviceName.c_str(), key);
     cJSON* root = cJSON_CreateObject();
-    cJSON_AddStringToObject(root, "name", "BME280 Dew Point");
+    char name[48];
+    snprintf(name, sizeof(name), "%s Dew Point", label);
+    cJSON_AddStringToObject(root, "name", name);
     cJSON_AddStringToObject(root, "state_topic", state_topic);
     cJSON_AddStringToObject(root, "unit_of_measurement", "°C");
     cJSON_AddStringToObject(root, "device_class", "temperature");
@@ -288,8 +311,40 @@ void MqttManager::publishDiscoveryForBME280DewPoint() {
     publish(topic, root);
 }
 
+void MqttManager::bme280EntityKey(const BME280Device* bme, char* key, size_t keyLen, char* label, size_t labelLen) {
+    if (bme == systemManager.getDeviceManager().getBME280Device()) {
+        snprintf(key, keyLen, "bme280");
+        snprintf(label, labelLen, "BME280");
+    } else {
+        snprintf(key, keyLen, "bme280_%02x", bme->getAddress());
+        snprintf(label, labelLen, "BME280 0x%02X", bme->getAddress());
+    }
+}
+
+void MqttManager::publishDiscoveryForBME280(const BME280Device* bme) {
+    char key[16], label[24];
+    bme280EntityKey(bme, key, sizeof(key), label, sizeof(label));
+    publishDiscoveryForBME280Temperature(key, label);
+    publishDiscoveryForBME280Humidity(key, label);
+    publishDiscoveryForBME280Pressure(key, label);
+    publishDiscoveryForBME280HeatIndex(key, label);
+    publishDiscoveryForBME280DewPoint(key, label);
+}
+
+void MqttManager::publishBME280Reading(const BME280Device* bme) {
+    char key[16], label[24];
+    bme280EntityKey(bme, key, sizeof(key), label, sizeof(label));
+    const BME280Reading& r = bme->getLastReading();
+    publishBME280Temperature(r.avgTemperature, key);
+    publishBME280Humidity(r.avgHumidity, key);
+    publishBME280Pressure(r.avgPressure, key);
+    publishBME280HeatIndex(r.avgHeatIndex, key);
+    publishBME280DewPoint(r.avgDewPoint, key);
+}
+
 // Publish Home Assistant MQTT Discovery for Soil Moisture sensor
 void MqttManager::publishDiscoveryForSoilMoisture() {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForSoilMoisture");
     char state_topic[128], availability_topic[128], topic[128], unique_id[128];
     snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/soil_moisture/state", deviceName.c_str());
     snprintf(availability_topic, sizeof(availability_topic), "homeassistant/esp32/%s/availability", deviceName.c_str());
@@ -315,6 +370,7 @@ void MqttManager::publishDiscoveryForSoilMoisture() {
 
 // Publish Home Assistant MQTT Discovery for MQ135 Air Quality Rating
 void MqttManager::publishDiscoveryForMQ135AirQuality() {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForMQ135AirQuality");
     char state_topic[128], availability_topic[128], topic[128], unique_id[128];
     snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/mq135_air_quality/state", deviceName.c_str());
     snprintf(availability_topic, sizeof(availability_topic), "homeassistant/esp32/%s/availability", deviceName.c_str());
@@ -342,6 +398,7 @@ void MqttManager::publishDiscoveryForMQ135AirQuality() {
 
 // Publish Soil Moisture value to MQTT (with config checks)
 void MqttManager::publishSoilMoisture(float percent) {
+    AllocationTracker::Scope allocScope("MQTT publishSoilMoisture");
     cJSON* config = systemManager.getConfigManager().getRoot();
     cJSON* wifiModeItem = cJSON_GetObjectItemCaseSensitive(config, "wifi_mode");
     cJSON* mqttEnabledItem = cJSON_GetObjectItemCaseSensitive(config, "mqtt_enabled");
@@ -377,6 +434,7 @@ void MqttManager::publishSoilMoisture(float percent) {
 
 // Publish MQ135 Air Quality Rating to MQTT (with config checks)
 void MqttManager::publishMQ135AirQuality() {
+    AllocationTracker::Scope allocScope("MQTT publishMQ135AirQuality");
     extern MQ135Sensor mq135Sensor;
     cJSON* config = systemManager.getConfigManager().getRoot();
     cJSON* wifiModeItem = cJSON_GetObjectItemCaseSensitive(config, "wifi_mode");
@@ -466,6 +524,7 @@ void MqttManager::begin(const std::string& deviceName_, const std::vector<std::s
 }
 
 void MqttManager::setInitialized(bool init) {
+    LoopProfiler::Site stallSite("MqttManager::setInitialized");
     initialized = init;
     if (initialized) {
         Serial.println("[MqttManager] MQTT Manager initialized and ready.");
@@ -488,12 +547,11 @@ void MqttManager::setInitialized(bool init) {
 
         // Publish config topics for Home Assistant with retain=true
         publishDiscovery();
-        // Publish BME280 temperature sensor discovery for Home Assistant
-        publishDiscoveryForBME280Temperature();
-        publishDiscoveryForBME280Humidity();
-        publishDiscoveryForBME280Pressure();
-        publishDiscoveryForBME280HeatIndex();
-        publishDiscoveryForBME280DewPoint();
+        // Publish BME280 sensor discovery for Home Assistant, one set per sensor
+        const BME280Group& bmeGroup = systemManager.getDeviceManager().getBME280Group();
+        for (int i = 0; i < bmeGroup.size(); ++i) {
+            publishDiscoveryForBME280(bmeGroup.get(i));
+        }
 
         // Publish Soil Moisture sensor discovery for Home Assistant
         publishDiscoveryForSoilMoisture();
@@ -509,17 +567,13 @@ void MqttManager::setInitialized(bool init) {
             }
         }
 
-        // Publish last BME280 temperature reading to Home Assistant
-        BME280Device* bme = systemManager.getDeviceManager().getBME280Device();
-        if (bme) {
-            BME280Reading r = bme->getLastReading();
+        // Publish last BME280 readings to Home Assistant
+        for (int i = 0; i < bmeGroup.size(); ++i) {
+            const BME280Device* bme = bmeGroup.get(i);
+            const BME280Reading& r = bme->getLastReading();
             if (r.valid) {
-                publishBME280Temperature(r.avgTemperature);
-                publishBME280Humidity(r.avgHumidity);
-                publishBME280Pressure(r.avgPressure);
-                publishBME280HeatIndex(r.avgHeatIndex);
-                publishBME280DewPoint(r.avgDewPoint);
-                Serial.printf("[MqttManager] Initial BME280 temperature published to Home Assistant: %.2fC\n", r.avgTemperature);
+                publishBME280Reading(bme);
+                Serial.printf("[MqttManager] Initial BME280 0x%02X temperature published to Home Assistant: %.2fC\n", bme->getAddress(), r.avgTemperature);
             }
         }
 
@@ -556,12 +610,14 @@ bool MqttManager::isInitialized() const {
 }
 
 void MqttManager::publishDiscovery() {
+    AllocationTracker::Scope allocScope("MQTT publishDiscovery");
     for (size_t i = 0; i < relayNames.size(); ++i) {
         publishDiscoveryForRelay(static_cast<int>(i));
     }
 }
 
 void MqttManager::publishDiscoveryForRelay(int relayIndex) {
+    AllocationTracker::Scope allocScope("MQTT publishDiscoveryForRelay");
     char state_topic[128], command_topic[128], unique_id[128], availability_topic[128], topic[128];
     snprintf(state_topic, sizeof(state_topic), "homeassistant/%s/relay%d/state", deviceName.c_str(), relayIndex + 1);
     snprintf(command_topic, sizeof(command_topic), "homeassistant/%s/relay%d/set", deviceName.c_str(), relayIndex + 1);
@@ -589,6 +645,7 @@ void MqttManager::publishDiscoveryForRelay(int relayIndex) {
 }
 
 void MqttManager::publishRelayState(int relayIndex, bool state) {
+    AllocationTracker::Scope allocScope("MQTT publishRelayState");
     // Check config before publishing relay state
     cJSON* config = systemManager.getConfigManager().getRoot();
     cJSON* wifiModeItem = cJSON_GetObjectItemCaseSensitive(config, "wifi_mode");
@@ -666,7 +723,7 @@ void MqttManager::publish(const std::string& topic, cJSON* payload) {
     bool pubResult = mqttClient.publish(topic.c_str(), msg, retain);
     Serial.printf("[MQTT] Publishing to topic '%s': %s (retain=%s)\n", topic.c_str(), msg, retain ? "true" : "false");
     Serial.printf("[MQTT] Publish result: %s\n", pubResult ? "success" : "fail");
-    free(msg); // Use free, not cJSON_free
+    cJSON_free(msg); // Allocated through the cJSON hooks, so released through them too
     // Only delete if payload is object or array
     if (cJSON_IsObject(payload) || cJSON_IsArray(payload)) {
         cJSON_Delete(payload);
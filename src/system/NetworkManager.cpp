@@ -1,5 +1,7 @@
 #include "system/NetworkManager.h"
 #include "system/TimeManager.h"
+#include "system/LoopProfiler.h"
+#include "system/BootTimeline.h"
 #include <WiFi.h>
 #include <cJSON.h>
 
@@ -113,6 +115,7 @@ void NetworkManager::update() {
             unsigned long elapsed = (millis() - wifiConnectStart) / 1000;
             if (WiFi.status() == WL_CONNECTED) {
                 wifiConnecting = false;
+                BootTimeline::mark("WiFi connected");
                 if (diagnosticManager) {
                     diagnosticManager->log(DiagnosticManager::LOG_INFO, "Network", "WiFi connected! IP: %s", WiFi.localIP().toString().c_str());
                 }
@@ -195,6 +198,7 @@ void NetworkManager::handleWiFiDisconnection() {
 }
 
 void NetworkManager::attemptReconnect() {
+    LoopProfiler::Site stallSite("NetworkManager::attemptReconnect");
     if (wifiMode == "client" && wifiSsid.length() > 0 && !apActive && !wifiConnecting) {
         reconnectAttempts++;
         if (diagnosticManager) {
@@ -1,10 +1,10 @@
 #include "system/ReadingManager.h"
-#include "devices/BME280Device.h"
+#include "devices/BME280Group.h"
 #include "devices/SoilMoistureSensor.h"
 #include <time.h>
 #include <Arduino.h>
 
-ReadingManager::ReadingManager(BME280Device* bme, SoilMoistureSensor* soil)
+ReadingManager::ReadingManager(BME280Group* bme, SoilMoistureSensor* soil)
     : bme280(bme), soilSensor(soil) {}
 
 void ReadingManager::begin() {
@@ -42,11 +42,8 @@ void ReadingManager::loop(const DateTime& now) {
     if (timeValid && now.minute() == 0 && soilState == SOIL_IDLE) {
         if (now.hour() != lastHour) {
             Serial.printf("[ReadingManager] Hourly trigger at %02d:00.\n", now.hour());
-            if (bme280) {
-                auto reading = bme280->readData();
-                Serial.printf("[ReadingManager] BME280: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC, time=%04d-%02d-%02d %02d:%02d:%02d\n",
-                    reading.temperature, reading.humidity, reading.pressure, reading.heatIndex, reading.dewPoint,
-                    now.year(), now.month(), now.day(), now.hour(), now.minute(), now.second());
+            if (bme280 && bme280->startReading() > 0) {
+                bmePending = true;
             }
             if (soilSensor) {
                 int stab = soilSensor->getStabilisationTimeSec();
@@ -59,6 +56,15 @@ void ReadingManager::loop(const DateTime& now) {
         }
     }
 
+    // The BME280 readings finish in the background (update() in loop())
+    if (bmePending && !bme280->isReading()) {
+        bmePending = false;
+        BME280Reading reading = bme280->getMedianReading();
+        Serial.printf("[ReadingManager] BME280 median: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC, time=%04d-%02d-%02d %02d:%02d:%02d\n",
+            reading.temperature, reading.humidity, reading.pressure, reading.heatIndex, reading.dewPoint,
+            now.year(), now.month(), now.day(), now.hour(), now.minute(), now.second());
+    }
+
     // Non-blocking soil stabilisation with progress output
     static unsigned long lastStabProgressPrint = 0;
     if (soilState == SOIL_STABILISING && soilSensor) {
@@ -3,7 +3,9 @@
 #include "system/I2CManager.h"
 #include "devices/BME280Device.h"
 #include "system/TimeManager.h"
+#include "diagnostics/AllocationTracker.h"
 #include <cJSON.h>
+#include <algorithm>
 
 // --- Restart scheduling ---
 void SystemManager::scheduleRestart(unsigned long delayMs) {
@@ -21,30 +23,88 @@ void SystemManager::clearRestartPending() {
 }
 
 void SystemManager::begin() {
-    initHardware();
-    fileSystemManager.begin(&diagnosticManager);
-    configManager.begin(fileSystemManager, &diagnosticManager);
-    diagnosticManager.begin(configManager);
-    deviceManager.begin(configManager);
-    healthManager.begin(&configManager, &diagnosticManager);
-    powerManager.begin(&configManager, &diagnosticManager);
-    networkManager.begin(&configManager, &diagnosticManager, &powerManager);
-    i2cManager.begin(&configManager, &diagnosticManager);
-    timeManager.begin(&i2cManager, &configManager, &diagnosticManager);
+    bootTimeline.start();
+    AllocationTracker::begin();
+    {
+        BootTimeline::Scope phase("SystemManager::initHardware");
+        initHardware();
+    }
+    {
+        BootTimeline::Scope phase("LittleFS mount");
+        fileSystemManager.begin(&diagnosticManager);
+    }
+    {
+        BootTimeline::Scope phase("ConfigManager::begin");
+        configManager.begin(fileSystemManager, &diagnosticManager);
+    }
+    {
+        BootTimeline::Scope phase("Diagnostic/Device/Health/Power begin");
+        diagnosticManager.begin(configManager);
+        deviceManager.begin(configManager);
+        healthManager.begin(&configManager, &diagnosticManager);
+        powerManager.begin(&configManager, &diagnosticManager);
+    }
+    {
+        BootTimeline::Scope phase("NetworkManager::begin");
+        networkManager.begin(&configManager, &diagnosticManager, &powerManager);
+    }
+    {
+        BootTimeline::Scope phase("I2CManager::begin");
+        i2cManager.begin(&configManager, &diagnosticManager);
+    }
+    {
+        BootTimeline::Scope phase("TimeManager::begin");
+        timeManager.begin(&i2cManager, &configManager, &diagnosticManager);
+    }
     // Connect TimeManager to NetworkManager for NTP sync on WiFi connect
     networkManager.setTimeManager(&timeManager);
-    i2cManager.autoRegisterBME280s(&timeManager, &deviceManager);
-    ads1115Manager.begin(i2cManager.getI2CMutex());
+    {
+        BootTimeline::Scope phase("I2CManager::autoRegisterBME280s");
+        i2cManager.autoRegisterBME280s(&timeManager, &deviceManager);
+    }
+    {
+        BootTimeline::Scope phase("ADS1115Manager::begin");
+        // Device 0 (0x48) feeds the sensors and is always started; devices
+        // 1-3 (ADDR strapped to VDD, SDA, SCL) only when the bus scan found
+        // them. ALERT/RDY is only wired for device 0.
+        ads1115Managers[0].begin(i2cManager.getI2CMutex(), 0x48, &i2cManager.getTracer(),
+                                 configManager.getInt("ads1115_alert_gpio", -1));
+        const std::vector<uint8_t>& detected = i2cManager.getDetectedDevices();
+        for (int device = 1; device < ADS1115Sampler::MAX_DEVICES; ++device) {
+            uint8_t address = 0x48 + device;
+            if (std::find(detected.begin(), detected.end(), address) == detected.end()) continue;
+            ads1115Managers[device].begin(i2cManager.getI2CMutex(), address, &i2cManager.getTracer());
+            ads1115Sampler.addDevice(device, &ads1115Managers[device]);
+        }
+        ads1115Sampler.begin(&ads1115Managers[0]);
+        ads1115Sampler.configureScans(cJSON_GetObjectItem(configManager.getRoot(), "ads1115_scan"));
+    }
     healthy = true;
 }
 
 void SystemManager::update() {
-    powerManager.update();
-    healthManager.update();
-    networkManager.update();
-    timeManager.update();
-    checkSystemHealth();
-    deviceManager.update();
+    {
+        LoopProfiler::Scope timing(loopProfiler, LoopProfiler::POWER);
+        powerManager.update();
+    }
+    {
+        LoopProfiler::Scope timing(loopProfiler, LoopProfiler::HEALTH);
+        healthManager.update();
+        checkSystemHealth();
+    }
+    {
+        LoopProfiler::Scope timing(loopProfiler, LoopProfiler::NETWORK);
+        networkManager.update();
+    }
+    {
+        LoopProfiler::Scope timing(loopProfiler, LoopProfiler::TIME);
+        timeManager.update();
+    }
+    {
+        LoopProfiler::Scope timing(loopProfiler, LoopProfiler::DEVICES);
+        deviceManager.update();
+        ads1115Sampler.update();
+    }
 
     // Handle scheduled restart
     if (restartPending && (millis() - restartScheduledAt >= restartDelayMs)) {
@@ -97,8 +157,21 @@ TimeManager& SystemManager::getTimeManager() {
     return timeManager;
 }
 
-ADS1115Manager& SystemManager::getADS1115Manager() {
-    return ads1115Manager;
+ADS1115Manager& SystemManager::getADS1115Manager(int device) {
+    if (device < 0 || device >= ADS1115Sampler::MAX_DEVICES) device = 0;
+    return ads1115Managers[device];
+}
+
+ADS1115Sampler& SystemManager::getADS1115Sampler() {
+    return ads1115Sampler;
+}
+
+LoopProfiler& SystemManager::getLoopProfiler() {
+    return loopProfiler;
+}
+
+BootTimeline& SystemManager::getBootTimeline() {
+    return bootTimeline;
 }
 
 void SystemManager::initHardware() {
@@ -5,6 +5,20 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include "system/MqttManager.h"
+#include "system/LoopProfiler.h"
+
+// DS3231 traffic per RTClib call, for the bus tracer. Register reads are a
+// pointer write plus a read; control/status updates read-modify-write.
+static const uint8_t RTC_ADDRESS = 0x68;
+static const I2CTracer::Cost RTC_BEGIN = {1, 0, 0};
+static const I2CTracer::Cost RTC_NOW = {2, 1, 7};
+static const I2CTracer::Cost RTC_ADJUST = {4, 10, 1};
+static const I2CTracer::Cost RTC_LOST_POWER = {2, 1, 1};
+static const I2CTracer::Cost RTC_ALARM_FIRED = {2, 1, 1};
+static const I2CTracer::Cost RTC_CLEAR_ALARM = {3, 3, 1};
+static const I2CTracer::Cost RTC_SET_ALARM1 = {4, 8, 1};
+static const I2CTracer::Cost RTC_SET_ALARM2 = {4, 7, 1};
+static const I2CTracer::Cost RTC_CONTROL = {3, 3, 1}; // disableAlarm, writeSqwPinMode, disable32K
 
 // Use the global instance from main.cpp
 extern MqttManager mqttManager;
@@ -23,9 +37,12 @@ void TimeManager::begin(I2CManager* i2c, ConfigManager* config, DiagnosticManage
     }
     
     // Initialize RTC
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-    rtcFound = rtc.begin();
-    if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
+    {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.begin");
+        rtcFound = rtc.begin();
+        access.add(RTC_BEGIN);
+        if (!rtcFound) access.fail();
+    }
     if (rtcFound) {
         if (diagnosticManager) {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "DS3231 RTC detected and initialized");
@@ -36,16 +53,20 @@ void TimeManager::begin(I2CManager* i2c, ConfigManager* config, DiagnosticManage
         
         // Enable alarm interrupts on INT/SQW pin
         // Clear any existing alarm flags first
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-        rtc.clearAlarm(1);
-        rtc.clearAlarm(2);
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
+        {
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.clearAlarm");
+            rtc.clearAlarm(1);
+            rtc.clearAlarm(2);
+            access.add(RTC_CLEAR_ALARM, 2);
+        }
         alarm1Active = false; // Reset alarm state
         // Enable alarm interrupts (this will control the INT/SQW pin)
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-        rtc.writeSqwPinMode(DS3231_OFF); // Disable square wave, enable alarm interrupts
-        rtc.disable32K(); // Disable 32K output to save power
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
+        {
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.control");
+            rtc.writeSqwPinMode(DS3231_OFF); // Disable square wave, enable alarm interrupts
+            rtc.disable32K(); // Disable 32K output to save power
+            access.add(RTC_CONTROL, 2);
+        }
         // The INT/SQW pin will now be controlled by alarm interrupts
         if (diagnosticManager) {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "DS3231 INT/SQW pin configured for alarm interrupts");
@@ -55,7 +76,12 @@ void TimeManager::begin(I2CManager* i2c, ConfigManager* config, DiagnosticManage
         initializeInterruptPin();
         
         // Initialize DST status based on current time
-        DateTime localTime = rtc.now(); // RTC stores local time
+        DateTime localTime;
+        {
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.now", false);
+            localTime = rtc.now(); // RTC stores local time
+            access.add(RTC_NOW);
+        }
         bool dstEnabled = configManager ? configManager->getBool("dst_enabled", true) : true;
         bool dstActive = dstEnabled && isDSTActive(localTime);
         lastDSTState = dstActive;
@@ -203,9 +229,11 @@ DateTime TimeManager::getTime() {
     static DateTime lastGoodTime;
     DateTime dt;
     if (rtcFound) {
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-        dt = rtc.now();
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
+        {
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.now");
+            dt = rtc.now();
+            access.add(RTC_NOW);
+        }
         // Check for valid/sane date
         bool valid = dt.isValid() && dt.year() >= 2000 && dt.year() < 2100 && dt.month() >= 1 && dt.month() <= 12 && dt.day() >= 1 && dt.day() <= 31;
         if (valid) {
@@ -243,15 +271,21 @@ DateTime TimeManager::getLocalTime() {
 
 void TimeManager::setTime(const DateTime& dt) {
     if (rtcFound) {
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreTake(i2cManager->getI2CMutex(), portMAX_DELAY);
-        rtc.adjust(dt);
-        if (i2cManager && i2cManager->getI2CMutex()) xSemaphoreGive(i2cManager->getI2CMutex());
+        {
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.adjust");
+            rtc.adjust(dt);
+            access.add(RTC_ADJUST);
+        }
         // Reinitialize lastDayId after time adjustment to prevent false "new day" detection
         int newDayId = dt.year() * 10000 + dt.month() * 100 + dt.day();
         if (diagnosticManager) {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "setTime: updating lastDayId from %d to %d", lastDayId, newDayId);
         }
         lastDayId = newDayId;
+        // Re-latch DST status for the new time so a manual set across the DST
+        // boundary is not treated as a transition by checkDST()
+        bool dstEnabled = configManager ? configManager->getBool("dst_enabled", true) : true;
+        lastDSTState = dstEnabled && isDSTActive(dt);
     }
 }
 
@@ -379,6 +413,7 @@ bool TimeManager::syncWithNTP() {
 }
 
 bool TimeManager::performNTPSync(const String& server, int timeoutMs) {
+    LoopProfiler::Site stallSite("TimeManager::performNTPSync");
     WiFiUDP udp;
     udp.begin(123); // NTP port
     
@@ -520,17 +555,22 @@ bool TimeManager::isWiFiConnected() {
 bool TimeManager::setAlarm1(int hour, int minute, int second, bool enabled) {
     if (!rtcFound) return false;
     
+    I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.setAlarm1", false);
     if (enabled) {
         // Clear any existing alarm flag
         rtc.clearAlarm(1);
         // Set alarm to trigger on hour:minute:second match (daily)
-        rtc.setAlarm1(DateTime(2000, 1, 1, hour, minute, second), DS3231_A1_Hour);
+        if (!rtc.setAlarm1(DateTime(2000, 1, 1, hour, minute, second), DS3231_A1_Hour)) access.fail();
+        access.add(RTC_CLEAR_ALARM);
+        access.add(RTC_SET_ALARM1);
         if (diagnosticManager) {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "Alarm1 set: %02d:%02d:%02d (enabled)", hour, minute, second);
         }
     } else {
         rtc.disableAlarm(1);
         rtc.clearAlarm(1);
+        access.add(RTC_CONTROL);
+        access.add(RTC_CLEAR_ALARM);
         alarm1Active = false; // Only reset when disabled
         if (diagnosticManager) {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "Alarm1 disabled");
@@ -542,17 +582,22 @@ bool TimeManager::setAlarm1(int hour, int minute, int second, bool enabled) {
 bool TimeManager::setAlarm2(int hour, int minute, bool enabled) {
     if (!rtcFound) return false;
     
+    I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.setAlarm2", false);
     if (enabled) {
         // Clear any existing alarm flag
         rtc.clearAlarm(2);
         // Set alarm to trigger on hour:minute match (daily)
-        rtc.setAlarm2(DateTime(2000, 1, 1, hour, minute, 0), DS3231_A2_Hour);
+        if (!rtc.setAlarm2(DateTime(2000, 1, 1, hour, minute, 0), DS3231_A2_Hour)) access.fail();
+        access.add(RTC_CLEAR_ALARM);
+        access.add(RTC_SET_ALARM2);
         if (diagnosticManager) {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "Alarm2 set: %02d:%02d (enabled)", hour, minute);
         }
     } else {
         rtc.disableAlarm(2);
         rtc.clearAlarm(2);
+        access.add(RTC_CONTROL);
+        access.add(RTC_CLEAR_ALARM);
         if (diagnosticManager) {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "Alarm2 disabled");
         }
@@ -574,13 +619,17 @@ bool TimeManager::readAlarm2(int &hour, int &minute, bool &enabled) {
 
 void TimeManager::clearAlarm1() {
     if (rtcFound) {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.clearAlarm", false);
         rtc.clearAlarm(1);
+        access.add(RTC_CLEAR_ALARM);
     }
 }
 
 void TimeManager::clearAlarm2() {
     if (rtcFound) {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.clearAlarm", false);
         rtc.clearAlarm(2);
+        access.add(RTC_CLEAR_ALARM);
     }
 }
 
@@ -695,7 +744,12 @@ void TimeManager::setAlarmsForToday() {
         bool shouldSetAlarm = false;
         if (dayEnabled) {
             // Compare scheduled time to current time
-            DateTime now = rtc.now();
+            DateTime now;
+            {
+                I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.now", false);
+                now = rtc.now();
+                access.add(RTC_NOW);
+            }
             int nowSec = now.hour() * 3600 + now.minute() * 60 + now.second();
             int alarmSec = hour * 3600 + minute * 60 + second;
             if (alarmSec > nowSec) {
@@ -827,9 +881,19 @@ void TimeManager::setBuildTimeIfNeeded() {
     
     bool forceBuildTime = configManager->getBool("force_build_time", false);
     
-    if (forceBuildTime || rtc.lostPower()) {
+    bool lostPower;
+    {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.lostPower", false);
+        lostPower = rtc.lostPower();
+        access.add(RTC_LOST_POWER);
+    }
+    if (forceBuildTime || lostPower) {
         DateTime buildDateTime = buildTime();
-        rtc.adjust(buildDateTime);
+        {
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.adjust", false);
+            rtc.adjust(buildDateTime);
+            access.add(RTC_ADJUST);
+        }
         
         // Reinitialize lastDayId after time adjustment
         int newDayId = buildDateTime.year() * 10000 + buildDateTime.month() * 100 + buildDateTime.day();
@@ -895,21 +959,33 @@ void TimeManager::enableAlarmInterrupts() {
     if (!rtcFound) return;
     
     // Clear any existing alarm flags BEFORE enabling interrupts
-    rtc.clearAlarm(1);
-    rtc.clearAlarm(2);
+    {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.clearAlarm", false);
+        rtc.clearAlarm(1);
+        rtc.clearAlarm(2);
+        access.add(RTC_CLEAR_ALARM, 2);
+    }
     alarm1Active = false; // Reset alarm state
     
     // Configure DS3231 control register to enable alarm interrupts
     // This will make the INT/SQW pin respond to alarm triggers
-    rtc.writeSqwPinMode(DS3231_OFF); // Disable square wave output
-    rtc.disable32K(); // Disable 32K output to save power
+    {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.control", false);
+        rtc.writeSqwPinMode(DS3231_OFF); // Disable square wave output
+        rtc.disable32K(); // Disable 32K output to save power
+        access.add(RTC_CONTROL, 2);
+    }
     
     // Set alarms for today's schedule
     setAlarmsForToday();
     
     // Clear alarm flags AGAIN after setting alarms to ensure clean start
-    rtc.clearAlarm(1);
-    rtc.clearAlarm(2);
+    {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.clearAlarm", false);
+        rtc.clearAlarm(1);
+        rtc.clearAlarm(2);
+        access.add(RTC_CLEAR_ALARM, 2);
+    }
     alarm1Active = false;
     
     if (diagnosticManager) {
@@ -921,8 +997,14 @@ void TimeManager::handleAlarmInterrupt() {
     if (!rtcFound || intSqwGpio == 255) return;
     
     // Check alarm flags, but only process them if they represent new triggers
-    bool alarm1Triggered = rtc.alarmFired(1);
-    bool alarm2Triggered = rtc.alarmFired(2);
+    bool alarm1Triggered;
+    bool alarm2Triggered;
+    {
+        I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.alarmFired", false);
+        alarm1Triggered = rtc.alarmFired(1);
+        alarm2Triggered = rtc.alarmFired(2);
+        access.add(RTC_ALARM_FIRED, 2);
+    }
     
     // Only process alarm1 if it wasn't already active and current time is actually at or past the alarm time
     if (alarm1Triggered && !alarm1Active) {
@@ -966,7 +1048,9 @@ void TimeManager::handleAlarmInterrupt() {
                 diagnosticManager->log(DiagnosticManager::LOG_DEBUG, "Time", "Alarm 1 flag set but time mismatch (%02d:%02d vs expected %02d:%02d, diff=%d min) - clearing flag", 
                                        currentTime.hour(), currentTime.minute(), expectedHour, expectedMinute, diff);
             }
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.clearAlarm", false);
             rtc.clearAlarm(1);
+            access.add(RTC_CLEAR_ALARM);
         }
     }
     
@@ -975,8 +1059,12 @@ void TimeManager::handleAlarmInterrupt() {
             diagnosticManager->log(DiagnosticManager::LOG_INFO, "Time", "Alarm 2 triggered - clearing both alarms, INT/SQW should go HIGH");
         }
         // Clear both alarms when alarm2 triggers - this makes INT/SQW go HIGH
-        rtc.clearAlarm(1);
-        rtc.clearAlarm(2);
+        {
+            I2CTracer::Access access(i2cManager, RTC_ADDRESS, "rtc.clearAlarm", false);
+            rtc.clearAlarm(1);
+            rtc.clearAlarm(2);
+            access.add(RTC_CLEAR_ALARM, 2);
+        }
         alarm1Active = false;
     }
     
@@ -1,5 +1,6 @@
 #include "system/WebServerManager.h"
 #include "system/MqttManager.h"
+#include "diagnostics/AllocationTracker.h"
 #include <Arduino.h>
 
 
@@ -18,6 +19,7 @@ void WebServerManager::begin() {
 
     // Clear Config API
     server->on("/api/clearconfig", HTTP_POST, [](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("POST /api/clearconfig");
         bool ok = systemManager.getFileSystemManager().deleteConfigJson();
         cJSON* resp = cJSON_CreateObject();
         if (ok) {
@@ -35,6 +37,7 @@ void WebServerManager::begin() {
 
     // Restart API (schedule restart after delay)
     server->on("/api/restart", HTTP_POST, [](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("POST /api/restart");
         cJSON* resp = cJSON_CreateObject();
         cJSON_AddStringToObject(resp, "result", "ok");
         cJSON_AddStringToObject(resp, "message", "System will restart in 3 seconds.");
@@ -48,9 +51,14 @@ void WebServerManager::begin() {
     // Config save API
     server->on("/api/config", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            AllocationTracker::Scope allocScope("POST /api/config");
             static String bodyAccum;
-            if (index == 0) bodyAccum = "";
-            bodyAccum += String((const char*)data, len);
+            if (index == 0) {
+                bodyAccum = "";
+                // One block for the whole body instead of a realloc per chunk
+                bodyAccum.reserve(total);
+            }
+            bodyAccum.concat((const char*)data, len);
             if (index + len < total) {
                 // Wait for more chunks
                 return;
@@ -124,6 +132,7 @@ void WebServerManager::begin() {
     extern MQ135Sensor mq135Sensor;
     server->on("/api/mq135/trigger", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            AllocationTracker::Scope allocScope("POST /api/mq135/trigger");
             extern MQ135Sensor mq135Sensor;
             extern bool mq135ReadingRequested;
             extern int sensorState;
@@ -149,6 +158,7 @@ void WebServerManager::begin() {
     extern SoilMoistureSensor soilMoistureSensor;
     server->on("/api/soilmoisture/trigger", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            AllocationTracker::Scope allocScope("POST /api/soilmoisture/trigger");
             extern SoilMoistureSensor soilMoistureSensor;
             soilMoistureSensor.beginStabilisation();
             // Set state machine so main loop will process the reading
@@ -168,30 +178,15 @@ void WebServerManager::begin() {
     // BME280 trigger API
     server->on("/api/bme280/trigger", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
-            BME280Device* bme = systemManager.getDeviceManager().getBME280Device();
+            AllocationTracker::Scope allocScope("POST /api/bme280/trigger");
+            BME280Group& bmeGroup = systemManager.getDeviceManager().getBME280Group();
             cJSON* resp = cJSON_CreateObject();
-            if (bme) {
-                BME280Reading r = bme->readData();
-                cJSON_AddStringToObject(resp, "result", r.valid ? "ok" : "error");
-                cJSON_AddNumberToObject(resp, "temperature", r.temperature);
-                cJSON_AddNumberToObject(resp, "humidity", r.humidity);
-                cJSON_AddNumberToObject(resp, "pressure", r.pressure);
-                cJSON_AddNumberToObject(resp, "heat_index", r.heatIndex);
-                cJSON_AddNumberToObject(resp, "dew_point", r.dewPoint);
-                // Print to terminal for manual reading
-                if (r.valid) {
-                    char timeStr[32] = "";
-                    if (r.timestamp.isValid()) {
-                        snprintf(timeStr, sizeof(timeStr), "%04d-%02d-%02d %02d:%02d:%02d", r.timestamp.year(), r.timestamp.month(), r.timestamp.day(), r.timestamp.hour(), r.timestamp.minute(), r.timestamp.second());
-                    } else {
-                        strcpy(timeStr, "N/A");
-                    }
-                    Serial.printf("[BME280] Manual reading: T=%.2fC, H=%.2f%%, P=%.2fhPa, HI=%.2fC, DP=%.2fC | avgT=%.2fC, avgH=%.2f%%, avgP=%.2fhPa, avgHI=%.2fC, avgDP=%.2fC, time=%s\n",
-                        r.temperature, r.humidity, r.pressure, r.heatIndex, r.dewPoint,
-                        r.avgTemperature, r.avgHumidity, r.avgPressure, r.avgHeatIndex, r.avgDewPoint, timeStr);
-                } else {
-                    Serial.println("[BME280] Manual reading: not valid");
-                }
+            if (bmeGroup.size() > 0) {
+                // Every sensor, on the loop task; the results show up in /api/status
+                bmeGroup.requestReading();
+                cJSON_AddStringToObject(resp, "result", "started");
+                cJSON_AddNumberToObject(resp, "sensors", bmeGroup.size());
+                cJSON_AddStringToObject(resp, "message", "BME280 reading started. Poll /api/status for result.");
             } else {
                 cJSON_AddStringToObject(resp, "result", "error");
                 Serial.println("[BME280] Manual reading: device not found");
@@ -210,6 +205,7 @@ void WebServerManager::begin() {
     extern IrrigationManager irrigationManager;
     server->on("/api/irrigation/trigger", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            AllocationTracker::Scope allocScope("POST /api/irrigation/trigger");
             int result = 0;
             
             irrigationManager.trigger();
@@ -224,6 +220,7 @@ void WebServerManager::begin() {
     // Irrigation Water Now API
     server->on("/api/irrigation/waternow", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            AllocationTracker::Scope allocScope("POST /api/irrigation/waternow");
             extern IrrigationManager irrigationManager;
             irrigationManager.waterNow();
             cJSON* resp = cJSON_CreateObject();
@@ -237,6 +234,7 @@ void WebServerManager::begin() {
     // Irrigation Stop Now API (grouped with other irrigation endpoints)
     server->on("/api/irrigation/stop", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+            AllocationTracker::Scope allocScope("POST /api/irrigation/stop");
             extern IrrigationManager irrigationManager;
             irrigationManager.stopNow();
             cJSON* resp = cJSON_CreateObject();
@@ -249,7 +247,8 @@ void WebServerManager::begin() {
         });
     server->on("/api/relay", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [relayControllerPtr](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
-            String body = String((char*)data).substring(0, len);
+            AllocationTracker::Scope allocScope("POST /api/relay");
+            String body((const char*)data, len);
             int relay = -1;
             String command;
             #if defined(ARDUINO_ARCH_ESP32)
@@ -303,13 +302,79 @@ void WebServerManager::begin() {
 
     // API routes
     server->on("/api/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /api/status");
         handleAPI(request);
     });
 
+    // Metrics routes: AsyncWebServer routes also match every URL below them,
+    // so the more specific paths are registered before "/api/metrics".
+    server->on("/api/metrics/reset", HTTP_POST, [](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("POST /api/metrics/reset");
+        systemManager.getLoopProfiler().requestReset();
+        AllocationTracker::reset();
+        systemManager.getI2CManager().getTracer().reset();
+        cJSON* resp = cJSON_CreateObject();
+        cJSON_AddStringToObject(resp, "result", "ok");
+        cJSON_AddStringToObject(resp, "message", "Loop, allocation and I2C metrics reset.");
+        char* respStr = cJSON_PrintUnformatted(resp);
+        request->send(200, "application/json", respStr);
+        cJSON_free(respStr);
+        cJSON_Delete(resp);
+    });
+
+    // Heap allocation metrics API (per web handler and MQTT publish)
+    server->on("/api/metrics/alloc", HTTP_GET, [](AsyncWebServerRequest* request) {
+        cJSON* resp = AllocationTracker::getStatsJson();
+        char* respStr = cJSON_PrintUnformatted(resp);
+        request->send(200, "application/json", respStr);
+        cJSON_free(respStr);
+        cJSON_Delete(resp);
+    });
+
+    // I2C bus metrics API: most recent accesses, then per-address utilisation
+    server->on("/api/metrics/i2c/trace", HTTP_GET, [](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /api/metrics/i2c/trace");
+        cJSON* resp = systemManager.getI2CManager().getTracer().getTraceJson();
+        char* respStr = cJSON_PrintUnformatted(resp);
+        request->send(200, "application/json", respStr);
+        cJSON_free(respStr);
+        cJSON_Delete(resp);
+    });
+
+    server->on("/api/metrics/i2c", HTTP_GET, [](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /api/metrics/i2c");
+        cJSON* resp = systemManager.getI2CManager().getTracer().getUtilisationJson();
+        char* respStr = cJSON_PrintUnformatted(resp);
+        request->send(200, "application/json", respStr);
+        cJSON_free(respStr);
+        cJSON_Delete(resp);
+    });
+
+    // Loop stall API: loop() latency histogram and the slowest iterations
+    server->on("/api/metrics/stalls", HTTP_GET, [](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /api/metrics/stalls");
+        cJSON* resp = systemManager.getLoopProfiler().getStallsJson();
+        char* respStr = cJSON_PrintUnformatted(resp);
+        request->send(200, "application/json", respStr);
+        cJSON_free(respStr);
+        cJSON_Delete(resp);
+    });
+
+    // Loop timing metrics API (per-subsystem min/max/p50/p99 in microseconds)
+    server->on("/api/metrics", HTTP_GET, [](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /api/metrics");
+        cJSON* resp = systemManager.getLoopProfiler().getMetricsJson();
+        char* respStr = cJSON_PrintUnformatted(resp);
+        request->send(200, "application/json", respStr);
+        cJSON_free(respStr);
+        cJSON_Delete(resp);
+    });
+
     // LED control API
     server->on("/api/led", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
-            String body = String((char*)data).substring(0, len);
+            AllocationTracker::Scope allocScope("POST /api/led");
+            String body((const char*)data, len);
             String command;
             #if defined(ARDUINO_ARCH_ESP32)
             cJSON* root = cJSON_Parse(body.c_str());
@@ -345,7 +410,8 @@ void WebServerManager::begin() {
     // Manual RTC time set API
     server->on("/api/settime", HTTP_POST, [](AsyncWebServerRequest* request){}, NULL,
         [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
-            String body = String((char*)data).substring(0, len);
+            AllocationTracker::Scope allocScope("POST /api/settime");
+            String body((const char*)data, len);
             cJSON* json = cJSON_Parse(body.c_str());
             cJSON* resp = cJSON_CreateObject();
             if (!json) {
@@ -394,51 +460,65 @@ void WebServerManager::begin() {
 
     // Static file routes
     server->on("/", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /");
         handleRoot(request);
     });
 
     server->on("/style.css", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /style.css");
         handleStaticFile(request);
     });
 
     server->on("/script.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /script.js");
         handleStaticFile(request);
     });
 
     server->on("/index.html", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /index.html");
         handleStaticFile(request);
     });
     server->on("/relay.html", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /relay.html");
         handleStaticFile(request);
     });
     server->on("/relay.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /relay.js");
         handleStaticFile(request);
     });
     server->on("/index.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /index.js");
         handleStaticFile(request);
     });
     server->on("/irrigation.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /irrigation.js");
         handleStaticFile(request);
     });
     server->on("/config.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /config.js");
         handleStaticFile(request);
     });
     server->on("/irrigation.html", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /irrigation.html");
         handleStaticFile(request);
     });
     server->on("/config.html", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /config.html");
         handleStaticFile(request);
     });
     server->on("/info.html", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /info.html");
         handleStaticFile(request);
     });
     server->on("/info.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("GET /info.js");
         handleStaticFile(request);
     });
 
     // Removed schedule.html and schedule.js routes (files deleted)
     
     server->onNotFound([this](AsyncWebServerRequest* request) {
+        AllocationTracker::Scope allocScope("notFound");
         handleNotFound(request);
     });
     